@@ -2,6 +2,8 @@
 #define CONFIG_MANAGER_H
 
 #include <stdbool.h>
+#include "cpu_affinity.h"
+#include "startup_graph.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -16,6 +18,12 @@ typedef struct {
     char config_data[1024];  // 配置数据
     int priority;            // 优先级
     bool auto_start;         // 是否自动启动
+    CpuPlacement placement;  // CPU放置("placement": {"policy", "cpus", "cpu_count"})
+    char depends_on[STARTUP_MAX_DEPENDENCIES][64]; // 依赖的进程("depends_on": ["name", ...])
+    int dependency_count;    // 依赖数量
+    bool isolated;           // 是否在独立的插件宿主进程中运行("isolated": true)
+    bool lazy;               // 非自动启动时延迟到首次启动才加载("lazy": true)
+    int idle_unload_seconds; // 延迟加载的进程停止超过该秒数后卸载("idle_unload_seconds"，0不卸载)
 } ProcessConfig;
 
 /**
@@ -0,0 +1,624 @@
+#ifndef CPP_COROUTINE_TASK_H
+#define CPP_COROUTINE_TASK_H
+
+#include "task_interface.h"
+#include "task_executor.h"
+#include "task_arena.h"
+#include "timer_wheel.h"
+
+#if !defined(__cplusplus) || __cplusplus < 202002L
+#error "cpp_coroutine_task.h 需要C++20 (-std=c++20)"
+#endif
+
+#include <atomic>
+#include <coroutine>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+/**
+ * C++20协程任务适配器
+ *
+ * 协程函数签名为 CoroTask fn(CoroContext& ctx)，在其中co_await定时器、停止请求和fd就绪，
+ * 挂起时不占用线程。适配器把协程包装为普通的TaskBase(第一个成员)，以池化模式
+ * (TASK_EXEC_POOLED)注册到task_manager: 每次resume对应一次step()，由共享执行器调度，
+ * 成千上万个协程任务只占用执行器的几个工作线程。
+ *
+ * 状态: 协程正常返回为STOPPED，抛出异常为ERROR；停止请求时适配器恢复协程，
+ * 所有co_await立即返回CoroWake::Stopped，协程应随即返回，帧随cleanup销毁。
+ *
+ *     CoroTask heartbeat_loop(CoroContext& ctx) {
+ *         for (;;) {
+ *             CoroWake wake = co_await ctx.sleep(1000);
+ *             if (wake == CoroWake::Stopped) {
+ *                 co_return;
+ *             }
+ *             ...
+ *         }
+ *     }
+ *
+ * 注意: GCC 12对if/while条件中的co_await生成错误代码，等待结果应先存入变量再判断
+ *
+ *     CoroTaskWrapper* task = coro_task_create(&config, heartbeat_loop);
+ *     task_manager_register(manager, coro_task_get_base(task));
+ */
+
+// 停止时最多恢复协程的次数，仍未返回则直接销毁协程帧
+#define CORO_STOP_RESUME_LIMIT 16
+
+/**
+ * co_await的结果
+ */
+enum class CoroWake {
+    Ready,      // fd就绪 / 让出后重新调度
+    Timeout,    // 定时到期
+    Stopped,    // 任务被要求停止
+    Error       // 无法等待(如fd无效或已有其他协程在等待同一fd)
+};
+
+/**
+ * 协程返回类型 - 创建后挂起，由适配器的step()恢复
+ */
+class CoroTask {
+public:
+    struct promise_type {
+        std::exception_ptr error;
+
+        CoroTask get_return_object() {
+            return CoroTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { error = std::current_exception(); }
+    };
+
+    CoroTask(CoroTask&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+    CoroTask(const CoroTask&) = delete;
+    CoroTask& operator=(const CoroTask&) = delete;
+
+    ~CoroTask() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    /**
+     * 交出协程帧的所有权
+     */
+    std::coroutine_handle<promise_type> release() noexcept {
+        return std::exchange(handle_, nullptr);
+    }
+
+private:
+    explicit CoroTask(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+class CoroContext;
+struct CoroTaskWrapper;
+
+inline void coro_task_release_frame(CoroTaskWrapper* wrapper);
+inline int coro_task_initialize(TaskBase* base);
+inline int coro_task_step(TaskBase* base);
+inline void coro_task_cleanup(TaskBase* base);
+inline int coro_task_get_status(TaskBase* base, char* buffer, size_t size);
+
+/**
+ * fd就绪反应器 - 进程内单个epoll线程，就绪时唤醒等待的协程任务
+ * 每个fd同时只能有一个协程等待(EPOLLONESHOT，每次等待重新登记)
+ */
+class CoroReactor {
+public:
+    static CoroReactor& instance() {
+        static CoroReactor reactor;
+        return reactor;
+    }
+
+    /**
+     * 登记一次等待
+     * @return 登记号，失败返回0
+     */
+    uint64_t watch(int fd, uint32_t events, CoroContext* context);
+
+    /**
+     * 撤销登记 - 返回后不会再唤醒该协程
+     */
+    void unwatch(int fd, uint64_t id);
+
+private:
+    CoroReactor() {
+        epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+        if (epoll_fd_ >= 0) {
+            // 随进程退出，不回收
+            std::thread(&CoroReactor::run, this).detach();
+        }
+    }
+
+    void run();
+
+    int epoll_fd_ = -1;
+    uint64_t next_id_ = 1;
+    std::mutex mutex_;                                      // 保护waiters_，分发就绪事件时持有
+    std::unordered_map<uint64_t, CoroContext*> waiters_;
+};
+
+/**
+ * 协程定时服务 - 进程级，首次等待定时器时创建
+ */
+inline TimerService* coro_timer_service() {
+    static TimerService* service = timer_service_create();
+    return service;
+}
+
+/**
+ * 等待体 - 由CoroContext的等待函数构造
+ */
+class CoroAwaiter {
+public:
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(std::coroutine_handle<>) noexcept;
+    CoroWake await_resume() noexcept;
+
+private:
+    friend class CoroContext;
+
+    enum class Kind { Yield, Timer, Fd, Stop };
+
+    CoroAwaiter(CoroContext& context, Kind kind, int fd, uint32_t events, uint32_t timeout_ms)
+        : context_(context), kind_(kind), fd_(fd), events_(events), timeout_ms_(timeout_ms) {}
+
+    CoroContext& context_;
+    Kind kind_;
+    int fd_;
+    uint32_t events_;
+    uint32_t timeout_ms_;
+};
+
+/**
+ * 协程上下文 - 每个协程任务一个，以引用传给协程函数
+ * 同一时刻只有一个等待，等待状态只在执行器的工作线程上访问(执行器保证同一任务不会并发step)，
+ * 定时线程和反应器线程只写入到期/就绪标志并唤醒任务
+ */
+class CoroContext {
+public:
+    explicit CoroContext(TaskBase* base) : base_(base) {
+        memset(&timer_, 0, sizeof(timer_));
+    }
+
+    CoroContext(const CoroContext&) = delete;
+    CoroContext& operator=(const CoroContext&) = delete;
+
+    /**
+     * 任务基类指针
+     */
+    TaskBase* base() const { return base_; }
+
+    /**
+     * 是否已被要求停止
+     */
+    bool stop_requested() const { return stopping_ || task_should_stop(base_); }
+
+    /**
+     * 等待指定毫秒 - 结果为Timeout，停止时为Stopped
+     * @param ms 延迟(毫秒)，0相当于yield()
+     */
+    CoroAwaiter sleep(uint32_t ms) {
+        return CoroAwaiter(*this, ms ? CoroAwaiter::Kind::Timer : CoroAwaiter::Kind::Yield, -1, 0, ms);
+    }
+
+    /**
+     * 等待fd可读 - 结果为Ready，超时为Timeout，停止时为Stopped
+     * @param fd 文件描述符
+     * @param timeout_ms 超时(毫秒)，0为不超时
+     */
+    CoroAwaiter readable(int fd, uint32_t timeout_ms = 0) {
+        return CoroAwaiter(*this, CoroAwaiter::Kind::Fd, fd, EPOLLIN, timeout_ms);
+    }
+
+    /**
+     * 等待fd可写 - 结果同readable()
+     * @param fd 文件描述符
+     * @param timeout_ms 超时(毫秒)，0为不超时
+     */
+    CoroAwaiter writable(int fd, uint32_t timeout_ms = 0) {
+        return CoroAwaiter(*this, CoroAwaiter::Kind::Fd, fd, EPOLLOUT, timeout_ms);
+    }
+
+    /**
+     * 让出工作线程，重新排队 - 结果为Ready，停止时为Stopped
+     */
+    CoroAwaiter yield() {
+        return CoroAwaiter(*this, CoroAwaiter::Kind::Yield, -1, 0, 0);
+    }
+
+    /**
+     * 挂起直到任务被要求停止 - 结果为Stopped
+     */
+    CoroAwaiter stopped() {
+        return CoroAwaiter(*this, CoroAwaiter::Kind::Stop, -1, 0, 0);
+    }
+
+    /**
+     * 最近一次fd等待返回的epoll事件
+     */
+    uint32_t fd_events() const { return fd_events_; }
+
+private:
+    friend class CoroAwaiter;
+    friend class CoroReactor;
+    friend void coro_task_release_frame(CoroTaskWrapper* wrapper);
+    friend int coro_task_initialize(TaskBase* base);
+    friend int coro_task_step(TaskBase* base);
+    friend void coro_task_cleanup(TaskBase* base);
+    friend int coro_task_get_status(TaskBase* base, char* buffer, size_t size);
+
+    enum class Wait { None, Yield, Timer, Fd, Stop };
+
+    static void on_timer(TimerWheelTimer*, void* user_data) {
+        auto* context = static_cast<CoroContext*>(user_data);
+        context->timer_fired_.store(true, std::memory_order_release);
+        task_executor_wake(context->base_);
+    }
+
+    void fd_ready(uint32_t events) {
+        fd_events_ = events;
+        fd_ready_.store(true, std::memory_order_release);
+        task_executor_wake(base_);
+    }
+
+    /**
+     * 开始等待 - 返回false表示不挂起(登记失败)
+     */
+    bool begin_wait(CoroAwaiter::Kind kind, int fd, uint32_t events, uint32_t timeout_ms) {
+        immediate_ = CoroWake::Ready;
+        if (stopping_) {
+            // 停止中仍然挂起，由cleanup有限次地恢复，忽略Stopped的协程也不会在cleanup里空转
+            wait_ = Wait::Stop;
+            immediate_ = CoroWake::Stopped;
+            return true;
+        }
+
+        timer_fired_.store(false, std::memory_order_relaxed);
+        fd_ready_.store(false, std::memory_order_relaxed);
+
+        switch (kind) {
+            case CoroAwaiter::Kind::Yield:
+                wait_ = Wait::Yield;
+                return true;
+
+            case CoroAwaiter::Kind::Stop:
+                wait_ = Wait::Stop;
+                return true;
+
+            case CoroAwaiter::Kind::Fd:
+                fd_ = fd;
+                fd_watch_ = CoroReactor::instance().watch(fd, events, this);
+                if (fd_watch_ == 0) {
+                    immediate_ = CoroWake::Error;
+                    return false;
+                }
+                wait_ = Wait::Fd;
+                break;
+
+            case CoroAwaiter::Kind::Timer:
+                wait_ = Wait::Timer;
+                break;
+        }
+
+        if (timeout_ms > 0) {
+            TimerService* service = coro_timer_service();
+            if (!service) {
+                end_wait();
+                immediate_ = CoroWake::Error;
+                return false;
+            }
+            timer_armed_ = true;
+            timer_service_arm(service, &timer_, timeout_ms, 0, on_timer, this);
+        }
+        return true;
+    }
+
+    /**
+     * 等待是否已满足 - 未满足时step()不恢复协程(来自其他来源的唤醒)
+     */
+    bool wait_satisfied() const {
+        switch (wait_) {
+            case Wait::None:
+            case Wait::Yield:
+                return true;
+            case Wait::Timer:
+                return timer_fired_.load(std::memory_order_acquire);
+            case Wait::Fd:
+                return fd_ready_.load(std::memory_order_acquire) ||
+                       timer_fired_.load(std::memory_order_acquire);
+            case Wait::Stop:
+                return false;
+        }
+        return false;
+    }
+
+    /**
+     * 结束等待 - 撤销未触发的定时器和fd登记，返回等待结果
+     */
+    CoroWake end_wait() {
+        bool fired = timer_fired_.load(std::memory_order_acquire);
+        bool ready = fd_ready_.load(std::memory_order_acquire);
+
+        if (timer_armed_) {
+            if (!fired) {
+                timer_service_cancel(coro_timer_service(), &timer_);
+            }
+            timer_armed_ = false;
+        }
+        if (fd_watch_ != 0) {
+            CoroReactor::instance().unwatch(fd_, fd_watch_);
+            fd_watch_ = 0;
+        }
+
+        Wait wait = wait_;
+        wait_ = Wait::None;
+
+        if (stopping_ || immediate_ != CoroWake::Ready) {
+            return stopping_ ? CoroWake::Stopped : immediate_;
+        }
+        if (wait == Wait::Fd) {
+            return ready ? CoroWake::Ready : CoroWake::Timeout;
+        }
+        return wait == Wait::Timer ? CoroWake::Timeout : CoroWake::Ready;
+    }
+
+    TaskBase* base_;
+    Wait wait_ = Wait::None;
+    CoroWake immediate_ = CoroWake::Ready;  // 无需挂起时的结果
+    bool stopping_ = false;                 // cleanup正在结束协程
+    TimerWheelTimer timer_;
+    bool timer_armed_ = false;
+    int fd_ = -1;
+    uint64_t fd_watch_ = 0;                 // 反应器登记号，0表示未登记
+    uint32_t fd_events_ = 0;
+    std::atomic<bool> timer_fired_{false};  // 定时线程写入
+    std::atomic<bool> fd_ready_{false};     // 反应器线程写入
+};
+
+inline bool CoroAwaiter::await_suspend(std::coroutine_handle<>) noexcept {
+    return context_.begin_wait(kind_, fd_, events_, timeout_ms_);
+}
+
+inline CoroWake CoroAwaiter::await_resume() noexcept {
+    return context_.end_wait();
+}
+
+inline uint64_t CoroReactor::watch(int fd, uint32_t events, CoroContext* context) {
+    if (epoll_fd_ < 0 || fd < 0) {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t id = next_id_++;
+
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = events | EPOLLONESHOT;
+    event.data.u64 = id;
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) != 0) {
+        return 0;
+    }
+
+    waiters_.emplace(id, context);
+    return id;
+}
+
+inline void CoroReactor::unwatch(int fd, uint64_t id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (waiters_.erase(id) > 0) {
+        epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+    }
+}
+
+inline void CoroReactor::run() {
+    struct epoll_event events[64];
+
+    for (;;) {
+        int count = epoll_wait(epoll_fd_, events, 64, -1);
+        if (count < 0) {
+            continue;
+        }
+
+        // 持锁分发: unwatch返回后不会再访问已撤销的上下文
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (int i = 0; i < count; i++) {
+            auto it = waiters_.find(events[i].data.u64);
+            if (it != waiters_.end()) {
+                it->second->fd_ready(events[i].events);
+            }
+        }
+    }
+}
+
+/**
+ * 协程任务包装器
+ */
+struct CoroTaskWrapper {
+    TaskBase base;                                      // 必须是第一个成员
+    CoroContext context;
+    std::function<CoroTask(CoroContext&)> function;     // 每次(重新)启动时调用，创建新的协程帧
+    std::coroutine_handle<CoroTask::promise_type> handle;
+};
+
+/**
+ * 撤销挂起中的等待并销毁协程帧(如有)
+ */
+inline void coro_task_release_frame(CoroTaskWrapper* wrapper) {
+    wrapper->context.end_wait();
+    if (wrapper->handle) {
+        wrapper->handle.destroy();
+        wrapper->handle = nullptr;
+    }
+}
+
+inline int coro_task_initialize(TaskBase* base) {
+    auto* wrapper = reinterpret_cast<CoroTaskWrapper*>(base);
+
+    // 重启时重新调用协程函数
+    coro_task_release_frame(wrapper);
+    wrapper->context.stopping_ = false;
+    wrapper->context.wait_ = CoroContext::Wait::None;
+
+    try {
+        wrapper->handle = wrapper->function(wrapper->context).release();
+    } catch (...) {
+        return -1;
+    }
+    return wrapper->handle ? 0 : -1;
+}
+
+inline int coro_task_execute(TaskBase*) {
+    // 协程任务只能由执行器驱动
+    return -1;
+}
+
+inline int coro_task_step(TaskBase* base) {
+    auto* wrapper = reinterpret_cast<CoroTaskWrapper*>(base);
+    CoroContext& context = wrapper->context;
+
+    if (!wrapper->handle) {
+        return -1;
+    }
+    if (!context.wait_satisfied()) {
+        return TASK_STEP_WAIT;
+    }
+
+    wrapper->handle.resume();
+    task_update_heartbeat(base);
+
+    if (wrapper->handle.done()) {
+        return wrapper->handle.promise().error ? -1 : TASK_STEP_DONE;
+    }
+    return context.wait_ == CoroContext::Wait::Yield ? TASK_STEP_YIELD : TASK_STEP_WAIT;
+}
+
+inline void coro_task_cleanup(TaskBase* base) {
+    auto* wrapper = reinterpret_cast<CoroTaskWrapper*>(base);
+    CoroContext& context = wrapper->context;
+
+    if (wrapper->handle && !wrapper->handle.done()) {
+        // 停止请求: 恢复协程，让挂起中的co_await返回Stopped，协程自行退出并析构局部对象
+        context.stopping_ = true;
+        for (int i = 0; i < CORO_STOP_RESUME_LIMIT && !wrapper->handle.done(); i++) {
+            wrapper->handle.resume();
+        }
+    }
+    coro_task_release_frame(wrapper);
+}
+
+inline bool coro_task_health_check(TaskBase* base) {
+    auto* wrapper = reinterpret_cast<CoroTaskWrapper*>(base);
+    return !wrapper->handle || !wrapper->handle.done() || !wrapper->handle.promise().error;
+}
+
+inline int coro_task_get_status(TaskBase* base, char* buffer, size_t size) {
+    auto* wrapper = reinterpret_cast<CoroTaskWrapper*>(base);
+    static const char* const names[] = {"running", "yield", "timer", "fd", "stop"};
+
+    const char* wait = wrapper->handle && wrapper->handle.done()
+        ? "finished" : names[static_cast<int>(wrapper->context.wait_)];
+    int written = snprintf(buffer, size, "Coroutine - Wait: %s", wait);
+    return written < 0 ? 0 : written;
+}
+
+inline const TaskInterface coro_task_vtable = {
+    .initialize = coro_task_initialize,
+    .execute = coro_task_execute,
+    .cleanup = coro_task_cleanup,
+    .pause = nullptr,
+    .resume = nullptr,
+    .handle_signal = nullptr,
+    .health_check = coro_task_health_check,
+    .get_status = coro_task_get_status,
+    .step = coro_task_step
+};
+
+/**
+ * 在分配区中创建协程任务 - 执行模式固定为TASK_EXEC_POOLED
+ * @param config 任务配置
+ * @param function 协程函数，每次启动(含重启)时调用一次
+ * @param arena 分配区(task_manager_get_arena)，NULL时使用malloc
+ * @return 任务包装器指针，失败返回NULL
+ */
+inline CoroTaskWrapper* coro_task_create_in(const TaskConfig* config,
+                                            std::function<CoroTask(CoroContext&)> function,
+                                            TaskArena* arena) {
+    if (!config || !function) {
+        return nullptr;
+    }
+
+    TaskConfig pooled = *config;
+    pooled.exec_mode = TASK_EXEC_POOLED;
+
+    auto* wrapper = static_cast<CoroTaskWrapper*>(task_object_alloc(arena, sizeof(CoroTaskWrapper)));
+    if (!wrapper) {
+        return nullptr;
+    }
+
+    if (task_base_init(&wrapper->base, &coro_task_vtable, &pooled) != 0) {
+        task_object_free(arena, wrapper, sizeof(CoroTaskWrapper));
+        return nullptr;
+    }
+    wrapper->base.arena = arena;
+
+    new(&wrapper->context) CoroContext(&wrapper->base);
+    new(&wrapper->function) std::function<CoroTask(CoroContext&)>(std::move(function));
+    wrapper->handle = nullptr;
+
+    return wrapper;
+}
+
+/**
+ * 创建协程任务
+ * @param config 任务配置
+ * @param function 协程函数
+ * @return 任务包装器指针，失败返回NULL
+ */
+inline CoroTaskWrapper* coro_task_create(const TaskConfig* config,
+                                         std::function<CoroTask(CoroContext&)> function) {
+    return coro_task_create_in(config, std::move(function), nullptr);
+}
+
+/**
+ * 销毁协程任务 - 任务必须已停止
+ * @param wrapper 任务包装器指针
+ */
+inline void coro_task_destroy(CoroTaskWrapper* wrapper) {
+    if (!wrapper) {
+        return;
+    }
+
+    TaskArena* arena = wrapper->base.arena;
+
+    coro_task_release_frame(wrapper);
+    wrapper->function.~function();
+    wrapper->context.~CoroContext();
+    task_base_destroy(&wrapper->base);
+    task_object_free(arena, wrapper, sizeof(CoroTaskWrapper));
+}
+
+/**
+ * 获取任务基类指针 - 用于向上转型
+ * @param wrapper 任务包装器指针
+ * @return 基类指针
+ */
+inline TaskBase* coro_task_get_base(CoroTaskWrapper* wrapper) {
+    return wrapper ? &wrapper->base : nullptr;
+}
+
+#endif // CPP_COROUTINE_TASK_H
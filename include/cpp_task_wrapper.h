@@ -2,6 +2,7 @@
 #define CPP_TASK_WRAPPER_H
 
 #include "task_interface.h"
+#include "task_arena.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -17,6 +18,14 @@ typedef struct CppTaskWrapper CppTaskWrapper;
  */
 CppTaskWrapper* cpp_example_task_create(const TaskConfig* config);
 
+/**
+ * 在分配区中创建C++示例任务 - 包装器按缓存行对齐，与同类任务连续存放
+ * @param config 任务配置
+ * @param arena 分配区(task_manager_get_arena)，NULL时使用malloc
+ * @return 任务包装器指针，失败返回NULL
+ */
+CppTaskWrapper* cpp_example_task_create_in(const TaskConfig* config, TaskArena* arena);
+
 /**
  * 销毁C++示例任务
  * @param wrapper 任务包装器指针
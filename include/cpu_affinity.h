@@ -0,0 +1,121 @@
+#ifndef CPU_AFFINITY_H
+#define CPU_AFFINITY_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 支持的最大CPU数
+#define CPU_AFFINITY_MAX_CPUS 1024
+
+/**
+ * CPU集合 - 与cpu_set_t等价的位图，头文件不依赖_GNU_SOURCE
+ */
+typedef struct {
+    uint64_t bits[CPU_AFFINITY_MAX_CPUS / 64];
+} CpuMask;
+
+/**
+ * 放置策略
+ */
+typedef enum {
+    CPU_PLACEMENT_NONE = 0,     // 不绑定，由内核调度
+    CPU_PLACEMENT_EXPLICIT,     // 绑定到显式指定的CPU列表
+    CPU_PLACEMENT_SPREAD,       // 依次分散到不同的物理核/插槽
+    CPU_PLACEMENT_COMPACT,      // 依次紧凑放置，优先填满同一物理核的超线程
+    CPU_PLACEMENT_ISOLATED      // 放置到isolcpus隔离的CPU上
+} CpuPlacementPolicy;
+
+/**
+ * 放置配置
+ */
+typedef struct {
+    CpuPlacementPolicy policy;  // 放置策略
+    char cpus[64];              // 显式CPU列表，如"2-3,6"(EXPLICIT使用)
+    uint32_t cpu_count;         // 每个线程分配的CPU数(SPREAD/COMPACT/ISOLATED使用，0视为1)
+} CpuPlacement;
+
+/**
+ * 解析CPU列表字符串
+ * @param list CPU列表，如"0-3,6"
+ * @param mask CPU集合(输出)
+ * @return 0成功，-1格式错误或超出范围
+ */
+int cpu_mask_parse(const char* list, CpuMask* mask);
+
+/**
+ * 将CPU集合格式化为CPU列表字符串
+ * @param mask CPU集合
+ * @param buffer 输出缓冲区
+ * @param size 缓冲区大小
+ * @return 写入的字符数
+ */
+int cpu_mask_format(const CpuMask* mask, char* buffer, size_t size);
+
+/**
+ * 获取CPU集合中的CPU数量
+ * @param mask CPU集合
+ * @return CPU数量
+ */
+uint32_t cpu_mask_count(const CpuMask* mask);
+
+/**
+ * 解析放置策略名称(none/explicit/spread/compact/isolated)
+ * @param name 策略名称
+ * @return 放置策略，无法识别时返回CPU_PLACEMENT_NONE
+ */
+CpuPlacementPolicy cpu_placement_policy_from_name(const char* name);
+
+/**
+ * 获取放置策略名称
+ * @param policy 放置策略
+ * @return 名称字符串
+ */
+const char* cpu_placement_policy_name(CpuPlacementPolicy policy);
+
+/**
+ * 按放置配置选择CPU集合
+ * SPREAD/COMPACT按/sys拓扑排列进程可用的CPU，每次调用依次取下一组，
+ * 因此多个线程按创建顺序分散或紧凑排布
+ * @param placement 放置配置
+ * @param mask CPU集合(输出)
+ * @return 0已选择，1无需绑定(NONE)，-1失败
+ */
+int cpu_placement_resolve(const CpuPlacement* placement, CpuMask* mask);
+
+/**
+ * 将放置配置写入线程属性 - 在pthread_create前调用，线程从第一条指令起就在目标CPU上
+ * @param placement 放置配置
+ * @param attr 线程属性
+ * @param effective 生效的CPU集合(输出，可为NULL)
+ * @return 0成功，1无需绑定，-1失败
+ */
+int cpu_placement_init_attr(const CpuPlacement* placement, pthread_attr_t* attr, CpuMask* effective);
+
+/**
+ * 将放置配置应用到已存在的线程
+ * @param placement 放置配置
+ * @param thread 线程
+ * @param effective 生效的CPU集合(输出，可为NULL)
+ * @return 0成功，1无需绑定，-1失败
+ */
+int cpu_placement_apply_thread(const CpuPlacement* placement, pthread_t thread, CpuMask* effective);
+
+/**
+ * 获取线程当前的CPU亲和性
+ * @param thread 线程
+ * @param mask CPU集合(输出)
+ * @return 0成功，-1失败
+ */
+int cpu_affinity_get_thread(pthread_t thread, CpuMask* mask);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CPU_AFFINITY_H
@@ -0,0 +1,104 @@
+#ifndef EVENT_DISPATCHER_H
+#define EVENT_DISPATCHER_H
+
+#include "task_interface.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * 任务状态变化事件
+ */
+typedef struct {
+    char task_name[64];         // 任务名称
+    TaskState old_state;        // 原状态(合并后为第一条的原状态)
+    TaskState new_state;        // 新状态(合并后为最后一条的新状态)
+    uint64_t timestamp_ns;      // 投递时间(单调时钟)
+    uint32_t merged;            // 合并进来的后续事件数
+} TaskEvent;
+
+/**
+ * 单条事件回调 - 与TaskEventCallback签名相同
+ */
+typedef void (*EventDispatchCallback)(const char* task_name, TaskState old_state, TaskState new_state, void* user_data);
+
+/**
+ * 批量事件回调 - 一次交付一批按投递顺序排列的事件
+ * @param events 事件数组(仅在回调期间有效)
+ * @param count 事件数量
+ * @param user_data 用户数据
+ */
+typedef void (*EventBatchCallback)(const TaskEvent* events, uint32_t count, void* user_data);
+
+/**
+ * 分发器配置
+ */
+typedef struct {
+    uint32_t capacity;              // 环形队列容量(向上取2的幂，0为1024)
+    uint32_t max_batch;             // 每批最多交付的事件数(0为64)
+    bool coalesce;                  // 同一批内同一任务的连续变化合并为一条
+    EventDispatchCallback callback; // 单条回调(与batch_callback二选一)
+    EventBatchCallback batch_callback; // 批量回调
+    void* user_data;                // 用户数据
+} EventDispatcherConfig;
+
+/**
+ * 分发器统计信息
+ */
+typedef struct {
+    uint64_t posted;                // 成功入队的事件数
+    uint64_t dropped;               // 队列满被丢弃的事件数
+    uint64_t delivered;             // 交付给回调的事件数(合并后)
+    uint64_t coalesced;             // 被合并掉的事件数
+    uint64_t batches;               // 交付批次
+    uint32_t max_batch_seen;        // 最大批大小
+} EventDispatcherStats;
+
+/**
+ * 异步事件分发器 - 投递端无锁写入有界环形队列，专用线程按顺序批量交付，
+ * 慢回调不会阻塞触发状态变化的线程
+ */
+typedef struct EventDispatcher EventDispatcher;
+
+/**
+ * 创建分发器并启动分发线程
+ * @param config 配置
+ * @return 分发器指针，失败返回NULL
+ */
+EventDispatcher* event_dispatcher_create(const EventDispatcherConfig* config);
+
+/**
+ * 交付剩余事件后停止并销毁分发器
+ * @param dispatcher 分发器指针
+ */
+void event_dispatcher_destroy(EventDispatcher* dispatcher);
+
+/**
+ * 投递事件 - 签名与TaskEventCallback相同，可直接作为任务管理器的事件回调，
+ * user_data传分发器指针；队列满时丢弃并计数，从不阻塞
+ * @param task_name 任务名称
+ * @param old_state 原状态
+ * @param new_state 新状态
+ * @param user_data 分发器指针
+ */
+void event_dispatcher_post(const char* task_name, TaskState old_state, TaskState new_state, void* user_data);
+
+/**
+ * 等待调用前已入队的事件全部交付
+ * @param dispatcher 分发器指针
+ */
+void event_dispatcher_flush(EventDispatcher* dispatcher);
+
+/**
+ * 获取统计信息
+ * @param dispatcher 分发器指针
+ * @param stats 统计信息(输出)
+ */
+void event_dispatcher_get_stats(EventDispatcher* dispatcher, EventDispatcherStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // EVENT_DISPATCHER_H
@@ -2,6 +2,7 @@
 #define EXAMPLE_TASK_H
 
 #include "task_interface.h"
+#include "task_arena.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -27,6 +28,16 @@ typedef struct ExampleTaskConfig {
  */
 ExampleTask* example_task_create(const TaskConfig* config, const ExampleTaskConfig* custom_config);
 
+/**
+ * 在分配区中创建示例任务 - 任务对象按缓存行对齐，与同类任务连续存放
+ * @param config 任务配置
+ * @param custom_config 自定义配置
+ * @param arena 分配区(task_manager_get_arena)，NULL时使用malloc
+ * @return 任务指针，失败返回NULL
+ */
+ExampleTask* example_task_create_in(const TaskConfig* config, const ExampleTaskConfig* custom_config,
+                                    TaskArena* arena);
+
 /**
  * 销毁示例任务
  * @param task 任务指针
@@ -0,0 +1,124 @@
+#ifndef HEARTBEAT_WATCHDOG_H
+#define HEARTBEAT_WATCHDOG_H
+
+#include "task_interface.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * 心跳超时回调函数类型
+ * 在看门狗线程上、释放看门狗锁后调用，可以查询管理器或停止监视任务，不得销毁看门狗
+ * @param task 心跳超时的任务
+ * @param last_heartbeat 最后一次心跳时间戳
+ * @param user_data 用户数据
+ */
+typedef void (*HeartbeatMissCallback)(TaskBase* task, uint64_t last_heartbeat, void* user_data);
+
+/**
+ * 心跳截止时间
+ */
+typedef struct {
+    uint64_t deadline;                 // 截止时间戳(秒)
+    TaskBase* task;                    // 被监视的任务
+} HeartbeatDeadline;
+
+/**
+ * 一次待报告的心跳超时
+ */
+typedef struct {
+    TaskBase* task;
+    uint64_t last_heartbeat;
+} HeartbeatMiss;
+
+/**
+ * 看门狗统计信息
+ */
+typedef struct {
+    uint32_t watched_tasks;            // 被监视的任务数
+    uint64_t wakeups;                  // 看门狗线程唤醒次数
+    uint64_t rearms;                   // 截止时间因新心跳顺延的次数
+    uint64_t misses;                   // 检测到的心跳超时次数
+} HeartbeatWatchdogStats;
+
+/**
+ * 心跳看门狗
+ * 按截止时间维护最小堆，timerfd只在最近的截止时间到达时唤醒线程；
+ * task_update_heartbeat仍只写last_heartbeat，到期时再比对并惰性顺延，
+ * 因此心跳路径零额外开销，空闲时没有轮询
+ */
+typedef struct HeartbeatWatchdog {
+    HeartbeatDeadline* heap;           // 截止时间最小堆
+    uint32_t count;
+    uint32_t capacity;
+    HeartbeatMiss* misses;             // 锁内收集、锁外回调的超时(容量与堆相同，线程内不分配)
+    HeartbeatMiss* retired_misses;     // 回调期间被扩容替换、待看门狗线程释放的缓冲
+    bool dispatching;                  // 看门狗线程正在锁外回调
+    pthread_cond_t dispatched;         // 一批回调结束时广播
+    int timer_fd;                      // CLOCK_REALTIME timerfd
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    bool running;
+    HeartbeatMissCallback callback;
+    void* user_data;
+    HeartbeatWatchdogStats stats;
+    uint32_t refs;                     // 引用计数(创建者持有一个，原子访问)
+} HeartbeatWatchdog;
+
+/**
+ * 创建看门狗并启动看门狗线程
+ * @param callback 心跳超时回调
+ * @param user_data 用户数据
+ * @return 看门狗指针，失败返回NULL
+ */
+HeartbeatWatchdog* heartbeat_watchdog_create(HeartbeatMissCallback callback, void* user_data);
+
+/**
+ * 停止看门狗线程并释放创建者的引用 - 其他引用全部释放后才回收内存
+ * @param watchdog 看门狗指针
+ */
+void heartbeat_watchdog_destroy(HeartbeatWatchdog* watchdog);
+
+/**
+ * 增加引用 - 让看门狗在heartbeat_watchdog_destroy之后仍可安全访问
+ * @param watchdog 看门狗指针
+ */
+void heartbeat_watchdog_retain(HeartbeatWatchdog* watchdog);
+
+/**
+ * 释放引用，最后一个引用释放时回收看门狗
+ * @param watchdog 看门狗指针
+ */
+void heartbeat_watchdog_release(HeartbeatWatchdog* watchdog);
+
+/**
+ * 开始监视任务(heartbeat_interval为0的任务忽略)
+ * 截止时间 = last_heartbeat + heartbeat_interval
+ * @param watchdog 看门狗指针
+ * @param task 任务指针
+ * @return 0成功，非0失败
+ */
+int heartbeat_watchdog_watch(HeartbeatWatchdog* watchdog, TaskBase* task);
+
+/**
+ * 停止监视任务 - 返回时已没有该任务的回调在进行，之后可以销毁任务；
+ * 会等待进行中的回调，调用时不得持有回调中会获取的锁
+ * @param watchdog 看门狗指针
+ * @param task 任务指针
+ * @return 0成功，-1未在监视
+ */
+int heartbeat_watchdog_unwatch(HeartbeatWatchdog* watchdog, TaskBase* task);
+
+/**
+ * 获取看门狗统计信息
+ * @param watchdog 看门狗指针
+ * @param stats 统计信息(输出)
+ */
+void heartbeat_watchdog_get_stats(HeartbeatWatchdog* watchdog, HeartbeatWatchdogStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HEARTBEAT_WATCHDOG_H
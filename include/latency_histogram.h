@@ -0,0 +1,92 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 每个2的幂区间再等分的子桶数(2^LATENCY_SUB_BUCKET_BITS)，相对误差不超过1/16
+#define LATENCY_SUB_BUCKET_BITS 4
+#define LATENCY_SUB_BUCKETS (1u << LATENCY_SUB_BUCKET_BITS)
+
+// 可区分的最大值为2^LATENCY_MAX_BITS纳秒(约18分钟)，更大的值计入最后一个桶
+#define LATENCY_MAX_BITS 40
+
+#define LATENCY_BUCKET_COUNT ((LATENCY_MAX_BITS - LATENCY_SUB_BUCKET_BITS + 1) * LATENCY_SUB_BUCKETS)
+
+/**
+ * 对数分桶延迟直方图(HDR风格) - 小于16ns的值各占一个桶，
+ * 之后每个2的幂区间等分为16个桶，记录只需一次前导零计数和一次加法
+ * 同一直方图同一时刻只能有一个线程记录，其他线程可随时读取
+ */
+typedef struct LatencyHistogram {
+    uint64_t buckets[LATENCY_BUCKET_COUNT];
+    uint64_t count;             // 记录次数
+    uint64_t sum_ns;            // 总耗时
+    uint64_t min_ns;            // 最小值(count为0时无意义)
+    uint64_t max_ns;            // 最大值
+} LatencyHistogram;
+
+/**
+ * 延迟摘要
+ */
+typedef struct {
+    uint64_t count;             // 样本数
+    uint64_t min_ns;
+    uint64_t max_ns;
+    uint64_t mean_ns;
+    uint64_t p50_ns;
+    uint64_t p99_ns;
+    uint64_t p999_ns;
+} LatencySummary;
+
+/**
+ * 清空直方图
+ * @param histogram 直方图
+ */
+void latency_histogram_reset(LatencyHistogram* histogram);
+
+/**
+ * 记录一个样本
+ * @param histogram 直方图
+ * @param value_ns 耗时(纳秒)
+ */
+void latency_histogram_record(LatencyHistogram* histogram, uint64_t value_ns);
+
+/**
+ * 复制正在被记录的直方图 - 不阻塞记录线程，副本可能漏掉复制期间的少量样本
+ * @param dst 副本(输出)
+ * @param src 源直方图
+ */
+void latency_histogram_snapshot(LatencyHistogram* dst, const LatencyHistogram* src);
+
+/**
+ * 把src累加到dst，用于合并多个任务的分布
+ * @param dst 目标直方图(不得有线程正在记录)
+ * @param src 源直方图(应为快照)
+ */
+void latency_histogram_merge(LatencyHistogram* dst, const LatencyHistogram* src);
+
+/**
+ * 计算分位数
+ * @param histogram 直方图
+ * @param quantile 分位(0~1，如0.99)
+ * @return 该分位所在桶的上界(不超过最大值)，无样本返回0
+ */
+uint64_t latency_histogram_percentile(const LatencyHistogram* histogram, double quantile);
+
+/**
+ * 生成摘要(p50/p99/p999等)
+ * @param histogram 直方图
+ * @param summary 摘要(输出)
+ */
+void latency_histogram_summarize(const LatencyHistogram* histogram, LatencySummary* summary);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LATENCY_HISTOGRAM_H
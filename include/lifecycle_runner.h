@@ -0,0 +1,93 @@
+#ifndef LIFECYCLE_RUNNER_H
+#define LIFECYCLE_RUNNER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 最大并发操作数
+#define LIFECYCLE_MAX_PARALLEL 64
+
+/**
+ * 批量启停选项
+ */
+typedef struct {
+    uint32_t task_timeout_ms;   // 单个操作期限，超过后升级(0不限)
+    uint32_t global_timeout_ms; // 整批期限，超过后放弃等待剩余操作(0不限)
+    uint32_t max_parallel;      // 最大并发数(0为LIFECYCLE_MAX_PARALLEL)
+} LifecycleOptions;
+
+/**
+ * 单个操作的结果
+ */
+typedef struct {
+    char name[64];              // 任务/进程名称
+    int result;                 // 操作返回值(0成功)，未完成时无意义
+    bool started;                // 是否已开始执行(整批期限到达时尚未开始的不再执行)
+    bool completed;             // 是否在整批期限内完成
+    bool escalated;             // 是否因超过单个期限被升级
+    uint64_t elapsed_us;        // 耗时(未完成时为截至放弃时的耗时)
+} LifecycleEntry;
+
+/**
+ * 批量启停报告 - entries按耗时从长到短排序，便于找出最慢的任务
+ */
+typedef struct {
+    LifecycleEntry* entries;
+    uint32_t count;
+    uint32_t succeeded;         // 完成且成功
+    uint32_t failed;            // 完成但失败
+    uint32_t escalated;         // 被升级
+    uint32_t abandoned;         // 整批期限内未完成(仍在后台执行)
+    uint32_t skipped;           // 整批期限到达时尚未开始(不再执行)
+    uint64_t total_us;          // 整批耗时
+} LifecycleReport;
+
+/**
+ * 单个操作 - 在辅助线程上执行，可能阻塞
+ * @param target 管理器
+ * @param name 名称
+ * @return 0成功，非0失败
+ */
+typedef int (*LifecycleOperation)(void* target, const char* name);
+
+/**
+ * 超时升级 - 在协调线程上调用，不得阻塞
+ * @param target 管理器
+ * @param name 名称
+ */
+typedef void (*LifecycleEscalation)(void* target, const char* name);
+
+/**
+ * 并发执行一批操作
+ * 超过单个期限的操作调用escalate一次；超过整批期限时停止分派并立即返回，
+ * 尚未开始的操作不再执行(计入skipped)，已开始的在后台继续执行(计入abandoned)，
+ * 此时target必须在它们结束前保持有效
+ * @param target 管理器
+ * @param names 名称数组
+ * @param count 数量
+ * @param operation 操作
+ * @param escalate 升级回调(可为NULL)
+ * @param options 选项(可为NULL，使用默认值)
+ * @param report 报告(输出，可为NULL)，用lifecycle_report_free释放
+ * @return 未成功完成的操作数，内部错误返回-1
+ */
+int lifecycle_run(void* target, char (*names)[64], uint32_t count,
+                  LifecycleOperation operation, LifecycleEscalation escalate,
+                  const LifecycleOptions* options, LifecycleReport* report);
+
+/**
+ * 释放报告
+ * @param report 报告
+ */
+void lifecycle_report_free(LifecycleReport* report);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIFECYCLE_RUNNER_H
@@ -0,0 +1,164 @@
+#ifndef PLUGIN_HOST_H
+#define PLUGIN_HOST_H
+
+#include "process_interface.h"
+#include <semaphore.h>
+#include <sys/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 同时存在的隔离插件上限(每个占用一组代理接口函数)
+#define PLUGIN_HOST_MAX_SLOTS 256
+
+// 代理调用等待宿主应答的默认期限(不含start，start持续到插件主循环返回)
+#define PLUGIN_HOST_DEFAULT_CALL_TIMEOUT_MS 10000
+
+// 宿主程序文件名，默认在启动器可执行文件的同一目录
+#define PLUGIN_HOST_EXECUTABLE "plugin_host"
+
+// 指定宿主程序路径的环境变量
+#define PLUGIN_HOST_PATH_ENV "STARTTOOL_PLUGIN_HOST"
+
+// 宿主进程中共享内存通道的文件描述符
+#define PLUGIN_HOST_CHANNEL_FD 3
+
+// 通道布局版本，宿主程序与启动器不一致时拒绝加载
+#define PLUGIN_HOST_CHANNEL_MAGIC 0x50484331
+
+// 宿主转发的日志缓冲条数，启动器来不及读取时丢弃新日志
+#define PLUGIN_HOST_LOG_SLOTS 64
+
+/**
+ * 代理命令 - 与ProcessInterface的调用一一对应
+ */
+typedef enum {
+    PLUGIN_HOST_CMD_NONE = 0,
+    PLUGIN_HOST_CMD_INITIALIZE,     // config_data在通道中
+    PLUGIN_HOST_CMD_START,          // 宿主在单独线程中运行start，立即应答
+    PLUGIN_HOST_CMD_STOP,
+    PLUGIN_HOST_CMD_CLEANUP,
+    PLUGIN_HOST_CMD_GET_STATE,
+    PLUGIN_HOST_CMD_GET_STATS,      // 统计复制到通道
+    PLUGIN_HOST_CMD_HANDLE_SIGNAL,  // argument为信号值
+    PLUGIN_HOST_CMD_HEALTH_CHECK,
+    PLUGIN_HOST_CMD_EXIT            // 宿主退出
+} PluginHostCommand;
+
+/**
+ * 共享内存通道 - 启动器与宿主进程共用的布局
+ * 一次只有一个命令在途(启动器侧按宿主串行化)；应答携带命令序号，
+ * 迟到的应答按序号丢弃。序号0是宿主加载插件后的握手应答
+ */
+typedef struct {
+    uint32_t magic;                 // PLUGIN_HOST_CHANNEL_MAGIC
+    sem_t request;                  // 启动器 -> 宿主: 有新命令
+    sem_t reply;                    // 宿主 -> 启动器: 命令已完成
+    sem_t events;                   // 宿主 -> 启动器: start返回或有新日志
+
+    uint32_t command;               // PluginHostCommand
+    uint32_t sequence;              // 命令序号
+    int32_t argument;               // 命令参数
+    int32_t result;                 // 命令结果
+    uint32_t reply_sequence;        // 应答对应的命令序号
+
+    int32_t load_result;            // 握手: 0加载成功，非0失败
+    uint32_t interface_version;     // 插件报告的接口版本
+    ProcessInfo info;               // 插件信息(握手时填写)
+    ProcessStats stats;             // GET_STATS应答
+    char config_data[1024];         // INITIALIZE参数
+    char stats_page_name[96];       // 统计页的共享内存对象名(空表示不提供，创建宿主前写入)
+    int32_t stats_page_attached;    // 握手: 插件导出了PROCESS_STATS_PAGE_SETTER且宿主已交给它页面
+    uint64_t capabilities;          // 握手: v2插件声明且经代理可用的PROCESS_CAP_*
+
+    uint32_t start_count;           // 已返回的start次数(原子访问)
+    int32_t start_result;           // 最近一次start的返回值
+
+    uint32_t log_head;              // 宿主写入位置(原子访问)
+    uint32_t log_tail;              // 启动器读取位置(原子访问)
+    uint32_t log_dropped;           // 缓冲满时丢弃的日志数
+    struct {
+        int32_t level;
+        char message[256];
+    } logs[PLUGIN_HOST_LOG_SLOTS];
+} PluginHostChannel;
+
+/**
+ * 插件宿主 - 在独立进程中加载一个插件，通过共享内存通道代理ProcessInterface调用
+ * 插件崩溃或泄漏只影响自己的宿主进程；宿主退出后代理接口报告ERROR，
+ * 下一次initialize/start重新创建宿主(start会先用原配置重新initialize)
+ */
+typedef struct PluginHost PluginHost;
+
+/**
+ * 宿主选项 - 字段为0/NULL时使用默认值
+ */
+typedef struct {
+    const char* host_path;          // 宿主程序路径，NULL时取PLUGIN_HOST_PATH_ENV，再取启动器同目录下的PLUGIN_HOST_EXECUTABLE
+    uint32_t call_timeout_ms;       // 代理调用的应答期限，超时视为宿主失去响应并结束宿主进程
+    LogCallback log_callback;       // 转发插件日志(NULL时丢弃)
+    const char* stats_page_name;    // 交给插件的统计页(见process_stats_page.h)，宿主重建时重新映射
+} PluginHostOptions;
+
+/**
+ * 宿主状态
+ */
+typedef struct {
+    pid_t pid;                      // 当前宿主进程，0表示没有
+    bool alive;                     // 宿主进程是否存活
+    int exit_status;                // 最近一次退出的waitpid状态
+    uint32_t spawn_count;           // 创建宿主进程的次数
+    uint32_t crash_count;           // 非请求的退出次数(崩溃、被杀或失去响应)
+    uint64_t calls;                 // 代理调用次数
+    uint32_t log_dropped;           // 宿主丢弃的日志数
+    uint64_t rss_bytes;             // 宿主进程常驻内存
+    bool stats_page_attached;       // 插件在写统计页
+    uint32_t interface_version;     // 插件报告的接口版本
+    uint64_t capabilities;          // 经代理可用的PROCESS_CAP_*(暂停和状态交接不经代理，只保留BATCH_STATS)
+} PluginHostInfo;
+
+/**
+ * 创建宿主 - 启动宿主进程并加载插件，不调用initialize
+ * @param name 进程名称
+ * @param library_path 插件动态库路径
+ * @param options 选项(可为NULL)
+ * @return 宿主指针，失败返回NULL
+ */
+PluginHost* plugin_host_create(const char* name, const char* library_path, const PluginHostOptions* options);
+
+/**
+ * 销毁宿主 - 请求宿主退出，期限内未退出则强制结束
+ * 调用前应已停止插件(代理的start已返回)
+ * @param host 宿主(可为NULL)
+ */
+void plugin_host_destroy(PluginHost* host);
+
+/**
+ * 获取代理接口 - 与进程内加载的插件接口用法相同，生命周期与宿主一致
+ * 代理调用可能等待宿主应答，调用者不应持有管理器锁；get_stats返回调用线程私有的副本，
+ * 在该线程下一次调用get_stats前有效
+ * @param host 宿主
+ * @return 代理接口指针
+ */
+ProcessInterface* plugin_host_get_interface(PluginHost* host);
+
+/**
+ * 强制结束宿主进程 - 等待中的代理调用随即失败返回
+ * @param host 宿主
+ */
+void plugin_host_kill(PluginHost* host);
+
+/**
+ * 获取宿主状态
+ * @param host 宿主
+ * @param info 状态(输出)
+ * @return 0成功，非0失败
+ */
+int plugin_host_get_info(PluginHost* host, PluginHostInfo* info);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PLUGIN_HOST_H
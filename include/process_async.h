@@ -0,0 +1,110 @@
+#ifndef PROCESS_ASYNC_H
+#define PROCESS_ASYNC_H
+
+#include "process_interface.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 同时存在的v2进程内插件实例上限(每个占用一个启动适配函数)
+#define PROCESS_ASYNC_MAX_SLOTS 256
+
+/**
+ * v2插件适配器 - 绑定插件的状态通知，并给管理器提供v1形式的接口:
+ * 适配接口的start发起启动后在条件变量上等到插件通知STOPPED/ERROR才返回，
+ * 其余函数直接是插件自己的实现。管理器按v1方式使用，停止、就绪和暂停由通知驱动，不轮询
+ */
+typedef struct ProcessAsyncAdapter ProcessAsyncAdapter;
+
+/**
+ * 适配器状态
+ */
+typedef struct {
+    uint64_t capabilities;          // 插件声明的PROCESS_CAP_*
+    ProcessState notified_state;    // 最近一次通知的状态(UNKNOWN表示尚无通知)
+    uint64_t notifications;         // 收到的通知次数
+    uint32_t runs;                  // 经适配接口发起的启动次数
+} ProcessAsyncInfo;
+
+/**
+ * 创建适配器 - 把通知绑定到插件，须在initialize之前调用
+ * @param name 进程名称(用于日志)
+ * @param plugin 插件的v2接口
+ * @param log_callback 日志回调(可为NULL)
+ * @return 适配器，槽位用尽或插件缺少bind_notifier时返回NULL
+ */
+ProcessAsyncAdapter* process_async_create(const char* name, ProcessInterfaceV2* plugin, LogCallback log_callback);
+
+/**
+ * 销毁适配器 - 须在插件cleanup之后调用，之后插件不得再通知；
+ * 正在process_async_wait_state中等待的调用者立即返回失败，内存在最后一个引用释放时回收
+ * @param adapter 适配器(可为NULL)
+ */
+void process_async_destroy(ProcessAsyncAdapter* adapter);
+
+/**
+ * 增加引用 - 让适配器在process_async_destroy之后仍可安全等待(此时插件可能已卸载，不得再调用其接口)
+ * @param adapter 适配器
+ */
+void process_async_retain(ProcessAsyncAdapter* adapter);
+
+/**
+ * 释放引用，最后一个引用释放时回收适配器
+ * @param adapter 适配器(可为NULL)
+ */
+void process_async_release(ProcessAsyncAdapter* adapter);
+
+/**
+ * 获取v1形式的接口 - 生命周期与适配器一致
+ * @param adapter 适配器
+ * @return 接口指针
+ */
+ProcessInterface* process_async_get_interface(ProcessAsyncAdapter* adapter);
+
+/**
+ * 获取插件的v2接口
+ * @param adapter 适配器
+ * @return 接口指针
+ */
+ProcessInterfaceV2* process_async_get_plugin(ProcessAsyncAdapter* adapter);
+
+/**
+ * 等待插件通知指定状态 - 已处于该状态时立即返回；每次发起启动时状态重置为INITIALIZING
+ * @param adapter 适配器
+ * @param state 目标状态
+ * @param timeout_ms 期限(毫秒)
+ * @return 0已到达，-1超时、插件通知了ERROR或适配器已销毁
+ */
+int process_async_wait_state(ProcessAsyncAdapter* adapter, ProcessState state, uint32_t timeout_ms);
+
+/**
+ * 发起暂停或恢复，不等待确认 - 调用插件的pause/resume，调用者须保证插件仍已加载
+ * @param adapter 适配器
+ * @param pause true暂停，false恢复
+ * @return 0已发起，插件未声明PROCESS_CAP_PAUSE或拒绝时返回-1
+ */
+int process_async_request_pause(ProcessAsyncAdapter* adapter, bool pause);
+
+/**
+ * 暂停或恢复并等待插件确认 - 插件未声明PROCESS_CAP_PAUSE时失败
+ * @param adapter 适配器
+ * @param pause true暂停，false恢复
+ * @param timeout_ms 等待确认的期限(毫秒)
+ * @return 0成功，非0失败
+ */
+int process_async_set_paused(ProcessAsyncAdapter* adapter, bool pause, uint32_t timeout_ms);
+
+/**
+ * 获取适配器状态
+ * @param adapter 适配器
+ * @param info 状态(输出)
+ * @return 0成功
+ */
+int process_async_get_info(ProcessAsyncAdapter* adapter, ProcessAsyncInfo* info);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PROCESS_ASYNC_H
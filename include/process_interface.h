@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -17,7 +18,8 @@ typedef enum {
     PROCESS_STATE_RUNNING,
     PROCESS_STATE_STOPPING,
     PROCESS_STATE_STOPPED,
-    PROCESS_STATE_ERROR
+    PROCESS_STATE_ERROR,
+    PROCESS_STATE_PAUSED            // 已暂停(仅v2插件，见PROCESS_CAP_PAUSE)
 } ProcessState;
 
 /**
@@ -120,6 +122,76 @@ typedef struct {
     
 } ProcessInterface;
 
+// ============================================================================
+// v2接口 - get_interface_version返回主版本2时，get_process_interface返回的指针
+// 指向ProcessInterfaceV2(首个成员即ProcessInterface，v1的调用方式仍然可用)
+// ============================================================================
+
+struct ProcessStatsPage;
+
+/**
+ * 插件能力位 - ProcessInterfaceV2.capabilities
+ */
+#define PROCESS_CAP_BATCH_STATS  (1ULL << 0)  // 统计成批发布到统计页(set_stats_page)，管理器不再调用get_stats
+#define PROCESS_CAP_PAUSE        (1ULL << 1)  // 支持pause/resume
+#define PROCESS_CAP_RELOAD       (1ULL << 2)  // 热重载时支持export_state/import_state交接运行状态
+
+/**
+ * 状态通知 - 由管理器提供，插件在状态变化时调用(可在任意线程，包括start/stop内部)
+ * RUNNING: 启动完成；STOPPED: 主循环结束，result为原先start的返回值；
+ * ERROR: 运行失败，result为错误码；PAUSED/RUNNING: 暂停/恢复完成
+ */
+typedef struct {
+    void* context;
+    void (*notify)(void* context, ProcessState state, int result);
+} ProcessNotifier;
+
+/**
+ * v2进程接口 - 与v1的区别:
+ * base.start只发起启动并立即返回，base.stop只发起停止并立即返回，
+ * 完成情况经notifier推送给管理器，插件不再占用调用线程
+ */
+typedef struct {
+    ProcessInterface base;           // start/stop为非阻塞语义
+    uint32_t size;                   // sizeof(ProcessInterfaceV2)，之后追加的字段按size判断是否存在
+    uint64_t capabilities;           // PROCESS_CAP_*
+
+    /**
+     * 绑定状态通知 - 管理器在initialize之前调用，notifier在cleanup返回前一直有效
+     * @param notifier 状态通知
+     */
+    void (*bind_notifier)(const ProcessNotifier* notifier);
+
+    /**
+     * 暂停/恢复(PROCESS_CAP_PAUSE) - 非阻塞，完成后通知PAUSED/RUNNING
+     * @return 0已发起，非0失败
+     */
+    int (*pause)(void);
+    int (*resume)(void);
+
+    /**
+     * 设置统计页(PROCESS_CAP_BATCH_STATS) - 在initialize之前调用，取代导出的set_process_stats_page
+     * @param page 统计页(见process_stats_page.h)
+     */
+    void (*set_stats_page)(struct ProcessStatsPage* page);
+
+    /**
+     * 导出运行状态(PROCESS_CAP_RELOAD) - 热重载时在旧实例停止后调用
+     * @param buffer 缓冲区
+     * @param size 缓冲区大小
+     * @return 写入的字节数，0表示没有状态
+     */
+    size_t (*export_state)(void* buffer, size_t size);
+
+    /**
+     * 导入运行状态(PROCESS_CAP_RELOAD) - 热重载时在新实例启动前调用
+     * @param buffer 旧实例导出的状态
+     * @param size 状态大小
+     * @return 0成功，非0时新实例以初始状态启动
+     */
+    int (*import_state)(const void* buffer, size_t size);
+} ProcessInterfaceV2;
+
 /**
  * 插件导出函数 - 每个插件动态库必须实现
  */
@@ -136,8 +208,11 @@ extern ProcessInterface* get_process_interface(void);
  */
 extern uint32_t get_interface_version(void);
 
-// 当前接口版本
+// 接口版本: 高16位为主版本，主版本决定get_process_interface返回的结构
+// PROCESS_INTERFACE_VERSION保持为v1，已有插件重新编译后行为不变
 #define PROCESS_INTERFACE_VERSION 0x00010000
+#define PROCESS_INTERFACE_VERSION_2 0x00020000
+#define PROCESS_INTERFACE_MAJOR(version) ((version) >> 16)
 
 #ifdef __cplusplus
 }
@@ -2,9 +2,29 @@
 #define PROCESS_MANAGER_H
 
 #include "process_interface.h"
+#include "cpu_affinity.h"
+#include "lifecycle_runner.h"
+#include "snapshot_cursor.h"
+#include "startup_graph.h"
+#include "restart_policy.h"
+#include "task_stop.h"
+#include "plugin_host.h"
+#include "process_stats_page.h"
+#include "process_async.h"
 #include <pthread.h>
 #include <sys/queue.h>
 
+// 热重载时新实例达到RUNNING的默认期限
+#define PROCESS_RELOAD_DEFAULT_READY_TIMEOUT_MS 5000
+// 热重载释放旧实例前的默认额外等待(锁外调用者由纪元跟踪，默认不额外等待)
+#define PROCESS_RELOAD_DEFAULT_DRAIN_MS 0
+// 热重载交接运行状态(PROCESS_CAP_RELOAD)的缓冲区大小
+#define PROCESS_RELOAD_STATE_MAX (64 * 1024)
+// 暂停/恢复等待插件确认的期限
+#define PROCESS_PAUSE_TIMEOUT_MS 5000
+// 等待v1插件到达某状态时的轮询间隔
+#define PROCESS_WAIT_POLL_MS 1
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -22,6 +42,27 @@ typedef struct ProcessNode {
     bool is_running;                  // 是否正在运行
     bool should_restart;              // 是否需要重启
     uint32_t restart_count;           // 当前重启次数
+    CpuPlacement placement;           // CPU放置配置(创建线程时应用)
+    char depends_on[STARTUP_MAX_DEPENDENCIES][64]; // 依赖的进程(按拓扑顺序启动时生效)
+    uint32_t dependency_count;        // 依赖数量
+    RestartPolicy restart_policy;     // 重启策略(全0时按插件的restart_count取默认值)
+    RestartState restart_state;       // 退避和窗口预算状态(manager->mutex保护)
+    RestartStats restart_stats;       // 最近一次导出的重启统计
+    uint64_t stop_time_ns;            // 最近一次限时停止的耗时
+    uint32_t stop_escalations;        // 未在期限内停止而被升级的次数
+    bool stop_abandoned;              // 限时停止放弃等待(线程已取消/分离)，状态报告为ERROR，线程不得再join
+    PluginHost* host;                 // 隔离加载时的插件宿主(interface为其代理接口，lib_handle为NULL)；NULL表示进程内加载
+    bool lazy;                        // 延迟加载: 首次启动时才加载和初始化，interface为NULL表示尚未加载或已卸载
+    bool lazy_isolated;               // 延迟加载时在插件宿主进程中加载
+    uint32_t idle_unload_ms;          // 延迟加载的进程停止超过该时长后卸载(0不卸载)
+    uint64_t idle_since_ns;           // 空闲卸载检查首次发现进程停止的时刻(0表示未开始计时)
+    uint32_t lazy_loads;              // 延迟加载的次数(卸载后再次启动会重新加载)
+    int image_fd;                     // 经私有副本(memfd)加载时的描述符，>0时有效，与lib_handle一同关闭
+    ProcessStatsPage* stats_page;     // 插件在写的统计页(插件未导出设置函数时为NULL)，cleanup后删除
+    uint32_t reload_count;            // 热重载成功的次数
+    uint32_t interface_version;       // 插件报告的接口版本
+    uint64_t capabilities;            // v2插件声明的PROCESS_CAP_*(v1插件为0)
+    ProcessAsyncAdapter* async;       // 进程内加载的v2插件的适配器(interface为其v1形式的接口)，cleanup后销毁
     TAILQ_ENTRY(ProcessNode) entries; // 队列链接
 } ProcessNode;
 
@@ -31,11 +72,115 @@ typedef struct ProcessNode {
 typedef struct {
     TAILQ_HEAD(ProcessList, ProcessNode) process_list; // 进程列表
     pthread_mutex_t mutex;                             // 互斥锁
+    uint64_t list_generation;                          // 进程列表代数，锁内插入或移除节点时递增，供快照翻页检测变化
     pthread_t monitor_thread;                          // 监控线程
     bool is_running;                                   // 管理器运行状态
     LogCallback log_callback;                          // 日志回调
 } ProcessManager;
 
+/**
+ * 进程快照记录 - process_manager_snapshot的输出
+ */
+typedef struct {
+    char name[64];                    // 进程名称
+    ProcessState state;               // 插件报告的状态
+    bool is_running;                  // 进程线程是否在运行
+    uint32_t restart_count;           // 当前重启次数
+    CpuPlacementPolicy placement;     // CPU放置策略
+    RestartStats restart;             // 自动重启统计
+    uint64_t stop_time_ns;            // 最近一次限时停止的耗时(纳秒，0表示未记录)
+    uint32_t stop_escalations;        // 限时停止被升级的次数
+    bool isolated;                    // 是否在插件宿主进程中运行
+    pid_t host_pid;                   // 宿主进程(0表示进程内加载或宿主已退出)
+    uint32_t host_crashes;            // 宿主非请求退出的次数
+    uint64_t host_rss_bytes;          // 宿主进程常驻内存
+    bool lazy;                        // 是否延迟加载
+    bool dormant;                     // 延迟加载且当前未加载(尚未启动过或已空闲卸载)
+    uint32_t lazy_loads;              // 延迟加载的次数
+    uint32_t reload_count;            // 热重载成功的次数
+    uint32_t interface_version;       // 插件报告的接口版本(未加载时为0)
+    uint64_t capabilities;            // v2插件声明的PROCESS_CAP_*
+    ProcessStats stats;               // 插件报告的统计信息(副本)
+    LatencySummary latency;           // 统计页中的耗时分布(无统计页或插件未填写时count为0)
+} ProcessSnapshotRecord;
+
+/**
+ * 批量加载请求
+ */
+typedef struct {
+    const char* name;                 // 进程名称
+    const char* library_path;         // 动态库路径
+    const char* config_data;          // 配置数据(可为NULL)
+    int priority;                     // 优先级，数值大的先加载；相同时按请求顺序
+    bool isolated;                    // 在插件宿主进程中加载(见process_manager_load_plugin_isolated)
+    bool lazy;                        // 只登记不加载，首次启动时加载(见process_manager_register_lazy)
+    uint32_t idle_unload_ms;          // 延迟加载的进程停止超过该时长后卸载(0不卸载)
+} ProcessLoadRequest;
+
+/**
+ * 批量加载选项
+ */
+typedef struct {
+    uint32_t max_parallel;            // 最大并发加载数(0为LIFECYCLE_MAX_PARALLEL)
+    bool priority_barrier;            // true时一个优先级的插件全部加载完成后才开始下一个优先级
+} ProcessLoadOptions;
+
+/**
+ * 单个插件的加载时间线 - 时刻均为相对整批开始的微秒数
+ * 隔离加载时open包含创建宿主进程，resolve在宿主握手中完成，与open相同
+ */
+typedef struct {
+    char name[64];                    // 进程名称
+    int priority;                     // 优先级
+    int result;                       // 0成功
+    bool deferred;                    // 延迟加载，只登记未打开(各时刻均为start_us)
+    char error[128];                  // 失败原因
+    uint64_t start_us;                // 开始加载
+    uint64_t open_us;                 // dlopen完成
+    uint64_t resolve_us;              // 导出函数解析和版本检查完成
+    uint64_t ready_us;                // initialize返回(加载结束)
+} ProcessLoadEntry;
+
+/**
+ * 批量加载报告 - entries按加载顺序(优先级从高到低)排列
+ */
+typedef struct {
+    ProcessLoadEntry* entries;
+    uint32_t count;
+    uint32_t loaded;                  // 成功加载
+    uint32_t failed;                  // 加载失败
+    uint32_t deferred;                // 延迟加载(只登记，计入loaded)
+    uint64_t total_us;                // 整批耗时
+    uint64_t serial_us;               // 各插件加载耗时之和(逐个加载时的估计)
+} ProcessLoadReport;
+
+/**
+ * 热重载选项 - 字段为0时使用默认值
+ */
+typedef struct {
+    const char* library_path;         // 新版本动态库路径(NULL为当前路径；原地替换的文件经私有副本加载)
+    uint32_t ready_timeout_ms;        // 新实例达到RUNNING的期限，超时回滚到旧实例
+    uint32_t drain_ms;                // 释放旧实例前的额外等待，留给仍持有process_manager_get_process_stats指针的调用者
+    TaskStopOptions stop;             // 停止旧实例的选项
+} ProcessReloadOptions;
+
+/**
+ * 热重载报告 - 耗时均为微秒
+ */
+typedef struct {
+    char old_version[32];             // 旧实例ProcessInfo.version
+    char new_version[32];             // 新实例ProcessInfo.version
+    bool was_running;                 // 重载前进程是否在运行
+    bool rolled_back;                 // 新实例未能就绪，已恢复旧实例
+    int stop_outcome;                 // 停止旧实例的TaskStopOutcome(未运行时为-1)
+    uint64_t prepare_us;              // 加载和初始化新实例(旧实例照常服务)
+    uint64_t gap_us;                  // 服务中断: 请求旧实例停止到新实例RUNNING
+    uint64_t drain_us;                // 等待并释放旧实例
+    uint64_t total_us;                // 总耗时
+    uint32_t state_bytes;             // 新旧实例都声明PROCESS_CAP_RELOAD时交接的运行状态字节数
+    char error[128];                  // 失败原因
+} ProcessReloadReport;
+
 /**
  * 创建进程管理器
  * @param log_callback 日志回调函数
@@ -63,7 +208,143 @@ int process_manager_load_plugin(ProcessManager* manager,
                                const char* config_data);
 
 /**
- * 启动进程
+ * 隔离加载进程插件 - 插件在posix_spawn创建的宿主进程中加载和运行，
+ * 节点的interface是经共享内存通道转发的代理，管理器的其他操作与进程内插件相同
+ * 插件崩溃只结束宿主进程: 代理报告ERROR，按重启策略重启时重建宿主
+ * @param manager 进程管理器
+ * @param name 进程名称
+ * @param library_path 动态库路径
+ * @param config_data 配置数据
+ * @param options 宿主选项(可为NULL；未设置日志回调时使用管理器的)
+ * @return 0成功，非0失败
+ */
+int process_manager_load_plugin_isolated(ProcessManager* manager,
+                                         const char* name,
+                                         const char* library_path,
+                                         const char* config_data,
+                                         const PluginHostOptions* options);
+
+/**
+ * 并发加载一批插件 - 在有界线程池上并发执行dlopen、解析get_process_interface和initialize，
+ * 按优先级从高到低依次派发；glibc的dlopen互相串行，并发的收益主要来自initialize
+ * @param manager 进程管理器
+ * @param requests 加载请求数组
+ * @param count 请求数量
+ * @param options 选项(可为NULL)
+ * @param report 每个插件的加载时间线(输出，可为NULL)，用process_load_report_free释放
+ * @return 加载失败的插件数量，内部错误返回-1
+ */
+int process_manager_load_plugins(ProcessManager* manager, const ProcessLoadRequest* requests, uint32_t count,
+                                 const ProcessLoadOptions* options, ProcessLoadReport* report);
+
+/**
+ * 释放批量加载报告
+ * @param report 报告
+ */
+void process_load_report_free(ProcessLoadReport* report);
+
+/**
+ * 注册已完成加载和初始化的插件 - 供自行加载插件的模块(隔离加载、并发加载)使用
+ * @param manager 进程管理器
+ * @param name 进程名称
+ * @param library_path 动态库路径
+ * @param config_data 配置数据(可为NULL)
+ * @param lib_handle 动态库句柄(隔离加载时为NULL)，销毁管理器时关闭
+ * @param interface 插件接口
+ * @param host 插件宿主(进程内加载时为NULL)，销毁管理器时销毁
+ * @return 0成功，同名进程已存在或失败返回非0(调用者保留句柄和宿主的所有权)
+ */
+int process_manager_add_plugin(ProcessManager* manager, const char* name, const char* library_path,
+                               const char* config_data, void* lib_handle, ProcessInterface* interface,
+                               PluginHost* host);
+
+/**
+ * 登记延迟加载的插件 - 节点只记录路径和配置，不打开动态库；
+ * 首次启动时由process_manager_ensure_loaded加载和初始化
+ * @param manager 进程管理器
+ * @param name 进程名称
+ * @param library_path 动态库路径
+ * @param config_data 配置数据(可为NULL)
+ * @param isolated 加载时在插件宿主进程中运行
+ * @param idle_unload_ms 进程停止超过该时长后卸载，下次启动时重新加载(0不卸载)
+ * @return 0成功，同名进程已存在或失败返回非0
+ */
+int process_manager_register_lazy(ProcessManager* manager, const char* name, const char* library_path,
+                                  const char* config_data, bool isolated, uint32_t idle_unload_ms);
+
+/**
+ * 确保进程的插件已加载 - 延迟加载的进程在此dlopen(或创建宿主)并initialize，
+ * 已加载的进程直接返回；同一时刻只有一个延迟加载在进行
+ * 调用者不得持有manager->mutex
+ * @param manager 进程管理器
+ * @param name 进程名称
+ * @return 0已加载，进程不存在或加载失败返回非0
+ */
+int process_manager_ensure_loaded(ProcessManager* manager, const char* name);
+
+/**
+ * 卸载空闲的延迟加载进程 - 由监控线程每个周期调用
+ * 进程线程停止、没有待执行的重启且持续时间超过idle_unload_ms时，调用cleanup并dlclose(或销毁宿主)，
+ * 节点保留以便再次启动
+ * @param manager 进程管理器
+ * @return 本次卸载的进程数量，失败返回-1
+ */
+int process_manager_unload_idle(ProcessManager* manager);
+
+/**
+ * 热重载插件 - 新版本与旧版本同时加载: 先dlopen、检查接口版本并initialize新实例(旧实例照常服务)，
+ * 再停止旧实例、原子替换节点的interface并启动新实例，服务中断只包含一次停止和启动；
+ * 新实例未在期限内就绪时回滚。切换前取得旧接口的调用者全部返回(再加drain_ms)后，
+ * 旧实例cleanup并dlclose(隔离加载时销毁旧宿主)
+ * 未加载的延迟加载进程只更新路径。调用者不得持有manager->mutex
+ * @param manager 进程管理器
+ * @param name 进程名称
+ * @param options 选项(可为NULL，使用默认值)
+ * @param report 重载报告(输出，可为NULL)
+ * @return 0成功，失败或回滚返回非0
+ */
+int process_manager_reload_plugin(ProcessManager* manager, const char* name, const ProcessReloadOptions* options,
+                                  ProcessReloadReport* report);
+
+/**
+ * 暂停进程 - 插件须为v2并声明PROCESS_CAP_PAUSE；等待插件通知PAUSED，
+ * 进程线程保持运行，状态报告为PAUSED。等待确认期间不阻塞热重载和空闲卸载
+ * @param manager 进程管理器
+ * @param name 进程名称
+ * @return 0成功，进程未运行、插件不支持、等待期间实例被替换或未在PROCESS_PAUSE_TIMEOUT_MS内确认返回-1
+ */
+int process_manager_pause_process(ProcessManager* manager, const char* name);
+
+/**
+ * 恢复暂停的进程 - 等待插件通知RUNNING
+ * @param manager 进程管理器
+ * @param name 进程名称
+ * @return 0成功，失败返回-1
+ */
+int process_manager_resume_process(ProcessManager* manager, const char* name);
+
+/**
+ * 等待进程到达指定状态 - 进程内加载的v2插件等待状态通知(不阻塞热重载和空闲卸载)，
+ * 其他插件按PROCESS_WAIT_POLL_MS轮询get_state
+ * @param manager 进程管理器
+ * @param name 进程名称
+ * @param state 目标状态
+ * @param timeout_ms 期限(毫秒)
+ * @return 0已到达，进程不存在、报告ERROR、等待期间实例被替换或超时返回-1
+ */
+int process_manager_wait_state(ProcessManager* manager, const char* name, ProcessState state, uint32_t timeout_ms);
+
+/**
+ * 获取隔离插件的宿主状态
+ * @param manager 进程管理器
+ * @param name 进程名称
+ * @param info 宿主状态(输出)
+ * @return 0成功，进程不存在或不是隔离加载返回-1
+ */
+int process_manager_get_host_info(ProcessManager* manager, const char* name, PluginHostInfo* info);
+
+/**
+ * 启动进程 - 延迟加载的进程先经process_manager_ensure_loaded加载
  * @param manager 进程管理器
  * @param name 进程名称
  * @return 0成功，非0失败
@@ -78,6 +359,17 @@ int process_manager_start_process(ProcessManager* manager, const char* name);
  */
 int process_manager_stop_process(ProcessManager* manager, const char* name);
 
+/**
+ * 限时停止进程 - 调用插件stop后按选项等待进程线程退出，超过期限逐级升级(见task_stop.h)
+ * 耗时记入节点和进程级停止耗时直方图；取消或分离时进程状态报告为ERROR
+ * @param manager 进程管理器
+ * @param name 进程名称
+ * @param options 选项(可为NULL，使用默认值)
+ * @return TaskStopOutcome，进程不存在返回-1
+ */
+int process_manager_stop_process_timed(ProcessManager* manager, const char* name,
+                                       const TaskStopOptions* options);
+
 /**
  * 重启进程
  * @param manager 进程管理器
@@ -100,6 +392,69 @@ int process_manager_start_all(ProcessManager* manager);
  */
 int process_manager_stop_all(ProcessManager* manager);
 
+/**
+ * 并发启动所有进程
+ * @param manager 进程管理器
+ * @param options 期限和并发选项(可为NULL)
+ * @param report 每个进程的耗时报告(输出，可为NULL)
+ * @return 未成功启动的进程数量
+ */
+int process_manager_start_all_parallel(ProcessManager* manager, const LifecycleOptions* options,
+                                       LifecycleReport* report);
+
+/**
+ * 并发停止所有进程 - 超过单个期限的进程内插件再收到一次handle_signal(SIGTERM)
+ * @param manager 进程管理器
+ * @param options 期限和并发选项(可为NULL)
+ * @param report 每个进程的耗时报告(输出，可为NULL)
+ * @return 未成功停止的进程数量
+ */
+int process_manager_stop_all_parallel(ProcessManager* manager, const LifecycleOptions* options,
+                                      LifecycleReport* report);
+
+/**
+ * 设置进程的依赖 - 替换原有依赖
+ * @param manager 进程管理器
+ * @param name 进程名称
+ * @param depends_on 依赖的进程名称数组
+ * @param count 依赖数量(不超过STARTUP_MAX_DEPENDENCIES)
+ * @return 0成功，非0失败
+ */
+int process_manager_set_dependencies(ProcessManager* manager, const char* name,
+                                     const char (*depends_on)[64], uint32_t count);
+
+/**
+ * 按依赖拓扑顺序并发启动进程
+ * 进程在其全部依赖的线程运行、插件状态为RUNNING(实现了health_check的还须检查通过)后才启动；
+ * 依赖不在本批中时须已就绪，否则该进程不启动
+ * @param manager 进程管理器
+ * @param names 要启动的进程名称数组，NULL表示全部进程
+ * @param count 名称数量
+ * @param options 并发和就绪期限选项(可为NULL)
+ * @param report 每个进程的层次、耗时及关键路径(输出，可为NULL)，用startup_report_free释放
+ * @return 未就绪的进程数量，失败返回-1
+ */
+int process_manager_start_ordered(ProcessManager* manager, char (*names)[64], uint32_t count,
+                                  const StartupOptions* options, StartupReport* report);
+
+/**
+ * 设置进程的自动重启策略
+ * @param manager 进程管理器
+ * @param name 进程名称
+ * @param policy 重启策略，NULL恢复默认(窗口预算取插件ProcessInfo.restart_count)
+ * @return 0成功，非0失败
+ */
+int process_manager_set_restart_policy(ProcessManager* manager, const char* name, const RestartPolicy* policy);
+
+/**
+ * 按重启策略处理自动重启 - 由监控线程每个周期调用，取代失败后立即重启
+ * 插件声明auto_restart、且进程线程以需要重启的方式退出或插件状态为ERROR时，
+ * 按退避计划重启；窗口预算用尽时标记为崩溃循环并推迟
+ * @param manager 进程管理器
+ * @return 本次重启的进程数量，失败返回-1
+ */
+int process_manager_check_restarts(ProcessManager* manager);
+
 /**
  * 获取进程状态
  * @param manager 进程管理器
@@ -116,6 +471,55 @@ ProcessState process_manager_get_process_state(ProcessManager* manager, const ch
  */
 const ProcessStats* process_manager_get_process_stats(ProcessManager* manager, const char* name);
 
+/**
+ * 设置进程线程的CPU放置 - 之后创建的线程按此放置，运行中的线程立即迁移
+ * @param manager 进程管理器
+ * @param name 进程名称
+ * @param placement 放置配置
+ * @return 0成功，非0失败
+ */
+int process_manager_set_placement(ProcessManager* manager, const char* name, const CpuPlacement* placement);
+
+/**
+ * 获取进程的放置策略和生效的CPU列表
+ * @param manager 进程管理器
+ * @param name 进程名称
+ * @param buffer 输出缓冲区，如"spread cpus=2"；未运行时只有策略
+ * @param size 缓冲区大小
+ * @return 写入的字符数，失败返回-1
+ */
+int process_manager_get_placement(ProcessManager* manager, const char* name, char* buffer, size_t size);
+
+/**
+ * 批量获取进程快照 - 一次获取manager->mutex填充一页记录
+ * @param manager 进程管理器
+ * @param records 记录数组(输出)
+ * @param capacity 数组容量
+ * @param cursor 分页游标(输入输出)
+ * @return 本页记录数，失败返回-1
+ */
+int process_manager_snapshot(ProcessManager* manager, ProcessSnapshotRecord* records, uint32_t capacity,
+                             SnapshotCursor* cursor);
+
+/**
+ * 读取进程统计信息的副本 - 插件有统计页时无锁复制页面，不调用插件；否则复制get_stats的结果
+ * 与process_manager_get_process_stats不同，返回的副本不会被插件并发修改
+ * @param manager 进程管理器
+ * @param name 进程名称
+ * @param stats 统计信息(输出)
+ * @return 0成功，进程不存在或未提供统计返回-1
+ */
+int process_manager_read_stats(ProcessManager* manager, const char* name, ProcessStats* stats);
+
+/**
+ * 复制进程的统计页 - 含自定义计数器和共享内存对象名
+ * @param manager 进程管理器
+ * @param name 进程名称
+ * @param copy 页面副本(输出)
+ * @return 0成功，进程不存在或插件没有统计页返回-1
+ */
+int process_manager_read_stats_page(ProcessManager* manager, const char* name, ProcessStatsPage* copy);
+
 /**
  * 启动监控线程
  * @param manager 进程管理器
@@ -0,0 +1,144 @@
+#ifndef PROCESS_STATS_PAGE_H
+#define PROCESS_STATS_PAGE_H
+
+#include "process_interface.h"
+#include "latency_histogram.h"
+#include "seqlock.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PROCESS_STATS_PAGE_MAGIC 0x50545353u       // "SSTP"
+#define PROCESS_STATS_PAGE_VERSION 2
+// 页面大小固定，外部工具按此映射
+#define PROCESS_STATS_PAGE_SIZE 4096
+#define PROCESS_STATS_PAGE_MAX_COUNTERS 32
+// 共享内存对象名前缀，完整名称为"/starttool.<启动器pid>.<进程名>.<序号>"(位于/dev/shm)
+#define PROCESS_STATS_PAGE_PREFIX "starttool."
+// 插件可选导出的函数名，见ProcessStatsPageSetter
+#define PROCESS_STATS_PAGE_SETTER "set_process_stats_page"
+
+/**
+ * 自定义计数器
+ */
+typedef struct {
+    char name[48];                    // 计数器名称
+    uint64_t value;                   // 计数值
+} ProcessStatsCounter;
+
+/**
+ * 插件统计页 - 管理器为每个插件实例分配的共享内存页
+ * 插件是唯一的写者，写入由lock保护；管理器、启动器和外部工具映射同一页面无锁读取，
+ * 读取不调用插件。头部在创建时写入，之后不变
+ */
+typedef struct ProcessStatsPage {
+    uint32_t magic;                   // PROCESS_STATS_PAGE_MAGIC
+    uint32_t version;                 // PROCESS_STATS_PAGE_VERSION
+    uint32_t size;                    // PROCESS_STATS_PAGE_SIZE
+    int32_t owner_pid;                // 创建页面的启动器进程
+    char process_name[64];            // 进程名称
+    char shm_name[96];                // 共享内存对象名
+    SeqLock lock;                     // 保护以下字段
+    uint32_t counter_count;           // 已注册的计数器数量
+    uint64_t update_count;            // 发布次数
+    uint64_t update_time_ns;          // 最近一次写入结束的CLOCK_REALTIME时刻
+    ProcessStats stats;               // 标准统计信息(v1布局)
+    LatencySummary latency;           // 单次工作耗时分布(插件可选填写，count为0表示未提供)
+    ProcessStatsCounter counters[PROCESS_STATS_PAGE_MAX_COUNTERS];
+} ProcessStatsPage;
+
+_Static_assert(sizeof(ProcessStatsPage) <= PROCESS_STATS_PAGE_SIZE, "ProcessStatsPage超过一页");
+
+/**
+ * 插件可选导出: void set_process_stats_page(ProcessStatsPage* page)
+ * 管理器在initialize之前调用，页面在cleanup返回前一直有效；未导出时管理器回退到get_stats
+ */
+typedef void (*ProcessStatsPageSetter)(ProcessStatsPage* page);
+
+// ============================================================================
+// 管理器端
+// ============================================================================
+
+/**
+ * 创建统计页 - 以共享内存对象创建并映射为可写，写入头部
+ * @param process_name 进程名称
+ * @return 页面，失败返回NULL
+ */
+ProcessStatsPage* process_stats_page_create(const char* process_name);
+
+/**
+ * 映射已有的统计页 - 供插件宿主进程和外部工具使用
+ * @param shm_name 共享内存对象名
+ * @param writable true映射为可写(插件宿主)，false只读(外部工具)
+ * @return 页面，对象不存在或头部无效返回NULL
+ */
+ProcessStatsPage* process_stats_page_open(const char* shm_name, bool writable);
+
+/**
+ * 解除映射
+ * @param page 页面
+ */
+void process_stats_page_close(ProcessStatsPage* page);
+
+/**
+ * 删除共享内存对象并解除映射 - 由创建者在插件cleanup之后调用
+ * @param page 页面
+ */
+void process_stats_page_destroy(ProcessStatsPage* page);
+
+/**
+ * 一致地复制页面 - 无锁，与写者并发时重试；只复制已注册的计数器，副本中其后的槽未定义
+ * 等待和重试都有上限: 写者在写入中途被杀死时序号停在奇数，此时返回-1，调用者回退到get_stats
+ * @param page 页面
+ * @param copy 副本(输出)
+ * @return 重试次数，头部无效或未能读到一致的副本返回-1
+ */
+int process_stats_page_read(const ProcessStatsPage* page, ProcessStatsPage* copy);
+
+/**
+ * 重置页面 - 清空统计和计数器，结束写者遗留的未完成写入；
+ * 写者进程退出后、新写者映射之前调用(插件宿主重建时)，头部保持不变
+ * @param page 页面(可写映射)
+ */
+void process_stats_page_reset(ProcessStatsPage* page);
+
+// ============================================================================
+// 插件端 - 写者之间须自行互斥(通常已持有插件自己的状态锁)
+// ============================================================================
+
+/**
+ * 开始写入 - page为NULL时什么也不做，插件可以无条件调用
+ * @param page 页面
+ */
+void process_stats_page_write_begin(ProcessStatsPage* page);
+
+/**
+ * 结束写入 - 递增发布次数并记录时刻
+ * @param page 页面
+ */
+void process_stats_page_write_end(ProcessStatsPage* page);
+
+/**
+ * 注册计数器 - 同名计数器返回已有下标
+ * @param page 页面
+ * @param name 计数器名称
+ * @return 下标，页面为NULL或计数器已满返回-1
+ */
+int process_stats_page_add_counter(ProcessStatsPage* page, const char* name);
+
+/**
+ * 发布标准统计信息 - 自带write_begin/write_end
+ * @param page 页面
+ * @param stats 统计信息
+ */
+void process_stats_page_publish(ProcessStatsPage* page, const ProcessStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PROCESS_STATS_PAGE_H
@@ -0,0 +1,127 @@
+#ifndef RESTART_POLICY_H
+#define RESTART_POLICY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 滑动窗口内记录的重启时刻数，也是窗口预算的上限
+#define RESTART_HISTORY_SIZE 32
+
+// 默认值
+#define RESTART_DEFAULT_INITIAL_DELAY_MS 100
+#define RESTART_DEFAULT_MAX_DELAY_MS     30000
+#define RESTART_DEFAULT_BACKOFF_FACTOR   2
+#define RESTART_DEFAULT_WINDOW_MS        60000
+#define RESTART_DEFAULT_MAX_RESTARTS     5
+
+/**
+ * 重启策略 - 字段为0时使用默认值
+ */
+typedef struct {
+    uint32_t initial_delay_ms;  // 首次重启延迟
+    uint32_t max_delay_ms;      // 退避延迟上限
+    uint32_t backoff_factor;    // 每次连续失败后延迟的倍数
+    uint32_t jitter_percent;    // 随机抖动幅度(±百分比，不超过100)，避免多个任务同时重启
+    uint32_t window_ms;         // 重启预算的滑动窗口
+    uint32_t max_restarts;      // 窗口内最多重启次数，用尽即判定为崩溃循环(不超过RESTART_HISTORY_SIZE)
+    uint32_t stable_ms;         // 连续运行超过此时长后退避级数和崩溃循环状态清零(默认等于window_ms)
+} RestartPolicy;
+
+/**
+ * 重启状态 - 由监控线程维护，调用者负责同步
+ */
+typedef struct {
+    uint64_t history[RESTART_HISTORY_SIZE]; // 最近的重启时刻(单调时钟纳秒，环形)
+    uint32_t history_head;      // 下一个写入位置
+    uint32_t history_count;     // 有效记录数
+    uint32_t attempt;           // 连续失败次数(退避级数)
+    uint32_t total;             // 累计自动重启次数
+    uint32_t delay_ms;          // 最近一次计划的延迟
+    uint64_t started_ns;        // 最近一次启动时刻，0表示未知
+    uint64_t due_ns;            // 计划的重启时刻，0表示没有待执行的重启
+    uint64_t last_restart_ns;   // 最近一次自动重启时刻
+    bool crash_loop;            // 窗口预算已用尽
+    uint32_t seed;              // 抖动随机数状态
+} RestartState;
+
+/**
+ * 对外公开的重启统计
+ */
+typedef struct {
+    uint32_t total;             // 累计自动重启次数
+    uint32_t in_window;         // 滑动窗口内的重启次数
+    uint32_t backoff_ms;        // 最近一次计划的退避延迟
+    bool crash_loop;            // 处于崩溃循环，重启被推迟到窗口有余量
+    bool pending;               // 有待执行的重启
+    uint64_t last_restart_time; // 最近一次自动重启的时间戳(秒，从未重启为0)
+    uint64_t next_restart_time; // 计划重启的时间戳(秒，没有待执行的重启为0)
+} RestartStats;
+
+/**
+ * 补全默认值
+ * @param policy 策略(输入输出)
+ * @param fallback_max_restarts max_restarts为0时使用的窗口预算(0则使用默认值)
+ */
+void restart_policy_normalize(RestartPolicy* policy, uint32_t fallback_max_restarts);
+
+/**
+ * 初始化重启状态
+ * @param state 重启状态
+ * @param seed 抖动随机种子
+ */
+void restart_state_init(RestartState* state, uint32_t seed);
+
+/**
+ * 发现失败时计划重启 - 已有计划时不重复计算
+ * 延迟为initial_delay_ms * backoff_factor^attempt(不超过max_delay_ms)加抖动；
+ * 窗口预算用尽时推迟到最早的一次重启滑出窗口
+ * @param state 重启状态
+ * @param policy 已补全的策略
+ * @param now_ns 当前单调时间
+ * @return 计划的重启时刻
+ */
+uint64_t restart_state_schedule(RestartState* state, const RestartPolicy* policy, uint64_t now_ns);
+
+/**
+ * 检查计划的重启是否到期
+ * @param state 重启状态
+ * @param now_ns 当前单调时间
+ * @return true应立即重启
+ */
+bool restart_state_due(const RestartState* state, uint64_t now_ns);
+
+/**
+ * 记录一次重启 - 清除计划并写入历史
+ * @param state 重启状态
+ * @param now_ns 当前单调时间
+ */
+void restart_state_restarted(RestartState* state, uint64_t now_ns);
+
+/**
+ * 运行中的任务调用 - 连续运行超过stable_ms后清零退避级数和崩溃循环状态
+ * @param state 重启状态
+ * @param policy 已补全的策略
+ * @param now_ns 当前单调时间
+ * @return true本次发生了清零
+ */
+bool restart_state_mark_running(RestartState* state, const RestartPolicy* policy, uint64_t now_ns);
+
+/**
+ * 导出统计
+ * @param state 重启状态
+ * @param policy 已补全的策略
+ * @param now_ns 当前单调时间
+ * @param stats 统计(输出)
+ */
+void restart_state_export(const RestartState* state, const RestartPolicy* policy, uint64_t now_ns,
+                          RestartStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RESTART_POLICY_H
@@ -0,0 +1,88 @@
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * 顺序锁 - 写者之间须自行互斥(通常已持有数据所属的互斥锁)，
+ * 写者从不等待读者；读者不加锁，读到写入中途的数据时重试
+ * sequence为奇数表示正在写入
+ */
+typedef struct {
+    uint32_t sequence;
+} SeqLock;
+
+#define SEQLOCK_INITIALIZER { 0 }
+
+/**
+ * 初始化顺序锁
+ * @param lock 顺序锁
+ */
+void seqlock_init(SeqLock* lock);
+
+/**
+ * 开始写入 - 之后对受保护数据的修改在seqlock_write_end之前对读者不可见为一致状态
+ * @param lock 顺序锁
+ */
+void seqlock_write_begin(SeqLock* lock);
+
+/**
+ * 结束写入
+ * @param lock 顺序锁
+ */
+void seqlock_write_end(SeqLock* lock);
+
+/**
+ * 开始读取 - 等待正在进行的写入结束
+ * @param lock 顺序锁
+ * @return 读取开始时的序号，传给seqlock_read_retry
+ */
+uint32_t seqlock_read_begin(const SeqLock* lock);
+
+/**
+ * 开始读取，最多等待max_spins次 - 写者在另一个进程中且可能在写入中途被杀死时使用，
+ * 此时序号停在奇数，seqlock_read_begin会一直等下去
+ * @param lock 顺序锁
+ * @param max_spins 最多检查序号的次数
+ * @param start 读取开始时的序号(输出)
+ * @return 0成功，写入在限定次数内未结束返回-1
+ */
+int seqlock_read_try_begin(const SeqLock* lock, uint32_t max_spins, uint32_t* start);
+
+/**
+ * 检查读取期间是否发生过写入
+ * @param lock 顺序锁
+ * @param start seqlock_read_begin的返回值
+ * @return 非0表示读到的数据可能不一致，需要重读
+ */
+int seqlock_read_retry(const SeqLock* lock, uint32_t start);
+
+/**
+ * 读取期间复制受保护数据 - 逐字原子读取，与写者并发时不会产生撕裂的单个字段，
+ * 整体一致性由seqlock_read_retry保证
+ * @param dst 目标缓冲区
+ * @param src 受保护数据
+ * @param size 字节数
+ */
+void seqlock_read_copy(void* dst, const void* src, size_t size);
+
+/**
+ * 一致地复制受保护数据 - seqlock_read_begin/seqlock_read_copy/seqlock_read_retry的组合
+ * @param lock 顺序锁
+ * @param dst 目标缓冲区
+ * @param src 受保护数据
+ * @param size 字节数
+ * @return 重试次数
+ */
+uint32_t seqlock_copy_out(const SeqLock* lock, void* dst, const void* src, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SEQLOCK_H
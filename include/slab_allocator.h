@@ -0,0 +1,88 @@
+#ifndef SLAB_ALLOCATOR_H
+#define SLAB_ALLOCATOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <pthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 缓存行大小
+#define SLAB_CACHE_LINE 64
+
+// 默认每块字节数
+#define SLAB_DEFAULT_CHUNK_BYTES (64 * 1024)
+
+struct SlabChunk;
+
+/**
+ * 定长对象的块分配器 - 对象从成批分配的连续内存块中切出，释放的对象进入空闲链表复用
+ * 内存块在slab_destroy前不归还，线程安全
+ */
+typedef struct {
+    size_t object_size;         // 对齐后的对象大小
+    size_t alignment;           // 对象对齐
+    uint32_t objects_per_chunk; // 每块对象数
+    struct SlabChunk* chunks;   // 内存块链表
+    void* free_list;            // 空闲对象链表(对象首字存放next指针)
+    char* bump;                 // 当前块中尚未切出的位置
+    char* bump_end;             // 当前块末尾
+    uint64_t chunk_count;       // 已分配的块数(即底层malloc次数)
+    uint64_t in_use;            // 正在使用的对象数
+    pthread_mutex_t mutex;
+} SlabAllocator;
+
+/**
+ * 分配器统计
+ */
+typedef struct {
+    size_t object_size;         // 对齐后的对象大小
+    uint64_t chunk_count;       // 底层分配次数
+    uint64_t capacity;          // 已切出的对象总数
+    uint64_t in_use;            // 正在使用的对象数
+} SlabStats;
+
+/**
+ * 初始化分配器
+ * @param slab 分配器
+ * @param object_size 对象大小
+ * @param alignment 对象对齐(2的幂，0为指针大小；SLAB_CACHE_LINE使对象独占缓存行)
+ * @param chunk_bytes 每块字节数(0为SLAB_DEFAULT_CHUNK_BYTES，至少容纳一个对象)
+ * @return 0成功，非0失败
+ */
+int slab_init(SlabAllocator* slab, size_t object_size, size_t alignment, size_t chunk_bytes);
+
+/**
+ * 释放全部内存块 - 之后所有对象失效
+ * @param slab 分配器
+ */
+void slab_destroy(SlabAllocator* slab);
+
+/**
+ * 分配一个清零的对象
+ * @param slab 分配器
+ * @return 对象指针，失败返回NULL
+ */
+void* slab_alloc(SlabAllocator* slab);
+
+/**
+ * 归还对象
+ * @param slab 分配器
+ * @param object 由同一分配器分配的对象(可为NULL)
+ */
+void slab_free(SlabAllocator* slab, void* object);
+
+/**
+ * 获取统计
+ * @param slab 分配器
+ * @param stats 统计(输出)
+ */
+void slab_get_stats(SlabAllocator* slab, SlabStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SLAB_ALLOCATOR_H
@@ -0,0 +1,28 @@
+#ifndef SNAPSHOT_CURSOR_H
+#define SNAPSHOT_CURSOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * 批量快照的分页游标 - 首次调用前用SNAPSHOT_CURSOR_INIT初始化，
+ * 每次调用后position前进到下一页，position >= total表示已取完
+ */
+typedef struct {
+    uint32_t position;          // 下一条记录的序号
+    uint32_t total;             // 最近一页生成时的记录总数
+    uint64_t generation;        // 首页时的注册表代数(0表示无法得知)
+    bool changed;               // 翻页期间注册表发生过变化，结果可能有重复或遗漏
+} SnapshotCursor;
+
+#define SNAPSHOT_CURSOR_INIT { 0, 0, 0, false }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SNAPSHOT_CURSOR_H
@@ -0,0 +1,133 @@
+#ifndef STARTUP_GRAPH_H
+#define STARTUP_GRAPH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 每个任务/进程最多声明的依赖数
+#define STARTUP_MAX_DEPENDENCIES 8
+
+// 最大并发启动数
+#define STARTUP_MAX_PARALLEL 64
+
+// 默认就绪期限(毫秒)
+#define STARTUP_DEFAULT_READY_TIMEOUT_MS 5000
+
+// 默认就绪探测的最大间隔(毫秒)
+#define STARTUP_DEFAULT_POLL_MS 50
+
+/**
+ * 启动图节点 - 名称及其依赖
+ * 依赖不在本批节点中时视为外部依赖，规划时探测一次，未就绪则该节点被阻塞
+ */
+typedef struct {
+    char name[64];                                      // 任务/进程名称
+    char depends_on[STARTUP_MAX_DEPENDENCIES][64];      // 依赖名称
+    uint32_t dependency_count;                          // 依赖数量
+} StartupNode;
+
+/**
+ * 启动选项
+ */
+typedef struct {
+    uint32_t max_parallel;      // 最大并发启动数(0为STARTUP_MAX_PARALLEL)
+    uint32_t ready_timeout_ms;  // 启动后等待就绪的期限(0为STARTUP_DEFAULT_READY_TIMEOUT_MS)
+    uint32_t poll_ms;           // 就绪探测的最大间隔(0为STARTUP_DEFAULT_POLL_MS)，从1毫秒起倍增
+} StartupOptions;
+
+/**
+ * 单个节点的启动结果
+ */
+typedef enum {
+    STARTUP_PENDING = 0,        // 未处理
+    STARTUP_READY,              // 已启动并就绪
+    STARTUP_FAILED,             // 启动操作失败
+    STARTUP_TIMEOUT,            // 启动后未在期限内就绪
+    STARTUP_BLOCKED             // 依赖缺失、成环或未就绪，未启动
+} StartupOutcome;
+
+/**
+ * 单个节点的启动记录
+ */
+typedef struct {
+    char name[64];              // 名称
+    StartupOutcome outcome;     // 结果
+    int result;                 // 启动操作返回值
+    uint32_t wave;              // 拓扑层次(无依赖为0)，被阻塞时无意义
+    int32_t gated_by;           // 最后就绪的依赖(entries下标)，-1表示不受依赖限制
+    uint64_t start_us;          // 开始启动的时刻(相对整批开始)
+    uint64_t ready_us;          // 就绪或放弃的时刻(相对整批开始)
+} StartupEntry;
+
+/**
+ * 启动报告 - entries与输入节点同序
+ * 关键路径从最晚结束的节点沿gated_by回溯得到，决定了整批的启动耗时
+ */
+typedef struct {
+    StartupEntry* entries;
+    uint32_t count;
+    uint32_t wave_count;        // 拓扑层数
+    uint32_t ready;             // 就绪数
+    uint32_t failed;            // 启动失败数
+    uint32_t timed_out;         // 未就绪数
+    uint32_t blocked;           // 被阻塞数
+    uint32_t* critical_path;    // 关键路径(entries下标，从最早的依赖到最晚结束的节点)
+    uint32_t critical_path_length;
+    uint64_t total_us;          // 整批耗时
+} StartupReport;
+
+/**
+ * 启动操作 - 在辅助线程上执行，可能阻塞
+ * @param target 管理器
+ * @param name 名称
+ * @return 0成功，非0失败
+ */
+typedef int (*StartupOperation)(void* target, const char* name);
+
+/**
+ * 就绪探测 - 在辅助线程上反复调用，不应长时间阻塞
+ * @param target 管理器
+ * @param name 名称
+ * @return true已就绪
+ */
+typedef bool (*StartupProbe)(void* target, const char* name);
+
+/**
+ * 按依赖拓扑顺序并发启动一批节点
+ * 节点在其全部依赖就绪后立即启动，不等待同层其他节点；启动失败或未就绪的
+ * 节点的所有下游节点被阻塞，不影响无关分支
+ * @param target 管理器
+ * @param nodes 节点数组
+ * @param count 数量
+ * @param operation 启动操作
+ * @param probe 就绪探测
+ * @param options 选项(可为NULL，使用默认值)
+ * @param report 报告(输出，可为NULL)，用startup_report_free释放
+ * @return 未就绪的节点数，内部错误返回-1
+ */
+int startup_graph_run(void* target, const StartupNode* nodes, uint32_t count,
+                      StartupOperation operation, StartupProbe probe,
+                      const StartupOptions* options, StartupReport* report);
+
+/**
+ * 结果名称
+ * @param outcome 结果
+ * @return 名称字符串
+ */
+const char* startup_outcome_name(StartupOutcome outcome);
+
+/**
+ * 释放报告
+ * @param report 报告
+ */
+void startup_report_free(StartupReport* report);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // STARTUP_GRAPH_H
@@ -0,0 +1,53 @@
+#ifndef TASK_ACCOUNTING_H
+#define TASK_ACCOUNTING_H
+
+#include "task_interface.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 采样内容
+#define TASK_ACCOUNTING_CPU   0x1   // 线程CPU时钟：每个任务一次clock_gettime
+#define TASK_ACCOUNTING_PROC  0x2   // /proc/self/task/<tid>/stat：缺页次数、最近运行的CPU
+#define TASK_ACCOUNTING_ALL   (TASK_ACCOUNTING_CPU | TASK_ACCOUNTING_PROC)
+
+/**
+ * 一次批量采样的结果
+ */
+typedef struct {
+    uint32_t sampled;           // 完成采样的任务数
+    uint32_t skipped;           // 未运行或线程已退出的任务数
+    uint64_t elapsed_ns;        // 本次采样耗时
+    uint64_t process_rss;       // 进程常驻内存(字节)，线程之间共享地址空间，没有各自的常驻内存
+} TaskAccountingSummary;
+
+/**
+ * 记录调用线程的内核线程ID - 独占线程模式的线程入口调用(task_sched_apply已包含)
+ * @param task 任务基类指针
+ */
+void task_accounting_attach_thread(TaskBase* task);
+
+/**
+ * 采样单个任务，更新stats中的cpu_time_ns、cpu_usage、缺页次数和last_cpu
+ * 独占线程任务按tid读取线程CPU时钟，线程退出后时钟失效，不会误读其他线程；
+ * 池化任务读取执行器在每个step前后累计的CPU时间(需enable_stats)，不读/proc
+ * cpu_usage为两次采样之间的CPU时间占墙钟时间的百分比，首次采样为0
+ * @param task 任务基类指针
+ * @param flags TASK_ACCOUNTING_*组合
+ * @param now_ns 采样时刻(CLOCK_MONOTONIC纳秒)
+ * @return 0成功，1任务没有可采样的线程，-1失败
+ */
+int task_accounting_sample(TaskBase* task, uint32_t flags, uint64_t now_ns);
+
+/**
+ * 读取进程常驻内存
+ * @return 字节数，失败返回0
+ */
+uint64_t task_accounting_process_rss(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TASK_ACCOUNTING_H
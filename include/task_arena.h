@@ -0,0 +1,80 @@
+#ifndef TASK_ARENA_H
+#define TASK_ARENA_H
+
+#include "slab_allocator.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 任务对象的大小分类数，用尽后的新大小直接malloc
+#define TASK_ARENA_CLASSES 16
+
+/**
+ * 任务分配区 - 管理器的TaskNode和任务包装对象从这里分配
+ * 同类对象在连续的内存块中按注册顺序相邻，监控扫描时访问的内存集中；
+ * 任务对象按缓存行对齐，相邻任务的热字段不会共享缓存行
+ * 按引用计数释放: 管理器持有一个引用，每个存活的任务对象持有一个引用，
+ * 任务对象可以在管理器销毁之后再销毁
+ */
+typedef struct TaskArena {
+    SlabAllocator nodes;                        // TaskNode
+    SlabAllocator classes[TASK_ARENA_CLASSES];  // 任务对象，按缓存行取整后的大小分类
+    uint32_t class_count;                       // 已建立的分类数
+    uint32_t refs;                              // 引用计数(原子访问)
+    uint64_t fallback_count;                    // 分类用尽后直接malloc的次数
+    pthread_mutex_t mutex;                      // 保护分类表
+} TaskArena;
+
+/**
+ * 分配区统计
+ */
+typedef struct {
+    SlabStats nodes;            // TaskNode分配器统计
+    uint32_t class_count;       // 任务对象分类数
+    uint64_t object_chunks;     // 任务对象的底层分配次数
+    uint64_t objects_in_use;    // 存活的任务对象数
+    uint64_t fallback_count;    // 直接malloc的任务对象数
+} TaskArenaStats;
+
+/**
+ * 创建分配区
+ * @param node_size 节点大小(sizeof(TaskNode))
+ * @return 分配区指针(持有一个引用)，失败返回NULL
+ */
+TaskArena* task_arena_create(size_t node_size);
+
+/**
+ * 释放一个引用 - 最后一个引用释放时归还全部内存
+ * @param arena 分配区(可为NULL)
+ */
+void task_arena_release(TaskArena* arena);
+
+/**
+ * 分配清零的任务对象 - 缓存行对齐
+ * @param arena 分配区，NULL时直接从堆分配(同样清零、对齐)
+ * @param size 对象大小
+ * @return 对象指针，失败返回NULL
+ */
+void* task_object_alloc(TaskArena* arena, size_t size);
+
+/**
+ * 释放任务对象
+ * @param arena 分配对象时使用的分配区(可为NULL)
+ * @param object 对象
+ * @param size 分配时的大小
+ */
+void task_object_free(TaskArena* arena, void* object, size_t size);
+
+/**
+ * 获取统计
+ * @param arena 分配区
+ * @param stats 统计(输出)
+ */
+void task_arena_get_stats(TaskArena* arena, TaskArenaStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TASK_ARENA_H
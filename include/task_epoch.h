@@ -0,0 +1,79 @@
+#ifndef TASK_EPOCH_H
+#define TASK_EPOCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 读者计数分片数(按线程分散，避免所有读者争用同一缓存行)
+#define TASK_EPOCH_STRIPES 32
+
+/**
+ * 读者计数分片 - 独占一个缓存行
+ */
+typedef struct {
+    uint64_t active[2];                // 按纪元奇偶分别计数的活跃读者
+    char padding[64 - 2 * sizeof(uint64_t)];
+} __attribute__((aligned(64))) TaskEpochStripe;
+
+/**
+ * 纪元回收域
+ * 读者进入/退出只做一次原子加减，从不阻塞；
+ * 写者翻转纪元后等待旧纪元的读者全部退出，再释放被替换的对象
+ */
+typedef struct TaskEpochDomain {
+    uint64_t global_epoch;             // 当前纪元(原子访问)
+    pthread_mutex_t writer_mutex;      // 串行化写者
+    TaskEpochStripe stripes[TASK_EPOCH_STRIPES];
+} TaskEpochDomain;
+
+/**
+ * 读临界区令牌 - 由task_epoch_enter返回，传给task_epoch_exit
+ */
+typedef struct {
+    uint32_t stripe;
+    uint32_t parity;
+} TaskEpochGuard;
+
+/**
+ * 创建纪元回收域
+ * @return 回收域指针，失败返回NULL
+ */
+TaskEpochDomain* task_epoch_create(void);
+
+/**
+ * 销毁纪元回收域(调用者保证已无读者)
+ * @param domain 回收域指针
+ */
+void task_epoch_destroy(TaskEpochDomain* domain);
+
+/**
+ * 进入读临界区
+ * @param domain 回收域指针
+ * @return 读临界区令牌
+ */
+TaskEpochGuard task_epoch_enter(TaskEpochDomain* domain);
+
+/**
+ * 退出读临界区
+ * @param domain 回收域指针
+ * @param guard task_epoch_enter返回的令牌
+ */
+void task_epoch_exit(TaskEpochDomain* domain, TaskEpochGuard guard);
+
+/**
+ * 等待宽限期结束 - 返回时，调用前进入的所有读者都已退出
+ * 写者在摘除旧对象后调用，随后即可安全释放旧对象
+ * @param domain 回收域指针
+ */
+void task_epoch_synchronize(TaskEpochDomain* domain);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TASK_EPOCH_H
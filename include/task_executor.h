@@ -0,0 +1,91 @@
+#ifndef TASK_EXECUTOR_H
+#define TASK_EXECUTOR_H
+
+#include "task_interface.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * 池化任务执行器 - M:N调度
+ * 固定数量的工作线程(默认每核一个)，各自按优先级持有工作窃取双端队列；
+ * 任务以step()为单位被调度，优先取高优先级队列，空闲线程从其他线程的队列窃取任务。
+ * 每个step结束都是调度点，CRITICAL任务被唤醒后最多等待一个正在执行的step
+ */
+typedef struct TaskExecutor TaskExecutor;
+
+/**
+ * 执行器统计信息
+ */
+typedef struct {
+    uint32_t worker_count;      // 工作线程数
+    uint32_t active_tasks;      // 已提交未结束的任务数
+    uint64_t steps;             // 累计step()调用次数
+    uint64_t steals;            // 累计窃取次数
+    uint64_t parks;             // 工作线程累计休眠次数
+    uint64_t priority_steps[TASK_PRIORITY_LEVELS]; // 各优先级的step()调用次数
+} TaskExecutorStats;
+
+/**
+ * 创建执行器
+ * @param worker_count 工作线程数，0表示在线CPU数
+ * @return 执行器指针，失败返回NULL
+ */
+TaskExecutor* task_executor_create(uint32_t worker_count);
+
+/**
+ * 销毁执行器 - 回收工作线程，调用前应先停止所有池化任务
+ * @param executor 执行器指针
+ */
+void task_executor_destroy(TaskExecutor* executor);
+
+/**
+ * 获取进程级默认执行器(首次调用时创建)
+ * task_start对exec_mode为TASK_EXEC_POOLED的任务提交到此执行器
+ * @return 执行器指针，失败返回NULL
+ */
+TaskExecutor* task_executor_default(void);
+
+/**
+ * 提交任务 - 相当于池化模式下的task_start
+ * 状态切换为RUNNING，首次调度时调用initialize，之后反复调用step
+ * @param executor 执行器指针
+ * @param task 任务基类指针(vtable必须实现step)
+ * @return 0成功，非0失败
+ */
+int task_executor_submit(TaskExecutor* executor, TaskBase* task);
+
+/**
+ * 唤醒因TASK_STEP_WAIT挂起的任务；任务未挂起时记录一次待处理唤醒
+ * @param task 任务基类指针
+ */
+void task_executor_wake(TaskBase* task);
+
+/**
+ * 停止池化任务 - 设置停止标志、唤醒并等待任务完成清理
+ * @param task 任务基类指针
+ * @return 0成功，非0失败
+ */
+int task_executor_stop_task(TaskBase* task);
+
+/**
+ * 限时停止池化任务 - 正在执行的step无法被打断，超时后任务仍由执行器在step返回时清理
+ * @param task 任务基类指针
+ * @param timeout_ms 最长等待时间(毫秒)，0不限
+ * @return 0已停止，1超时，-1失败
+ */
+int task_executor_stop_task_timed(TaskBase* task, uint32_t timeout_ms);
+
+/**
+ * 获取执行器统计信息
+ * @param executor 执行器指针
+ * @param stats 统计信息(输出)
+ */
+void task_executor_get_stats(TaskExecutor* executor, TaskExecutorStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TASK_EXECUTOR_H
@@ -0,0 +1,83 @@
+#ifndef TASK_INDEX_H
+#define TASK_INDEX_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 前向声明 - 定义见task_manager.h
+struct TaskNode;
+
+/**
+ * 索引槽位 - 缓存哈希值以避免无谓的strcmp
+ */
+typedef struct {
+    uint32_t hash;                     // 名称哈希值
+    struct TaskNode* node;             // 任务节点(NULL为空槽，TASK_INDEX_TOMBSTONE为已删除)
+} TaskIndexSlot;
+
+/**
+ * 任务名称哈希索引 - 开放寻址(线性探测)
+ * 嵌入只读注册表视图(TaskRegistryView)：节点数组负责有序遍历，索引负责按名称查找
+ * 不带锁，由调用者保护(视图发布后只读)
+ */
+typedef struct TaskIndex {
+    TaskIndexSlot* slots;              // 槽位数组
+    uint32_t capacity;                 // 槽位数量(2的幂)
+    uint32_t count;                    // 有效节点数
+    uint32_t tombstones;               // 已删除槽位数
+} TaskIndex;
+
+/**
+ * 初始化索引
+ * @param index 索引指针
+ * @param initial_capacity 初始容量提示(会向上取整为2的幂)
+ * @return 0成功，非0失败
+ */
+int task_index_init(TaskIndex* index, uint32_t initial_capacity);
+
+/**
+ * 销毁索引(不释放节点本身)
+ * @param index 索引指针
+ */
+void task_index_destroy(TaskIndex* index);
+
+/**
+ * 插入节点，以node->name为键
+ * @param index 索引指针
+ * @param node 任务节点
+ * @return 0成功，-1参数错误或内存不足，-2名称已存在
+ */
+int task_index_insert(TaskIndex* index, struct TaskNode* node);
+
+/**
+ * 按名称删除节点
+ * @param index 索引指针
+ * @param name 任务名称
+ * @return 被删除的节点，未找到返回NULL
+ */
+struct TaskNode* task_index_remove(TaskIndex* index, const char* name);
+
+/**
+ * 按名称查找节点
+ * @param index 索引指针
+ * @param name 任务名称
+ * @return 任务节点，未找到返回NULL
+ */
+struct TaskNode* task_index_find(const TaskIndex* index, const char* name);
+
+/**
+ * 计算任务名称哈希值(FNV-1a)
+ * @param name 任务名称
+ * @return 哈希值
+ */
+uint32_t task_index_hash(const char* name);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TASK_INDEX_H
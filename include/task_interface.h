@@ -4,6 +4,10 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <pthread.h>
+#include "cpu_affinity.h"
+#include "seqlock.h"
+#include "startup_graph.h"
+#include "restart_policy.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -31,6 +35,25 @@ typedef enum {
     TASK_PRIORITY_CRITICAL
 } TaskPriority;
 
+#define TASK_PRIORITY_LEVELS (TASK_PRIORITY_CRITICAL + 1)
+
+/**
+ * 任务执行模式
+ */
+typedef enum {
+    TASK_EXEC_THREAD = 0,       // 独占线程(默认)：execute()在专属线程中运行
+    TASK_EXEC_POOLED            // 池化：step()在共享工作线程池上反复调度
+} TaskExecMode;
+
+/**
+ * 单步执行结果 - step()的返回值，负数表示出错
+ */
+typedef enum {
+    TASK_STEP_YIELD = 0,        // 本步完成，重新排队等待下一次调度
+    TASK_STEP_WAIT = 1,         // 挂起，直到task_executor_wake唤醒
+    TASK_STEP_DONE = 2          // 任务执行完毕
+} TaskStepResult;
+
 /**
  * 任务统计信息
  */
@@ -39,9 +62,18 @@ typedef struct {
     uint64_t total_run_time;    // 总运行时间
     uint32_t execution_count;   // 执行次数
     uint32_t error_count;       // 错误次数
-    uint32_t cpu_usage;         // CPU使用率(百分比)
-    uint64_t memory_usage;      // 内存使用量(字节)
+    uint32_t cpu_usage;         // CPU使用率(百分比，两次采样之间)
+    uint64_t memory_usage;      // 内存使用量(字节，由任务自行上报)
     uint64_t last_heartbeat;    // 最后心跳时间
+    char cpu_affinity[64];      // 生效的CPU亲和性，如"2-3"(空表示未记录)
+    uint64_t cpu_time_ns;       // 累计CPU时间(纳秒)
+    uint64_t minor_faults;      // 次缺页次数(独占线程模式)
+    uint64_t major_faults;      // 主缺页次数(独占线程模式)
+    int32_t last_cpu;           // 最近一次运行所在的CPU(采样后有效)
+    RestartStats restart;       // 自动重启统计(task_manager_check_restarts更新)
+    uint64_t stop_time_ns;      // 最近一次限时停止的耗时(task_stop_timed记录，放弃时为放弃前的等待时长)
+    uint32_t stop_count;        // 限时停止次数
+    uint32_t stop_escalations;  // 未在期限内停止而被升级的次数
 } TaskStats;
 
 /**
@@ -51,11 +83,15 @@ typedef struct {
     char name[64];              // 任务名称
     char description[256];      // 任务描述
     TaskPriority priority;      // 任务优先级
-    uint32_t max_restart_count; // 最大重启次数
+    uint32_t max_restart_count; // 重启预算: 滑动窗口内最多自动重启次数(见restart_policy.h)
     uint32_t heartbeat_interval; // 心跳间隔(秒)
     bool auto_restart;          // 是否自动重启
     bool enable_stats;          // 是否启用统计
     void* custom_config;        // 自定义配置数据
+    TaskExecMode exec_mode;     // 执行模式(池化需实现step)
+    CpuPlacement placement;     // CPU放置(独占线程模式生效)
+    char depends_on[STARTUP_MAX_DEPENDENCIES][64]; // 依赖的任务(task_manager_start_all_ordered生效)
+    uint32_t dependency_count;  // 依赖数量
 } TaskConfig;
 
 // 前向声明
@@ -70,11 +106,35 @@ typedef struct TaskBase {
     TaskConfig config;              // 任务配置
     TaskState state;                // 当前状态
     TaskStats stats;                // 统计信息
+    SeqLock stats_seq;              // 统计信息的顺序锁(写者持有mutex，见task_stats.h)
     pthread_t thread;               // 任务线程
     pthread_mutex_t mutex;          // 状态保护互斥锁
     bool should_stop;               // 停止标志
+    bool stop_abandoned;            // task_stop_timed放弃等待(线程已取消/分离或step未返回)，线程不得再join
+    uint32_t park_seq;              // 停靠唤醒序号(futex字，原子访问，见task_park.h)
+    uint32_t park_seen;             // 任务线程已消费的唤醒序号
+    uint32_t paused;                // 暂停标志(原子访问)
     uint32_t restart_count;         // 已重启次数
     
+    // 池化执行状态(由task_executor维护)
+    struct TaskExecutor* executor;  // 所属执行器，NULL表示独占线程
+    uint32_t exec_state;            // 调度状态(原子访问)
+    uint32_t wake_pending;          // 挂起期间收到的唤醒(原子访问)
+    struct TimerWheelTimer* periodic_timer; // 周期调度定时器(task_manager_schedule_periodic)
+    uint32_t sched_class;           // 实际生效的调度类(TaskSchedClass，见task_sched.h)
+    
+    // 资源采样状态(见task_accounting.h)
+    int32_t tid;                    // 独占线程的内核线程ID(原子访问，0表示没有线程)
+    uint64_t acct_cpu_ns;           // 上次采样时的累计CPU时间
+    uint64_t acct_sample_ns;        // 上次采样时刻
+    struct LatencyHistogram* latency; // 单次工作耗时直方图(首次记录时创建，见task_latency.h)
+    
+    // 自动重启状态(由监控线程在mutex保护下维护，见restart_policy.h)
+    RestartPolicy restart_policy;   // 重启策略(全0时按config.max_restart_count取默认值)
+    RestartState restart_state;     // 退避和窗口预算状态
+    
+    struct TaskArena* arena;        // 任务对象所属的分配区(NULL表示malloc，见task_arena.h)
+    
     // 虚函数表指针 (类似C++的vtable)
     const struct TaskInterface* vtable;
 } TaskBase;
@@ -140,6 +200,14 @@ typedef struct TaskInterface {
      * @return 写入的字节数
      */
     int (*get_status)(TaskBase* task, char* buffer, size_t size);
+    
+    /**
+     * 单步执行 - 虚函数(池化执行模式下必须实现)
+     * 每次调用完成一小段工作后立即返回，不得阻塞
+     * @param task 任务基类指针
+     * @return TaskStepResult，负数表示出错
+     */
+    int (*step)(TaskBase* task);
 } TaskInterface;
 
 /**
@@ -187,6 +255,7 @@ TaskState task_get_state(TaskBase* task);
 
 /**
  * 获取任务统计信息
+ * 返回的是正在被更新的统计，任务运行中读取请用task_stats_snapshot(task_stats.h)
  * @param task 任务基类指针
  * @return 统计信息指针
  */
@@ -0,0 +1,53 @@
+#ifndef TASK_LATENCY_H
+#define TASK_LATENCY_H
+
+#include "task_interface.h"
+#include "latency_histogram.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * 开始计时一次工作 - 在execute循环或step内成对调用:
+ *     uint64_t begin = task_latency_begin();
+ *     ...一次工作...
+ *     task_latency_end(task, begin);
+ * @return 起始时刻(CLOCK_MONOTONIC纳秒)
+ */
+uint64_t task_latency_begin(void);
+
+/**
+ * 结束计时并记入任务的直方图，首次调用时创建直方图
+ * 同一任务同一时刻只应有一个线程记录(独占线程或池化step均满足)
+ * @param task 任务基类指针
+ * @param begin task_latency_begin的返回值
+ */
+void task_latency_end(TaskBase* task, uint64_t begin);
+
+/**
+ * 直接记录一次耗时
+ * @param task 任务基类指针
+ * @param value_ns 耗时(纳秒)
+ */
+void task_latency_record(TaskBase* task, uint64_t value_ns);
+
+/**
+ * 复制任务的直方图 - 任务运行中也可调用
+ * @param task 任务基类指针
+ * @param histogram 副本(输出)
+ * @return 0成功，-1任务尚未记录过
+ */
+int task_latency_snapshot(TaskBase* task, LatencyHistogram* histogram);
+
+/**
+ * 释放任务的直方图 - 任务停止后、task_base_destroy之前调用，可重复调用
+ * @param task 任务基类指针
+ */
+void task_latency_release(TaskBase* task);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TASK_LATENCY_H
@@ -2,6 +2,17 @@
 #define TASK_MANAGER_H
 
 #include "task_interface.h"
+#include "task_index.h"
+#include "timer_wheel.h"
+#include "heartbeat_watchdog.h"
+#include "lifecycle_runner.h"
+#include "event_dispatcher.h"
+#include "task_accounting.h"
+#include "task_latency.h"
+#include "snapshot_cursor.h"
+#include "task_park.h"
+#include "task_arena.h"
+#include "task_stop.h"
 #include <sys/queue.h>
 #include <pthread.h>
 
@@ -18,11 +29,30 @@ typedef struct TaskNode {
     TAILQ_ENTRY(TaskNode) entries;     // 队列链接
 } TaskNode;
 
+/**
+ * 只读注册表视图 - 写者整体发布的不可变快照
+ * 读者在纪元临界区内无锁访问，被替换的旧视图在宽限期后释放
+ */
+typedef struct TaskRegistryView {
+    uint64_t generation;               // 发布代数
+    uint32_t count;                    // 任务数量
+    TaskNode* nodes;                   // 节点副本(仅task与name有效，保持链表顺序)
+    TaskIndex index;                   // 指向nodes的名称索引
+} TaskRegistryView;
+
 /**
  * 任务管理器
  */
 typedef struct TaskManager {
     TAILQ_HEAD(TaskList, TaskNode) task_list;  // 任务链表
+    TaskRegistryView* view;                    // 当前只读视图(原子发布)
+    struct TaskEpochDomain* view_epoch;        // 只读视图的纪元回收域
+    TimerService* timer_service;               // 周期调度定时服务(首次使用时创建)
+    TaskBase* maintenance;                     // 定时维护任务(未启动时为NULL)
+    TaskArena* arena;                          // 节点和任务对象分配区(首次使用时创建)
+    HeartbeatWatchdog* watchdog;               // 心跳看门狗(未启动时为NULL)
+    EventDispatcher* event_dispatcher;         // 异步事件分发器(未启用时为NULL，原子发布)
+    struct TaskEpochDomain* event_epoch;       // 事件投递的纪元回收域(替换分发器时等待正在投递的线程)
     pthread_mutex_t mutex;                     // 保护链表的互斥锁
     pthread_t monitor_thread;                  // 监控线程
     bool is_running;                           // 管理器运行状态
@@ -30,6 +60,17 @@ typedef struct TaskManager {
     uint32_t running_task_count;               // 运行中任务计数
 } TaskManager;
 
+/**
+ * 任务快照记录 - task_manager_snapshot的输出
+ */
+typedef struct {
+    char name[64];                     // 任务名称
+    TaskState state;                   // 当前状态
+    uint32_t restart_count;            // 已重启次数
+    uint64_t heartbeat_age;            // 距最后一次心跳的秒数(从未心跳为0)
+    TaskStats stats;                   // 统计信息(顺序锁一致副本)
+} TaskSnapshotRecord;
+
 /**
  * 任务管理器回调函数类型
  */
@@ -80,6 +121,15 @@ int task_manager_start_task(TaskManager* manager, const char* name);
  */
 int task_manager_stop_task(TaskManager* manager, const char* name);
 
+/**
+ * 限时停止指定任务 - 超过期限按选项升级，见task_stop.h
+ * @param manager 任务管理器指针
+ * @param name 任务名称
+ * @param options 选项(可为NULL，使用默认值)
+ * @return TaskStopOutcome，任务不存在或失败返回-1
+ */
+int task_manager_stop_task_timed(TaskManager* manager, const char* name, const TaskStopOptions* options);
+
 /**
  * 重启指定任务
  * @param manager 任务管理器指针
@@ -102,6 +152,90 @@ int task_manager_start_all(TaskManager* manager);
  */
 int task_manager_stop_all(TaskManager* manager);
 
+/**
+ * 并发启动所有任务
+ * @param manager 任务管理器指针
+ * @param options 期限和并发选项(可为NULL)
+ * @param report 每个任务的耗时报告(输出，可为NULL)
+ * @return 未成功启动的任务数量
+ */
+int task_manager_start_all_parallel(TaskManager* manager, const LifecycleOptions* options,
+                                    LifecycleReport* report);
+
+/**
+ * 并发停止所有任务
+ * 超过单个期限仍未停止的任务被升级: 池化任务再次唤醒，线程任务经task_notify
+ * 再次唤醒其停靠(task_park/task_sleep)
+ * @param manager 任务管理器指针
+ * @param options 期限和并发选项(可为NULL)
+ * @param report 每个任务的耗时报告(输出，可为NULL)
+ * @return 未成功停止的任务数量
+ */
+int task_manager_stop_all_parallel(TaskManager* manager, const LifecycleOptions* options,
+                                   LifecycleReport* report);
+
+/**
+ * 为任务追加一个依赖 - 写入任务配置的depends_on
+ * @param manager 任务管理器指针
+ * @param name 任务名称
+ * @param dependency 依赖的任务名称
+ * @return 0成功，非0失败(任务不存在或依赖已满)
+ */
+int task_manager_add_dependency(TaskManager* manager, const char* name, const char* dependency);
+
+/**
+ * 按依赖拓扑顺序并发启动所有任务
+ * 任务在其全部依赖进入RUNNING(实现了health_check的还须检查通过)后才启动，
+ * 互不依赖的任务并发启动；依赖失败、缺失或成环的任务不启动
+ * @param manager 任务管理器指针
+ * @param options 并发和就绪期限选项(可为NULL)
+ * @param report 每个任务的层次、耗时及关键路径(输出，可为NULL)，用startup_report_free释放
+ * @return 未就绪的任务数量，失败返回-1
+ */
+int task_manager_start_all_ordered(TaskManager* manager, const StartupOptions* options,
+                                   StartupReport* report);
+
+/**
+ * 设置任务的自动重启策略
+ * @param manager 任务管理器指针
+ * @param name 任务名称
+ * @param policy 重启策略，NULL恢复默认(窗口预算取config.max_restart_count)
+ * @return 0成功，非0失败
+ */
+int task_manager_set_restart_policy(TaskManager* manager, const char* name, const RestartPolicy* policy);
+
+/**
+ * 按重启策略处理自动重启 - 由定时维护(或监控线程)每个周期调用，取代失败后立即重启
+ * 对auto_restart且处于ERROR状态的任务按退避计划重启，计划到期前不重复重启；
+ * 窗口预算用尽的任务被标记为崩溃循环并推迟到窗口有余量；
+ * 稳定运行超过stable_ms的任务清零退避。重启统计写入TaskStats.restart
+ * @param manager 任务管理器指针
+ * @return 本次重启的任务数量，失败返回-1
+ */
+int task_manager_check_restarts(TaskManager* manager);
+
+/**
+ * 获取管理器的任务分配区 - 首次调用时创建
+ * 任务包装对象用*_create_in(config, arena)在其中分配，使监控扫描访问的内存连续
+ * @param manager 任务管理器指针
+ * @return 分配区指针，失败返回NULL
+ */
+TaskArena* task_manager_get_arena(TaskManager* manager);
+
+/**
+ * 从分配区的TaskNode块分配器中分配一个清零的节点 - 供注册使用
+ * @param manager 任务管理器指针
+ * @return 节点指针，失败返回NULL
+ */
+TaskNode* task_manager_alloc_node(TaskManager* manager);
+
+/**
+ * 归还节点 - 供注销和销毁管理器使用
+ * @param manager 任务管理器指针
+ * @param node 由task_manager_alloc_node分配的节点
+ */
+void task_manager_free_node(TaskManager* manager, TaskNode* node);
+
 /**
  * 获取任务指针
  * @param manager 任务管理器指针
@@ -110,6 +244,30 @@ int task_manager_stop_all(TaskManager* manager);
  */
 TaskBase* task_manager_get_task(TaskManager* manager, const char* name);
 
+/**
+ * 暂停任务 - 任务线程在下一次task_park/task_sleep时阻塞，直到恢复或停止
+ * @param manager 任务管理器指针
+ * @param name 任务名称
+ * @return 0成功，非0失败
+ */
+int task_manager_pause_task(TaskManager* manager, const char* name);
+
+/**
+ * 恢复暂停的任务
+ * @param manager 任务管理器指针
+ * @param name 任务名称
+ * @return 0成功，非0失败
+ */
+int task_manager_resume_task(TaskManager* manager, const char* name);
+
+/**
+ * 唤醒停靠在task_park中的任务线程
+ * @param manager 任务管理器指针
+ * @param name 任务名称
+ * @return 0成功，非0失败
+ */
+int task_manager_notify_task(TaskManager* manager, const char* name);
+
 /**
  * 获取任务状态
  * @param manager 任务管理器指针
@@ -120,12 +278,48 @@ TaskState task_manager_get_task_state(TaskManager* manager, const char* name);
 
 /**
  * 获取任务统计信息
+ * 返回的是任务内正在被更新的统计，任务运行中读取请用task_manager_read_task_stats
  * @param manager 任务管理器指针
  * @param name 任务名称
  * @return 统计信息指针，未找到返回NULL
  */
 const TaskStats* task_manager_get_task_stats(TaskManager* manager, const char* name);
 
+/**
+ * 发布新的只读视图 - 注册/注销后调用，调用者须持有manager->mutex
+ * 返回前等待旧视图的读者全部退出并释放旧视图，
+ * 因此注销返回后即可安全销毁任务对象
+ * 失败(内存不足)时旧视图保持发布，注销的调用者此时不得销毁任务对象
+ * @param manager 任务管理器指针
+ * @return 0成功，非0失败
+ */
+int task_manager_publish_view(TaskManager* manager);
+
+/**
+ * 释放只读视图及纪元域 - 销毁管理器时调用(调用者保证已无读者)
+ * @param manager 任务管理器指针
+ */
+void task_manager_release_view(TaskManager* manager);
+
+/**
+ * 无锁获取任务状态 - 读取已发布视图，不争用manager->mutex
+ * 尚未发布视图时退化为task_manager_get_task_state
+ * @param manager 任务管理器指针
+ * @param name 任务名称
+ * @return 任务状态，未找到返回TASK_STATE_UNKNOWN
+ */
+TaskState task_manager_read_task_state(TaskManager* manager, const char* name);
+
+/**
+ * 无锁复制任务统计信息 - 读取已发布视图，不争用manager->mutex；
+ * 经由顺序锁复制，不阻塞任务线程的更新，也不会读到更新到一半的统计
+ * @param manager 任务管理器指针
+ * @param name 任务名称
+ * @param stats 统计信息(输出)
+ * @return 0成功，-1未找到
+ */
+int task_manager_read_task_stats(TaskManager* manager, const char* name, TaskStats* stats);
+
 /**
  * 列出所有任务
  * @param manager 任务管理器指针
@@ -136,7 +330,20 @@ const TaskStats* task_manager_get_task_stats(TaskManager* manager, const char* n
 int task_manager_list_tasks(TaskManager* manager, char names[][64], int max_count);
 
 /**
- * 启动任务监控
+ * 批量获取任务快照 - 一次调用填充一页记录，替代逐个名称查询状态和统计
+ * 已发布只读视图时整页来自同一视图且不加锁，否则只获取一次manager->mutex
+ * @param manager 任务管理器指针
+ * @param records 记录数组(输出)
+ * @param capacity 数组容量
+ * @param cursor 分页游标(输入输出)
+ * @return 本页记录数，失败返回-1
+ */
+int task_manager_snapshot(TaskManager* manager, TaskSnapshotRecord* records, uint32_t capacity,
+                          SnapshotCursor* cursor);
+
+/**
+ * 启动任务监控 - 按周期扫描所有任务心跳并处理重启的轮询线程；
+ * 心跳检测改用task_manager_start_watchdog，重启和记账改用task_manager_start_maintenance
  * @param manager 任务管理器指针
  * @return 0成功，非0失败
  */
@@ -156,6 +363,155 @@ void task_manager_stop_monitor(TaskManager* manager);
  */
 void task_manager_set_event_callback(TaskManager* manager, TaskEventCallback callback, void* user_data);
 
+/**
+ * 设置异步事件回调 - 状态变化写入无锁环形队列，由分发线程按顺序交付，
+ * 回调再慢也不会阻塞触发状态变化的线程；重复调用会替换之前的分发器
+ * @param manager 任务管理器指针
+ * @param config 分发器配置(回调、容量、批大小、是否合并)
+ * @return 0成功，非0失败
+ */
+int task_manager_set_async_event_callback(TaskManager* manager, const EventDispatcherConfig* config);
+
+/**
+ * 获取异步事件分发统计信息
+ * @param manager 任务管理器指针
+ * @param stats 统计信息(输出)
+ * @return 0成功，-1未启用异步回调
+ */
+int task_manager_get_event_stats(TaskManager* manager, EventDispatcherStats* stats);
+
+/**
+ * 停止异步事件分发 - 交付剩余事件后销毁分发器，在停止所有任务之后、销毁管理器之前调用
+ * @param manager 任务管理器指针
+ */
+void task_manager_release_events(TaskManager* manager);
+
+/**
+ * 周期调度任务 - 由定时服务按固定间隔唤醒任务的step，不占用独立线程
+ * 任务须实现step并在每次工作完成后返回TASK_STEP_WAIT；
+ * 未运行的任务会以池化模式提交到默认执行器并立即执行一次
+ * @param manager 任务管理器指针
+ * @param name 任务名称
+ * @param interval_ms 调度间隔(毫秒)
+ * @return 0成功，非0失败
+ */
+int task_manager_schedule_periodic(TaskManager* manager, const char* name, uint32_t interval_ms);
+
+/**
+ * 取消周期调度(不停止任务)
+ * @param manager 任务管理器指针
+ * @param name 任务名称
+ * @return 0成功，非0失败
+ */
+int task_manager_cancel_periodic(TaskManager* manager, const char* name);
+
+/**
+ * 取消并释放任务的周期调度定时器 - 注销任务时调用，调用者须持有manager->mutex
+ * 返回后定时线程不再持有该任务指针，任务对象可以销毁
+ * @param manager 任务管理器指针
+ * @param task 任务指针
+ */
+void task_manager_detach_periodic(TaskManager* manager, TaskBase* task);
+
+/**
+ * 获取周期调度统计信息
+ * @param manager 任务管理器指针
+ * @param stats 统计信息(输出)
+ * @return 0成功，-1定时服务未启动
+ */
+int task_manager_get_timer_stats(TaskManager* manager, TimerServiceStats* stats);
+
+/**
+ * 启动定时维护 - 定时服务按周期唤醒一个池化任务，执行task_manager_check_restarts
+ * 和task_manager_sample_accounting；与心跳看门狗一起取代task_manager_start_monitor:
+ * 不占用独立线程，也不扫描心跳
+ * @param manager 任务管理器指针
+ * @param interval_ms 维护周期(毫秒)
+ * @param accounting_flags 每周期采样的TASK_ACCOUNTING_*组合，0不采样
+ * @return 0成功，非0失败(已启动也返回失败)
+ */
+int task_manager_start_maintenance(TaskManager* manager, uint32_t interval_ms, uint32_t accounting_flags);
+
+/**
+ * 停止定时维护 - 等待进行中的一次维护结束，不得在管理器锁内调用
+ * @param manager 任务管理器指针
+ */
+void task_manager_stop_maintenance(TaskManager* manager);
+
+/**
+ * 停止定时服务 - 销毁管理器时调用，先取消并释放所有已注册任务的定时器
+ * @param manager 任务管理器指针
+ */
+void task_manager_release_timers(TaskManager* manager);
+
+/**
+ * 启动心跳看门狗 - 监视当前所有任务，取代按周期扫描的心跳检查
+ * 之后注册的任务需通过task_manager_watch_task加入
+ * @param manager 任务管理器指针
+ * @param callback 心跳超时回调(在看门狗线程上调用)
+ * @param user_data 用户数据
+ * @return 0成功，非0失败
+ */
+int task_manager_start_watchdog(TaskManager* manager, HeartbeatMissCallback callback, void* user_data);
+
+/**
+ * 停止心跳看门狗 - 销毁管理器前调用
+ * @param manager 任务管理器指针
+ */
+void task_manager_stop_watchdog(TaskManager* manager);
+
+/**
+ * 将任务加入心跳看门狗
+ * @param manager 任务管理器指针
+ * @param name 任务名称
+ * @return 0成功，非0失败(看门狗未启动或任务不存在)
+ */
+int task_manager_watch_task(TaskManager* manager, const char* name);
+
+/**
+ * 将任务移出心跳看门狗 - 注销任务前调用
+ * @param manager 任务管理器指针
+ * @param name 任务名称
+ * @return 0成功，非0失败
+ */
+int task_manager_unwatch_task(TaskManager* manager, const char* name);
+
+/**
+ * 获取心跳看门狗统计信息
+ * @param manager 任务管理器指针
+ * @param stats 统计信息(输出)
+ * @return 0成功，-1看门狗未启动
+ */
+int task_manager_get_watchdog_stats(TaskManager* manager, HeartbeatWatchdogStats* stats);
+
+/**
+ * 批量采样所有任务的CPU时间、CPU使用率和缺页次数 - 由监控线程按周期调用
+ * 已发布只读视图时不持有管理器锁；TASK_ACCOUNTING_PROC每个任务多读一次/proc，
+ * 任务很多时可降低其频率，只用TASK_ACCOUNTING_CPU高频采样
+ * @param manager 任务管理器指针
+ * @param flags TASK_ACCOUNTING_*组合
+ * @param summary 采样结果(输出，可为NULL)
+ * @return 0成功，非0失败
+ */
+int task_manager_sample_accounting(TaskManager* manager, uint32_t flags, TaskAccountingSummary* summary);
+
+/**
+ * 获取任务单次工作耗时直方图的副本 - 不需要停止任务
+ * @param manager 任务管理器指针
+ * @param name 任务名称
+ * @param histogram 副本(输出)，用latency_histogram_summarize得到p50/p99/p999
+ * @return 0成功，-1任务不存在或尚未记录过
+ */
+int task_manager_get_task_latency(TaskManager* manager, const char* name, LatencyHistogram* histogram);
+
+/**
+ * 合并所有任务的耗时直方图
+ * @param manager 任务管理器指针
+ * @param histogram 合并结果(输出)
+ * @return 参与合并的任务数，失败返回-1
+ */
+int task_manager_merge_latency(TaskManager* manager, LatencyHistogram* histogram);
+
 /**
  * 执行任务健康检查
  * @param manager 任务管理器指针
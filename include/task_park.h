@@ -0,0 +1,78 @@
+#ifndef TASK_PARK_H
+#define TASK_PARK_H
+
+#include "task_interface.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 无限期停靠
+#define TASK_PARK_FOREVER UINT32_MAX
+
+/**
+ * 停靠返回原因
+ */
+typedef enum {
+    TASK_PARK_NOTIFIED = 0,     // 被task_notify或task_resume唤醒
+    TASK_PARK_TIMEOUT,          // 等待时间已到
+    TASK_PARK_STOPPED           // 任务被要求停止
+} TaskParkResult;
+
+/**
+ * 停靠任务线程 - 基于futex阻塞，取代sleep轮询task_should_stop
+ * 任务被停止、通知或恢复时立即返回；暂停期间不会因超时返回，直到恢复或停止
+ * 通知像许可一样保留：停靠前已到达的通知会使下一次停靠立即返回
+ * 只能在任务自己的线程上调用，池化任务的step中不得调用
+ * @param task 任务基类指针
+ * @param timeout_ms 最长等待时间(毫秒)，TASK_PARK_FOREVER不限
+ * @return TaskParkResult
+ */
+TaskParkResult task_park(TaskBase* task, uint32_t timeout_ms);
+
+/**
+ * 可中断的休眠 - 忽略普通通知，睡满时长或任务被停止时返回；暂停的时长不计入，恢复后继续睡完剩余部分
+ * @param task 任务基类指针
+ * @param duration_ms 休眠时长(毫秒)
+ * @return TASK_PARK_TIMEOUT睡满，TASK_PARK_STOPPED被停止
+ */
+TaskParkResult task_sleep(TaskBase* task, uint32_t duration_ms);
+
+/**
+ * 唤醒停靠中的任务线程(任意线程可调用)
+ * @param task 任务基类指针
+ */
+void task_notify(TaskBase* task);
+
+/**
+ * 设置停止标志并唤醒停靠中的任务线程 - task_stop应以此代替直接设置should_stop
+ * @param task 任务基类指针
+ */
+void task_request_stop(TaskBase* task);
+
+/**
+ * 暂停任务 - 调用虚函数pause后置暂停标志，任务线程下一次停靠时阻塞
+ * @param task 任务基类指针
+ * @return 0成功，非0失败(pause返回错误)
+ */
+int task_pause(TaskBase* task);
+
+/**
+ * 恢复任务 - 清除暂停标志、调用虚函数resume并唤醒任务线程
+ * @param task 任务基类指针
+ * @return 0成功，非0失败
+ */
+int task_resume(TaskBase* task);
+
+/**
+ * 检查任务是否处于暂停状态
+ * @param task 任务基类指针
+ * @return true已暂停
+ */
+bool task_is_paused(TaskBase* task);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TASK_PARK_H
@@ -0,0 +1,65 @@
+#ifndef TASK_SCHED_H
+#define TASK_SCHED_H
+
+#include "task_interface.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * 线程调度类 - TaskPriority映射到内核调度策略的结果
+ */
+typedef enum {
+    TASK_SCHED_DEFAULT = 0,     // 未应用(保持继承的策略)
+    TASK_SCHED_IDLE,            // SCHED_IDLE，仅在CPU空闲时运行
+    TASK_SCHED_NORMAL,          // SCHED_OTHER，nice 0
+    TASK_SCHED_BOOSTED,         // SCHED_OTHER，负nice值
+    TASK_SCHED_REALTIME         // SCHED_FIFO
+} TaskSchedClass;
+
+// CRITICAL任务使用的SCHED_FIFO优先级，保持较低以免压过内核线程
+#define TASK_SCHED_FIFO_PRIORITY 10
+
+// 无实时权限时HIGH/CRITICAL使用的nice值
+#define TASK_SCHED_HIGH_NICE (-5)
+#define TASK_SCHED_CRITICAL_NICE (-10)
+
+/**
+ * 将优先级应用到调用线程
+ * LOW -> SCHED_IDLE；NORMAL -> SCHED_OTHER nice 0；
+ * HIGH -> nice -5；CRITICAL -> SCHED_FIFO，无权限时依次降级为nice -10、nice 0
+ * @param priority 任务优先级
+ * @return 实际生效的调度类
+ */
+TaskSchedClass task_sched_apply_current(TaskPriority priority);
+
+/**
+ * 按任务配置的优先级设置调用线程的调度策略，并记录到task->sched_class；
+ * 同时把调用线程实际的CPU亲和性记录到stats.cpu_affinity，并记录tid供资源采样使用
+ * task_start的线程入口在调用initialize前调用
+ * @param task 任务基类指针
+ * @return 实际生效的调度类
+ */
+TaskSchedClass task_sched_apply(TaskBase* task);
+
+/**
+ * 按任务的放置配置设置线程属性的CPU亲和性 - task_start在pthread_create前调用
+ * @param task 任务基类指针
+ * @param attr 线程属性
+ * @return 0成功，1无需绑定，-1失败
+ */
+int task_sched_init_attr(TaskBase* task, pthread_attr_t* attr);
+
+/**
+ * 获取调度类名称
+ * @param sched_class 调度类
+ * @return 名称字符串
+ */
+const char* task_sched_class_name(TaskSchedClass sched_class);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TASK_SCHED_H
@@ -0,0 +1,50 @@
+#ifndef TASK_STATS_H
+#define TASK_STATS_H
+
+#include "task_interface.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * 开始修改任务统计信息 - 获取task->mutex并进入顺序锁写区
+ * 修改task->stats的代码都应放在task_stats_write_begin/task_stats_write_end之间，
+ * 读者才能通过task_stats_snapshot无锁得到一致的副本
+ * 已持有task->mutex时改用task_stats_write_begin_locked
+ * @param task 任务基类指针
+ */
+void task_stats_write_begin(TaskBase* task);
+
+/**
+ * 结束修改任务统计信息并释放task->mutex
+ * @param task 任务基类指针
+ */
+void task_stats_write_end(TaskBase* task);
+
+/**
+ * 在已持有task->mutex时进入顺序锁写区
+ * @param task 任务基类指针
+ */
+void task_stats_write_begin_locked(TaskBase* task);
+
+/**
+ * 离开顺序锁写区(不释放task->mutex)
+ * @param task 任务基类指针
+ */
+void task_stats_write_end_locked(TaskBase* task);
+
+/**
+ * 复制任务统计信息 - 不加锁，不阻塞写者，保证副本是某次写入完成后的完整状态
+ * 替代直接读取task_get_stats返回的指针
+ * @param task 任务基类指针
+ * @param stats 副本(输出)
+ * @return 0成功，-1参数错误
+ */
+int task_stats_snapshot(const TaskBase* task, TaskStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TASK_STATS_H
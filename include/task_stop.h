@@ -0,0 +1,105 @@
+#ifndef TASK_STOP_H
+#define TASK_STOP_H
+
+#include "task_interface.h"
+#include "latency_histogram.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 默认协作停止期限
+#define TASK_STOP_DEFAULT_TIMEOUT_MS 5000
+
+// 默认每级升级后的宽限期
+#define TASK_STOP_DEFAULT_GRACE_MS 200
+
+/**
+ * 期限到后仍未退出时的最终处理
+ */
+typedef enum {
+    TASK_STOP_ESCALATE_DETACH = 0,  // 分离线程，任由其在后台结束
+    TASK_STOP_ESCALATE_CANCEL       // 先pthread_cancel(在取消点退出并展开栈)，宽限期后仍未退出再分离
+} TaskStopEscalation;
+
+// 取消只对为此编写的任务安全: 线程可能在任何取消点(pthread_cond_wait、sleep、read等)退出，
+// C代码须用pthread_cleanup_push释放跨取消点持有的锁(pthread_cond_wait返回时已重新加锁)，
+// C++代码依靠栈展开析构，不得用catch(...)吞掉展开，展开的栈帧上也不得有可join的std::thread；
+// 否则锁会永远保持锁定或进程终止。其他任务应使用默认的TASK_STOP_ESCALATE_DETACH
+
+/**
+ * 限时停止选项 - 字段为0时使用默认值
+ * 升级顺序: 协作停止(停止标志+唤醒停靠) -> 再次唤醒(中断回调) -> 取消 -> 分离
+ * 不使用信号: 只有停靠在task_park/task_sleep(或插件自己的条件变量)中的线程能被唤醒，
+ * 阻塞在其他系统调用中的线程只能等它返回，或取消/分离
+ */
+typedef struct {
+    uint32_t timeout_ms;            // 协作停止期限
+    uint32_t grace_ms;              // 每级升级后等待线程退出的时长
+    TaskStopEscalation escalation;  // 最终处理
+} TaskStopOptions;
+
+/**
+ * 限时停止结果
+ */
+typedef enum {
+    TASK_STOP_CLEAN = 0,        // 期限内协作停止
+    TASK_STOP_INTERRUPTED,      // 再次唤醒后在宽限期内停止
+    TASK_STOP_CANCELLED,        // 线程被取消(标记ERROR)
+    TASK_STOP_DETACHED          // 放弃等待: 线程被分离或池化任务的step仍未返回(标记ERROR)
+} TaskStopOutcome;
+
+/**
+ * 限时停止任务 - 调用者最多阻塞timeout_ms加上各级宽限期
+ * 耗时记入TaskStats.stop_time_ns和进程级停止耗时直方图；
+ * 结果为CANCELLED/DETACHED时任务标记为ERROR并置stop_abandoned，自动重启不会重启这类任务；
+ * 被分离的线程仍可能访问任务对象，在它退出前不得销毁任务
+ * @param task 任务基类指针
+ * @param options 选项(可为NULL，使用默认值)
+ * @return TaskStopOutcome，失败返回-1
+ */
+int task_stop_timed(TaskBase* task, const TaskStopOptions* options);
+
+/**
+ * 中断回调 - 协作期限到后调用一次，再次唤醒线程正在等待的停靠点或条件变量
+ * @param context 调用者上下文
+ */
+typedef void (*TaskStopInterrupt)(void* context);
+
+/**
+ * 按升级顺序等待线程退出 - 调用前应已通知线程停止
+ * 供进程管理器等自行持有线程的模块复用
+ * @param thread 目标线程(可join)
+ * @param options 选项(可为NULL，使用默认值)
+ * @param start_ns 发出停止请求的单调时刻，协作期限从此起算
+ * @param interrupt 中断回调(可为NULL)
+ * @param context 中断回调的上下文
+ * @return TaskStopOutcome；DETACHED时线程已被分离
+ */
+TaskStopOutcome task_stop_join_thread(pthread_t thread, const TaskStopOptions* options, uint64_t start_ns,
+                                      TaskStopInterrupt interrupt, void* context);
+
+/**
+ * 记录一次停止耗时到进程级直方图
+ * @param elapsed_ns 停止耗时(纳秒)
+ */
+void task_stop_record(uint64_t elapsed_ns);
+
+/**
+ * 复制进程级停止耗时直方图 - 包含任务和插件进程的限时停止
+ * @param histogram 副本(输出)
+ */
+void task_stop_latency_snapshot(LatencyHistogram* histogram);
+
+/**
+ * 获取结果名称
+ * @param outcome 结果
+ * @return 名称字符串
+ */
+const char* task_stop_outcome_name(TaskStopOutcome outcome);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TASK_STOP_H
@@ -0,0 +1,165 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 时间轮层级: 第0层256槽(1 tick/槽)，其余每层64槽，共覆盖2^32个tick
+#define TIMER_WHEEL_LEVELS 5
+#define TIMER_WHEEL_L0_BITS 8
+#define TIMER_WHEEL_LN_BITS 6
+#define TIMER_WHEEL_L0_SIZE (1 << TIMER_WHEEL_L0_BITS)
+#define TIMER_WHEEL_LN_SIZE (1 << TIMER_WHEEL_LN_BITS)
+
+struct TimerWheelTimer;
+
+/**
+ * 槽位链表头
+ */
+typedef struct TimerWheelSlot {
+    struct TimerWheelTimer* head;
+} TimerWheelSlot;
+
+/**
+ * 定时器回调函数类型
+ * @param timer 到期的定时器
+ * @param user_data 用户数据
+ */
+typedef void (*TimerWheelCallback)(struct TimerWheelTimer* timer, void* user_data);
+
+/**
+ * 定时器 - 侵入式双向链表节点，由调用者分配
+ */
+typedef struct TimerWheelTimer {
+    struct TimerWheelTimer* prev;
+    struct TimerWheelTimer* next;
+    TimerWheelSlot* slot;              // 所在槽位
+    uint64_t expires;                  // 到期tick
+    uint64_t interval;                 // 周期(tick)，0为一次性
+    TimerWheelCallback callback;       // 到期回调
+    void* user_data;                   // 用户数据
+    bool armed;                        // 是否已挂入时间轮
+} TimerWheelTimer;
+
+/**
+ * 分层时间轮 - 插入/删除O(1)，到期按tick推进并逐层级联
+ * 不带锁，由调用者保护
+ */
+typedef struct TimerWheel {
+    uint64_t current_tick;             // 已处理到的tick
+    uint32_t count;                    // 已挂入的定时器数量
+    TimerWheelSlot level0[TIMER_WHEEL_L0_SIZE];
+    TimerWheelSlot levels[TIMER_WHEEL_LEVELS - 1][TIMER_WHEEL_LN_SIZE];
+} TimerWheel;
+
+/**
+ * 初始化时间轮
+ * @param wheel 时间轮指针
+ * @param start_tick 起始tick
+ */
+void timer_wheel_init(TimerWheel* wheel, uint64_t start_tick);
+
+/**
+ * 挂入定时器(已挂入的会先摘除)
+ * @param wheel 时间轮指针
+ * @param timer 定时器(callback/user_data/interval需预先设置)
+ * @param expires 到期tick，不晚于当前tick时在下一个tick到期
+ */
+void timer_wheel_add(TimerWheel* wheel, TimerWheelTimer* timer, uint64_t expires);
+
+/**
+ * 摘除定时器
+ * @param wheel 时间轮指针
+ * @param timer 定时器
+ */
+void timer_wheel_cancel(TimerWheel* wheel, TimerWheelTimer* timer);
+
+/**
+ * 推进时间轮到指定tick，依次触发到期定时器，周期定时器按原节拍重新挂入
+ * @param wheel 时间轮指针
+ * @param now_tick 当前tick
+ * @return 触发的定时器数量
+ */
+uint32_t timer_wheel_advance(TimerWheel* wheel, uint64_t now_tick);
+
+/**
+ * 获取下一次需要推进的tick(可能是级联点而非实际到期点)
+ * @param wheel 时间轮指针
+ * @return tick，没有定时器时返回UINT64_MAX
+ */
+uint64_t timer_wheel_next_tick(const TimerWheel* wheel);
+
+/**
+ * 定时服务统计信息
+ */
+typedef struct {
+    uint32_t armed_timers;             // 当前挂入的定时器数量
+    uint64_t fired;                    // 累计触发次数
+    uint64_t max_lateness_ns;          // 最大触发延迟
+    uint64_t total_lateness_ns;        // 累计触发延迟
+    uint64_t wakeups;                  // 定时线程唤醒次数
+} TimerServiceStats;
+
+/**
+ * 定时服务 - 单个定时线程驱动的毫秒级时间轮
+ * 回调在定时线程上、持有服务锁时执行，必须短小且不得调用定时服务接口
+ */
+typedef struct TimerService {
+    TimerWheel wheel;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    pthread_t thread;
+    bool running;
+    uint64_t base_ns;                  // tick 0对应的单调时钟
+    TimerServiceStats stats;
+} TimerService;
+
+/**
+ * 创建定时服务并启动定时线程
+ * @return 定时服务指针，失败返回NULL
+ */
+TimerService* timer_service_create(void);
+
+/**
+ * 停止定时线程并销毁定时服务(不释放定时器本身)
+ * @param service 定时服务指针
+ */
+void timer_service_destroy(TimerService* service);
+
+/**
+ * 启动定时器
+ * @param service 定时服务指针
+ * @param timer 定时器
+ * @param delay_ms 首次到期延迟(毫秒)
+ * @param interval_ms 周期(毫秒)，0为一次性
+ * @param callback 到期回调
+ * @param user_data 用户数据
+ */
+void timer_service_arm(TimerService* service, TimerWheelTimer* timer,
+                       uint32_t delay_ms, uint32_t interval_ms,
+                       TimerWheelCallback callback, void* user_data);
+
+/**
+ * 取消定时器 - 返回后回调不会再执行
+ * @param service 定时服务指针
+ * @param timer 定时器
+ */
+void timer_service_cancel(TimerService* service, TimerWheelTimer* timer);
+
+/**
+ * 获取定时服务统计信息
+ * @param service 定时服务指针
+ * @param stats 统计信息(输出)
+ */
+void timer_service_get_stats(TimerService* service, TimerServiceStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TIMER_WHEEL_H
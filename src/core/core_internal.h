@@ -0,0 +1,43 @@
+#ifndef CORE_INTERNAL_H
+#define CORE_INTERNAL_H
+
+#include "process_manager.h"
+#include "task_epoch.h"
+#include <stdint.h>
+#include <time.h>
+
+/*
+ * 核心模块内部共用的辅助函数 - 不安装，插件不可见
+ */
+
+/**
+ * 获取单调时钟(纳秒)
+ */
+static inline uint64_t get_monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/**
+ * 按名称查找进程节点(调用者持有manager->mutex)
+ * @param manager 进程管理器
+ * @param name 进程名称
+ * @return 节点，不存在返回NULL
+ */
+ProcessNode* process_find_node_locked(ProcessManager* manager, const char* name);
+
+/**
+ * 进入插件接口读临界区 - 须在持锁取得node->interface之前进入，锁外的插件调用全部返回后退出
+ * 热重载和空闲卸载在释放换出的实例前等待临界区内的读者退出
+ * @return 读临界区令牌
+ */
+TaskEpochGuard process_interface_enter(void);
+
+/**
+ * 退出插件接口读临界区
+ * @param guard process_interface_enter返回的令牌
+ */
+void process_interface_exit(TaskEpochGuard guard);
+
+#endif // CORE_INTERNAL_H
@@ -0,0 +1,378 @@
+#define _GNU_SOURCE
+#include "cpu_affinity.h"
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+/**
+ * CPU拓扑项
+ */
+typedef struct {
+    int cpu;
+    int package_id;             // 物理插槽
+    int core_id;                // 插槽内的物理核
+    int thread_index;           // 在同一物理核的超线程中的序号
+} CpuTopologyEntry;
+
+/**
+ * 按策略排好序的CPU序列(进程启动后拓扑不变，只读取一次)
+ */
+typedef struct {
+    int compact[CPU_AFFINITY_MAX_CPUS];
+    int spread[CPU_AFFINITY_MAX_CPUS];
+    int isolated[CPU_AFFINITY_MAX_CPUS];
+    uint32_t count;
+    uint32_t isolated_count;
+} CpuPlacementOrder;
+
+static CpuPlacementOrder g_order;
+static pthread_once_t g_order_once = PTHREAD_ONCE_INIT;
+
+// 各策略下一次分配的位置
+static uint32_t g_spread_next = 0;
+static uint32_t g_compact_next = 0;
+static uint32_t g_isolated_next = 0;
+
+// ============================================================================
+// CPU集合
+// ============================================================================
+
+static void mask_set(CpuMask* mask, int cpu) {
+    mask->bits[cpu / 64] |= 1ULL << (cpu % 64);
+}
+
+static bool mask_isset(const CpuMask* mask, int cpu) {
+    return (mask->bits[cpu / 64] >> (cpu % 64)) & 1;
+}
+
+int cpu_mask_parse(const char* list, CpuMask* mask) {
+    if (!list || !mask) {
+        return -1;
+    }
+
+    memset(mask, 0, sizeof(CpuMask));
+    const char* p = list;
+
+    while (*p) {
+        while (isspace((unsigned char)*p) || *p == ',') {
+            p++;
+        }
+        if (!*p) {
+            break;
+        }
+
+        char* end;
+        long first = strtol(p, &end, 10);
+        if (end == p) {
+            return -1;
+        }
+        long last = first;
+        p = end;
+        if (*p == '-') {
+            p++;
+            last = strtol(p, &end, 10);
+            if (end == p) {
+                return -1;
+            }
+            p = end;
+        }
+
+        if (first < 0 || last < first || last >= CPU_AFFINITY_MAX_CPUS) {
+            return -1;
+        }
+        for (long cpu = first; cpu <= last; cpu++) {
+            mask_set(mask, (int)cpu);
+        }
+
+        while (isspace((unsigned char)*p)) {
+            p++;
+        }
+        if (*p && *p != ',') {
+            return -1;
+        }
+    }
+
+    return cpu_mask_count(mask) > 0 ? 0 : -1;
+}
+
+int cpu_mask_format(const CpuMask* mask, char* buffer, size_t size) {
+    if (!mask || !buffer || size == 0) {
+        return 0;
+    }
+
+    buffer[0] = '\0';
+    size_t written = 0;
+
+    for (int cpu = 0; cpu < CPU_AFFINITY_MAX_CPUS; cpu++) {
+        if (!mask_isset(mask, cpu)) {
+            continue;
+        }
+        int last = cpu;
+        while (last + 1 < CPU_AFFINITY_MAX_CPUS && mask_isset(mask, last + 1)) {
+            last++;
+        }
+
+        int n = last > cpu
+            ? snprintf(buffer + written, size - written, "%s%d-%d", written ? "," : "", cpu, last)
+            : snprintf(buffer + written, size - written, "%s%d", written ? "," : "", cpu);
+        if (n < 0 || (size_t)n >= size - written) {
+            break; // 缓冲区不足，保留已写入的部分
+        }
+        written += n;
+        cpu = last;
+    }
+
+    return (int)written;
+}
+
+uint32_t cpu_mask_count(const CpuMask* mask) {
+    uint32_t count = 0;
+    for (size_t i = 0; i < sizeof(mask->bits) / sizeof(mask->bits[0]); i++) {
+        count += (uint32_t)__builtin_popcountll(mask->bits[i]);
+    }
+    return count;
+}
+
+static void mask_to_cpuset(const CpuMask* mask, cpu_set_t* set) {
+    CPU_ZERO(set);
+    for (int cpu = 0; cpu < CPU_AFFINITY_MAX_CPUS && cpu < CPU_SETSIZE; cpu++) {
+        if (mask_isset(mask, cpu)) {
+            CPU_SET(cpu, set);
+        }
+    }
+}
+
+static void cpuset_to_mask(const cpu_set_t* set, CpuMask* mask) {
+    memset(mask, 0, sizeof(CpuMask));
+    for (int cpu = 0; cpu < CPU_AFFINITY_MAX_CPUS && cpu < CPU_SETSIZE; cpu++) {
+        if (CPU_ISSET(cpu, set)) {
+            mask_set(mask, cpu);
+        }
+    }
+}
+
+// ============================================================================
+// 拓扑
+// ============================================================================
+
+static int read_topology_value(int cpu, const char* field) {
+    char path[128];
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/%s", cpu, field);
+
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        return -1;
+    }
+    int value = -1;
+    if (fscanf(file, "%d", &value) != 1) {
+        value = -1;
+    }
+    fclose(file);
+    return value;
+}
+
+static int compare_compact(const void* a, const void* b) {
+    const CpuTopologyEntry* x = a;
+    const CpuTopologyEntry* y = b;
+    if (x->package_id != y->package_id) return x->package_id - y->package_id;
+    if (x->core_id != y->core_id) return x->core_id - y->core_id;
+    return x->cpu - y->cpu;
+}
+
+static int compare_spread(const void* a, const void* b) {
+    const CpuTopologyEntry* x = a;
+    const CpuTopologyEntry* y = b;
+    if (x->thread_index != y->thread_index) return x->thread_index - y->thread_index;
+    if (x->core_id != y->core_id) return x->core_id - y->core_id;
+    if (x->package_id != y->package_id) return x->package_id - y->package_id;
+    return x->cpu - y->cpu;
+}
+
+static void load_placement_order(void) {
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        return;
+    }
+
+    CpuTopologyEntry* entries = calloc(CPU_AFFINITY_MAX_CPUS, sizeof(CpuTopologyEntry));
+    if (!entries) {
+        return;
+    }
+
+    uint32_t count = 0;
+    for (int cpu = 0; cpu < CPU_AFFINITY_MAX_CPUS && cpu < CPU_SETSIZE; cpu++) {
+        if (!CPU_ISSET(cpu, &allowed)) {
+            continue;
+        }
+        CpuTopologyEntry* entry = &entries[count++];
+        entry->cpu = cpu;
+        entry->package_id = read_topology_value(cpu, "physical_package_id");
+        entry->core_id = read_topology_value(cpu, "core_id");
+        if (entry->core_id < 0) {
+            entry->core_id = cpu; // 无拓扑信息时每个CPU视为独立的物理核
+        }
+    }
+
+    // 先按紧凑顺序排列，同一物理核的超线程相邻，据此编号
+    qsort(entries, count, sizeof(CpuTopologyEntry), compare_compact);
+    for (uint32_t i = 0; i < count; i++) {
+        bool same_core = i > 0 && entries[i].package_id == entries[i - 1].package_id &&
+                         entries[i].core_id == entries[i - 1].core_id;
+        entries[i].thread_index = same_core ? entries[i - 1].thread_index + 1 : 0;
+        g_order.compact[i] = entries[i].cpu;
+    }
+
+    qsort(entries, count, sizeof(CpuTopologyEntry), compare_spread);
+    for (uint32_t i = 0; i < count; i++) {
+        g_order.spread[i] = entries[i].cpu;
+    }
+    g_order.count = count;
+    free(entries);
+
+    // isolcpus隔离的CPU不在默认亲和性中，单独读取
+    FILE* file = fopen("/sys/devices/system/cpu/isolated", "r");
+    if (file) {
+        char line[256];
+        CpuMask isolated;
+        if (fgets(line, sizeof(line), file) && cpu_mask_parse(line, &isolated) == 0) {
+            for (int cpu = 0; cpu < CPU_AFFINITY_MAX_CPUS; cpu++) {
+                if (mask_isset(&isolated, cpu)) {
+                    g_order.isolated[g_order.isolated_count++] = cpu;
+                }
+            }
+        }
+        fclose(file);
+    }
+}
+
+// ============================================================================
+// 放置
+// ============================================================================
+
+CpuPlacementPolicy cpu_placement_policy_from_name(const char* name) {
+    if (!name) {
+        return CPU_PLACEMENT_NONE;
+    }
+    if (strcmp(name, "explicit") == 0) return CPU_PLACEMENT_EXPLICIT;
+    if (strcmp(name, "spread") == 0) return CPU_PLACEMENT_SPREAD;
+    if (strcmp(name, "compact") == 0) return CPU_PLACEMENT_COMPACT;
+    if (strcmp(name, "isolated") == 0) return CPU_PLACEMENT_ISOLATED;
+    return CPU_PLACEMENT_NONE;
+}
+
+const char* cpu_placement_policy_name(CpuPlacementPolicy policy) {
+    switch (policy) {
+        case CPU_PLACEMENT_EXPLICIT: return "explicit";
+        case CPU_PLACEMENT_SPREAD:   return "spread";
+        case CPU_PLACEMENT_COMPACT:  return "compact";
+        case CPU_PLACEMENT_ISOLATED: return "isolated";
+        default:                     return "none";
+    }
+}
+
+/**
+ * 从排好序的CPU序列中依次取cpu_count个
+ */
+static int take_from_order(const int* order, uint32_t order_count, uint32_t* next,
+                           uint32_t cpu_count, CpuMask* mask) {
+    if (order_count == 0) {
+        return -1;
+    }
+    if (cpu_count == 0) {
+        cpu_count = 1;
+    }
+    if (cpu_count > order_count) {
+        cpu_count = order_count;
+    }
+
+    uint32_t start = __atomic_fetch_add(next, cpu_count, __ATOMIC_RELAXED);
+    memset(mask, 0, sizeof(CpuMask));
+    for (uint32_t i = 0; i < cpu_count; i++) {
+        mask_set(mask, order[(start + i) % order_count]);
+    }
+    return 0;
+}
+
+int cpu_placement_resolve(const CpuPlacement* placement, CpuMask* mask) {
+    if (!placement || !mask) {
+        return -1;
+    }
+
+    pthread_once(&g_order_once, load_placement_order);
+
+    switch (placement->policy) {
+        case CPU_PLACEMENT_NONE:
+            return 1;
+        case CPU_PLACEMENT_EXPLICIT:
+            return cpu_mask_parse(placement->cpus, mask);
+        case CPU_PLACEMENT_SPREAD:
+            return take_from_order(g_order.spread, g_order.count, &g_spread_next,
+                                   placement->cpu_count, mask);
+        case CPU_PLACEMENT_COMPACT:
+            return take_from_order(g_order.compact, g_order.count, &g_compact_next,
+                                   placement->cpu_count, mask);
+        case CPU_PLACEMENT_ISOLATED:
+            return take_from_order(g_order.isolated, g_order.isolated_count, &g_isolated_next,
+                                   placement->cpu_count, mask);
+        default:
+            return -1;
+    }
+}
+
+int cpu_placement_init_attr(const CpuPlacement* placement, pthread_attr_t* attr, CpuMask* effective) {
+    if (!attr) {
+        return -1;
+    }
+
+    CpuMask mask;
+    int ret = cpu_placement_resolve(placement, &mask);
+    if (ret != 0) {
+        return ret;
+    }
+
+    cpu_set_t set;
+    mask_to_cpuset(&mask, &set);
+    if (pthread_attr_setaffinity_np(attr, sizeof(set), &set) != 0) {
+        return -1;
+    }
+
+    if (effective) {
+        *effective = mask;
+    }
+    return 0;
+}
+
+int cpu_placement_apply_thread(const CpuPlacement* placement, pthread_t thread, CpuMask* effective) {
+    CpuMask mask;
+    int ret = cpu_placement_resolve(placement, &mask);
+    if (ret != 0) {
+        return ret;
+    }
+
+    cpu_set_t set;
+    mask_to_cpuset(&mask, &set);
+    if (pthread_setaffinity_np(thread, sizeof(set), &set) != 0) {
+        return -1;
+    }
+
+    if (effective) {
+        *effective = mask;
+    }
+    return 0;
+}
+
+int cpu_affinity_get_thread(pthread_t thread, CpuMask* mask) {
+    if (!mask) {
+        return -1;
+    }
+
+    cpu_set_t set;
+    if (pthread_getaffinity_np(thread, sizeof(set), &set) != 0) {
+        return -1;
+    }
+
+    cpuset_to_mask(&set, mask);
+    return 0;
+}
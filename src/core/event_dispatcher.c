@@ -0,0 +1,320 @@
+#include "event_dispatcher.h"
+#include "core_internal.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define DEFAULT_CAPACITY 1024
+#define DEFAULT_MAX_BATCH 64
+
+/**
+ * 环形队列单元 - 有界多生产者队列(Vyukov)，sequence指示单元可写/可读
+ */
+typedef struct {
+    uint64_t sequence;
+    TaskEvent event;
+} EventCell;
+
+struct EventDispatcher {
+    EventCell* cells;
+    uint64_t mask;
+    uint64_t enqueue_pos __attribute__((aligned(64)));
+    uint64_t dequeue_pos __attribute__((aligned(64)));
+
+    EventDispatcherConfig config;
+    TaskEvent* batch;           // 分发线程的批缓冲区
+
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;        // 有新事件/停止时唤醒分发线程
+    pthread_cond_t flush_cond;  // 一批交付完成时唤醒flush
+    uint32_t sleeping;          // 分发线程是否在等待(原子访问)
+    bool running;
+
+    uint64_t posted;
+    uint64_t dropped;
+    uint64_t processed;         // 已出队并处理的事件数(含被合并的)
+    uint64_t delivered;
+    uint64_t coalesced;
+    uint64_t batches;
+    uint32_t max_batch_seen;
+};
+
+// ============================================================================
+// 环形队列
+// ============================================================================
+
+static bool ring_push(EventDispatcher* dispatcher, const char* task_name,
+                      TaskState old_state, TaskState new_state) {
+    uint64_t pos = __atomic_load_n(&dispatcher->enqueue_pos, __ATOMIC_RELAXED);
+
+    for (;;) {
+        EventCell* cell = &dispatcher->cells[pos & dispatcher->mask];
+        uint64_t sequence = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+        int64_t diff = (int64_t)(sequence - pos);
+
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&dispatcher->enqueue_pos, &pos, pos + 1, true,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                TaskEvent* event = &cell->event;
+                strncpy(event->task_name, task_name, sizeof(event->task_name) - 1);
+                event->task_name[sizeof(event->task_name) - 1] = '\0';
+                event->old_state = old_state;
+                event->new_state = new_state;
+                event->timestamp_ns = get_monotonic_ns();
+                event->merged = 0;
+                __atomic_store_n(&cell->sequence, pos + 1, __ATOMIC_RELEASE);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false; // 队列已满
+        } else {
+            pos = __atomic_load_n(&dispatcher->enqueue_pos, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+/**
+ * 取出一个事件(仅分发线程调用)
+ */
+static bool ring_pop(EventDispatcher* dispatcher, TaskEvent* event) {
+    uint64_t pos = dispatcher->dequeue_pos;
+    EventCell* cell = &dispatcher->cells[pos & dispatcher->mask];
+
+    if (__atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE) != pos + 1) {
+        return false;
+    }
+
+    *event = cell->event;
+    __atomic_store_n(&cell->sequence, pos + dispatcher->mask + 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&dispatcher->dequeue_pos, pos + 1, __ATOMIC_RELAXED);
+    return true;
+}
+
+static bool ring_empty(EventDispatcher* dispatcher) {
+    uint64_t pos = dispatcher->dequeue_pos;
+    EventCell* cell = &dispatcher->cells[pos & dispatcher->mask];
+    return __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE) != pos + 1;
+}
+
+// ============================================================================
+// 分发线程
+// ============================================================================
+
+/**
+ * 收集一批事件，开启合并时同一任务的多次变化并入该任务在本批中的上一条
+ * @return 批中的事件数
+ */
+static uint32_t collect_batch(EventDispatcher* dispatcher, uint32_t* processed) {
+    uint32_t count = 0;
+    *processed = 0;
+
+    TaskEvent event;
+    while (count < dispatcher->config.max_batch && ring_pop(dispatcher, &event)) {
+        (*processed)++;
+
+        if (dispatcher->config.coalesce) {
+            TaskEvent* previous = NULL;
+            for (uint32_t i = count; i > 0; i--) {
+                if (strcmp(dispatcher->batch[i - 1].task_name, event.task_name) == 0) {
+                    previous = &dispatcher->batch[i - 1];
+                    break;
+                }
+            }
+            if (previous) {
+                previous->new_state = event.new_state;
+                previous->timestamp_ns = event.timestamp_ns;
+                previous->merged++;
+                continue;
+            }
+        }
+
+        dispatcher->batch[count++] = event;
+    }
+
+    return count;
+}
+
+static void deliver_batch(EventDispatcher* dispatcher, uint32_t count) {
+    const EventDispatcherConfig* config = &dispatcher->config;
+
+    if (config->batch_callback) {
+        config->batch_callback(dispatcher->batch, count, config->user_data);
+        return;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        const TaskEvent* event = &dispatcher->batch[i];
+        config->callback(event->task_name, event->old_state, event->new_state, config->user_data);
+    }
+}
+
+static void* dispatcher_thread(void* arg) {
+    EventDispatcher* dispatcher = arg;
+
+    for (;;) {
+        uint32_t processed;
+        uint32_t count = collect_batch(dispatcher, &processed);
+
+        if (processed > 0) {
+            if (count > 0) {
+                deliver_batch(dispatcher, count);
+            }
+
+            pthread_mutex_lock(&dispatcher->mutex);
+            dispatcher->processed += processed;
+            dispatcher->delivered += count;
+            dispatcher->coalesced += processed - count;
+            dispatcher->batches++;
+            if (count > dispatcher->max_batch_seen) {
+                dispatcher->max_batch_seen = count;
+            }
+            pthread_cond_broadcast(&dispatcher->flush_cond);
+            pthread_mutex_unlock(&dispatcher->mutex);
+            continue;
+        }
+
+        // 队列为空: 先声明即将休眠再复查，与投递端的"入队后检查sleeping"配对，避免丢失唤醒
+        pthread_mutex_lock(&dispatcher->mutex);
+        __atomic_store_n(&dispatcher->sleeping, 1, __ATOMIC_SEQ_CST);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if (ring_empty(dispatcher)) {
+            if (!dispatcher->running) {
+                __atomic_store_n(&dispatcher->sleeping, 0, __ATOMIC_RELAXED);
+                pthread_mutex_unlock(&dispatcher->mutex);
+                break;
+            }
+            pthread_cond_wait(&dispatcher->cond, &dispatcher->mutex);
+        }
+        __atomic_store_n(&dispatcher->sleeping, 0, __ATOMIC_RELAXED);
+        pthread_mutex_unlock(&dispatcher->mutex);
+    }
+
+    return NULL;
+}
+
+// ============================================================================
+// 公共接口
+// ============================================================================
+
+EventDispatcher* event_dispatcher_create(const EventDispatcherConfig* config) {
+    if (!config || (!config->callback && !config->batch_callback)) {
+        return NULL;
+    }
+
+    EventDispatcher* dispatcher;
+    if (posix_memalign((void**)&dispatcher, 64, sizeof(EventDispatcher)) != 0) {
+        return NULL;
+    }
+    memset(dispatcher, 0, sizeof(EventDispatcher));
+
+    dispatcher->config = *config;
+    if (dispatcher->config.max_batch == 0) {
+        dispatcher->config.max_batch = DEFAULT_MAX_BATCH;
+    }
+
+    uint64_t capacity = 2;
+    while (capacity < (config->capacity ? config->capacity : DEFAULT_CAPACITY)) {
+        capacity <<= 1;
+    }
+
+    dispatcher->cells = calloc(capacity, sizeof(EventCell));
+    dispatcher->batch = calloc(dispatcher->config.max_batch, sizeof(TaskEvent));
+    if (!dispatcher->cells || !dispatcher->batch) {
+        free(dispatcher->cells);
+        free(dispatcher->batch);
+        free(dispatcher);
+        return NULL;
+    }
+
+    dispatcher->mask = capacity - 1;
+    for (uint64_t i = 0; i < capacity; i++) {
+        dispatcher->cells[i].sequence = i;
+    }
+
+    pthread_mutex_init(&dispatcher->mutex, NULL);
+    pthread_cond_init(&dispatcher->cond, NULL);
+    pthread_cond_init(&dispatcher->flush_cond, NULL);
+    dispatcher->running = true;
+
+    if (pthread_create(&dispatcher->thread, NULL, dispatcher_thread, dispatcher) != 0) {
+        pthread_mutex_destroy(&dispatcher->mutex);
+        pthread_cond_destroy(&dispatcher->cond);
+        pthread_cond_destroy(&dispatcher->flush_cond);
+        free(dispatcher->cells);
+        free(dispatcher->batch);
+        free(dispatcher);
+        return NULL;
+    }
+
+    return dispatcher;
+}
+
+void event_dispatcher_destroy(EventDispatcher* dispatcher) {
+    if (!dispatcher) {
+        return;
+    }
+
+    pthread_mutex_lock(&dispatcher->mutex);
+    dispatcher->running = false;
+    pthread_cond_signal(&dispatcher->cond);
+    pthread_mutex_unlock(&dispatcher->mutex);
+
+    pthread_join(dispatcher->thread, NULL);
+
+    pthread_mutex_destroy(&dispatcher->mutex);
+    pthread_cond_destroy(&dispatcher->cond);
+    pthread_cond_destroy(&dispatcher->flush_cond);
+    free(dispatcher->cells);
+    free(dispatcher->batch);
+    free(dispatcher);
+}
+
+void event_dispatcher_post(const char* task_name, TaskState old_state, TaskState new_state, void* user_data) {
+    EventDispatcher* dispatcher = user_data;
+    if (!dispatcher || !task_name) {
+        return;
+    }
+
+    if (!ring_push(dispatcher, task_name, old_state, new_state)) {
+        __atomic_add_fetch(&dispatcher->dropped, 1, __ATOMIC_RELAXED);
+        return;
+    }
+    __atomic_add_fetch(&dispatcher->posted, 1, __ATOMIC_SEQ_CST);
+
+    if (__atomic_load_n(&dispatcher->sleeping, __ATOMIC_SEQ_CST)) {
+        pthread_mutex_lock(&dispatcher->mutex);
+        pthread_cond_signal(&dispatcher->cond);
+        pthread_mutex_unlock(&dispatcher->mutex);
+    }
+}
+
+void event_dispatcher_flush(EventDispatcher* dispatcher) {
+    if (!dispatcher) {
+        return;
+    }
+
+    uint64_t target = __atomic_load_n(&dispatcher->posted, __ATOMIC_SEQ_CST);
+
+    pthread_mutex_lock(&dispatcher->mutex);
+    while (dispatcher->processed < target) {
+        pthread_cond_wait(&dispatcher->flush_cond, &dispatcher->mutex);
+    }
+    pthread_mutex_unlock(&dispatcher->mutex);
+}
+
+void event_dispatcher_get_stats(EventDispatcher* dispatcher, EventDispatcherStats* stats) {
+    if (!dispatcher || !stats) {
+        return;
+    }
+
+    stats->posted = __atomic_load_n(&dispatcher->posted, __ATOMIC_RELAXED);
+    stats->dropped = __atomic_load_n(&dispatcher->dropped, __ATOMIC_RELAXED);
+
+    pthread_mutex_lock(&dispatcher->mutex);
+    stats->delivered = dispatcher->delivered;
+    stats->coalesced = dispatcher->coalesced;
+    stats->batches = dispatcher->batches;
+    stats->max_batch_seen = dispatcher->max_batch_seen;
+    pthread_mutex_unlock(&dispatcher->mutex);
+}
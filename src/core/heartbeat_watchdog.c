@@ -0,0 +1,323 @@
+#include "heartbeat_watchdog.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include <sys/timerfd.h>
+
+// ============================================================================
+// 截止时间最小堆(调用者持有watchdog->mutex)
+// ============================================================================
+
+static void heap_swap(HeartbeatDeadline* heap, uint32_t a, uint32_t b) {
+    HeartbeatDeadline tmp = heap[a];
+    heap[a] = heap[b];
+    heap[b] = tmp;
+}
+
+static void heap_sift_up(HeartbeatDeadline* heap, uint32_t i) {
+    while (i > 0) {
+        uint32_t parent = (i - 1) / 2;
+        if (heap[parent].deadline <= heap[i].deadline) {
+            break;
+        }
+        heap_swap(heap, parent, i);
+        i = parent;
+    }
+}
+
+static void heap_sift_down(HeartbeatDeadline* heap, uint32_t count, uint32_t i) {
+    for (;;) {
+        uint32_t smallest = i;
+        uint32_t left = 2 * i + 1;
+        uint32_t right = left + 1;
+        if (left < count && heap[left].deadline < heap[smallest].deadline) {
+            smallest = left;
+        }
+        if (right < count && heap[right].deadline < heap[smallest].deadline) {
+            smallest = right;
+        }
+        if (smallest == i) {
+            break;
+        }
+        heap_swap(heap, smallest, i);
+        i = smallest;
+    }
+}
+
+static void heap_remove_at(HeartbeatWatchdog* watchdog, uint32_t i) {
+    watchdog->count--;
+    if (i == watchdog->count) {
+        return;
+    }
+
+    watchdog->heap[i] = watchdog->heap[watchdog->count];
+    heap_sift_down(watchdog->heap, watchdog->count, i);
+    heap_sift_up(watchdog->heap, i);
+}
+
+/**
+ * 获取与timerfd同源的当前时间(秒)
+ * time()可能走粗粒度时钟，在timerfd到期后的几毫秒内仍返回上一秒，导致空转
+ */
+static uint64_t get_realtime_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (uint64_t)ts.tv_sec;
+}
+
+/**
+ * 按堆顶截止时间重新设置timerfd，堆为空时停止计时
+ */
+static void rearm_timer(HeartbeatWatchdog* watchdog) {
+    struct itimerspec spec;
+    memset(&spec, 0, sizeof(spec));
+
+    if (!watchdog->running) {
+        spec.it_value.tv_nsec = 1; // 立即到期以唤醒线程退出
+        timerfd_settime(watchdog->timer_fd, 0, &spec, NULL);
+        return;
+    }
+
+    if (watchdog->count > 0) {
+        spec.it_value.tv_sec = (time_t)watchdog->heap[0].deadline;
+    }
+    timerfd_settime(watchdog->timer_fd, TFD_TIMER_ABSTIME, &spec, NULL);
+}
+
+// ============================================================================
+// 看门狗线程
+// ============================================================================
+
+static void* watchdog_thread(void* arg) {
+    HeartbeatWatchdog* watchdog = arg;
+
+    for (;;) {
+        uint64_t expirations;
+        if (read(watchdog->timer_fd, &expirations, sizeof(expirations)) < 0 && errno != EINTR &&
+            errno != ECANCELED) {
+            break;
+        }
+
+        pthread_mutex_lock(&watchdog->mutex);
+        if (!watchdog->running) {
+            pthread_mutex_unlock(&watchdog->mutex);
+            break;
+        }
+
+        watchdog->stats.wakeups++;
+        uint64_t now = get_realtime_sec();
+        uint32_t missed = 0;
+
+        while (watchdog->count > 0 && watchdog->heap[0].deadline <= now) {
+            HeartbeatDeadline* top = &watchdog->heap[0];
+            TaskBase* task = top->task;
+            uint64_t last_heartbeat = __atomic_load_n(&task->stats.last_heartbeat, __ATOMIC_RELAXED);
+            uint32_t interval = task->config.heartbeat_interval;
+
+            if (last_heartbeat + interval > now) {
+                // 期间有新心跳，顺延到新的截止时间
+                top->deadline = last_heartbeat + interval;
+                watchdog->stats.rearms++;
+            } else {
+                // 超时只在运行中且未暂停的任务上报告，之后每个间隔再报告一次
+                if (task_get_state(task) == TASK_STATE_RUNNING &&
+                    !__atomic_load_n(&task->paused, __ATOMIC_ACQUIRE)) {
+                    watchdog->stats.misses++;
+                    watchdog->misses[missed].task = task;
+                    watchdog->misses[missed].last_heartbeat = last_heartbeat;
+                    missed++;
+                }
+                top->deadline = now + interval;
+            }
+            heap_sift_down(watchdog->heap, watchdog->count, 0);
+        }
+
+        rearm_timer(watchdog);
+
+        // 回调可能查询管理器，而启动看门狗时先持有管理器锁再取看门狗锁，须在锁外回调；
+        // unwatch等待dispatching清除，保证返回后不再有该任务的回调
+        if (missed > 0 && watchdog->callback) {
+            watchdog->dispatching = true;
+            HeartbeatMiss* batch = watchdog->misses;
+            pthread_mutex_unlock(&watchdog->mutex);
+            for (uint32_t i = 0; i < missed; i++) {
+                watchdog->callback(batch[i].task, batch[i].last_heartbeat, watchdog->user_data);
+            }
+            pthread_mutex_lock(&watchdog->mutex);
+            free(watchdog->retired_misses);
+            watchdog->retired_misses = NULL;
+            watchdog->dispatching = false;
+            pthread_cond_broadcast(&watchdog->dispatched);
+        }
+        pthread_mutex_unlock(&watchdog->mutex);
+    }
+
+    return NULL;
+}
+
+// ============================================================================
+// 公共接口
+// ============================================================================
+
+HeartbeatWatchdog* heartbeat_watchdog_create(HeartbeatMissCallback callback, void* user_data) {
+    HeartbeatWatchdog* watchdog = calloc(1, sizeof(HeartbeatWatchdog));
+    if (!watchdog) {
+        return NULL;
+    }
+
+    // 心跳时间戳取自time()，使用同一时钟避免换算
+    watchdog->timer_fd = timerfd_create(CLOCK_REALTIME, TFD_CLOEXEC);
+    if (watchdog->timer_fd < 0) {
+        free(watchdog);
+        return NULL;
+    }
+
+    pthread_mutex_init(&watchdog->mutex, NULL);
+    pthread_cond_init(&watchdog->dispatched, NULL);
+    watchdog->callback = callback;
+    watchdog->user_data = user_data;
+    watchdog->running = true;
+    watchdog->refs = 1;
+
+    if (pthread_create(&watchdog->thread, NULL, watchdog_thread, watchdog) != 0) {
+        close(watchdog->timer_fd);
+        pthread_cond_destroy(&watchdog->dispatched);
+        pthread_mutex_destroy(&watchdog->mutex);
+        free(watchdog);
+        return NULL;
+    }
+
+    return watchdog;
+}
+
+void heartbeat_watchdog_destroy(HeartbeatWatchdog* watchdog) {
+    if (!watchdog) {
+        return;
+    }
+
+    pthread_mutex_lock(&watchdog->mutex);
+    watchdog->running = false;
+    rearm_timer(watchdog);
+    pthread_mutex_unlock(&watchdog->mutex);
+
+    pthread_join(watchdog->thread, NULL);
+    heartbeat_watchdog_release(watchdog);
+}
+
+void heartbeat_watchdog_retain(HeartbeatWatchdog* watchdog) {
+    __atomic_add_fetch(&watchdog->refs, 1, __ATOMIC_RELAXED);
+}
+
+void heartbeat_watchdog_release(HeartbeatWatchdog* watchdog) {
+    if (!watchdog || __atomic_sub_fetch(&watchdog->refs, 1, __ATOMIC_ACQ_REL) != 0) {
+        return;
+    }
+
+    // 线程已退出；timerfd保留到这里，持有引用者调用watch/unwatch时重新设置它无害
+    close(watchdog->timer_fd);
+    pthread_cond_destroy(&watchdog->dispatched);
+    pthread_mutex_destroy(&watchdog->mutex);
+    free(watchdog->retired_misses);
+    free(watchdog->misses);
+    free(watchdog->heap);
+    free(watchdog);
+}
+
+int heartbeat_watchdog_watch(HeartbeatWatchdog* watchdog, TaskBase* task) {
+    if (!watchdog || !task) {
+        return -1;
+    }
+    if (task->config.heartbeat_interval == 0) {
+        return 0;
+    }
+
+    pthread_mutex_lock(&watchdog->mutex);
+
+    for (uint32_t i = 0; i < watchdog->count; i++) {
+        if (watchdog->heap[i].task == task) {
+            pthread_mutex_unlock(&watchdog->mutex);
+            return 0;
+        }
+    }
+
+    if (watchdog->count == watchdog->capacity) {
+        uint32_t new_capacity = watchdog->capacity ? watchdog->capacity * 2 : 64;
+        HeartbeatDeadline* heap = realloc(watchdog->heap, new_capacity * sizeof(HeartbeatDeadline));
+        if (!heap) {
+            pthread_mutex_unlock(&watchdog->mutex);
+            return -1;
+        }
+        watchdog->heap = heap;
+        // 不能等待回调结束: 启动看门狗时调用者持有管理器锁，回调可能正等这把锁；
+        // 看门狗线程正在锁外读取的缓冲留给它回调结束后释放
+        HeartbeatMiss* misses = malloc(new_capacity * sizeof(HeartbeatMiss));
+        if (!misses) {
+            pthread_mutex_unlock(&watchdog->mutex);
+            return -1;
+        }
+        if (watchdog->dispatching && !watchdog->retired_misses) {
+            watchdog->retired_misses = watchdog->misses;
+        } else {
+            free(watchdog->misses);
+        }
+        watchdog->misses = misses;
+        watchdog->capacity = new_capacity;
+    }
+
+    uint64_t last_heartbeat = __atomic_load_n(&task->stats.last_heartbeat, __ATOMIC_RELAXED);
+    if (last_heartbeat == 0) {
+        last_heartbeat = get_realtime_sec();
+    }
+
+    uint32_t i = watchdog->count++;
+    watchdog->heap[i].deadline = last_heartbeat + task->config.heartbeat_interval;
+    watchdog->heap[i].task = task;
+    heap_sift_up(watchdog->heap, i);
+
+    // 新任务成为最近的截止时间时才需要重设timerfd
+    if (watchdog->heap[0].task == task) {
+        rearm_timer(watchdog);
+    }
+
+    pthread_mutex_unlock(&watchdog->mutex);
+    return 0;
+}
+
+int heartbeat_watchdog_unwatch(HeartbeatWatchdog* watchdog, TaskBase* task) {
+    if (!watchdog || !task) {
+        return -1;
+    }
+
+    int ret = -1;
+    pthread_mutex_lock(&watchdog->mutex);
+
+    for (uint32_t i = 0; i < watchdog->count; i++) {
+        if (watchdog->heap[i].task == task) {
+            heap_remove_at(watchdog, i);
+            rearm_timer(watchdog);
+            ret = 0;
+            break;
+        }
+    }
+
+    // 锁外回调的一批中可能有该任务；回调内自己调用时不等待
+    while (ret == 0 && watchdog->dispatching && !pthread_equal(pthread_self(), watchdog->thread)) {
+        pthread_cond_wait(&watchdog->dispatched, &watchdog->mutex);
+    }
+
+    pthread_mutex_unlock(&watchdog->mutex);
+    return ret;
+}
+
+void heartbeat_watchdog_get_stats(HeartbeatWatchdog* watchdog, HeartbeatWatchdogStats* stats) {
+    if (!watchdog || !stats) {
+        return;
+    }
+
+    pthread_mutex_lock(&watchdog->mutex);
+    *stats = watchdog->stats;
+    stats->watched_tasks = watchdog->count;
+    pthread_mutex_unlock(&watchdog->mutex);
+}
@@ -0,0 +1,146 @@
+#include "latency_histogram.h"
+#include <string.h>
+
+/**
+ * 值到桶序号: 小于子桶数的值直接作序号；否则按最高位确定区间，
+ * 再取最高位之后的LATENCY_SUB_BUCKET_BITS位确定区间内的子桶
+ */
+static uint32_t bucket_index(uint64_t value) {
+    if (value < LATENCY_SUB_BUCKETS) {
+        return (uint32_t)value;
+    }
+
+    uint32_t msb = 63 - (uint32_t)__builtin_clzll(value);
+    if (msb >= LATENCY_MAX_BITS) {
+        return LATENCY_BUCKET_COUNT - 1;
+    }
+
+    uint32_t shift = msb - LATENCY_SUB_BUCKET_BITS;
+    return (shift + 1) * LATENCY_SUB_BUCKETS + (uint32_t)(value >> shift) - LATENCY_SUB_BUCKETS;
+}
+
+/**
+ * 桶内的最大值
+ */
+static uint64_t bucket_upper_bound(uint32_t index) {
+    if (index < LATENCY_SUB_BUCKETS) {
+        return index;
+    }
+
+    uint32_t shift = index / LATENCY_SUB_BUCKETS - 1;
+    uint64_t sub = index % LATENCY_SUB_BUCKETS + LATENCY_SUB_BUCKETS;
+    return ((sub + 1) << shift) - 1;
+}
+
+// 单写者: 用不加锁前缀的原子读写代替fetch_add，读者不会看到撕裂的计数
+static inline void add_relaxed(uint64_t* counter, uint64_t value) {
+    __atomic_store_n(counter, __atomic_load_n(counter, __ATOMIC_RELAXED) + value, __ATOMIC_RELAXED);
+}
+
+void latency_histogram_reset(LatencyHistogram* histogram) {
+    if (histogram) {
+        memset(histogram, 0, sizeof(LatencyHistogram));
+    }
+}
+
+void latency_histogram_record(LatencyHistogram* histogram, uint64_t value_ns) {
+    add_relaxed(&histogram->buckets[bucket_index(value_ns)], 1);
+    add_relaxed(&histogram->sum_ns, value_ns);
+
+    uint64_t count = __atomic_load_n(&histogram->count, __ATOMIC_RELAXED);
+    if (count == 0 || value_ns < __atomic_load_n(&histogram->min_ns, __ATOMIC_RELAXED)) {
+        __atomic_store_n(&histogram->min_ns, value_ns, __ATOMIC_RELAXED);
+    }
+    if (value_ns > __atomic_load_n(&histogram->max_ns, __ATOMIC_RELAXED)) {
+        __atomic_store_n(&histogram->max_ns, value_ns, __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&histogram->count, count + 1, __ATOMIC_RELAXED);
+}
+
+void latency_histogram_snapshot(LatencyHistogram* dst, const LatencyHistogram* src) {
+    if (!dst || !src) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < LATENCY_BUCKET_COUNT; i++) {
+        dst->buckets[i] = __atomic_load_n(&src->buckets[i], __ATOMIC_RELAXED);
+    }
+    dst->count = __atomic_load_n(&src->count, __ATOMIC_RELAXED);
+    dst->sum_ns = __atomic_load_n(&src->sum_ns, __ATOMIC_RELAXED);
+    dst->min_ns = __atomic_load_n(&src->min_ns, __ATOMIC_RELAXED);
+    dst->max_ns = __atomic_load_n(&src->max_ns, __ATOMIC_RELAXED);
+}
+
+void latency_histogram_merge(LatencyHistogram* dst, const LatencyHistogram* src) {
+    if (!dst || !src || src->count == 0) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < LATENCY_BUCKET_COUNT; i++) {
+        dst->buckets[i] += src->buckets[i];
+    }
+    if (dst->count == 0 || src->min_ns < dst->min_ns) {
+        dst->min_ns = src->min_ns;
+    }
+    if (src->max_ns > dst->max_ns) {
+        dst->max_ns = src->max_ns;
+    }
+    dst->count += src->count;
+    dst->sum_ns += src->sum_ns;
+}
+
+uint64_t latency_histogram_percentile(const LatencyHistogram* histogram, double quantile) {
+    if (!histogram) {
+        return 0;
+    }
+
+    // 快照中count与各桶可能相差几个样本，以桶的合计为准
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < LATENCY_BUCKET_COUNT; i++) {
+        total += histogram->buckets[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    if (quantile < 0.0) {
+        quantile = 0.0;
+    } else if (quantile > 1.0) {
+        quantile = 1.0;
+    }
+
+    uint64_t rank = (uint64_t)(quantile * (double)total + 0.5);
+    if (rank == 0) {
+        rank = 1;
+    }
+
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < LATENCY_BUCKET_COUNT; i++) {
+        seen += histogram->buckets[i];
+        if (seen >= rank) {
+            uint64_t upper = bucket_upper_bound(i);
+            return upper < histogram->max_ns ? upper : histogram->max_ns;
+        }
+    }
+
+    return histogram->max_ns;
+}
+
+void latency_histogram_summarize(const LatencyHistogram* histogram, LatencySummary* summary) {
+    if (!summary) {
+        return;
+    }
+
+    memset(summary, 0, sizeof(LatencySummary));
+    if (!histogram || histogram->count == 0) {
+        return;
+    }
+
+    summary->count = histogram->count;
+    summary->min_ns = histogram->min_ns;
+    summary->max_ns = histogram->max_ns;
+    summary->mean_ns = histogram->sum_ns / histogram->count;
+    summary->p50_ns = latency_histogram_percentile(histogram, 0.50);
+    summary->p99_ns = latency_histogram_percentile(histogram, 0.99);
+    summary->p999_ns = latency_histogram_percentile(histogram, 0.999);
+}
@@ -0,0 +1,272 @@
+#include "lifecycle_runner.h"
+#include "core_internal.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * 操作执行状态
+ */
+enum {
+    OPERATION_PENDING = 0,
+    OPERATION_RUNNING,
+    OPERATION_DONE
+};
+
+typedef struct {
+    LifecycleEntry entry;
+    int state;
+    uint64_t start_ns;
+    uint64_t end_ns;
+} RunnerSlot;
+
+/**
+ * 一批操作的共享上下文 - 协调线程可能先于辅助线程退出，按引用计数释放
+ */
+typedef struct {
+    void* target;
+    LifecycleOperation operation;
+    RunnerSlot* slots;
+    uint32_t count;
+    uint32_t next;              // 下一个待领取的操作
+    bool dispatching;           // 为false时辅助线程不再领取操作
+    uint32_t completed;
+    uint32_t refs;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+} RunnerContext;
+
+static void context_release(RunnerContext* context) {
+    pthread_mutex_lock(&context->mutex);
+    bool last = --context->refs == 0;
+    pthread_mutex_unlock(&context->mutex);
+
+    if (last) {
+        pthread_mutex_destroy(&context->mutex);
+        pthread_cond_destroy(&context->cond);
+        free(context->slots);
+        free(context);
+    }
+}
+
+static void* runner_thread(void* arg) {
+    RunnerContext* context = arg;
+
+    for (;;) {
+        // 领取与标记RUNNING在同一临界区内，协调线程停止分派后报告中的状态不会再变为RUNNING
+        pthread_mutex_lock(&context->mutex);
+        if (!context->dispatching || context->next >= context->count) {
+            pthread_mutex_unlock(&context->mutex);
+            break;
+        }
+        RunnerSlot* slot = &context->slots[context->next++];
+        slot->state = OPERATION_RUNNING;
+        slot->start_ns = get_monotonic_ns();
+        pthread_mutex_unlock(&context->mutex);
+
+        int result = context->operation(context->target, slot->entry.name);
+
+        pthread_mutex_lock(&context->mutex);
+        slot->entry.result = result;
+        slot->end_ns = get_monotonic_ns();
+        slot->state = OPERATION_DONE;
+        context->completed++;
+        pthread_cond_signal(&context->cond);
+        pthread_mutex_unlock(&context->mutex);
+    }
+
+    context_release(context);
+    return NULL;
+}
+
+static int compare_elapsed_desc(const void* a, const void* b) {
+    const LifecycleEntry* x = a;
+    const LifecycleEntry* y = b;
+    return x->elapsed_us < y->elapsed_us ? 1 : x->elapsed_us > y->elapsed_us ? -1 : 0;
+}
+
+/**
+ * 等待到指定单调时间或被唤醒
+ */
+static void wait_until(RunnerContext* context, uint64_t deadline_ns) {
+    if (deadline_ns == UINT64_MAX) {
+        pthread_cond_wait(&context->cond, &context->mutex);
+        return;
+    }
+
+    struct timespec deadline = {
+        .tv_sec = deadline_ns / 1000000000ULL,
+        .tv_nsec = deadline_ns % 1000000000ULL
+    };
+    pthread_cond_timedwait(&context->cond, &context->mutex, &deadline);
+}
+
+int lifecycle_run(void* target, char (*names)[64], uint32_t count,
+                  LifecycleOperation operation, LifecycleEscalation escalate,
+                  const LifecycleOptions* options, LifecycleReport* report) {
+    if (report) {
+        memset(report, 0, sizeof(LifecycleReport));
+    }
+    if (!operation || (count > 0 && !names)) {
+        return -1;
+    }
+    if (count == 0) {
+        return 0;
+    }
+
+    LifecycleOptions defaults = {0};
+    if (!options) {
+        options = &defaults;
+    }
+
+    RunnerContext* context = calloc(1, sizeof(RunnerContext));
+    if (!context) {
+        return -1;
+    }
+    context->slots = calloc(count, sizeof(RunnerSlot));
+    if (!context->slots) {
+        free(context);
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        strncpy(context->slots[i].entry.name, names[i], sizeof(context->slots[i].entry.name) - 1);
+    }
+    context->target = target;
+    context->operation = operation;
+    context->count = count;
+    context->dispatching = true;
+
+    pthread_condattr_t cond_attr;
+    pthread_condattr_init(&cond_attr);
+    pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&context->cond, &cond_attr);
+    pthread_condattr_destroy(&cond_attr);
+    pthread_mutex_init(&context->mutex, NULL);
+
+    uint32_t parallel = options->max_parallel ? options->max_parallel : LIFECYCLE_MAX_PARALLEL;
+    if (parallel > LIFECYCLE_MAX_PARALLEL) {
+        parallel = LIFECYCLE_MAX_PARALLEL;
+    }
+    if (parallel > count) {
+        parallel = count;
+    }
+
+    uint64_t start_ns = get_monotonic_ns();
+    uint64_t task_timeout_ns = (uint64_t)options->task_timeout_ms * 1000000ULL;
+    uint64_t global_deadline = options->global_timeout_ms
+        ? start_ns + (uint64_t)options->global_timeout_ms * 1000000ULL : UINT64_MAX;
+
+    // 协调线程持有一个引用
+    context->refs = 1;
+    uint32_t started = 0;
+    for (uint32_t i = 0; i < parallel; i++) {
+        pthread_t thread;
+        pthread_mutex_lock(&context->mutex);
+        context->refs++;
+        pthread_mutex_unlock(&context->mutex);
+
+        if (pthread_create(&thread, NULL, runner_thread, context) != 0) {
+            pthread_mutex_lock(&context->mutex);
+            context->refs--;
+            pthread_mutex_unlock(&context->mutex);
+            break;
+        }
+        pthread_detach(thread);
+        started++;
+    }
+
+    if (started == 0) {
+        context_release(context);
+        return -1;
+    }
+
+    pthread_mutex_lock(&context->mutex);
+    while (context->completed < count) {
+        uint64_t now = get_monotonic_ns();
+        if (now >= global_deadline) {
+            break;
+        }
+
+        // 升级超过单个期限的操作，并找出下一个需要检查的时间点
+        uint64_t next_check = global_deadline;
+        for (uint32_t i = 0; task_timeout_ns && i < count; i++) {
+            RunnerSlot* slot = &context->slots[i];
+            if (slot->state != OPERATION_RUNNING || slot->entry.escalated) {
+                continue;
+            }
+
+            uint64_t deadline = slot->start_ns + task_timeout_ns;
+            if (deadline <= now) {
+                slot->entry.escalated = true;
+                if (escalate) {
+                    escalate(target, slot->entry.name);
+                }
+            } else if (deadline < next_check) {
+                next_check = deadline;
+            }
+        }
+
+        wait_until(context, next_check);
+    }
+
+    // 放弃等待时先停止分派，尚未领取的操作不再执行，报告如实反映哪些仍在运行
+    context->dispatching = false;
+
+    // 生成报告
+    uint64_t end_ns = get_monotonic_ns();
+    int unsuccessful = 0;
+    LifecycleEntry* entries = report ? calloc(count, sizeof(LifecycleEntry)) : NULL;
+
+    for (uint32_t i = 0; i < count; i++) {
+        RunnerSlot* slot = &context->slots[i];
+        LifecycleEntry entry = slot->entry;
+        entry.started = slot->state != OPERATION_PENDING;
+        entry.completed = slot->state == OPERATION_DONE;
+
+        if (entry.completed) {
+            entry.elapsed_us = (slot->end_ns - slot->start_ns) / 1000;
+        } else if (slot->state == OPERATION_RUNNING) {
+            entry.elapsed_us = (end_ns - slot->start_ns) / 1000;
+        }
+
+        if (!entry.completed || entry.result != 0) {
+            unsuccessful++;
+        }
+
+        if (report) {
+            report->succeeded += entry.completed && entry.result == 0;
+            report->failed += entry.completed && entry.result != 0;
+            report->escalated += entry.escalated;
+            report->abandoned += slot->state == OPERATION_RUNNING;
+            report->skipped += slot->state == OPERATION_PENDING;
+        }
+        if (entries) {
+            entries[i] = entry;
+        }
+    }
+
+    pthread_mutex_unlock(&context->mutex);
+
+    if (report) {
+        report->total_us = (end_ns - start_ns) / 1000;
+        if (entries) {
+            qsort(entries, count, sizeof(LifecycleEntry), compare_elapsed_desc);
+            report->entries = entries;
+            report->count = count;
+        }
+    }
+
+    context_release(context);
+    return unsuccessful;
+}
+
+void lifecycle_report_free(LifecycleReport* report) {
+    if (!report) {
+        return;
+    }
+
+    free(report->entries);
+    report->entries = NULL;
+    report->count = 0;
+}
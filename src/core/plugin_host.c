@@ -0,0 +1,802 @@
+#define _GNU_SOURCE
+#include "plugin_host.h"
+#include "core_internal.h"
+#include "process_stats_page.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <signal.h>
+#include <spawn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+extern char** environ;
+
+// 等待宿主时检查其是否存活的间隔
+#define HOST_WAIT_SLICE_MS 50
+
+// 请求宿主退出后等待其退出的期限，超过后强制结束
+#define HOST_EXIT_TIMEOUT_MS 1000
+
+struct PluginHost {
+    char name[64];
+    char library_path[256];
+    char host_path[PATH_MAX];
+    uint32_t call_timeout_ms;
+    LogCallback log_callback;
+    char stats_page_name[96];       // 统计页的共享内存对象名
+    uint32_t slot;                  // 代理接口槽位
+
+    pthread_mutex_t call_mutex;     // 串行化代理调用和宿主重建
+    pthread_mutex_t state_mutex;    // 保护宿主进程状态
+    pthread_mutex_t log_mutex;      // 串行化日志读取
+
+    PluginHostChannel* channel;     // 当前宿主的通道(每次创建宿主时重建)
+    uint32_t sequence;              // 最近一次命令序号(call_mutex保护)
+    uint64_t calls;                 // 代理调用次数(原子访问)
+
+    pid_t pid;                      // 以下由state_mutex保护
+    bool alive;
+    bool exit_requested;
+    int exit_status;
+    uint32_t spawn_count;
+    uint32_t crash_count;
+    bool stats_page_attached;       // 以下三项在握手时从通道复制，读取方无需访问可能被重建的通道
+    uint32_t interface_version;
+    uint64_t capabilities;
+    uint32_t log_dropped;           // 宿主丢弃的日志数(读取日志时从通道复制，原子访问)
+
+    bool initialized;               // 调用过initialize，重建宿主时按原配置重新初始化(call_mutex保护)
+    char config_data[1024];
+    bool start_active;              // 代理的start正在等待插件主循环返回(原子访问)
+    bool stop_requested;            // start期间收到过stop(原子访问)
+
+    ProcessInfo info;               // 握手时复制的插件信息
+    ProcessStats stats;             // 最近一次取得的统计
+};
+
+static PluginHost* g_slots[PLUGIN_HOST_MAX_SLOTS];
+static pthread_mutex_t g_slots_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static void host_log(PluginHost* host, LogLevel level, const char* format, const char* detail) {
+    if (!host->log_callback) {
+        return;
+    }
+
+    char message[512];
+    snprintf(message, sizeof(message), "插件宿主 %s: %s%s", host->name, format, detail ? detail : "");
+    host->log_callback(level, message);
+}
+
+/**
+ * 回收已退出的宿主进程 - 调用者持有state_mutex
+ * @param flags waitpid选项
+ * @return true退出是非请求的(崩溃、被杀)
+ */
+static bool host_reap_locked(PluginHost* host, int flags) {
+    if (!host->alive) {
+        return false;
+    }
+
+    int status;
+    if (waitpid(host->pid, &status, flags) != host->pid) {
+        return false;
+    }
+
+    host->alive = false;
+    host->exit_status = status;
+    if (!host->exit_requested) {
+        host->crash_count++;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * 检查宿主进程是否存活，顺带回收已退出的进程
+ */
+static bool host_alive(PluginHost* host) {
+    pthread_mutex_lock(&host->state_mutex);
+    bool crashed = host_reap_locked(host, WNOHANG);
+    bool alive = host->alive;
+    int status = host->exit_status;
+    pthread_mutex_unlock(&host->state_mutex);
+
+    if (crashed) {
+        char detail[64];
+        if (WIFSIGNALED(status)) {
+            snprintf(detail, sizeof(detail), "信号 %d", WTERMSIG(status));
+        } else {
+            snprintf(detail, sizeof(detail), "退出码 %d", WEXITSTATUS(status));
+        }
+        host_log(host, LOG_LEVEL_ERROR, "宿主进程异常退出: ", detail);
+    }
+    return alive;
+}
+
+void plugin_host_kill(PluginHost* host) {
+    if (!host) {
+        return;
+    }
+
+    pthread_mutex_lock(&host->state_mutex);
+    // 未回收前pid仍属于宿主，不会误杀
+    if (host->alive) {
+        kill(host->pid, SIGKILL);
+    }
+    pthread_mutex_unlock(&host->state_mutex);
+}
+
+/**
+ * 读取宿主转发的日志并交给日志回调
+ */
+static void host_drain_logs(PluginHost* host, PluginHostChannel* channel) {
+    pthread_mutex_lock(&host->log_mutex);
+
+    uint32_t head = __atomic_load_n(&channel->log_head, __ATOMIC_ACQUIRE);
+    uint32_t tail = channel->log_tail;
+    while (tail != head) {
+        uint32_t index = tail % PLUGIN_HOST_LOG_SLOTS;
+        if (host->log_callback) {
+            char message[sizeof(channel->logs[0].message)];
+            memcpy(message, channel->logs[index].message, sizeof(message));
+            message[sizeof(message) - 1] = '\0';
+            host->log_callback((LogLevel)channel->logs[index].level, message);
+        }
+        tail++;
+        __atomic_store_n(&channel->log_tail, tail, __ATOMIC_RELEASE);
+    }
+    __atomic_store_n(&host->log_dropped, __atomic_load_n(&channel->log_dropped, __ATOMIC_RELAXED),
+                     __ATOMIC_RELAXED);
+
+    pthread_mutex_unlock(&host->log_mutex);
+}
+
+/**
+ * 等待信号量直到单调时刻deadline_ns，每个时间片检查宿主是否存活
+ * @param interruptible true时被信号打断即返回
+ * @return 0等到，ETIMEDOUT超时，ESRCH宿主已退出，EINTR被信号打断
+ */
+static int host_wait(PluginHost* host, sem_t* sem, uint64_t deadline_ns, bool interruptible) {
+    for (;;) {
+        uint64_t now = get_monotonic_ns();
+        if (now >= deadline_ns) {
+            return ETIMEDOUT;
+        }
+
+        uint64_t slice_end = now + HOST_WAIT_SLICE_MS * 1000000ULL;
+        if (slice_end > deadline_ns) {
+            slice_end = deadline_ns;
+        }
+        struct timespec ts = {
+            .tv_sec = (time_t)(slice_end / 1000000000ULL),
+            .tv_nsec = (long)(slice_end % 1000000000ULL),
+        };
+
+        if (sem_clockwait(sem, CLOCK_MONOTONIC, &ts) == 0) {
+            return 0;
+        }
+        if (errno == EINTR && interruptible) {
+            return EINTR;
+        }
+        if (!host_alive(host)) {
+            return ESRCH;
+        }
+    }
+}
+
+/**
+ * 等待指定序号的应答，丢弃迟到的旧应答
+ * @return 0成功，ETIMEDOUT超时，ESRCH宿主已退出
+ */
+static int host_wait_reply(PluginHost* host, PluginHostChannel* channel, uint32_t sequence) {
+    uint64_t deadline = get_monotonic_ns() + (uint64_t)host->call_timeout_ms * 1000000ULL;
+
+    for (;;) {
+        int ret = host_wait(host, &channel->reply, deadline, false);
+        if (ret != 0) {
+            return ret;
+        }
+        if (__atomic_load_n(&channel->reply_sequence, __ATOMIC_ACQUIRE) == sequence) {
+            return 0;
+        }
+    }
+}
+
+/**
+ * 发送命令并等待应答 - 调用者持有call_mutex
+ * 应答超时视为宿主失去响应，结束宿主进程
+ * @return 0成功(命令结果在channel->result)，-1宿主不可用
+ */
+static int host_call_locked(PluginHost* host, PluginHostCommand command, int32_t argument) {
+    if (!host_alive(host)) {
+        return -1;
+    }
+
+    PluginHostChannel* channel = host->channel;
+    uint32_t sequence = ++host->sequence;
+    channel->command = command;
+    channel->argument = argument;
+    __atomic_store_n(&channel->sequence, sequence, __ATOMIC_RELEASE);
+    sem_post(&channel->request);
+    __atomic_add_fetch(&host->calls, 1, __ATOMIC_RELAXED);
+
+    int ret = host_wait_reply(host, channel, sequence);
+    host_drain_logs(host, channel);
+
+    if (ret == ETIMEDOUT) {
+        host_log(host, LOG_LEVEL_ERROR, "调用超时，结束宿主进程", NULL);
+        plugin_host_kill(host);
+    }
+    return ret == 0 ? 0 : -1;
+}
+
+/**
+ * 创建宿主进程并等待其加载插件 - 调用者持有call_mutex，旧宿主已退出
+ * @return 0成功，非0失败
+ */
+static int host_spawn_locked(PluginHost* host) {
+    int fd = memfd_create("plugin_host", MFD_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+
+    // dup2到相同编号不会清除CLOEXEC，先把通道移开
+    if (fd == PLUGIN_HOST_CHANNEL_FD) {
+        int moved = fcntl(fd, F_DUPFD_CLOEXEC, PLUGIN_HOST_CHANNEL_FD + 1);
+        close(fd);
+        if (moved < 0) {
+            return -1;
+        }
+        fd = moved;
+    }
+
+    PluginHostChannel* channel = MAP_FAILED;
+    if (ftruncate(fd, sizeof(PluginHostChannel)) == 0) {
+        channel = mmap(NULL, sizeof(PluginHostChannel), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    if (channel == MAP_FAILED) {
+        close(fd);
+        return -1;
+    }
+
+    channel->magic = PLUGIN_HOST_CHANNEL_MAGIC;
+    sem_init(&channel->request, 1, 0);
+    sem_init(&channel->reply, 1, 0);
+    sem_init(&channel->events, 1, 0);
+    channel->load_result = -1;
+    channel->reply_sequence = UINT32_MAX;
+    memcpy(channel->stats_page_name, host->stats_page_name, sizeof(channel->stats_page_name));
+
+    // 宿主进入独立的进程组，终端的Ctrl-C只发给启动器，由启动器按顺序停止插件
+    posix_spawn_file_actions_t actions;
+    posix_spawnattr_t attr;
+    sigset_t mask;
+    sigemptyset(&mask);
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, fd, PLUGIN_HOST_CHANNEL_FD);
+    posix_spawnattr_init(&attr);
+    posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETPGROUP | POSIX_SPAWN_SETSIGMASK);
+    posix_spawnattr_setpgroup(&attr, 0);
+    posix_spawnattr_setsigmask(&attr, &mask);
+
+    char* argv[] = {host->host_path, host->library_path, host->name, NULL};
+    pid_t pid;
+    int ret = posix_spawn(&pid, host->host_path, &actions, &attr, argv, environ);
+
+    posix_spawnattr_destroy(&attr);
+    posix_spawn_file_actions_destroy(&actions);
+    close(fd);
+
+    if (ret != 0) {
+        host_log(host, LOG_LEVEL_ERROR, "无法启动宿主程序: ", strerror(ret));
+        munmap(channel, sizeof(PluginHostChannel));
+        return -1;
+    }
+
+    if (host->channel) {
+        munmap(host->channel, sizeof(PluginHostChannel));
+    }
+    host->channel = channel;
+    host->sequence = 0;
+
+    pthread_mutex_lock(&host->state_mutex);
+    host->pid = pid;
+    host->alive = true;
+    host->exit_requested = false;
+    host->spawn_count++;
+    pthread_mutex_unlock(&host->state_mutex);
+
+    // 握手: 序号0的应答表示插件已加载
+    ret = host_wait_reply(host, channel, 0);
+    host_drain_logs(host, channel);
+    if (ret == 0 && channel->load_result == 0) {
+        host->info = channel->info;
+        pthread_mutex_lock(&host->state_mutex);
+        host->stats_page_attached = channel->stats_page_attached != 0;
+        host->interface_version = channel->interface_version;
+        host->capabilities = channel->capabilities;
+        pthread_mutex_unlock(&host->state_mutex);
+        return 0;
+    }
+
+    host_log(host, LOG_LEVEL_ERROR, "加载插件失败: ", host->library_path);
+    pthread_mutex_lock(&host->state_mutex);
+    host->exit_requested = true;
+    if (host->alive) {
+        kill(host->pid, SIGKILL);
+        host_reap_locked(host, 0);
+    }
+    pthread_mutex_unlock(&host->state_mutex);
+    return -1;
+}
+
+/**
+ * 确保宿主进程存活，已退出时重建并按原配置重新初始化 - 调用者持有call_mutex
+ * @return 0成功，非0失败
+ */
+static int host_ensure_locked(PluginHost* host) {
+    if (host_alive(host)) {
+        return 0;
+    }
+
+    // 旧宿主的start尚未返回时不能替换通道
+    if (__atomic_load_n(&host->start_active, __ATOMIC_ACQUIRE)) {
+        return -1;
+    }
+
+    // 旧宿主可能死在统计页写入中途，新宿主的插件重新注册计数器前清空页面
+    if (host->stats_page_name[0]) {
+        ProcessStatsPage* page = process_stats_page_open(host->stats_page_name, true);
+        process_stats_page_reset(page);
+        process_stats_page_close(page);
+    }
+
+    if (host_spawn_locked(host) != 0) {
+        return -1;
+    }
+    if (!host->initialized) {
+        return 0;
+    }
+
+    memcpy(host->channel->config_data, host->config_data, sizeof(host->config_data));
+    if (host_call_locked(host, PLUGIN_HOST_CMD_INITIALIZE, 0) != 0 || host->channel->result != 0) {
+        return -1;
+    }
+    return 0;
+}
+
+// ============================================================================
+// 代理接口: 按槽位找到宿主并转发调用
+// ============================================================================
+
+static PluginHost* slot_host(uint32_t slot) {
+    return __atomic_load_n(&g_slots[slot], __ATOMIC_ACQUIRE);
+}
+
+static const ProcessInfo* proxy_get_process_info(uint32_t slot) {
+    PluginHost* host = slot_host(slot);
+    return host ? &host->info : NULL;
+}
+
+static int proxy_initialize(uint32_t slot, const char* config_data, LogCallback log_callback) {
+    PluginHost* host = slot_host(slot);
+    if (!host) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&host->call_mutex);
+    if (log_callback) {
+        host->log_callback = log_callback;
+    }
+
+    int result = -1;
+    bool was_initialized = host->initialized;
+    host->initialized = false;
+    memset(host->config_data, 0, sizeof(host->config_data));
+    if (config_data) {
+        strncpy(host->config_data, config_data, sizeof(host->config_data) - 1);
+    }
+
+    if (host_ensure_locked(host) == 0) {
+        memcpy(host->channel->config_data, host->config_data, sizeof(host->config_data));
+        if (host_call_locked(host, PLUGIN_HOST_CMD_INITIALIZE, 0) == 0) {
+            result = host->channel->result;
+        }
+    }
+    host->initialized = result == 0 || was_initialized;
+    pthread_mutex_unlock(&host->call_mutex);
+
+    return result;
+}
+
+/**
+ * 等待start时被取消 - 放弃的插件主循环不能留在宿主中运行
+ */
+static void proxy_start_cancelled(void* arg) {
+    PluginHost* host = arg;
+    plugin_host_kill(host);
+    __atomic_store_n(&host->start_active, false, __ATOMIC_RELEASE);
+}
+
+static int proxy_start(uint32_t slot) {
+    PluginHost* host = slot_host(slot);
+    if (!host) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&host->call_mutex);
+    if (__atomic_load_n(&host->start_active, __ATOMIC_ACQUIRE) || host_ensure_locked(host) != 0) {
+        pthread_mutex_unlock(&host->call_mutex);
+        return -1;
+    }
+
+    PluginHostChannel* channel = host->channel;
+    uint32_t expected = __atomic_load_n(&channel->start_count, __ATOMIC_ACQUIRE) + 1;
+    if (host_call_locked(host, PLUGIN_HOST_CMD_START, 0) != 0 || channel->result != 0) {
+        pthread_mutex_unlock(&host->call_mutex);
+        return -1;
+    }
+    __atomic_store_n(&host->stop_requested, false, __ATOMIC_RELAXED);
+    __atomic_store_n(&host->start_active, true, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&host->call_mutex);
+
+    // 与进程内插件一样阻塞到插件主循环返回；等待期间转发日志
+    int result = -1;
+    pthread_cleanup_push(proxy_start_cancelled, host);
+    for (;;) {
+        int ret = host_wait(host, &channel->events, UINT64_MAX, true);
+        host_drain_logs(host, channel);
+
+        if (__atomic_load_n(&channel->start_count, __ATOMIC_ACQUIRE) >= expected) {
+            result = channel->start_result;
+            break;
+        }
+        if (ret == ESRCH) {
+            break;
+        }
+        // 停止升级中打断阻塞调用的信号: 插件在另一个进程里，改为结束宿主
+        if (ret == EINTR && __atomic_load_n(&host->stop_requested, __ATOMIC_RELAXED)) {
+            host_log(host, LOG_LEVEL_WARN, "停止被升级，结束宿主进程", NULL);
+            plugin_host_kill(host);
+        }
+    }
+    pthread_cleanup_pop(0);
+
+    __atomic_store_n(&host->start_active, false, __ATOMIC_RELEASE);
+    return result;
+}
+
+static int proxy_stop(uint32_t slot) {
+    PluginHost* host = slot_host(slot);
+    if (!host) {
+        return -1;
+    }
+
+    __atomic_store_n(&host->stop_requested, true, __ATOMIC_RELAXED);
+
+    pthread_mutex_lock(&host->call_mutex);
+    int result;
+    if (!host_alive(host)) {
+        // 宿主已退出，没有需要停止的插件
+        result = 0;
+    } else if (host_call_locked(host, PLUGIN_HOST_CMD_STOP, 0) == 0) {
+        result = host->channel->result;
+    } else {
+        result = -1;
+    }
+    pthread_mutex_unlock(&host->call_mutex);
+
+    return result;
+}
+
+static void proxy_cleanup(uint32_t slot) {
+    PluginHost* host = slot_host(slot);
+    if (!host) {
+        return;
+    }
+
+    pthread_mutex_lock(&host->call_mutex);
+    if (host_alive(host)) {
+        host_call_locked(host, PLUGIN_HOST_CMD_CLEANUP, 0);
+    }
+    pthread_mutex_unlock(&host->call_mutex);
+}
+
+static ProcessState proxy_get_state(uint32_t slot) {
+    PluginHost* host = slot_host(slot);
+    if (!host) {
+        return PROCESS_STATE_UNKNOWN;
+    }
+
+    // 宿主不在时报告ERROR，由重启策略决定是否重建
+    pthread_mutex_lock(&host->call_mutex);
+    ProcessState state = PROCESS_STATE_ERROR;
+    if (host_call_locked(host, PLUGIN_HOST_CMD_GET_STATE, 0) == 0) {
+        state = (ProcessState)host->channel->result;
+    }
+    pthread_mutex_unlock(&host->call_mutex);
+
+    return state;
+}
+
+static const ProcessStats* proxy_get_stats(uint32_t slot) {
+    // 每个调用线程一份副本，在call_mutex内复制，其他线程的代理调用不会改写调用者正在读的统计
+    static __thread ProcessStats stats;
+
+    PluginHost* host = slot_host(slot);
+    if (!host) {
+        return NULL;
+    }
+
+    // 宿主不在时返回最近一次取得的统计
+    pthread_mutex_lock(&host->call_mutex);
+    if (host_call_locked(host, PLUGIN_HOST_CMD_GET_STATS, 0) == 0 && host->channel->result == 0) {
+        host->stats = host->channel->stats;
+    }
+    stats = host->stats;
+    pthread_mutex_unlock(&host->call_mutex);
+
+    return &stats;
+}
+
+static void proxy_handle_signal(uint32_t slot, int signal) {
+    PluginHost* host = slot_host(slot);
+    if (!host) {
+        return;
+    }
+
+    pthread_mutex_lock(&host->call_mutex);
+    host_call_locked(host, PLUGIN_HOST_CMD_HANDLE_SIGNAL, signal);
+    pthread_mutex_unlock(&host->call_mutex);
+}
+
+static bool proxy_health_check(uint32_t slot) {
+    PluginHost* host = slot_host(slot);
+    if (!host) {
+        return false;
+    }
+
+    pthread_mutex_lock(&host->call_mutex);
+    bool healthy = host_call_locked(host, PLUGIN_HOST_CMD_HEALTH_CHECK, 0) == 0 && host->channel->result != 0;
+    pthread_mutex_unlock(&host->call_mutex);
+
+    return healthy;
+}
+
+// ProcessInterface没有上下文参数，每个槽位生成一组转发函数
+#define HOST_SLOT(hi, lo) ((hi) * 16 + (lo))
+
+#define HOST_SLOT_THUNKS(hi, lo)                                                                    \
+    static const ProcessInfo* slot_##hi##_##lo##_get_process_info(void) {                          \
+        return proxy_get_process_info(HOST_SLOT(hi, lo));                                           \
+    }                                                                                               \
+    static int slot_##hi##_##lo##_initialize(const char* config_data, LogCallback log_callback) {   \
+        return proxy_initialize(HOST_SLOT(hi, lo), config_data, log_callback);                      \
+    }                                                                                               \
+    static int slot_##hi##_##lo##_start(void) { return proxy_start(HOST_SLOT(hi, lo)); }            \
+    static int slot_##hi##_##lo##_stop(void) { return proxy_stop(HOST_SLOT(hi, lo)); }              \
+    static void slot_##hi##_##lo##_cleanup(void) { proxy_cleanup(HOST_SLOT(hi, lo)); }              \
+    static ProcessState slot_##hi##_##lo##_get_state(void) { return proxy_get_state(HOST_SLOT(hi, lo)); } \
+    static const ProcessStats* slot_##hi##_##lo##_get_stats(void) {                                 \
+        return proxy_get_stats(HOST_SLOT(hi, lo));                                                  \
+    }                                                                                               \
+    static void slot_##hi##_##lo##_handle_signal(int signal) {                                      \
+        proxy_handle_signal(HOST_SLOT(hi, lo), signal);                                             \
+    }                                                                                               \
+    static bool slot_##hi##_##lo##_health_check(void) { return proxy_health_check(HOST_SLOT(hi, lo)); }
+
+#define HOST_SLOT_INTERFACE(hi, lo)                                     \
+    [HOST_SLOT(hi, lo)] = {                                             \
+        .get_process_info = slot_##hi##_##lo##_get_process_info,        \
+        .initialize = slot_##hi##_##lo##_initialize,                    \
+        .start = slot_##hi##_##lo##_start,                              \
+        .stop = slot_##hi##_##lo##_stop,                                \
+        .cleanup = slot_##hi##_##lo##_cleanup,                          \
+        .get_state = slot_##hi##_##lo##_get_state,                      \
+        .get_stats = slot_##hi##_##lo##_get_stats,                      \
+        .handle_signal = slot_##hi##_##lo##_handle_signal,              \
+        .health_check = slot_##hi##_##lo##_health_check,                \
+    },
+
+#define HOST_SLOT_ROW(X, hi) \
+    X(hi, 0) X(hi, 1) X(hi, 2) X(hi, 3) X(hi, 4) X(hi, 5) X(hi, 6) X(hi, 7) \
+    X(hi, 8) X(hi, 9) X(hi, 10) X(hi, 11) X(hi, 12) X(hi, 13) X(hi, 14) X(hi, 15)
+
+#define HOST_SLOT_TABLE(X) \
+    HOST_SLOT_ROW(X, 0) HOST_SLOT_ROW(X, 1) HOST_SLOT_ROW(X, 2) HOST_SLOT_ROW(X, 3) \
+    HOST_SLOT_ROW(X, 4) HOST_SLOT_ROW(X, 5) HOST_SLOT_ROW(X, 6) HOST_SLOT_ROW(X, 7) \
+    HOST_SLOT_ROW(X, 8) HOST_SLOT_ROW(X, 9) HOST_SLOT_ROW(X, 10) HOST_SLOT_ROW(X, 11) \
+    HOST_SLOT_ROW(X, 12) HOST_SLOT_ROW(X, 13) HOST_SLOT_ROW(X, 14) HOST_SLOT_ROW(X, 15)
+
+_Static_assert(PLUGIN_HOST_MAX_SLOTS == 16 * 16, "HOST_SLOT_TABLE must cover PLUGIN_HOST_MAX_SLOTS");
+
+HOST_SLOT_TABLE(HOST_SLOT_THUNKS)
+
+static ProcessInterface g_slot_interfaces[PLUGIN_HOST_MAX_SLOTS] = {
+    HOST_SLOT_TABLE(HOST_SLOT_INTERFACE)
+};
+
+// ============================================================================
+// 宿主管理
+// ============================================================================
+
+/**
+ * 确定宿主程序路径: 选项 > 环境变量 > 启动器同目录
+ */
+static int resolve_host_path(const PluginHostOptions* options, char* path, size_t size) {
+    const char* configured = options && options->host_path ? options->host_path : getenv(PLUGIN_HOST_PATH_ENV);
+    if (configured && configured[0]) {
+        snprintf(path, size, "%s", configured);
+        return 0;
+    }
+
+    char exe[PATH_MAX];
+    ssize_t len = readlink("/proc/self/exe", exe, sizeof(exe) - 1);
+    if (len <= 0) {
+        return -1;
+    }
+    exe[len] = '\0';
+
+    char* slash = strrchr(exe, '/');
+    if (!slash) {
+        return -1;
+    }
+    *slash = '\0';
+    int written = snprintf(path, size, "%s/%s", exe, PLUGIN_HOST_EXECUTABLE);
+    return written > 0 && (size_t)written < size ? 0 : -1;
+}
+
+PluginHost* plugin_host_create(const char* name, const char* library_path, const PluginHostOptions* options) {
+    if (!name || !library_path) {
+        return NULL;
+    }
+
+    PluginHost* host = calloc(1, sizeof(PluginHost));
+    if (!host) {
+        return NULL;
+    }
+
+    strncpy(host->name, name, sizeof(host->name) - 1);
+    strncpy(host->library_path, library_path, sizeof(host->library_path) - 1);
+    host->call_timeout_ms = options && options->call_timeout_ms ? options->call_timeout_ms
+                                                                : PLUGIN_HOST_DEFAULT_CALL_TIMEOUT_MS;
+    host->log_callback = options ? options->log_callback : NULL;
+    if (options && options->stats_page_name) {
+        strncpy(host->stats_page_name, options->stats_page_name, sizeof(host->stats_page_name) - 1);
+    }
+    if (resolve_host_path(options, host->host_path, sizeof(host->host_path)) != 0) {
+        free(host);
+        return NULL;
+    }
+
+    // 槽位的代理接口只有拿到接口指针后才会被调用，创建前占用即可
+    pthread_mutex_lock(&g_slots_mutex);
+    host->slot = PLUGIN_HOST_MAX_SLOTS;
+    for (uint32_t i = 0; i < PLUGIN_HOST_MAX_SLOTS; i++) {
+        if (!g_slots[i]) {
+            host->slot = i;
+            __atomic_store_n(&g_slots[i], host, __ATOMIC_RELEASE);
+            break;
+        }
+    }
+    pthread_mutex_unlock(&g_slots_mutex);
+
+    if (host->slot == PLUGIN_HOST_MAX_SLOTS) {
+        host_log(host, LOG_LEVEL_ERROR, "隔离插件数量已达上限", NULL);
+        free(host);
+        return NULL;
+    }
+
+    pthread_mutex_init(&host->call_mutex, NULL);
+    pthread_mutex_init(&host->state_mutex, NULL);
+    pthread_mutex_init(&host->log_mutex, NULL);
+
+    pthread_mutex_lock(&host->call_mutex);
+    int ret = host_spawn_locked(host);
+    pthread_mutex_unlock(&host->call_mutex);
+
+    if (ret != 0) {
+        plugin_host_destroy(host);
+        return NULL;
+    }
+    return host;
+}
+
+void plugin_host_destroy(PluginHost* host) {
+    if (!host) {
+        return;
+    }
+
+    pthread_mutex_lock(&host->call_mutex);
+    pthread_mutex_lock(&host->state_mutex);
+    bool alive = host->alive;
+    host->exit_requested = true;
+    pthread_mutex_unlock(&host->state_mutex);
+
+    if (alive) {
+        host_call_locked(host, PLUGIN_HOST_CMD_EXIT, 0);
+
+        uint64_t deadline = get_monotonic_ns() + HOST_EXIT_TIMEOUT_MS * 1000000ULL;
+        while (host_alive(host) && get_monotonic_ns() < deadline) {
+            usleep(1000);
+        }
+
+        pthread_mutex_lock(&host->state_mutex);
+        if (host->alive) {
+            kill(host->pid, SIGKILL);
+            host_reap_locked(host, 0);
+        }
+        pthread_mutex_unlock(&host->state_mutex);
+    }
+    pthread_mutex_unlock(&host->call_mutex);
+
+    pthread_mutex_lock(&g_slots_mutex);
+    __atomic_store_n(&g_slots[host->slot], NULL, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&g_slots_mutex);
+
+    if (host->channel) {
+        munmap(host->channel, sizeof(PluginHostChannel));
+    }
+    pthread_mutex_destroy(&host->call_mutex);
+    pthread_mutex_destroy(&host->state_mutex);
+    pthread_mutex_destroy(&host->log_mutex);
+    free(host);
+}
+
+ProcessInterface* plugin_host_get_interface(PluginHost* host) {
+    return host ? &g_slot_interfaces[host->slot] : NULL;
+}
+
+/**
+ * 读取进程常驻内存(/proc/<pid>/statm的第二项)
+ */
+static uint64_t read_rss_bytes(pid_t pid) {
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%d/statm", (int)pid);
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        return 0;
+    }
+
+    unsigned long long size = 0, resident = 0;
+    if (fscanf(file, "%llu %llu", &size, &resident) != 2) {
+        resident = 0;
+    }
+    fclose(file);
+    return (uint64_t)resident * (uint64_t)sysconf(_SC_PAGESIZE);
+}
+
+int plugin_host_get_info(PluginHost* host, PluginHostInfo* info) {
+    if (!host || !info) {
+        return -1;
+    }
+
+    memset(info, 0, sizeof(PluginHostInfo));
+    host_alive(host);
+
+    pthread_mutex_lock(&host->state_mutex);
+    info->alive = host->alive;
+    info->pid = host->alive ? host->pid : 0;
+    info->exit_status = host->exit_status;
+    info->spawn_count = host->spawn_count;
+    info->crash_count = host->crash_count;
+    info->stats_page_attached = host->stats_page_attached;
+    info->interface_version = host->interface_version;
+    info->capabilities = host->capabilities;
+    pthread_mutex_unlock(&host->state_mutex);
+
+    // 通道在宿主重建时被替换，不读取；计数只用于展示，不为它等待正在进行的代理调用
+    info->calls = __atomic_load_n(&host->calls, __ATOMIC_RELAXED);
+    info->log_dropped = __atomic_load_n(&host->log_dropped, __ATOMIC_RELAXED);
+    if (info->alive) {
+        info->rss_bytes = read_rss_bytes(info->pid);
+    }
+    return 0;
+}
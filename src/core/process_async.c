@@ -0,0 +1,276 @@
+#include "process_async.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+struct ProcessAsyncAdapter {
+    char name[64];
+    ProcessInterfaceV2* plugin;
+    ProcessInterface interface;     // v1形式的接口: start为槽位适配函数，其余为插件的实现
+    ProcessNotifier notifier;       // 交给插件的通知，context指向适配器
+    LogCallback log_callback;
+    uint32_t slot;
+    uint32_t refs;                  // 创建者一个，process_async_retain每次一个(原子访问)
+
+    pthread_mutex_t mutex;          // 保护以下字段
+    pthread_cond_t changed;         // 每次通知广播(CLOCK_MONOTONIC)
+    ProcessState state;             // 最近一次通知的状态
+    uint64_t notifications;
+    uint32_t run_generation;        // 每次发起启动递增
+    uint32_t finished_generation;   // 最近一次结束的运行
+    int run_result;                 // 最近一次结束的运行结果
+    bool closed;                    // 已调用process_async_destroy，等待者不再等通知
+};
+
+static ProcessAsyncAdapter* g_slots[PROCESS_ASYNC_MAX_SLOTS];
+static pthread_mutex_t g_slots_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static void log_message(ProcessAsyncAdapter* adapter, LogLevel level, const char* what, int result) {
+    if (adapter->log_callback) {
+        char message[160];
+        snprintf(message, sizeof(message), "进程 %s %s (%d)", adapter->name, what, result);
+        adapter->log_callback(level, message);
+    }
+}
+
+/**
+ * 插件的通知入口
+ */
+static void adapter_notify(void* context, ProcessState state, int result) {
+    ProcessAsyncAdapter* adapter = context;
+
+    pthread_mutex_lock(&adapter->mutex);
+    adapter->state = state;
+    adapter->notifications++;
+    bool finished = (state == PROCESS_STATE_STOPPED || state == PROCESS_STATE_ERROR) &&
+                    adapter->finished_generation != adapter->run_generation;
+    if (finished) {
+        adapter->finished_generation = adapter->run_generation;
+        adapter->run_result = state == PROCESS_STATE_ERROR && result == 0 ? -1 : result;
+    }
+    pthread_cond_broadcast(&adapter->changed);
+    pthread_mutex_unlock(&adapter->mutex);
+
+    if (state == PROCESS_STATE_ERROR) {
+        log_message(adapter, LOG_LEVEL_ERROR, "报告运行失败", result);
+    }
+}
+
+static void unlock_mutex(void* mutex) {
+    pthread_mutex_unlock(mutex);
+}
+
+/**
+ * 适配接口的start - 发起启动后阻塞到插件通知本次运行结束，与v1的start语义一致
+ */
+static int adapter_start(uint32_t slot) {
+    ProcessAsyncAdapter* adapter = __atomic_load_n(&g_slots[slot], __ATOMIC_ACQUIRE);
+    if (!adapter || !adapter->plugin->base.start) {
+        return -1;
+    }
+
+    // 上一次运行留下的STOPPED/ERROR不能让等待RUNNING的调用者立即失败
+    pthread_mutex_lock(&adapter->mutex);
+    uint32_t generation = ++adapter->run_generation;
+    adapter->state = PROCESS_STATE_INITIALIZING;
+    pthread_cond_broadcast(&adapter->changed);
+    pthread_mutex_unlock(&adapter->mutex);
+
+    // 插件可能在start内同步通知，调用时不持锁
+    int ret = adapter->plugin->base.start();
+    if (ret != 0) {
+        pthread_mutex_lock(&adapter->mutex);
+        if (adapter->finished_generation != generation) {
+            adapter->finished_generation = generation;
+            adapter->run_result = ret;
+        }
+        pthread_mutex_unlock(&adapter->mutex);
+        return ret;
+    }
+
+    // 停止升级取消本线程时须释放锁
+    int result;
+    pthread_mutex_lock(&adapter->mutex);
+    pthread_cleanup_push(unlock_mutex, &adapter->mutex);
+    while (adapter->finished_generation != generation) {
+        pthread_cond_wait(&adapter->changed, &adapter->mutex);
+    }
+    result = adapter->run_result;
+    pthread_cleanup_pop(1);
+    return result;
+}
+
+#define ASYNC_SLOT(hi, lo) ((hi) * 16 + (lo))
+
+#define ASYNC_SLOT_THUNK(hi, lo) \
+    static int slot_##hi##_##lo##_start(void) { return adapter_start(ASYNC_SLOT(hi, lo)); }
+
+#define ASYNC_SLOT_ENTRY(hi, lo) [ASYNC_SLOT(hi, lo)] = slot_##hi##_##lo##_start,
+
+#define ASYNC_SLOT_ROW(X, hi) \
+    X(hi, 0) X(hi, 1) X(hi, 2) X(hi, 3) X(hi, 4) X(hi, 5) X(hi, 6) X(hi, 7) \
+    X(hi, 8) X(hi, 9) X(hi, 10) X(hi, 11) X(hi, 12) X(hi, 13) X(hi, 14) X(hi, 15)
+
+#define ASYNC_SLOT_TABLE(X) \
+    ASYNC_SLOT_ROW(X, 0) ASYNC_SLOT_ROW(X, 1) ASYNC_SLOT_ROW(X, 2) ASYNC_SLOT_ROW(X, 3) \
+    ASYNC_SLOT_ROW(X, 4) ASYNC_SLOT_ROW(X, 5) ASYNC_SLOT_ROW(X, 6) ASYNC_SLOT_ROW(X, 7) \
+    ASYNC_SLOT_ROW(X, 8) ASYNC_SLOT_ROW(X, 9) ASYNC_SLOT_ROW(X, 10) ASYNC_SLOT_ROW(X, 11) \
+    ASYNC_SLOT_ROW(X, 12) ASYNC_SLOT_ROW(X, 13) ASYNC_SLOT_ROW(X, 14) ASYNC_SLOT_ROW(X, 15)
+
+_Static_assert(PROCESS_ASYNC_MAX_SLOTS == 16 * 16, "ASYNC_SLOT_TABLE must cover PROCESS_ASYNC_MAX_SLOTS");
+
+ASYNC_SLOT_TABLE(ASYNC_SLOT_THUNK)
+
+static int (*const g_slot_starts[PROCESS_ASYNC_MAX_SLOTS])(void) = {
+    ASYNC_SLOT_TABLE(ASYNC_SLOT_ENTRY)
+};
+
+ProcessAsyncAdapter* process_async_create(const char* name, ProcessInterfaceV2* plugin, LogCallback log_callback) {
+    if (!name || !plugin || !plugin->bind_notifier) {
+        return NULL;
+    }
+
+    ProcessAsyncAdapter* adapter = calloc(1, sizeof(ProcessAsyncAdapter));
+    if (!adapter) {
+        return NULL;
+    }
+    strncpy(adapter->name, name, sizeof(adapter->name) - 1);
+    adapter->plugin = plugin;
+    adapter->log_callback = log_callback;
+    adapter->state = PROCESS_STATE_UNKNOWN;
+    adapter->refs = 1;
+
+    pthread_mutex_init(&adapter->mutex, NULL);
+    pthread_condattr_t cond_attr;
+    pthread_condattr_init(&cond_attr);
+    pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&adapter->changed, &cond_attr);
+    pthread_condattr_destroy(&cond_attr);
+
+    pthread_mutex_lock(&g_slots_mutex);
+    adapter->slot = PROCESS_ASYNC_MAX_SLOTS;
+    for (uint32_t i = 0; i < PROCESS_ASYNC_MAX_SLOTS; i++) {
+        if (!g_slots[i]) {
+            adapter->slot = i;
+            __atomic_store_n(&g_slots[i], adapter, __ATOMIC_RELEASE);
+            break;
+        }
+    }
+    pthread_mutex_unlock(&g_slots_mutex);
+
+    if (adapter->slot == PROCESS_ASYNC_MAX_SLOTS) {
+        log_message(adapter, LOG_LEVEL_ERROR, "无法加载: v2插件数量已达上限", PROCESS_ASYNC_MAX_SLOTS);
+        pthread_cond_destroy(&adapter->changed);
+        pthread_mutex_destroy(&adapter->mutex);
+        free(adapter);
+        return NULL;
+    }
+
+    adapter->interface = plugin->base;
+    adapter->interface.start = g_slot_starts[adapter->slot];
+    adapter->notifier.context = adapter;
+    adapter->notifier.notify = adapter_notify;
+    plugin->bind_notifier(&adapter->notifier);
+    return adapter;
+}
+
+void process_async_destroy(ProcessAsyncAdapter* adapter) {
+    if (!adapter) {
+        return;
+    }
+
+    pthread_mutex_lock(&g_slots_mutex);
+    __atomic_store_n(&g_slots[adapter->slot], NULL, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&g_slots_mutex);
+
+    // 唤醒仍持有引用的等待者，它们返回失败后释放引用
+    pthread_mutex_lock(&adapter->mutex);
+    adapter->closed = true;
+    pthread_cond_broadcast(&adapter->changed);
+    pthread_mutex_unlock(&adapter->mutex);
+
+    process_async_release(adapter);
+}
+
+void process_async_retain(ProcessAsyncAdapter* adapter) {
+    __atomic_add_fetch(&adapter->refs, 1, __ATOMIC_RELAXED);
+}
+
+void process_async_release(ProcessAsyncAdapter* adapter) {
+    if (!adapter || __atomic_sub_fetch(&adapter->refs, 1, __ATOMIC_ACQ_REL) != 0) {
+        return;
+    }
+
+    pthread_cond_destroy(&adapter->changed);
+    pthread_mutex_destroy(&adapter->mutex);
+    free(adapter);
+}
+
+ProcessInterface* process_async_get_interface(ProcessAsyncAdapter* adapter) {
+    return adapter ? &adapter->interface : NULL;
+}
+
+ProcessInterfaceV2* process_async_get_plugin(ProcessAsyncAdapter* adapter) {
+    return adapter ? adapter->plugin : NULL;
+}
+
+int process_async_wait_state(ProcessAsyncAdapter* adapter, ProcessState state, uint32_t timeout_ms) {
+    if (!adapter) {
+        return -1;
+    }
+
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += timeout_ms / 1000;
+    deadline.tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    pthread_mutex_lock(&adapter->mutex);
+    int ret = 0;
+    while (adapter->state != state) {
+        if (adapter->closed || adapter->state == PROCESS_STATE_ERROR ||
+            pthread_cond_timedwait(&adapter->changed, &adapter->mutex, &deadline) != 0) {
+            ret = adapter->state == state ? 0 : -1;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&adapter->mutex);
+
+    return ret;
+}
+
+int process_async_request_pause(ProcessAsyncAdapter* adapter, bool pause) {
+    if (!adapter || !(adapter->plugin->capabilities & PROCESS_CAP_PAUSE)) {
+        return -1;
+    }
+
+    int (*call)(void) = pause ? adapter->plugin->pause : adapter->plugin->resume;
+    return call && call() == 0 ? 0 : -1;
+}
+
+int process_async_set_paused(ProcessAsyncAdapter* adapter, bool pause, uint32_t timeout_ms) {
+    if (process_async_request_pause(adapter, pause) != 0) {
+        return -1;
+    }
+    return process_async_wait_state(adapter, pause ? PROCESS_STATE_PAUSED : PROCESS_STATE_RUNNING, timeout_ms);
+}
+
+int process_async_get_info(ProcessAsyncAdapter* adapter, ProcessAsyncInfo* info) {
+    if (!adapter || !info) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&adapter->mutex);
+    info->capabilities = adapter->plugin->capabilities;
+    info->notified_state = adapter->state;
+    info->notifications = adapter->notifications;
+    info->runs = adapter->run_generation;
+    pthread_mutex_unlock(&adapter->mutex);
+
+    return 0;
+}
@@ -0,0 +1,69 @@
+#include "process_manager.h"
+#include "core_internal.h"
+#include <stdio.h>
+#include <string.h>
+
+int process_manager_load_plugin_isolated(ProcessManager* manager,
+                                         const char* name,
+                                         const char* library_path,
+                                         const char* config_data,
+                                         const PluginHostOptions* options) {
+    if (!manager || !name || !library_path) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&manager->mutex);
+    bool exists = process_find_node_locked(manager, name) != NULL;
+    pthread_mutex_unlock(&manager->mutex);
+    if (exists) {
+        return -1;
+    }
+
+    PluginHostOptions host_options;
+    memset(&host_options, 0, sizeof(host_options));
+    if (options) {
+        host_options = *options;
+    }
+    if (!host_options.log_callback) {
+        host_options.log_callback = manager->log_callback;
+    }
+
+    // 创建宿主和初始化可能较慢，不持有管理器锁
+    PluginHost* host = plugin_host_create(name, library_path, &host_options);
+    if (!host) {
+        return -1;
+    }
+
+    ProcessInterface* interface = plugin_host_get_interface(host);
+    if (interface->initialize(config_data ? config_data : "", manager->log_callback) != 0) {
+        plugin_host_destroy(host);
+        return -1;
+    }
+
+    if (process_manager_add_plugin(manager, name, library_path, config_data, NULL, interface, host) != 0) {
+        plugin_host_destroy(host);
+        return -1;
+    }
+
+    if (manager->log_callback) {
+        PluginHostInfo info;
+        plugin_host_get_info(host, &info);
+        char message[384];
+        snprintf(message, sizeof(message), "进程 %s 隔离加载: %s (宿主pid %d)", name, library_path, (int)info.pid);
+        manager->log_callback(LOG_LEVEL_INFO, message);
+    }
+    return 0;
+}
+
+int process_manager_get_host_info(ProcessManager* manager, const char* name, PluginHostInfo* info) {
+    if (!manager || !name || !info) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&manager->mutex);
+    ProcessNode* node = process_find_node_locked(manager, name);
+    int ret = node && node->host ? plugin_host_get_info(node->host, info) : -1;
+    pthread_mutex_unlock(&manager->mutex);
+
+    return ret;
+}
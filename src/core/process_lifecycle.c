@@ -0,0 +1,375 @@
+#include "process_manager.h"
+#include "core_internal.h"
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * 复制当前所有进程名称
+ * @return 进程数量，失败返回-1
+ */
+static int collect_process_names(ProcessManager* manager, char (**names)[64]) {
+    pthread_mutex_lock(&manager->mutex);
+
+    uint32_t count = 0;
+    ProcessNode* node;
+    TAILQ_FOREACH(node, &manager->process_list, entries) {
+        count++;
+    }
+
+    *names = calloc(count ? count : 1, 64);
+    if (!*names) {
+        pthread_mutex_unlock(&manager->mutex);
+        return -1;
+    }
+
+    uint32_t i = 0;
+    TAILQ_FOREACH(node, &manager->process_list, entries) {
+        memcpy((*names)[i++], node->name, sizeof(node->name));
+    }
+
+    pthread_mutex_unlock(&manager->mutex);
+    return (int)count;
+}
+
+static int start_operation(void* target, const char* name) {
+    return process_manager_start_process(target, name);
+}
+
+static int stop_operation(void* target, const char* name) {
+    return process_manager_stop_process(target, name);
+}
+
+static void stop_escalation(void* target, const char* name) {
+    ProcessManager* manager = target;
+
+    // 升级在协调线程上进行，不得阻塞: 只通知进程内插件，代理调用可能等到宿主超时
+    ProcessInterface* interface = NULL;
+    TaskEpochGuard guard = process_interface_enter();
+    pthread_mutex_lock(&manager->mutex);
+    ProcessNode* node = process_find_node_locked(manager, name);
+    if (node && node->is_running && !node->stop_abandoned && !node->host) {
+        interface = node->interface;
+    }
+    pthread_mutex_unlock(&manager->mutex);
+
+    if (interface && interface->handle_signal) {
+        interface->handle_signal(SIGTERM);
+    }
+    process_interface_exit(guard);
+}
+
+/**
+ * 限时停止的中断回调 - 让插件再次唤醒其主循环
+ */
+static void interrupt_process(void* context) {
+    ProcessInterface* interface = context;
+    if (interface->handle_signal) {
+        interface->handle_signal(SIGTERM);
+    }
+}
+
+static int run_all(ProcessManager* manager, LifecycleOperation operation, LifecycleEscalation escalate,
+                   const LifecycleOptions* options, LifecycleReport* report) {
+    // 失败时调用者仍可安全读取报告和调用lifecycle_report_free
+    if (report) {
+        memset(report, 0, sizeof(LifecycleReport));
+    }
+    if (!manager) {
+        return -1;
+    }
+
+    char (*names)[64];
+    int count = collect_process_names(manager, &names);
+    if (count < 0) {
+        return -1;
+    }
+
+    int ret = lifecycle_run(manager, names, (uint32_t)count, operation, escalate, options, report);
+    free(names);
+    return ret;
+}
+
+int process_manager_start_all_parallel(ProcessManager* manager, const LifecycleOptions* options,
+                                       LifecycleReport* report) {
+    return run_all(manager, start_operation, NULL, options, report);
+}
+
+int process_manager_stop_all_parallel(ProcessManager* manager, const LifecycleOptions* options,
+                                      LifecycleReport* report) {
+    return run_all(manager, stop_operation, stop_escalation, options, report);
+}
+
+int process_manager_stop_process_timed(ProcessManager* manager, const char* name,
+                                       const TaskStopOptions* options) {
+    if (!manager || !name) {
+        return -1;
+    }
+
+    TaskEpochGuard guard = process_interface_enter();
+    pthread_mutex_lock(&manager->mutex);
+    ProcessNode* node = process_find_node_locked(manager, name);
+    if (!node) {
+        pthread_mutex_unlock(&manager->mutex);
+        process_interface_exit(guard);
+        return -1;
+    }
+    bool running = node->is_running && !node->stop_abandoned;
+    ProcessInterface* interface = node->interface;
+    pthread_t thread = node->thread;
+    pthread_mutex_unlock(&manager->mutex);
+
+    if (!running) {
+        process_interface_exit(guard);
+        return TASK_STOP_CLEAN;
+    }
+
+    // 插件的stop只发出停止请求，等待由升级流程限时完成；升级期间中断回调仍会调用插件
+    uint64_t start = get_monotonic_ns();
+    if (interface && interface->stop) {
+        interface->stop();
+    }
+    TaskStopOutcome outcome = task_stop_join_thread(thread, options, start,
+                                                    interface ? interrupt_process : NULL, interface);
+    uint64_t elapsed = get_monotonic_ns() - start;
+    process_interface_exit(guard);
+
+    pthread_mutex_lock(&manager->mutex);
+    node = process_find_node_locked(manager, name);
+    if (node) {
+        node->is_running = false;
+        node->stop_time_ns = elapsed;
+        if (outcome != TASK_STOP_CLEAN) {
+            node->stop_escalations++;
+        }
+        if (outcome == TASK_STOP_CANCELLED || outcome == TASK_STOP_DETACHED) {
+            node->stop_abandoned = true;
+        }
+    }
+    pthread_mutex_unlock(&manager->mutex);
+
+    task_stop_record(elapsed);
+
+    if (outcome != TASK_STOP_CLEAN && manager->log_callback) {
+        char message[160];
+        snprintf(message, sizeof(message), "进程 %s 未在期限内停止: %s (%.1f ms)",
+                 name, task_stop_outcome_name(outcome), elapsed / 1e6);
+        manager->log_callback(outcome == TASK_STOP_INTERRUPTED ? LOG_LEVEL_WARN : LOG_LEVEL_ERROR, message);
+    }
+    return outcome;
+}
+
+static bool process_ready_probe(void* target, const char* name) {
+    ProcessManager* manager = target;
+
+    TaskEpochGuard guard = process_interface_enter();
+    pthread_mutex_lock(&manager->mutex);
+    ProcessNode* node = process_find_node_locked(manager, name);
+    const ProcessInterface* interface = node && node->is_running ? node->interface : NULL;
+    pthread_mutex_unlock(&manager->mutex);
+
+    // 隔离加载的插件的查询是代理调用，可能等待宿主应答，不持锁
+    bool ready = interface != NULL;
+    if (ready && interface->get_state) {
+        ready = interface->get_state() == PROCESS_STATE_RUNNING;
+    }
+    if (ready && interface->health_check) {
+        ready = interface->health_check();
+    }
+    process_interface_exit(guard);
+    return ready;
+}
+
+static int ordered_start_operation(void* target, const char* name) {
+    // 已经就绪的进程不再重复启动
+    if (process_ready_probe(target, name)) {
+        return 0;
+    }
+    return process_manager_start_process(target, name);
+}
+
+int process_manager_set_dependencies(ProcessManager* manager, const char* name,
+                                     const char (*depends_on)[64], uint32_t count) {
+    if (!manager || !name || (count > 0 && !depends_on) || count > STARTUP_MAX_DEPENDENCIES) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&manager->mutex);
+    ProcessNode* node = process_find_node_locked(manager, name);
+    if (node) {
+        memset(node->depends_on, 0, sizeof(node->depends_on));
+        for (uint32_t i = 0; i < count; i++) {
+            strncpy(node->depends_on[i], depends_on[i], 63);
+        }
+        node->dependency_count = count;
+    }
+    pthread_mutex_unlock(&manager->mutex);
+
+    return node ? 0 : -1;
+}
+
+int process_manager_start_ordered(ProcessManager* manager, char (*names)[64], uint32_t count,
+                                  const StartupOptions* options, StartupReport* report) {
+    if (!manager || (count > 0 && !names)) {
+        return -1;
+    }
+
+    char (*all_names)[64] = NULL;
+    if (!names) {
+        int total = collect_process_names(manager, &all_names);
+        if (total < 0) {
+            return -1;
+        }
+        names = all_names;
+        count = (uint32_t)total;
+    }
+
+    StartupNode* nodes = calloc(count ? count : 1, sizeof(StartupNode));
+    if (!nodes) {
+        free(all_names);
+        return -1;
+    }
+
+    // 未加载的进程保留空依赖，启动操作会失败并阻塞其下游
+    pthread_mutex_lock(&manager->mutex);
+    for (uint32_t i = 0; i < count; i++) {
+        strncpy(nodes[i].name, names[i], 63);
+        ProcessNode* node = process_find_node_locked(manager, names[i]);
+        if (node) {
+            nodes[i].dependency_count = node->dependency_count;
+            memcpy(nodes[i].depends_on, node->depends_on, sizeof(nodes[i].depends_on));
+        }
+    }
+    pthread_mutex_unlock(&manager->mutex);
+
+    int ret = startup_graph_run(manager, nodes, count, ordered_start_operation, process_ready_probe,
+                                options, report);
+    free(nodes);
+    free(all_names);
+    return ret;
+}
+
+int process_manager_set_restart_policy(ProcessManager* manager, const char* name, const RestartPolicy* policy) {
+    if (!manager || !name) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&manager->mutex);
+    ProcessNode* node = process_find_node_locked(manager, name);
+    if (node) {
+        if (policy) {
+            node->restart_policy = *policy;
+        } else {
+            memset(&node->restart_policy, 0, sizeof(RestartPolicy));
+        }
+    }
+    pthread_mutex_unlock(&manager->mutex);
+
+    return node ? 0 : -1;
+}
+
+/**
+ * 获取自动重启所依据的插件信息 - 调用者持有manager->mutex
+ * get_process_info返回加载时的信息(代理接口返回握手时的副本)，不等待宿主
+ * @return 插件信息，未加载或不自动重启返回NULL
+ */
+static const ProcessInfo* restart_info_locked(const ProcessNode* node) {
+    const ProcessInterface* interface = node->interface;
+    const ProcessInfo* info = interface && interface->get_process_info ? interface->get_process_info() : NULL;
+    return info && info->auto_restart ? info : NULL;
+}
+
+/**
+ * 查询插件是否自报ERROR - 不持锁调用get_state(隔离加载时是代理调用)
+ * @return true插件报告ERROR
+ */
+static bool process_reports_error(ProcessManager* manager, const char* name) {
+    TaskEpochGuard guard = process_interface_enter();
+    pthread_mutex_lock(&manager->mutex);
+    ProcessNode* node = process_find_node_locked(manager, name);
+    const ProcessInterface* interface = NULL;
+    if (node && !node->stop_abandoned && restart_info_locked(node)) {
+        interface = node->interface;
+    }
+    pthread_mutex_unlock(&manager->mutex);
+
+    bool reported_error = interface && interface->get_state && interface->get_state() == PROCESS_STATE_ERROR;
+    process_interface_exit(guard);
+    return reported_error;
+}
+
+/**
+ * 在manager->mutex下推进重启状态并导出统计
+ * @param reported_error 插件是否自报ERROR(由process_reports_error在锁外查询)
+ * @return true计划的重启已到期
+ */
+static bool update_restart_state(ProcessNode* node, bool reported_error, uint64_t now) {
+    const ProcessInfo* info = restart_info_locked(node);
+    if (!info) {
+        return false;
+    }
+
+    RestartPolicy policy = node->restart_policy;
+    restart_policy_normalize(&policy, info->restart_count);
+
+    // 限时停止放弃等待的进程是操作者要求停止的，线程可能仍在运行，不自动重启
+    bool failed = false;
+    if (!node->stop_abandoned) {
+        failed = (!node->is_running && node->should_restart) || reported_error;
+    }
+
+    bool due = false;
+    if (failed) {
+        restart_state_schedule(&node->restart_state, &policy, now);
+        due = restart_state_due(&node->restart_state, now);
+    } else if (node->is_running) {
+        restart_state_mark_running(&node->restart_state, &policy, now);
+    }
+
+    restart_state_export(&node->restart_state, &policy, now, &node->restart_stats);
+    return due;
+}
+
+int process_manager_check_restarts(ProcessManager* manager) {
+    if (!manager) {
+        return -1;
+    }
+
+    char (*names)[64];
+    int count = collect_process_names(manager, &names);
+    if (count < 0) {
+        return -1;
+    }
+
+    int restarted = 0;
+    for (int i = 0; i < count; i++) {
+        bool reported_error = process_reports_error(manager, names[i]);
+        pthread_mutex_lock(&manager->mutex);
+        ProcessNode* node = process_find_node_locked(manager, names[i]);
+        bool due = node && update_restart_state(node, reported_error, get_monotonic_ns());
+        pthread_mutex_unlock(&manager->mutex);
+
+        if (!due) {
+            continue;
+        }
+
+        // 重启会等待进程线程退出，不持锁
+        int ret = process_manager_restart_process(manager, names[i]);
+        restarted += ret == 0;
+
+        reported_error = process_reports_error(manager, names[i]);
+        pthread_mutex_lock(&manager->mutex);
+        node = process_find_node_locked(manager, names[i]);
+        if (node) {
+            uint64_t now = get_monotonic_ns();
+            restart_state_restarted(&node->restart_state, now);
+            update_restart_state(node, reported_error, now);
+        }
+        pthread_mutex_unlock(&manager->mutex);
+    }
+
+    free(names);
+    return restarted;
+}
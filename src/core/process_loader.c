@@ -0,0 +1,1047 @@
+#define _GNU_SOURCE
+#include "process_manager.h"
+#include "core_internal.h"
+#include "task_index.h"
+#include <dlfcn.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+/**
+ * 一次批量加载的上下文 - lifecycle_run的target
+ */
+typedef struct {
+    ProcessManager* manager;
+    const ProcessLoadRequest* requests;
+    uint32_t* order;                  // 按优先级排序后的请求下标
+    ProcessLoadEntry* entries;        // 与order一一对应
+    bool* claimed;                    // 条目已被某个操作领取(原子访问，本批中重名的请求各占一个条目)
+    uint32_t count;
+    uint64_t begin_ns;                // 整批开始时刻
+} LoadContext;
+
+/**
+ * 一个已打开的插件实例 - 节点持有的加载产物，热重载时整体交换
+ */
+typedef struct {
+    void* handle;                     // 动态库句柄(隔离加载时为NULL)
+    ProcessInterface* interface;      // 插件接口(隔离加载时为代理)
+    PluginHost* host;                 // 插件宿主(进程内加载时为NULL)
+    int image_fd;                     // 私有副本的描述符(>0时有效)
+    ProcessStatsPage* stats_page;     // 插件在写的统计页(插件未导出设置函数时为NULL)
+    ProcessAsyncAdapter* async;       // v2插件的适配器(v1插件和隔离加载时为NULL)
+    uint32_t interface_version;       // 插件报告的接口版本
+    uint64_t capabilities;            // v2插件声明的PROCESS_CAP_*
+} PluginInstance;
+
+// 延迟加载、空闲卸载和热重载互相串行: 避免同一进程被并发加载或替换，加载期间不持有manager->mutex
+static pthread_mutex_t g_load_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+// 不持manager->mutex调用插件接口的读者(快照、就绪探测、限时停止等)，释放旧实例前等待它们退出
+static TaskEpochDomain g_interface_epoch = { .writer_mutex = PTHREAD_MUTEX_INITIALIZER };
+
+TaskEpochGuard process_interface_enter(void) {
+    return task_epoch_enter(&g_interface_epoch);
+}
+
+void process_interface_exit(TaskEpochGuard guard) {
+    task_epoch_exit(&g_interface_epoch, guard);
+}
+
+ProcessNode* process_find_node_locked(ProcessManager* manager, const char* name) {
+    ProcessNode* node;
+    TAILQ_FOREACH(node, &manager->process_list, entries) {
+        if (strcmp(node->name, name) == 0) {
+            return node;
+        }
+    }
+    return NULL;
+}
+
+static ProcessNode* new_node(const char* name, const char* library_path, const char* config_data) {
+    ProcessNode* node = calloc(1, sizeof(ProcessNode));
+    if (!node) {
+        return NULL;
+    }
+
+    strncpy(node->name, name, sizeof(node->name) - 1);
+    strncpy(node->library_path, library_path, sizeof(node->library_path) - 1);
+    if (config_data) {
+        strncpy(node->config_data, config_data, sizeof(node->config_data) - 1);
+    }
+    // 按名称播种抖动，同时失败的进程不会同步重启
+    restart_state_init(&node->restart_state, task_index_hash(name));
+    return node;
+}
+
+/**
+ * 插入节点，同名进程已存在时释放节点
+ * @return 0成功，-1同名进程已存在
+ */
+static int insert_node(ProcessManager* manager, ProcessNode* node) {
+    pthread_mutex_lock(&manager->mutex);
+    bool exists = process_find_node_locked(manager, node->name) != NULL;
+    if (!exists) {
+        TAILQ_INSERT_TAIL(&manager->process_list, node, entries);
+        manager->list_generation++;
+    }
+    pthread_mutex_unlock(&manager->mutex);
+
+    if (exists) {
+        free(node);
+        return -1;
+    }
+    return 0;
+}
+
+int process_manager_add_plugin(ProcessManager* manager, const char* name, const char* library_path,
+                               const char* config_data, void* lib_handle, ProcessInterface* interface,
+                               PluginHost* host) {
+    if (!manager || !name || !library_path || !interface) {
+        return -1;
+    }
+
+    ProcessNode* node = new_node(name, library_path, config_data);
+    if (!node) {
+        return -1;
+    }
+    node->lib_handle = lib_handle;
+    node->interface = interface;
+    node->host = host;
+    return insert_node(manager, node);
+}
+
+int process_manager_register_lazy(ProcessManager* manager, const char* name, const char* library_path,
+                                  const char* config_data, bool isolated, uint32_t idle_unload_ms) {
+    if (!manager || !name || !library_path) {
+        return -1;
+    }
+
+    ProcessNode* node = new_node(name, library_path, config_data);
+    if (!node) {
+        return -1;
+    }
+    node->lazy = true;
+    node->lazy_isolated = isolated;
+    node->idle_unload_ms = idle_unload_ms;
+    return insert_node(manager, node);
+}
+
+static uint64_t elapsed_us(const LoadContext* context) {
+    return (get_monotonic_ns() - context->begin_ns) / 1000;
+}
+
+/**
+ * 释放插件实例 - 进程内加载时cleanup后dlclose，隔离加载时经代理cleanup后销毁宿主；
+ * 统计页在插件不再写入后删除
+ * @param initialized 是否调用过initialize(决定是否调用cleanup)
+ */
+static void close_instance(PluginInstance* instance, bool initialized) {
+    if (initialized && instance->interface && instance->interface->cleanup) {
+        instance->interface->cleanup();
+    }
+    // cleanup之后插件不再通知
+    process_async_destroy(instance->async);
+    if (instance->host) {
+        plugin_host_destroy(instance->host);
+    } else if (instance->handle) {
+        dlclose(instance->handle);
+    }
+    if (instance->image_fd > 0) {
+        close(instance->image_fd);
+    }
+    process_stats_page_destroy(instance->stats_page);
+    memset(instance, 0, sizeof(PluginInstance));
+}
+
+static void take_instance_locked(ProcessNode* node, PluginInstance* instance) {
+    instance->handle = node->lib_handle;
+    instance->interface = node->interface;
+    instance->host = node->host;
+    instance->image_fd = node->image_fd;
+    instance->stats_page = node->stats_page;
+    instance->async = node->async;
+    instance->interface_version = node->interface_version;
+    instance->capabilities = node->capabilities;
+}
+
+static void put_instance_locked(ProcessNode* node, const PluginInstance* instance) {
+    node->lib_handle = instance->handle;
+    node->host = instance->host;
+    node->image_fd = instance->image_fd;
+    node->stats_page = instance->stats_page;
+    node->async = instance->async;
+    node->interface_version = instance->interface_version;
+    node->capabilities = instance->capabilities;
+    // 不持锁读取interface的路径(如进程线程)看到的是完整的旧实例或新实例
+    __atomic_store_n(&node->interface, instance->interface, __ATOMIC_RELEASE);
+}
+
+/**
+ * 把动态库复制到memfd - dlopen按路径去重，原地替换的同名文件须换一个路径才能与旧版本同时加载
+ * 描述符须保持打开到dlclose之后，否则新的副本可能复用同一个/proc/self/fd路径
+ * @return 描述符，失败返回-1
+ */
+static int copy_to_memfd(const char* library_path) {
+    int source = open(library_path, O_RDONLY | O_CLOEXEC);
+    if (source < 0) {
+        return -1;
+    }
+
+    int fd = memfd_create("plugin", MFD_CLOEXEC);
+    bool ok = fd >= 0;
+    char buffer[65536];
+    while (ok) {
+        ssize_t n = read(source, buffer, sizeof(buffer));
+        if (n <= 0) {
+            ok = n == 0;
+            break;
+        }
+        ok = write(fd, buffer, (size_t)n) == n;
+    }
+    close(source);
+
+    if (!ok) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * 在宿主进程中打开并初始化插件 - 创建宿主时已完成dlopen和解析
+ */
+static int open_isolated(LoadContext* context, const ProcessLoadRequest* request, ProcessLoadEntry* entry,
+                         PluginInstance* instance) {
+    // 插件是否导出设置函数要等宿主加载后才知道，先创建页面
+    instance->stats_page = process_stats_page_create(request->name);
+    PluginHostOptions options = {
+        .log_callback = context->manager->log_callback,
+        .stats_page_name = instance->stats_page ? instance->stats_page->shm_name : NULL,
+    };
+    instance->host = plugin_host_create(request->name, request->library_path, &options);
+    entry->open_us = entry->resolve_us = elapsed_us(context);
+    if (!instance->host) {
+        snprintf(entry->error, sizeof(entry->error), "无法创建插件宿主");
+        close_instance(instance, false);
+        return -1;
+    }
+
+    PluginHostInfo info;
+    bool have_info = plugin_host_get_info(instance->host, &info) == 0;
+    if (!have_info || !info.stats_page_attached) {
+        process_stats_page_destroy(instance->stats_page);
+        instance->stats_page = NULL;
+    }
+    if (have_info) {
+        instance->interface_version = info.interface_version;
+        instance->capabilities = info.capabilities;
+    }
+
+    instance->interface = plugin_host_get_interface(instance->host);
+    int ret = instance->interface->initialize(request->config_data ? request->config_data : "",
+                                              context->manager->log_callback);
+    entry->ready_us = elapsed_us(context);
+    if (ret != 0) {
+        snprintf(entry->error, sizeof(entry->error), "initialize返回%d", ret);
+        close_instance(instance, false);
+        return -1;
+    }
+    return 0;
+}
+
+static int open_in_process(LoadContext* context, const ProcessLoadRequest* request, ProcessLoadEntry* entry,
+                           bool private_copy, PluginInstance* instance) {
+    char image_path[64];
+    const char* open_path = request->library_path;
+    if (private_copy) {
+        instance->image_fd = copy_to_memfd(request->library_path);
+        if (instance->image_fd < 0) {
+            snprintf(entry->error, sizeof(entry->error), "无法复制动态库: %s", strerror(errno));
+            instance->image_fd = 0;
+            return -1;
+        }
+        snprintf(image_path, sizeof(image_path), "/proc/self/fd/%d", instance->image_fd);
+        open_path = image_path;
+    }
+
+    void* handle = dlopen(open_path, RTLD_NOW | RTLD_LOCAL);
+    entry->open_us = elapsed_us(context);
+    if (!handle) {
+        snprintf(entry->error, sizeof(entry->error), "%s", dlerror());
+        close_instance(instance, false);
+        return -1;
+    }
+    instance->handle = handle;
+
+    ProcessInterface* (*get_interface)(void) = (ProcessInterface* (*)(void))dlsym(handle, "get_process_interface");
+    uint32_t (*get_version)(void) = (uint32_t (*)(void))dlsym(handle, "get_interface_version");
+    ProcessInterface* interface = NULL;
+    uint32_t version = get_version ? get_version() : 0;
+    uint32_t major = PROCESS_INTERFACE_MAJOR(version);
+    if (!get_interface || !get_version) {
+        snprintf(entry->error, sizeof(entry->error), "缺少插件导出函数");
+    } else if (major != PROCESS_INTERFACE_MAJOR(PROCESS_INTERFACE_VERSION) &&
+               major != PROCESS_INTERFACE_MAJOR(PROCESS_INTERFACE_VERSION_2)) {
+        snprintf(entry->error, sizeof(entry->error), "接口版本0x%08x不兼容", version);
+    } else if (!(interface = get_interface())) {
+        snprintf(entry->error, sizeof(entry->error), "get_process_interface返回NULL");
+    }
+    instance->interface_version = version;
+
+    // v2插件经适配器提供v1形式的接口，通知须在initialize之前绑定
+    ProcessInterfaceV2* plugin = NULL;
+    if (interface && major == PROCESS_INTERFACE_MAJOR(PROCESS_INTERFACE_VERSION_2)) {
+        plugin = (ProcessInterfaceV2*)interface;
+        if (plugin->size < sizeof(ProcessInterfaceV2) || !plugin->bind_notifier) {
+            snprintf(entry->error, sizeof(entry->error), "ProcessInterfaceV2不完整(size %u)", plugin->size);
+            interface = NULL;
+        } else if (!(instance->async = process_async_create(request->name, plugin,
+                                                             context->manager->log_callback))) {
+            snprintf(entry->error, sizeof(entry->error), "无法创建v2适配器");
+            interface = NULL;
+        } else {
+            interface = process_async_get_interface(instance->async);
+            instance->capabilities = plugin->capabilities;
+        }
+    }
+    entry->resolve_us = elapsed_us(context);
+    if (!interface) {
+        close_instance(instance, false);
+        return -1;
+    }
+    instance->interface = interface;
+
+    // 统计页须在initialize之前交给插件
+    ProcessStatsPageSetter set_page = (ProcessStatsPageSetter)dlsym(handle, PROCESS_STATS_PAGE_SETTER);
+    if (plugin && (plugin->capabilities & PROCESS_CAP_BATCH_STATS) && plugin->set_stats_page) {
+        set_page = plugin->set_stats_page;
+    }
+    if (set_page) {
+        instance->stats_page = process_stats_page_create(request->name);
+        if (instance->stats_page) {
+            set_page(instance->stats_page);
+        }
+    }
+
+    int ret = interface->initialize ? interface->initialize(request->config_data ? request->config_data : "",
+                                                            context->manager->log_callback)
+                                    : 0;
+    entry->ready_us = elapsed_us(context);
+    if (ret != 0) {
+        snprintf(entry->error, sizeof(entry->error), "initialize返回%d", ret);
+        close_instance(instance, false);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * 打开并初始化插件
+ * @param private_copy 进程内加载时经memfd副本加载(见copy_to_memfd)
+ */
+static int open_plugin(LoadContext* context, const ProcessLoadRequest* request, ProcessLoadEntry* entry,
+                       bool private_copy, PluginInstance* instance) {
+    memset(instance, 0, sizeof(PluginInstance));
+    return request->isolated ? open_isolated(context, request, entry, instance)
+                             : open_in_process(context, request, entry, private_copy, instance);
+}
+
+static int load_request(LoadContext* context, const ProcessLoadRequest* request, ProcessLoadEntry* entry) {
+    if (request->lazy) {
+        entry->deferred = true;
+        entry->open_us = entry->resolve_us = entry->ready_us = entry->start_us;
+        if (process_manager_register_lazy(context->manager, request->name, request->library_path,
+                                          request->config_data, request->isolated, request->idle_unload_ms) != 0) {
+            snprintf(entry->error, sizeof(entry->error), "同名进程已存在");
+            return -1;
+        }
+        return 0;
+    }
+
+    PluginInstance instance;
+    if (open_plugin(context, request, entry, false, &instance) != 0) {
+        return -1;
+    }
+
+    ProcessNode* node = new_node(request->name, request->library_path, request->config_data);
+    if (node) {
+        put_instance_locked(node, &instance);
+    }
+    if (!node || insert_node(context->manager, node) != 0) {
+        snprintf(entry->error, sizeof(entry->error), "同名进程已存在");
+        close_instance(&instance, true);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * lifecycle_run的操作 - 按名称找到本批中的请求并加载
+ */
+static int load_operation(void* target, const char* name) {
+    LoadContext* context = target;
+
+    ProcessLoadEntry* entry = NULL;
+    const ProcessLoadRequest* request = NULL;
+    for (uint32_t i = 0; i < context->count; i++) {
+        if (strcmp(context->entries[i].name, name) == 0 &&
+            !__atomic_exchange_n(&context->claimed[i], true, __ATOMIC_ACQ_REL)) {
+            entry = &context->entries[i];
+            request = &context->requests[context->order[i]];
+            break;
+        }
+    }
+    if (!entry) {
+        return -1;
+    }
+
+    entry->start_us = elapsed_us(context);
+
+    // 提前发现重名，避免为注定失败的插件执行initialize
+    pthread_mutex_lock(&context->manager->mutex);
+    bool exists = process_find_node_locked(context->manager, request->name) != NULL;
+    pthread_mutex_unlock(&context->manager->mutex);
+
+    int ret;
+    if (exists) {
+        snprintf(entry->error, sizeof(entry->error), "同名进程已存在");
+        ret = -1;
+    } else {
+        ret = load_request(context, request, entry);
+    }
+
+    if (ret != 0) {
+        // 失败时把尚未到达的阶段记为失败时刻
+        uint64_t now = elapsed_us(context);
+        entry->open_us = entry->open_us ? entry->open_us : now;
+        entry->resolve_us = entry->resolve_us ? entry->resolve_us : now;
+        entry->ready_us = entry->ready_us ? entry->ready_us : now;
+    }
+    entry->result = ret;
+    return ret;
+}
+
+typedef struct {
+    int priority;
+    uint32_t index;
+} LoadOrder;
+
+static int compare_priority_desc(const void* a, const void* b) {
+    const LoadOrder* x = a;
+    const LoadOrder* y = b;
+    if (x->priority != y->priority) {
+        return x->priority > y->priority ? -1 : 1;
+    }
+    // qsort不稳定，以请求下标作为次关键字保持请求顺序
+    return x->index < y->index ? -1 : x->index > y->index ? 1 : 0;
+}
+
+int process_manager_load_plugins(ProcessManager* manager, const ProcessLoadRequest* requests, uint32_t count,
+                                 const ProcessLoadOptions* options, ProcessLoadReport* report) {
+    if (report) {
+        memset(report, 0, sizeof(ProcessLoadReport));
+    }
+    if (!manager || (count > 0 && !requests)) {
+        return -1;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        if (!requests[i].name || !requests[i].library_path) {
+            return -1;
+        }
+    }
+
+    ProcessLoadOptions defaults = {0};
+    if (!options) {
+        options = &defaults;
+    }
+
+    LoadContext context = {
+        .manager = manager,
+        .requests = requests,
+        .count = count,
+    };
+    uint32_t allocation = count ? count : 1;
+    LoadOrder* sorted = calloc(allocation, sizeof(LoadOrder));
+    context.order = calloc(allocation, sizeof(uint32_t));
+    context.entries = calloc(allocation, sizeof(ProcessLoadEntry));
+    context.claimed = calloc(allocation, sizeof(bool));
+    char (*names)[64] = calloc(allocation, 64);
+    if (!sorted || !context.order || !context.entries || !context.claimed || !names) {
+        free(sorted);
+        free(context.order);
+        free(context.entries);
+        free(context.claimed);
+        free(names);
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        sorted[i].priority = requests[i].priority;
+        sorted[i].index = i;
+    }
+    qsort(sorted, count, sizeof(LoadOrder), compare_priority_desc);
+
+    for (uint32_t i = 0; i < count; i++) {
+        context.order[i] = sorted[i].index;
+        const ProcessLoadRequest* request = &requests[context.order[i]];
+        strncpy(context.entries[i].name, request->name, sizeof(context.entries[i].name) - 1);
+        strncpy(names[i], request->name, 63);
+        context.entries[i].priority = request->priority;
+        context.entries[i].result = -1;
+    }
+
+    // 加载没有超时升级，整批等待全部完成
+    LifecycleOptions run_options = {
+        .task_timeout_ms = 0,
+        .global_timeout_ms = 0,
+        .max_parallel = options->max_parallel,
+    };
+
+    context.begin_ns = get_monotonic_ns();
+    uint32_t group_begin = 0;
+    int ret = 0;
+    while (group_begin < count && ret >= 0) {
+        // 无屏障时整批一次派发，派发顺序即优先级顺序
+        uint32_t group_end = count;
+        if (options->priority_barrier) {
+            group_end = group_begin + 1;
+            while (group_end < count && context.entries[group_end].priority == context.entries[group_begin].priority) {
+                group_end++;
+            }
+        }
+
+        ret = lifecycle_run(&context, &names[group_begin], group_end - group_begin, load_operation, NULL,
+                            &run_options, NULL);
+        group_begin = group_end;
+    }
+    uint64_t total_us = elapsed_us(&context);
+    free(names);
+    free(sorted);
+    free(context.claimed);
+
+    uint32_t failed = 0;
+    uint32_t deferred = 0;
+    uint64_t serial_us = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        const ProcessLoadEntry* entry = &context.entries[i];
+        failed += entry->result != 0;
+        deferred += entry->result == 0 && entry->deferred;
+        serial_us += entry->ready_us - entry->start_us;
+    }
+
+    if (report) {
+        report->entries = context.entries;
+        report->count = count;
+        report->loaded = count - failed;
+        report->failed = failed;
+        report->deferred = deferred;
+        report->total_us = total_us;
+        report->serial_us = serial_us;
+    } else {
+        free(context.entries);
+    }
+    free(context.order);
+
+    return ret < 0 ? -1 : (int)failed;
+}
+
+void process_load_report_free(ProcessLoadReport* report) {
+    if (!report) {
+        return;
+    }
+
+    free(report->entries);
+    memset(report, 0, sizeof(ProcessLoadReport));
+}
+
+int process_manager_ensure_loaded(ProcessManager* manager, const char* name) {
+    if (!manager || !name) {
+        return -1;
+    }
+
+    // 已加载时不取g_load_mutex: 热重载持有它期间会经process_manager_start_process回到这里
+    pthread_mutex_lock(&manager->mutex);
+    ProcessNode* node = process_find_node_locked(manager, name);
+    bool loaded = node && node->interface;
+    pthread_mutex_unlock(&manager->mutex);
+    if (!node || loaded) {
+        return node ? 0 : -1;
+    }
+
+    pthread_mutex_lock(&g_load_mutex);
+
+    pthread_mutex_lock(&manager->mutex);
+    node = process_find_node_locked(manager, name);
+    if (!node || node->interface) {
+        pthread_mutex_unlock(&manager->mutex);
+        pthread_mutex_unlock(&g_load_mutex);
+        return node ? 0 : -1;
+    }
+    char library_path[sizeof(node->library_path)];
+    char config_data[sizeof(node->config_data)];
+    memcpy(library_path, node->library_path, sizeof(library_path));
+    memcpy(config_data, node->config_data, sizeof(config_data));
+    ProcessLoadRequest request = {
+        .name = name,
+        .library_path = library_path,
+        .config_data = config_data,
+        .isolated = node->lazy_isolated,
+    };
+    pthread_mutex_unlock(&manager->mutex);
+
+    LoadContext context = {
+        .manager = manager,
+        .begin_ns = get_monotonic_ns(),
+    };
+    ProcessLoadEntry entry;
+    memset(&entry, 0, sizeof(entry));
+    PluginInstance instance;
+    int ret = open_plugin(&context, &request, &entry, false, &instance);
+
+    if (ret == 0) {
+        // 加载期间节点可能已被移除
+        pthread_mutex_lock(&manager->mutex);
+        node = process_find_node_locked(manager, name);
+        if (node && !node->interface) {
+            put_instance_locked(node, &instance);
+            node->idle_since_ns = 0;
+            node->lazy_loads++;
+        } else {
+            ret = -1;
+            snprintf(entry.error, sizeof(entry.error), "进程已被移除");
+        }
+        pthread_mutex_unlock(&manager->mutex);
+        if (ret != 0) {
+            close_instance(&instance, true);
+        }
+    }
+
+    pthread_mutex_unlock(&g_load_mutex);
+
+    if (manager->log_callback) {
+        char message[512];
+        if (ret == 0) {
+            snprintf(message, sizeof(message), "进程 %s 延迟加载: %s (%.1f ms)", name, library_path,
+                     entry.ready_us / 1000.0);
+        } else {
+            snprintf(message, sizeof(message), "进程 %s 延迟加载失败: %s", name, entry.error);
+        }
+        manager->log_callback(ret == 0 ? LOG_LEVEL_INFO : LOG_LEVEL_ERROR, message);
+    }
+    return ret;
+}
+
+typedef struct {
+    char name[64];
+    PluginInstance instance;
+} UnloadItem;
+
+int process_manager_unload_idle(ProcessManager* manager) {
+    if (!manager) {
+        return -1;
+    }
+
+    // 与延迟加载串行，卸载中的进程不会同时被重新加载
+    pthread_mutex_lock(&g_load_mutex);
+    pthread_mutex_lock(&manager->mutex);
+
+    uint32_t capacity = 0;
+    ProcessNode* node;
+    TAILQ_FOREACH(node, &manager->process_list, entries) {
+        capacity += node->lazy && node->interface;
+    }
+    UnloadItem* items = capacity ? calloc(capacity, sizeof(UnloadItem)) : NULL;
+    if (capacity && !items) {
+        pthread_mutex_unlock(&manager->mutex);
+        pthread_mutex_unlock(&g_load_mutex);
+        return -1;
+    }
+
+    uint64_t now = get_monotonic_ns();
+    uint32_t count = 0;
+    TAILQ_FOREACH(node, &manager->process_list, entries) {
+        if (!node->lazy || !node->interface || node->idle_unload_ms == 0) {
+            continue;
+        }
+        // 运行中、线程被放弃或等待重启的进程仍需要插件
+        if (node->is_running || node->stop_abandoned || node->restart_stats.pending) {
+            node->idle_since_ns = 0;
+            continue;
+        }
+        if (node->idle_since_ns == 0) {
+            node->idle_since_ns = now;
+            continue;
+        }
+        if (now - node->idle_since_ns < (uint64_t)node->idle_unload_ms * 1000000ULL) {
+            continue;
+        }
+
+        UnloadItem* item = &items[count++];
+        memcpy(item->name, node->name, sizeof(item->name));
+        take_instance_locked(node, &item->instance);
+        PluginInstance empty;
+        memset(&empty, 0, sizeof(empty));
+        put_instance_locked(node, &empty);
+        node->idle_since_ns = 0;
+    }
+    pthread_mutex_unlock(&manager->mutex);
+
+    // 摘除前取得旧接口的锁外调用者退出后才能释放；cleanup和dlclose(或等待宿主退出)可能较慢，不持有管理器锁
+    if (count > 0) {
+        task_epoch_synchronize(&g_interface_epoch);
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        close_instance(&items[i].instance, true);
+        if (manager->log_callback) {
+            char message[128];
+            snprintf(message, sizeof(message), "进程 %s 空闲卸载", items[i].name);
+            manager->log_callback(LOG_LEVEL_INFO, message);
+        }
+    }
+    pthread_mutex_unlock(&g_load_mutex);
+
+    free(items);
+    return (int)count;
+}
+
+/**
+ * 等待插件报告RUNNING - v2插件等待通知，v1插件轮询get_state
+ * @return true期限内就绪
+ */
+static bool wait_running(const PluginInstance* instance, uint32_t timeout_ms) {
+    if (instance->async) {
+        return process_async_wait_state(instance->async, PROCESS_STATE_RUNNING, timeout_ms) == 0;
+    }
+
+    ProcessInterface* interface = instance->interface;
+    if (!interface->get_state) {
+        return true;
+    }
+
+    uint64_t deadline = get_monotonic_ns() + (uint64_t)timeout_ms * 1000000ULL;
+    for (;;) {
+        ProcessState state = interface->get_state();
+        if (state == PROCESS_STATE_RUNNING) {
+            return true;
+        }
+        if (state == PROCESS_STATE_ERROR || get_monotonic_ns() >= deadline) {
+            return false;
+        }
+        // v1插件没有通知，与process_manager_wait_state一样按固定间隔轮询
+        usleep(PROCESS_WAIT_POLL_MS * 1000);
+    }
+}
+
+static void copy_version(char* buffer, size_t size, ProcessInterface* interface) {
+    const ProcessInfo* info = interface && interface->get_process_info ? interface->get_process_info() : NULL;
+    snprintf(buffer, size, "%s", info ? info->version : "?");
+}
+
+/**
+ * 把已停止的旧实例的运行状态交给尚未启动的新实例 - 两者都须为进程内加载的v2插件并声明PROCESS_CAP_RELOAD
+ * @return 交接的字节数，未交接返回0
+ */
+static size_t hand_over_state(ProcessManager* manager, const char* name, const PluginInstance* target) {
+    pthread_mutex_lock(&manager->mutex);
+    ProcessNode* node = process_find_node_locked(manager, name);
+    ProcessInterfaceV2* source = node && (node->capabilities & PROCESS_CAP_RELOAD) ?
+                                 process_async_get_plugin(node->async) : NULL;
+    pthread_mutex_unlock(&manager->mutex);
+
+    ProcessInterfaceV2* plugin = target->capabilities & PROCESS_CAP_RELOAD ? process_async_get_plugin(target->async)
+                                                                           : NULL;
+    if (!source || !plugin || !source->export_state || !plugin->import_state) {
+        return 0;
+    }
+
+    void* buffer = malloc(PROCESS_RELOAD_STATE_MAX);
+    if (!buffer) {
+        return 0;
+    }
+    size_t size = source->export_state(buffer, PROCESS_RELOAD_STATE_MAX);
+    if (size > PROCESS_RELOAD_STATE_MAX || (size > 0 && plugin->import_state(buffer, size) != 0)) {
+        size = 0;
+    }
+    free(buffer);
+    return size;
+}
+
+/**
+ * 在manager->mutex下交换节点的插件实例 - 换出的实例写回参数
+ */
+static void swap_instance_locked(ProcessNode* node, PluginInstance* instance) {
+    PluginInstance old;
+    take_instance_locked(node, &old);
+    put_instance_locked(node, instance);
+    *instance = old;
+}
+
+int process_manager_reload_plugin(ProcessManager* manager, const char* name, const ProcessReloadOptions* options,
+                                  ProcessReloadReport* report) {
+    ProcessReloadReport local_report;
+    if (!report) {
+        report = &local_report;
+    }
+    memset(report, 0, sizeof(ProcessReloadReport));
+    report->stop_outcome = -1;
+    if (!manager || !name) {
+        return -1;
+    }
+
+    ProcessReloadOptions defaults;
+    memset(&defaults, 0, sizeof(defaults));
+    if (!options) {
+        options = &defaults;
+    }
+    uint32_t ready_timeout_ms = options->ready_timeout_ms ? options->ready_timeout_ms
+                                                          : PROCESS_RELOAD_DEFAULT_READY_TIMEOUT_MS;
+    uint32_t drain_ms = options->drain_ms ? options->drain_ms : PROCESS_RELOAD_DEFAULT_DRAIN_MS;
+    uint64_t begin = get_monotonic_ns();
+
+    pthread_mutex_lock(&g_load_mutex);
+
+    pthread_mutex_lock(&manager->mutex);
+    ProcessNode* node = process_find_node_locked(manager, name);
+    if (!node) {
+        pthread_mutex_unlock(&manager->mutex);
+        pthread_mutex_unlock(&g_load_mutex);
+        snprintf(report->error, sizeof(report->error), "进程不存在");
+        return -1;
+    }
+    char library_path[sizeof(node->library_path)];
+    char config_data[sizeof(node->config_data)];
+    snprintf(library_path, sizeof(library_path), "%s", options->library_path ? options->library_path
+                                                                             : node->library_path);
+    memcpy(config_data, node->config_data, sizeof(config_data));
+    bool isolated = node->host != NULL || (node->lazy && node->lazy_isolated);
+    bool dormant = node->interface == NULL;
+    // 同一路径会被dlopen去重为旧实例，进程内加载的新实例经私有副本加载
+    bool private_copy = !isolated && strcmp(library_path, node->library_path) == 0;
+    report->was_running = node->is_running && !node->stop_abandoned;
+    copy_version(report->old_version, sizeof(report->old_version), node->interface);
+
+    if (dormant) {
+        // 未加载的延迟加载进程: 下次启动时直接加载新版本
+        memcpy(node->library_path, library_path, sizeof(node->library_path));
+        pthread_mutex_unlock(&manager->mutex);
+        pthread_mutex_unlock(&g_load_mutex);
+        report->total_us = (get_monotonic_ns() - begin) / 1000;
+        return 0;
+    }
+    pthread_mutex_unlock(&manager->mutex);
+
+    // 加载、检查版本并初始化新实例，旧实例照常服务
+    LoadContext context = {
+        .manager = manager,
+        .begin_ns = get_monotonic_ns(),
+    };
+    ProcessLoadRequest request = {
+        .name = name,
+        .library_path = library_path,
+        .config_data = config_data,
+        .isolated = isolated,
+    };
+    ProcessLoadEntry entry;
+    memset(&entry, 0, sizeof(entry));
+    PluginInstance instance;
+    int ret = open_plugin(&context, &request, &entry, private_copy, &instance);
+    report->prepare_us = entry.ready_us;
+    if (ret != 0) {
+        pthread_mutex_unlock(&g_load_mutex);
+        snprintf(report->error, sizeof(report->error), "%s", entry.error);
+        report->total_us = (get_monotonic_ns() - begin) / 1000;
+        return -1;
+    }
+    copy_version(report->new_version, sizeof(report->new_version), instance.interface);
+    PluginInstance new_instance = instance;
+
+    // 服务中断从这里开始: 停止旧实例
+    uint64_t gap_begin = get_monotonic_ns();
+    if (report->was_running) {
+        report->stop_outcome = process_manager_stop_process_timed(manager, name, &options->stop);
+        if (report->stop_outcome < 0 || report->stop_outcome == TASK_STOP_DETACHED) {
+            // 旧线程可能仍在执行旧库的代码，不能切换
+            close_instance(&instance, true);
+            pthread_mutex_unlock(&g_load_mutex);
+            snprintf(report->error, sizeof(report->error), "旧实例未能停止");
+            report->total_us = (get_monotonic_ns() - begin) / 1000;
+            return -1;
+        }
+    }
+
+    if (report->was_running) {
+        report->state_bytes = (uint32_t)hand_over_state(manager, name, &new_instance);
+    }
+
+    pthread_mutex_lock(&manager->mutex);
+    node = process_find_node_locked(manager, name);
+    if (node) {
+        swap_instance_locked(node, &instance);
+        memcpy(node->library_path, library_path, sizeof(node->library_path));
+        if (report->stop_outcome == TASK_STOP_CANCELLED) {
+            // 被取消的线程已经退出并回收，可以为新实例创建线程
+            node->stop_abandoned = false;
+        }
+    }
+    pthread_mutex_unlock(&manager->mutex);
+
+    if (!node) {
+        close_instance(&instance, true);
+        pthread_mutex_unlock(&g_load_mutex);
+        snprintf(report->error, sizeof(report->error), "进程已被移除");
+        report->total_us = (get_monotonic_ns() - begin) / 1000;
+        return -1;
+    }
+
+    // instance此后是换出的旧实例
+    if (report->was_running) {
+        bool ready = process_manager_start_process(manager, name) == 0 &&
+                     wait_running(&new_instance, ready_timeout_ms);
+        report->gap_us = (get_monotonic_ns() - gap_begin) / 1000;
+
+        if (!ready) {
+            // 回滚: 停止新实例，换回旧实例并重新启动
+            int outcome = process_manager_stop_process_timed(manager, name, &options->stop);
+            pthread_mutex_lock(&manager->mutex);
+            node = process_find_node_locked(manager, name);
+            if (node && outcome != TASK_STOP_DETACHED) {
+                swap_instance_locked(node, &instance);
+                if (outcome == TASK_STOP_CANCELLED) {
+                    node->stop_abandoned = false;
+                }
+            }
+            pthread_mutex_unlock(&manager->mutex);
+            if (node && outcome != TASK_STOP_DETACHED) {
+                process_manager_start_process(manager, name);
+            } else {
+                // 新实例的线程仍未退出，两个实例都不能释放
+                memset(&instance, 0, sizeof(instance));
+            }
+            report->rolled_back = true;
+            snprintf(report->error, sizeof(report->error), "新实例未能在%u ms内就绪", ready_timeout_ms);
+        }
+    }
+    if (!report->rolled_back && node) {
+        pthread_mutex_lock(&manager->mutex);
+        node = process_find_node_locked(manager, name);
+        if (node) {
+            node->reload_count++;
+        }
+        pthread_mutex_unlock(&manager->mutex);
+    }
+    pthread_mutex_unlock(&g_load_mutex);
+
+    // 换出的实例在切换前取得旧接口的锁外调用者全部退出后释放；
+    // drain_ms只为仍持有process_manager_get_process_stats所返回指针的外部调用者额外等待
+    uint64_t drain_begin = get_monotonic_ns();
+    task_epoch_synchronize(&g_interface_epoch);
+    if (drain_ms > 0) {
+        usleep(drain_ms * 1000);
+    }
+    close_instance(&instance, true);
+    report->drain_us = (get_monotonic_ns() - drain_begin) / 1000;
+    report->total_us = (get_monotonic_ns() - begin) / 1000;
+
+    if (manager->log_callback) {
+        char message[512];
+        if (report->rolled_back) {
+            snprintf(message, sizeof(message), "进程 %s 热重载失败，已回滚到 %s: %s", name, report->old_version,
+                     report->error);
+        } else {
+            snprintf(message, sizeof(message), "进程 %s 热重载: %s -> %s (%s)，准备 %.1f ms，服务中断 %.1f ms",
+                     name, report->old_version, report->new_version, library_path, report->prepare_us / 1000.0,
+                     report->gap_us / 1000.0);
+        }
+        manager->log_callback(report->rolled_back ? LOG_LEVEL_ERROR : LOG_LEVEL_INFO, message);
+    }
+    return report->rolled_back ? -1 : 0;
+}
+
+/**
+ * 暂停或恢复 - 插件的pause/resume在接口读临界区内调用，热重载和空闲卸载会等它返回；
+ * 等待确认时只持有适配器的引用，期间实例被替换时等待立即失败
+ */
+static int set_paused(ProcessManager* manager, const char* name, bool pause) {
+    if (!manager || !name) {
+        return -1;
+    }
+
+    TaskEpochGuard guard = process_interface_enter();
+    pthread_mutex_lock(&manager->mutex);
+    ProcessNode* node = process_find_node_locked(manager, name);
+    ProcessAsyncAdapter* adapter = node && node->is_running && !node->stop_abandoned ? node->async : NULL;
+    if (adapter) {
+        process_async_retain(adapter);
+    }
+    pthread_mutex_unlock(&manager->mutex);
+
+    int ret = adapter ? process_async_request_pause(adapter, pause) : -1;
+    process_interface_exit(guard);
+
+    if (ret == 0) {
+        ret = process_async_wait_state(adapter, pause ? PROCESS_STATE_PAUSED : PROCESS_STATE_RUNNING,
+                                       PROCESS_PAUSE_TIMEOUT_MS);
+    }
+    process_async_release(adapter);
+
+    if (manager->log_callback) {
+        char message[128];
+        snprintf(message, sizeof(message), "进程 %s %s%s", name, pause ? "暂停" : "恢复", ret == 0 ? "" : "失败");
+        manager->log_callback(ret == 0 ? LOG_LEVEL_INFO : LOG_LEVEL_WARN, message);
+    }
+    return ret;
+}
+
+int process_manager_pause_process(ProcessManager* manager, const char* name) {
+    return set_paused(manager, name, true);
+}
+
+int process_manager_resume_process(ProcessManager* manager, const char* name) {
+    return set_paused(manager, name, false);
+}
+
+int process_manager_wait_state(ProcessManager* manager, const char* name, ProcessState state, uint32_t timeout_ms) {
+    if (!manager || !name) {
+        return -1;
+    }
+
+    // 等待期间只持有适配器的引用，不阻塞热重载和空闲卸载
+    pthread_mutex_lock(&manager->mutex);
+    ProcessNode* node = process_find_node_locked(manager, name);
+    bool exists = node != NULL;
+    ProcessAsyncAdapter* adapter = node ? node->async : NULL;
+    if (adapter) {
+        process_async_retain(adapter);
+    }
+    pthread_mutex_unlock(&manager->mutex);
+    if (!exists) {
+        return -1;
+    }
+
+    if (adapter) {
+        int ret = process_async_wait_state(adapter, state, timeout_ms);
+        process_async_release(adapter);
+        return ret;
+    }
+
+    // v1插件没有通知，按PROCESS_WAIT_POLL_MS轮询
+    uint64_t deadline = get_monotonic_ns() + (uint64_t)timeout_ms * 1000000ULL;
+    for (;;) {
+        ProcessState current = process_manager_get_process_state(manager, name);
+        if (current == state) {
+            return 0;
+        }
+        if (current == PROCESS_STATE_ERROR || get_monotonic_ns() >= deadline) {
+            return -1;
+        }
+        usleep(PROCESS_WAIT_POLL_MS * 1000);
+    }
+}
@@ -0,0 +1,54 @@
+#include "process_manager.h"
+#include "core_internal.h"
+#include <stdio.h>
+#include <string.h>
+
+int process_manager_set_placement(ProcessManager* manager, const char* name, const CpuPlacement* placement) {
+    if (!manager || !name || !placement) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&manager->mutex);
+
+    ProcessNode* node = process_find_node_locked(manager, name);
+    if (!node) {
+        pthread_mutex_unlock(&manager->mutex);
+        return -1;
+    }
+
+    node->placement = *placement;
+
+    int ret = 0;
+    if (node->is_running && placement->policy != CPU_PLACEMENT_NONE) {
+        ret = cpu_placement_apply_thread(placement, node->thread, NULL) < 0 ? -1 : 0;
+    }
+
+    pthread_mutex_unlock(&manager->mutex);
+    return ret;
+}
+
+int process_manager_get_placement(ProcessManager* manager, const char* name, char* buffer, size_t size) {
+    if (!manager || !name || !buffer || size == 0) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&manager->mutex);
+
+    ProcessNode* node = process_find_node_locked(manager, name);
+    if (!node) {
+        pthread_mutex_unlock(&manager->mutex);
+        return -1;
+    }
+
+    int written = snprintf(buffer, size, "%s", cpu_placement_policy_name(node->placement.policy));
+
+    CpuMask mask;
+    if (node->is_running && cpu_affinity_get_thread(node->thread, &mask) == 0 &&
+        written >= 0 && (size_t)written + 6 < size) {
+        written += snprintf(buffer + written, size - written, " cpus=");
+        written += cpu_mask_format(&mask, buffer + written, size - written);
+    }
+
+    pthread_mutex_unlock(&manager->mutex);
+    return written;
+}
@@ -0,0 +1,184 @@
+#include "process_manager.h"
+#include "core_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * 需要在锁外完成的插件查询 - 隔离加载的插件的get_state/get_stats是代理调用，
+ * 可能等待宿主应答，不得持有manager->mutex
+ */
+typedef struct {
+    const ProcessInterface* interface;  // 待查询的接口，NULL表示无需查询
+    bool query_state;                   // 调用get_state
+    bool query_stats;                   // 没有统计页，调用get_stats
+} PluginQuery;
+
+/**
+ * 在manager->mutex下读取统计页 - 无锁复制页面，不调用插件
+ * 耗时分布只在统计页中提供，ProcessStats保持v1布局
+ * @param latency 耗时分布(输出，可为NULL)，没有统计页时不修改
+ * @param interface 没有统计页时需在锁外调用get_stats的接口(输出)
+ * @return 0已从统计页读取，1需在锁外调用get_stats，-1无法读取
+ */
+static int read_stats_page_locked(const ProcessNode* node, ProcessStats* stats, LatencySummary* latency,
+                                  const ProcessInterface** interface) {
+    if (node->stats_page) {
+        ProcessStatsPage copy;
+        if (process_stats_page_read(node->stats_page, &copy) >= 0) {
+            *stats = copy.stats;
+            if (latency) {
+                *latency = copy.latency;
+            }
+            return 0;
+        }
+    }
+    // 声明成批发布统计的插件不保证get_stats可用
+    if (node->capabilities & PROCESS_CAP_BATCH_STATS) {
+        return -1;
+    }
+
+    *interface = node->interface;
+    return node->interface && node->interface->get_stats ? 1 : -1;
+}
+
+/**
+ * 不持锁调用get_stats并复制结果
+ * @return 0成功
+ */
+static int read_stats_unlocked(const ProcessInterface* interface, ProcessStats* stats) {
+    const ProcessStats* current = interface->get_stats();
+    if (!current) {
+        return -1;
+    }
+    *stats = *current;
+    return 0;
+}
+
+static void fill_record_locked(ProcessSnapshotRecord* record, PluginQuery* query, const ProcessNode* node) {
+    memset(record, 0, sizeof(ProcessSnapshotRecord));
+    memset(query, 0, sizeof(PluginQuery));
+    memcpy(record->name, node->name, sizeof(record->name));
+    record->is_running = node->is_running;
+    record->restart_count = node->restart_count;
+    record->placement = node->placement.policy;
+    record->restart = node->restart_stats;
+    record->stop_time_ns = node->stop_time_ns;
+    record->stop_escalations = node->stop_escalations;
+    record->state = PROCESS_STATE_UNKNOWN;
+    record->lazy = node->lazy;
+    record->dormant = node->lazy && !node->interface;
+    record->lazy_loads = node->lazy_loads;
+    record->reload_count = node->reload_count;
+    record->interface_version = node->interface ? node->interface_version : 0;
+    record->capabilities = node->capabilities;
+
+    // 宿主状态在宿主内部的锁下复制，不经通道
+    PluginHostInfo host;
+    if (node->host && plugin_host_get_info(node->host, &host) == 0) {
+        record->isolated = true;
+        record->host_pid = host.pid;
+        record->host_crashes = host.crash_count;
+        record->host_rss_bytes = host.rss_bytes;
+    }
+
+    const ProcessInterface* interface = node->interface;
+    if (!interface) {
+        return;
+    }
+    if (node->stop_abandoned) {
+        // 插件线程被取消或分离，插件自报的状态不再可信
+        record->state = PROCESS_STATE_ERROR;
+    } else if (interface->get_state) {
+        query->interface = interface;
+        query->query_state = true;
+    }
+    if (read_stats_page_locked(node, &record->stats, &record->latency, &interface) == 1) {
+        query->interface = interface;
+        query->query_stats = true;
+    }
+}
+
+int process_manager_snapshot(ProcessManager* manager, ProcessSnapshotRecord* records, uint32_t capacity,
+                             SnapshotCursor* cursor) {
+    if (!manager || !records || !cursor) {
+        return -1;
+    }
+
+    PluginQuery* queries = calloc(capacity ? capacity : 1, sizeof(PluginQuery));
+    if (!queries) {
+        return -1;
+    }
+
+    TaskEpochGuard guard = process_interface_enter();
+    pthread_mutex_lock(&manager->mutex);
+
+    uint32_t index = 0;
+    uint32_t filled = 0;
+    ProcessNode* node;
+    TAILQ_FOREACH(node, &manager->process_list, entries) {
+        if (index >= cursor->position && filled < capacity) {
+            fill_record_locked(&records[filled], &queries[filled], node);
+            filled++;
+        }
+        index++;
+    }
+
+    // 先删后增时总数不变，以列表代数判断翻页期间的增删
+    if (cursor->position == 0) {
+        cursor->generation = manager->list_generation;
+        cursor->changed = false;
+    } else if (cursor->generation != manager->list_generation || cursor->total != index) {
+        cursor->changed = true;
+    }
+    cursor->total = index;
+    cursor->position += filled;
+
+    pthread_mutex_unlock(&manager->mutex);
+
+    // 插件状态和统计在锁外查询，慢插件或失去响应的宿主不阻塞其他管理操作
+    for (uint32_t i = 0; i < filled; i++) {
+        const PluginQuery* query = &queries[i];
+        if (query->query_state) {
+            records[i].state = query->interface->get_state();
+        }
+        if (query->query_stats) {
+            read_stats_unlocked(query->interface, &records[i].stats);
+        }
+    }
+    process_interface_exit(guard);
+
+    free(queries);
+    return (int)filled;
+}
+
+int process_manager_read_stats(ProcessManager* manager, const char* name, ProcessStats* stats) {
+    if (!manager || !name || !stats) {
+        return -1;
+    }
+
+    const ProcessInterface* interface = NULL;
+    TaskEpochGuard guard = process_interface_enter();
+    pthread_mutex_lock(&manager->mutex);
+    ProcessNode* node = process_find_node_locked(manager, name);
+    int ret = node ? read_stats_page_locked(node, stats, NULL, &interface) : -1;
+    pthread_mutex_unlock(&manager->mutex);
+
+    if (ret == 1) {
+        ret = read_stats_unlocked(interface, stats);
+    }
+    process_interface_exit(guard);
+    return ret;
+}
+
+int process_manager_read_stats_page(ProcessManager* manager, const char* name, ProcessStatsPage* copy) {
+    if (!manager || !name || !copy) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&manager->mutex);
+    ProcessNode* node = process_find_node_locked(manager, name);
+    int ret = node && node->stats_page && process_stats_page_read(node->stats_page, copy) >= 0 ? 0 : -1;
+    pthread_mutex_unlock(&manager->mutex);
+
+    return ret;
+}
@@ -0,0 +1,192 @@
+#include "process_stats_page.h"
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+// 读者等待写入结束时最多检查序号的次数(约每64次让出一次CPU)
+#define PAGE_READ_MAX_SPINS (1u << 16)
+// 读到不一致的副本后最多重读的次数
+#define PAGE_READ_MAX_RETRIES 64
+
+// 同一进程的多个实例(热重载时新旧实例并存)各有一个页面
+static uint32_t g_page_sequence = 0;
+
+static uint64_t get_realtime_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static bool header_valid(const ProcessStatsPage* page) {
+    return page->magic == PROCESS_STATS_PAGE_MAGIC && page->version == PROCESS_STATS_PAGE_VERSION &&
+           page->size == PROCESS_STATS_PAGE_SIZE;
+}
+
+static ProcessStatsPage* map_page(int fd, bool writable) {
+    void* address = mmap(NULL, PROCESS_STATS_PAGE_SIZE, writable ? PROT_READ | PROT_WRITE : PROT_READ,
+                         MAP_SHARED, fd, 0);
+    return address == MAP_FAILED ? NULL : address;
+}
+
+ProcessStatsPage* process_stats_page_create(const char* process_name) {
+    if (!process_name) {
+        return NULL;
+    }
+
+    char shm_name[96];
+    int written = snprintf(shm_name, sizeof(shm_name), "/" PROCESS_STATS_PAGE_PREFIX "%d.%s.%u", (int)getpid(),
+                           process_name, __atomic_add_fetch(&g_page_sequence, 1, __ATOMIC_RELAXED));
+    if (written < 0 || (size_t)written >= sizeof(shm_name)) {
+        return NULL;
+    }
+    // 对象名除开头外不能含'/'
+    for (char* p = shm_name + 1; *p; p++) {
+        if (*p == '/') {
+            *p = '_';
+        }
+    }
+
+    int fd = shm_open(shm_name, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return NULL;
+    }
+    ProcessStatsPage* page = ftruncate(fd, PROCESS_STATS_PAGE_SIZE) == 0 ? map_page(fd, true) : NULL;
+    close(fd);
+    if (!page) {
+        shm_unlink(shm_name);
+        return NULL;
+    }
+
+    // ftruncate得到的页面已清零
+    page->version = PROCESS_STATS_PAGE_VERSION;
+    page->size = PROCESS_STATS_PAGE_SIZE;
+    page->owner_pid = (int32_t)getpid();
+    strncpy(page->process_name, process_name, sizeof(page->process_name) - 1);
+    memcpy(page->shm_name, shm_name, sizeof(page->shm_name));
+    seqlock_init(&page->lock);
+    // 头部写完才发布魔数，先映射的读者看到的要么无效要么完整
+    __atomic_store_n(&page->magic, PROCESS_STATS_PAGE_MAGIC, __ATOMIC_RELEASE);
+    return page;
+}
+
+ProcessStatsPage* process_stats_page_open(const char* shm_name, bool writable) {
+    if (!shm_name) {
+        return NULL;
+    }
+
+    int fd = shm_open(shm_name, (writable ? O_RDWR : O_RDONLY) | O_CLOEXEC, 0);
+    if (fd < 0) {
+        return NULL;
+    }
+    ProcessStatsPage* page = map_page(fd, writable);
+    close(fd);
+    if (page && !header_valid(page)) {
+        munmap(page, PROCESS_STATS_PAGE_SIZE);
+        return NULL;
+    }
+    return page;
+}
+
+void process_stats_page_close(ProcessStatsPage* page) {
+    if (page) {
+        munmap(page, PROCESS_STATS_PAGE_SIZE);
+    }
+}
+
+void process_stats_page_destroy(ProcessStatsPage* page) {
+    if (!page) {
+        return;
+    }
+
+    shm_unlink(page->shm_name);
+    munmap(page, PROCESS_STATS_PAGE_SIZE);
+}
+
+int process_stats_page_read(const ProcessStatsPage* page, ProcessStatsPage* copy) {
+    if (!page || !copy || !header_valid(page)) {
+        return -1;
+    }
+
+    // 只复制头部和已注册的计数器
+    for (int retries = 0; retries <= PAGE_READ_MAX_RETRIES; retries++) {
+        uint32_t start;
+        if (seqlock_read_try_begin(&page->lock, PAGE_READ_MAX_SPINS, &start) != 0) {
+            return -1;
+        }
+        seqlock_read_copy(copy, page, offsetof(ProcessStatsPage, counters));
+        uint32_t count = copy->counter_count < PROCESS_STATS_PAGE_MAX_COUNTERS ? copy->counter_count
+                                                                              : PROCESS_STATS_PAGE_MAX_COUNTERS;
+        seqlock_read_copy(copy->counters, page->counters, count * sizeof(ProcessStatsCounter));
+        if (!seqlock_read_retry(&page->lock, start)) {
+            copy->counter_count = count;
+            return retries;
+        }
+    }
+    return -1;
+}
+
+void process_stats_page_reset(ProcessStatsPage* page) {
+    if (!page) {
+        return;
+    }
+
+    // 序号为奇数说明旧写者死在写入中途，接着它的写入完成即可
+    if ((__atomic_load_n(&page->lock.sequence, __ATOMIC_RELAXED) & 1) == 0) {
+        seqlock_write_begin(&page->lock);
+    }
+    memset(&page->counter_count, 0, sizeof(ProcessStatsPage) - offsetof(ProcessStatsPage, counter_count));
+    seqlock_write_end(&page->lock);
+}
+
+void process_stats_page_write_begin(ProcessStatsPage* page) {
+    if (page) {
+        seqlock_write_begin(&page->lock);
+    }
+}
+
+void process_stats_page_write_end(ProcessStatsPage* page) {
+    if (!page) {
+        return;
+    }
+
+    page->update_count++;
+    page->update_time_ns = get_realtime_ns();
+    seqlock_write_end(&page->lock);
+}
+
+int process_stats_page_add_counter(ProcessStatsPage* page, const char* name) {
+    if (!page || !name) {
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < page->counter_count; i++) {
+        if (strncmp(page->counters[i].name, name, sizeof(page->counters[i].name)) == 0) {
+            return (int)i;
+        }
+    }
+    if (page->counter_count >= PROCESS_STATS_PAGE_MAX_COUNTERS) {
+        return -1;
+    }
+
+    seqlock_write_begin(&page->lock);
+    uint32_t index = page->counter_count;
+    strncpy(page->counters[index].name, name, sizeof(page->counters[index].name) - 1);
+    page->counters[index].value = 0;
+    page->counter_count = index + 1;
+    seqlock_write_end(&page->lock);
+    return (int)index;
+}
+
+void process_stats_page_publish(ProcessStatsPage* page, const ProcessStats* stats) {
+    if (!page || !stats) {
+        return;
+    }
+
+    process_stats_page_write_begin(page);
+    page->stats = *stats;
+    process_stats_page_write_end(page);
+}
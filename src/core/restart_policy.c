@@ -0,0 +1,184 @@
+#include "restart_policy.h"
+#include <string.h>
+#include <time.h>
+
+void restart_policy_normalize(RestartPolicy* policy, uint32_t fallback_max_restarts) {
+    if (!policy) {
+        return;
+    }
+
+    if (policy->initial_delay_ms == 0) {
+        policy->initial_delay_ms = RESTART_DEFAULT_INITIAL_DELAY_MS;
+    }
+    if (policy->max_delay_ms == 0) {
+        policy->max_delay_ms = RESTART_DEFAULT_MAX_DELAY_MS;
+    }
+    if (policy->max_delay_ms < policy->initial_delay_ms) {
+        policy->max_delay_ms = policy->initial_delay_ms;
+    }
+    if (policy->backoff_factor == 0) {
+        policy->backoff_factor = RESTART_DEFAULT_BACKOFF_FACTOR;
+    }
+    if (policy->jitter_percent > 100) {
+        policy->jitter_percent = 100;
+    }
+    if (policy->window_ms == 0) {
+        policy->window_ms = RESTART_DEFAULT_WINDOW_MS;
+    }
+    if (policy->max_restarts == 0) {
+        policy->max_restarts = fallback_max_restarts ? fallback_max_restarts : RESTART_DEFAULT_MAX_RESTARTS;
+    }
+    if (policy->max_restarts > RESTART_HISTORY_SIZE) {
+        policy->max_restarts = RESTART_HISTORY_SIZE;
+    }
+    if (policy->stable_ms == 0) {
+        policy->stable_ms = policy->window_ms;
+    }
+}
+
+void restart_state_init(RestartState* state, uint32_t seed) {
+    if (!state) {
+        return;
+    }
+
+    memset(state, 0, sizeof(RestartState));
+    state->seed = seed ? seed : 0x9E3779B9u;
+}
+
+static uint32_t next_random(RestartState* state) {
+    // xorshift32
+    uint32_t x = state->seed ? state->seed : 0x9E3779B9u;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    state->seed = x;
+    return x;
+}
+
+/**
+ * 第n近的重启时刻(n从1开始)，不存在返回0
+ */
+static uint64_t recent_restart(const RestartState* state, uint32_t n) {
+    if (n == 0 || n > state->history_count) {
+        return 0;
+    }
+    return state->history[(state->history_head + RESTART_HISTORY_SIZE - n) % RESTART_HISTORY_SIZE];
+}
+
+static uint32_t restarts_in_window(const RestartState* state, const RestartPolicy* policy, uint64_t now_ns) {
+    uint64_t window_ns = (uint64_t)policy->window_ms * 1000000ULL;
+    uint32_t count = 0;
+
+    for (uint32_t n = 1; n <= state->history_count; n++) {
+        if (now_ns - recent_restart(state, n) >= window_ns) {
+            break;
+        }
+        count++;
+    }
+    return count;
+}
+
+static uint64_t backoff_delay_ms(RestartState* state, const RestartPolicy* policy) {
+    uint64_t delay = policy->initial_delay_ms;
+    for (uint32_t i = 0; i < state->attempt && delay < policy->max_delay_ms; i++) {
+        delay *= policy->backoff_factor;
+    }
+    if (delay > policy->max_delay_ms) {
+        delay = policy->max_delay_ms;
+    }
+
+    if (policy->jitter_percent > 0) {
+        // 在[-jitter, +jitter]内均匀取值
+        uint64_t span = delay * policy->jitter_percent / 100;
+        uint64_t offset = span ? next_random(state) % (2 * span + 1) : 0;
+        delay = delay + offset - span;
+    }
+    return delay;
+}
+
+uint64_t restart_state_schedule(RestartState* state, const RestartPolicy* policy, uint64_t now_ns) {
+    if (state->due_ns != 0) {
+        return state->due_ns;
+    }
+
+    uint64_t due = now_ns + backoff_delay_ms(state, policy) * 1000000ULL;
+
+    // 窗口内已重启max_restarts次: 等到第max_restarts近的那次滑出窗口
+    if (restarts_in_window(state, policy, now_ns) >= policy->max_restarts) {
+        uint64_t window_open = recent_restart(state, policy->max_restarts) +
+                               (uint64_t)policy->window_ms * 1000000ULL;
+        if (window_open > due) {
+            due = window_open;
+        }
+        state->crash_loop = true;
+    }
+
+    if (state->attempt < 31) {
+        state->attempt++;
+    }
+    state->due_ns = due;
+    state->delay_ms = (uint32_t)((due - now_ns) / 1000000ULL);
+    return due;
+}
+
+bool restart_state_due(const RestartState* state, uint64_t now_ns) {
+    return state->due_ns != 0 && now_ns >= state->due_ns;
+}
+
+void restart_state_restarted(RestartState* state, uint64_t now_ns) {
+    state->history[state->history_head] = now_ns;
+    state->history_head = (state->history_head + 1) % RESTART_HISTORY_SIZE;
+    if (state->history_count < RESTART_HISTORY_SIZE) {
+        state->history_count++;
+    }
+
+    state->total++;
+    state->due_ns = 0;
+    state->started_ns = now_ns;
+    state->last_restart_ns = now_ns;
+}
+
+bool restart_state_mark_running(RestartState* state, const RestartPolicy* policy, uint64_t now_ns) {
+    if (state->started_ns == 0) {
+        state->started_ns = now_ns;
+    }
+
+    if (state->due_ns != 0 || (state->attempt == 0 && !state->crash_loop)) {
+        return false;
+    }
+    if (now_ns - state->started_ns < (uint64_t)policy->stable_ms * 1000000ULL) {
+        return false;
+    }
+
+    state->attempt = 0;
+    state->crash_loop = false;
+    return true;
+}
+
+/**
+ * 单调时刻换算为墙钟秒
+ */
+static uint64_t to_wall_seconds(uint64_t mono_ns, uint64_t now_ns) {
+    uint64_t wall_now = (uint64_t)time(NULL);
+    if (mono_ns >= now_ns) {
+        return wall_now + (mono_ns - now_ns + 999999999ULL) / 1000000000ULL;
+    }
+    uint64_t ago = (now_ns - mono_ns) / 1000000000ULL;
+    return ago < wall_now ? wall_now - ago : 0;
+}
+
+void restart_state_export(const RestartState* state, const RestartPolicy* policy, uint64_t now_ns,
+                          RestartStats* stats) {
+    memset(stats, 0, sizeof(RestartStats));
+    stats->total = state->total;
+    stats->in_window = restarts_in_window(state, policy, now_ns);
+    stats->backoff_ms = state->delay_ms;
+    stats->crash_loop = state->crash_loop;
+    stats->pending = state->due_ns != 0;
+    if (state->last_restart_ns) {
+        stats->last_restart_time = to_wall_seconds(state->last_restart_ns, now_ns);
+    }
+    if (state->due_ns) {
+        stats->next_restart_time = to_wall_seconds(state->due_ns, now_ns);
+    }
+}
@@ -0,0 +1,84 @@
+#include "seqlock.h"
+#include <sched.h>
+
+// 读者等待写入结束时，每自旋多少次让出一次CPU(写者可能与读者在同一个CPU上)
+#define SEQLOCK_SPINS_BEFORE_YIELD 64
+
+static inline void cpu_relax(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+void seqlock_init(SeqLock* lock) {
+    if (lock) {
+        __atomic_store_n(&lock->sequence, 0, __ATOMIC_RELAXED);
+    }
+}
+
+void seqlock_write_begin(SeqLock* lock) {
+    __atomic_store_n(&lock->sequence, lock->sequence + 1, __ATOMIC_RELAXED);
+    // 序号变为奇数必须先于任何数据写入可见
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+void seqlock_write_end(SeqLock* lock) {
+    __atomic_store_n(&lock->sequence, lock->sequence + 1, __ATOMIC_RELEASE);
+}
+
+uint32_t seqlock_read_begin(const SeqLock* lock) {
+    uint32_t sequence;
+    seqlock_read_try_begin(lock, UINT32_MAX, &sequence);
+    return sequence;
+}
+
+int seqlock_read_try_begin(const SeqLock* lock, uint32_t max_spins, uint32_t* start) {
+    uint32_t spins = 0;
+    for (;;) {
+        uint32_t sequence = __atomic_load_n(&lock->sequence, __ATOMIC_ACQUIRE);
+        if ((sequence & 1) == 0) {
+            *start = sequence;
+            return 0;
+        }
+        if (++spins == max_spins && max_spins != UINT32_MAX) {
+            return -1;
+        }
+        if (spins % SEQLOCK_SPINS_BEFORE_YIELD == 0) {
+            sched_yield();
+        } else {
+            cpu_relax();
+        }
+    }
+}
+
+int seqlock_read_retry(const SeqLock* lock, uint32_t start) {
+    // 数据读取必须先于序号的复查完成
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(&lock->sequence, __ATOMIC_RELAXED) != start;
+}
+
+void seqlock_read_copy(void* dst, const void* src, size_t size) {
+    uint8_t* out = dst;
+    const uint8_t* in = src;
+
+    if (((uintptr_t)in & 7) == 0 && ((uintptr_t)out & 7) == 0) {
+        for (; size >= 8; size -= 8, in += 8, out += 8) {
+            *(uint64_t*)out = __atomic_load_n((const uint64_t*)in, __ATOMIC_RELAXED);
+        }
+    }
+    for (; size > 0; size--, in++, out++) {
+        *out = __atomic_load_n(in, __ATOMIC_RELAXED);
+    }
+}
+
+uint32_t seqlock_copy_out(const SeqLock* lock, void* dst, const void* src, size_t size) {
+    uint32_t retries = 0;
+    for (;;) {
+        uint32_t start = seqlock_read_begin(lock);
+        seqlock_read_copy(dst, src, size);
+        if (!seqlock_read_retry(lock, start)) {
+            return retries;
+        }
+        retries++;
+    }
+}
@@ -0,0 +1,132 @@
+#include "slab_allocator.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * 内存块头 - 对象区紧随其后并按对象对齐
+ */
+typedef struct SlabChunk {
+    struct SlabChunk* next;
+} SlabChunk;
+
+static size_t align_up(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+int slab_init(SlabAllocator* slab, size_t object_size, size_t alignment, size_t chunk_bytes) {
+    if (!slab || object_size == 0) {
+        return -1;
+    }
+    if (alignment == 0) {
+        alignment = sizeof(void*);
+    }
+    if (alignment < sizeof(void*) || (alignment & (alignment - 1)) != 0) {
+        return -1;
+    }
+
+    memset(slab, 0, sizeof(SlabAllocator));
+    slab->alignment = alignment;
+    // 空闲对象的首字存放链表指针
+    slab->object_size = align_up(object_size < sizeof(void*) ? sizeof(void*) : object_size, alignment);
+
+    if (chunk_bytes == 0) {
+        chunk_bytes = SLAB_DEFAULT_CHUNK_BYTES;
+    }
+    size_t header = align_up(sizeof(SlabChunk), alignment);
+    slab->objects_per_chunk = chunk_bytes > header + slab->object_size
+        ? (uint32_t)((chunk_bytes - header) / slab->object_size) : 1;
+
+    pthread_mutex_init(&slab->mutex, NULL);
+    return 0;
+}
+
+void slab_destroy(SlabAllocator* slab) {
+    if (!slab) {
+        return;
+    }
+
+    SlabChunk* chunk = slab->chunks;
+    while (chunk) {
+        SlabChunk* next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+
+    pthread_mutex_destroy(&slab->mutex);
+    slab->chunks = NULL;
+    slab->free_list = NULL;
+    slab->bump = slab->bump_end = NULL;
+}
+
+/**
+ * 分配新块并设为切分区 - 调用者持有mutex
+ */
+static int slab_grow(SlabAllocator* slab) {
+    size_t header = align_up(sizeof(SlabChunk), slab->alignment);
+    size_t bytes = align_up(header + (size_t)slab->objects_per_chunk * slab->object_size, slab->alignment);
+
+    SlabChunk* chunk = aligned_alloc(slab->alignment, bytes);
+    if (!chunk) {
+        return -1;
+    }
+
+    chunk->next = slab->chunks;
+    slab->chunks = chunk;
+    slab->bump = (char*)chunk + header;
+    slab->bump_end = slab->bump + (size_t)slab->objects_per_chunk * slab->object_size;
+    slab->chunk_count++;
+    return 0;
+}
+
+void* slab_alloc(SlabAllocator* slab) {
+    if (!slab) {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&slab->mutex);
+
+    void* object = slab->free_list;
+    if (object) {
+        slab->free_list = *(void**)object;
+    } else {
+        // 新对象按地址顺序从块中切出，连续注册的对象在内存中相邻
+        if (slab->bump == slab->bump_end && slab_grow(slab) != 0) {
+            pthread_mutex_unlock(&slab->mutex);
+            return NULL;
+        }
+        object = slab->bump;
+        slab->bump += slab->object_size;
+    }
+    slab->in_use++;
+
+    pthread_mutex_unlock(&slab->mutex);
+
+    memset(object, 0, slab->object_size);
+    return object;
+}
+
+void slab_free(SlabAllocator* slab, void* object) {
+    if (!slab || !object) {
+        return;
+    }
+
+    pthread_mutex_lock(&slab->mutex);
+    *(void**)object = slab->free_list;
+    slab->free_list = object;
+    slab->in_use--;
+    pthread_mutex_unlock(&slab->mutex);
+}
+
+void slab_get_stats(SlabAllocator* slab, SlabStats* stats) {
+    if (!slab || !stats) {
+        return;
+    }
+
+    pthread_mutex_lock(&slab->mutex);
+    stats->object_size = slab->object_size;
+    stats->chunk_count = slab->chunk_count;
+    stats->capacity = slab->chunk_count * slab->objects_per_chunk -
+                      (uint64_t)(slab->bump_end - slab->bump) / slab->object_size;
+    stats->in_use = slab->in_use;
+    pthread_mutex_unlock(&slab->mutex);
+}
@@ -0,0 +1,448 @@
+#include "startup_graph.h"
+#include "core_internal.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * 按名称排序的查找项
+ */
+typedef struct {
+    const char* name;
+    uint32_t index;
+} NameSlot;
+
+/**
+ * 一批启动的共享状态 - 除entries中各节点自己的启动字段外均受mutex保护
+ */
+typedef struct {
+    void* target;
+    StartupOperation operation;
+    StartupProbe probe;
+    uint64_t ready_timeout_ns;
+    uint64_t poll_max_ns;
+    uint64_t start_ns;
+
+    StartupEntry* entries;
+    uint32_t count;
+    uint32_t* pending;          // 每个节点尚未就绪的依赖数
+    uint32_t* dependent_offsets; // 下游节点表的起始位置(count + 1项)
+    uint32_t* dependents;       // 下游节点表
+    uint32_t* queue;            // 依赖已全部就绪、等待启动的节点
+    uint32_t queue_head;
+    uint32_t queue_tail;
+    uint32_t* stack;            // 阻塞传播用的栈
+    uint32_t unresolved;        // 尚未得出结果的节点数
+
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+} StartupGraph;
+
+static void sleep_ns(uint64_t ns) {
+    struct timespec ts = {
+        .tv_sec = ns / 1000000000ULL,
+        .tv_nsec = ns % 1000000000ULL
+    };
+    nanosleep(&ts, NULL);
+}
+
+static uint64_t elapsed_us(const StartupGraph* graph) {
+    return (get_monotonic_ns() - graph->start_ns) / 1000;
+}
+
+static int compare_name_slot(const void* a, const void* b) {
+    return strcmp(((const NameSlot*)a)->name, ((const NameSlot*)b)->name);
+}
+
+static int find_node(const NameSlot* lookup, uint32_t count, const char* name) {
+    NameSlot key = { .name = name, .index = 0 };
+    const NameSlot* slot = bsearch(&key, lookup, count, sizeof(NameSlot), compare_name_slot);
+    return slot ? (int)slot->index : -1;
+}
+
+/**
+ * 阻塞节点及其全部下游节点
+ */
+static void block_dependents(StartupGraph* graph, uint32_t index) {
+    uint32_t top = 0;
+    graph->stack[top++] = index;
+
+    while (top > 0) {
+        uint32_t node = graph->stack[--top];
+        for (uint32_t i = graph->dependent_offsets[node]; i < graph->dependent_offsets[node + 1]; i++) {
+            StartupEntry* entry = &graph->entries[graph->dependents[i]];
+            if (entry->outcome == STARTUP_PENDING) {
+                entry->outcome = STARTUP_BLOCKED;
+                graph->unresolved--;
+                graph->stack[top++] = graph->dependents[i];
+            }
+        }
+    }
+}
+
+/**
+ * 节点就绪后释放下游节点 - 最后一个就绪的依赖即为下游节点的限制者
+ */
+static void release_dependents(StartupGraph* graph, uint32_t index) {
+    for (uint32_t i = graph->dependent_offsets[index]; i < graph->dependent_offsets[index + 1]; i++) {
+        uint32_t dependent = graph->dependents[i];
+        graph->entries[dependent].gated_by = (int32_t)index;
+        if (--graph->pending[dependent] == 0 && graph->entries[dependent].outcome == STARTUP_PENDING) {
+            graph->queue[graph->queue_tail++] = dependent;
+        }
+    }
+}
+
+/**
+ * 执行启动操作并等待就绪，探测间隔从1毫秒起倍增
+ */
+static StartupOutcome start_and_wait(StartupGraph* graph, StartupEntry* entry) {
+    entry->result = graph->operation(graph->target, entry->name);
+    if (entry->result != 0) {
+        return STARTUP_FAILED;
+    }
+    if (!graph->probe) {
+        return STARTUP_READY;
+    }
+
+    uint64_t deadline = get_monotonic_ns() + graph->ready_timeout_ns;
+    uint64_t interval = 1000000ULL;
+    for (;;) {
+        if (graph->probe(graph->target, entry->name)) {
+            return STARTUP_READY;
+        }
+
+        uint64_t now = get_monotonic_ns();
+        if (now >= deadline) {
+            return STARTUP_TIMEOUT;
+        }
+
+        sleep_ns(interval < deadline - now ? interval : deadline - now);
+        interval = interval * 2 < graph->poll_max_ns ? interval * 2 : graph->poll_max_ns;
+    }
+}
+
+static void* startup_worker(void* arg) {
+    StartupGraph* graph = arg;
+
+    pthread_mutex_lock(&graph->mutex);
+    for (;;) {
+        while (graph->queue_head == graph->queue_tail && graph->unresolved > 0) {
+            pthread_cond_wait(&graph->cond, &graph->mutex);
+        }
+        if (graph->queue_head == graph->queue_tail) {
+            break;
+        }
+
+        uint32_t index = graph->queue[graph->queue_head++];
+        StartupEntry* entry = &graph->entries[index];
+        entry->start_us = elapsed_us(graph);
+        pthread_mutex_unlock(&graph->mutex);
+
+        StartupOutcome outcome = start_and_wait(graph, entry);
+
+        pthread_mutex_lock(&graph->mutex);
+        entry->outcome = outcome;
+        entry->ready_us = elapsed_us(graph);
+        graph->unresolved--;
+        if (outcome == STARTUP_READY) {
+            release_dependents(graph, index);
+        } else {
+            block_dependents(graph, index);
+        }
+        pthread_cond_broadcast(&graph->cond);
+    }
+    pthread_mutex_unlock(&graph->mutex);
+    return NULL;
+}
+
+/**
+ * 建立依赖边、计算拓扑层次并阻塞无法启动的节点
+ * 依赖缺失(外部依赖未就绪)或处于环中/环下游的节点在启动前即被阻塞
+ * @return 拓扑层数，失败返回-1
+ */
+static int plan_graph(StartupGraph* graph, const StartupNode* nodes) {
+    uint32_t count = graph->count;
+    int wave_count = -1;
+
+    NameSlot* lookup = malloc(count * sizeof(NameSlot));
+    bool* missing = calloc(count, sizeof(bool));
+    uint32_t* remaining = calloc(count, sizeof(uint32_t));
+    if (!lookup || !missing || !remaining) {
+        goto out;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        lookup[i].name = graph->entries[i].name;
+        lookup[i].index = i;
+    }
+    qsort(lookup, count, sizeof(NameSlot), compare_name_slot);
+
+    // 第一遍统计每个节点的下游数量，第二遍填表
+    for (int pass = 0; pass < 2; pass++) {
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t dependency_count = nodes[i].dependency_count;
+            if (dependency_count > STARTUP_MAX_DEPENDENCIES) {
+                dependency_count = STARTUP_MAX_DEPENDENCIES;
+            }
+
+            for (uint32_t d = 0; d < dependency_count; d++) {
+                const char* dependency = nodes[i].depends_on[d];
+                if (dependency[0] == '\0') {
+                    continue;
+                }
+
+                int source = find_node(lookup, count, dependency);
+                if (source < 0) {
+                    if (pass == 0 && (!graph->probe || !graph->probe(graph->target, dependency))) {
+                        missing[i] = true;
+                    }
+                    continue;
+                }
+
+                if (pass == 0) {
+                    graph->dependent_offsets[source + 1]++;
+                    graph->pending[i]++;
+                } else {
+                    graph->dependents[remaining[source]++] = i;
+                }
+            }
+        }
+
+        if (pass == 0) {
+            for (uint32_t i = 0; i < count; i++) {
+                graph->dependent_offsets[i + 1] += graph->dependent_offsets[i];
+            }
+            graph->dependents = malloc((graph->dependent_offsets[count] ? graph->dependent_offsets[count] : 1) *
+                                       sizeof(uint32_t));
+            if (!graph->dependents) {
+                goto out;
+            }
+            for (uint32_t i = 0; i < count; i++) {
+                remaining[i] = graph->dependent_offsets[i];
+            }
+        }
+    }
+
+    // Kahn算法计算层次，未被访问到的节点处于环中或环的下游
+    uint32_t head = 0, tail = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        remaining[i] = graph->pending[i];
+        if (remaining[i] == 0) {
+            graph->queue[tail++] = i;
+        }
+    }
+    wave_count = 0;
+    while (head < tail) {
+        uint32_t node = graph->queue[head++];
+        uint32_t wave = graph->entries[node].wave;
+        if ((int)wave + 1 > wave_count) {
+            wave_count = (int)wave + 1;
+        }
+
+        for (uint32_t i = graph->dependent_offsets[node]; i < graph->dependent_offsets[node + 1]; i++) {
+            uint32_t dependent = graph->dependents[i];
+            if (graph->entries[dependent].wave < wave + 1) {
+                graph->entries[dependent].wave = wave + 1;
+            }
+            if (--remaining[dependent] == 0) {
+                graph->queue[tail++] = dependent;
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        if (remaining[i] != 0 || missing[i]) {
+            if (graph->entries[i].outcome == STARTUP_PENDING) {
+                graph->entries[i].outcome = STARTUP_BLOCKED;
+                graph->unresolved--;
+            }
+            block_dependents(graph, i);
+        }
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        if (graph->entries[i].outcome == STARTUP_PENDING && graph->pending[i] == 0) {
+            graph->queue[graph->queue_tail++] = i;
+        }
+    }
+
+out:
+    free(lookup);
+    free(missing);
+    free(remaining);
+    return wave_count;
+}
+
+/**
+ * 从最晚结束的节点沿限制依赖回溯关键路径
+ */
+static void build_critical_path(StartupReport* report) {
+    int32_t last = -1;
+    for (uint32_t i = 0; i < report->count; i++) {
+        const StartupEntry* entry = &report->entries[i];
+        if (entry->outcome != STARTUP_BLOCKED &&
+            (last < 0 || entry->ready_us > report->entries[last].ready_us)) {
+            last = (int32_t)i;
+        }
+    }
+    if (last < 0) {
+        return;
+    }
+
+    uint32_t length = 0;
+    for (int32_t node = last; node >= 0; node = report->entries[node].gated_by) {
+        length++;
+    }
+
+    report->critical_path = malloc(length * sizeof(uint32_t));
+    if (!report->critical_path) {
+        return;
+    }
+
+    report->critical_path_length = length;
+    for (int32_t node = last; node >= 0; node = report->entries[node].gated_by) {
+        report->critical_path[--length] = (uint32_t)node;
+    }
+}
+
+static void graph_free(StartupGraph* graph) {
+    free(graph->pending);
+    free(graph->dependent_offsets);
+    free(graph->dependents);
+    free(graph->queue);
+    free(graph->stack);
+}
+
+int startup_graph_run(void* target, const StartupNode* nodes, uint32_t count,
+                      StartupOperation operation, StartupProbe probe,
+                      const StartupOptions* options, StartupReport* report) {
+    if (report) {
+        memset(report, 0, sizeof(StartupReport));
+    }
+    if (!operation || (count > 0 && !nodes)) {
+        return -1;
+    }
+    if (count == 0) {
+        return 0;
+    }
+
+    StartupOptions defaults = {0};
+    if (!options) {
+        options = &defaults;
+    }
+
+    StartupGraph graph;
+    memset(&graph, 0, sizeof(graph));
+    graph.target = target;
+    graph.operation = operation;
+    graph.probe = probe;
+    graph.ready_timeout_ns = (uint64_t)(options->ready_timeout_ms ? options->ready_timeout_ms
+                                        : STARTUP_DEFAULT_READY_TIMEOUT_MS) * 1000000ULL;
+    graph.poll_max_ns = (uint64_t)(options->poll_ms ? options->poll_ms : STARTUP_DEFAULT_POLL_MS) * 1000000ULL;
+    graph.count = count;
+    graph.unresolved = count;
+    graph.entries = calloc(count, sizeof(StartupEntry));
+    graph.pending = calloc(count, sizeof(uint32_t));
+    graph.dependent_offsets = calloc(count + 1, sizeof(uint32_t));
+    graph.queue = calloc(count, sizeof(uint32_t));
+    graph.stack = calloc(count, sizeof(uint32_t));
+    if (!graph.entries || !graph.pending || !graph.dependent_offsets || !graph.queue || !graph.stack) {
+        free(graph.entries);
+        graph_free(&graph);
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        strncpy(graph.entries[i].name, nodes[i].name, sizeof(graph.entries[i].name) - 1);
+        graph.entries[i].gated_by = -1;
+    }
+
+    graph.start_ns = get_monotonic_ns();
+    int wave_count = plan_graph(&graph, nodes);
+    if (wave_count < 0) {
+        free(graph.entries);
+        graph_free(&graph);
+        return -1;
+    }
+
+    pthread_mutex_init(&graph.mutex, NULL);
+    pthread_cond_init(&graph.cond, NULL);
+
+    uint32_t parallel = options->max_parallel ? options->max_parallel : STARTUP_MAX_PARALLEL;
+    if (parallel > STARTUP_MAX_PARALLEL) {
+        parallel = STARTUP_MAX_PARALLEL;
+    }
+    if (parallel > count) {
+        parallel = count;
+    }
+
+    pthread_t threads[STARTUP_MAX_PARALLEL];
+    uint32_t started = 0;
+    for (uint32_t i = 0; i < parallel; i++) {
+        if (pthread_create(&threads[started], NULL, startup_worker, &graph) != 0) {
+            break;
+        }
+        started++;
+    }
+
+    // 一个辅助线程都创建不了时在当前线程上串行启动
+    if (started == 0) {
+        startup_worker(&graph);
+    }
+    for (uint32_t i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    pthread_mutex_destroy(&graph.mutex);
+    pthread_cond_destroy(&graph.cond);
+
+    uint32_t ready = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        ready += graph.entries[i].outcome == STARTUP_READY;
+    }
+
+    if (report) {
+        report->entries = graph.entries;
+        report->count = count;
+        report->wave_count = (uint32_t)wave_count;
+        report->total_us = elapsed_us(&graph);
+        for (uint32_t i = 0; i < count; i++) {
+            report->ready += graph.entries[i].outcome == STARTUP_READY;
+            report->failed += graph.entries[i].outcome == STARTUP_FAILED;
+            report->timed_out += graph.entries[i].outcome == STARTUP_TIMEOUT;
+            report->blocked += graph.entries[i].outcome == STARTUP_BLOCKED;
+        }
+        build_critical_path(report);
+    } else {
+        free(graph.entries);
+    }
+
+    graph_free(&graph);
+    return (int)(count - ready);
+}
+
+const char* startup_outcome_name(StartupOutcome outcome) {
+    switch (outcome) {
+        case STARTUP_PENDING: return "pending";
+        case STARTUP_READY:   return "ready";
+        case STARTUP_FAILED:  return "failed";
+        case STARTUP_TIMEOUT: return "timeout";
+        case STARTUP_BLOCKED: return "blocked";
+        default:              return "unknown";
+    }
+}
+
+void startup_report_free(StartupReport* report) {
+    if (!report) {
+        return;
+    }
+
+    free(report->entries);
+    free(report->critical_path);
+    report->entries = NULL;
+    report->critical_path = NULL;
+    report->count = 0;
+    report->critical_path_length = 0;
+}
@@ -0,0 +1,219 @@
+#define _GNU_SOURCE
+#include "task_accounting.h"
+#include "core_internal.h"
+#include "task_manager.h"
+#include "task_epoch.h"
+#include "task_stats.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+// /proc/<pid>/task/<tid>/stat中的字段序号(从1开始)
+#define STAT_FIELD_MINFLT    10
+#define STAT_FIELD_MAJFLT    12
+#define STAT_FIELD_PROCESSOR 39
+
+/**
+ * 由tid构造线程CPU时钟ID - 与内核MAKE_THREAD_CPUCLOCK(tid, CPUCLOCK_SCHED)一致
+ * 不经过pthread_getcpuclockid，线程被join后pthread_t失效，tid只会使时钟返回EINVAL
+ */
+static clockid_t thread_cpu_clock(pid_t tid) {
+    return (clockid_t)(((unsigned int)~tid << 3) | 6);
+}
+
+/**
+ * 读取整个小文件到缓冲区
+ * @return 读取的字节数，失败返回-1
+ */
+static ssize_t read_small_file(const char* path, char* buffer, size_t size) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+    ssize_t n = read(fd, buffer, size - 1);
+    close(fd);
+    if (n < 0) {
+        return -1;
+    }
+    buffer[n] = '\0';
+    return n;
+}
+
+/**
+ * 解析线程的stat文件，comm字段可能含空格和括号，从最后一个')'之后开始计数
+ */
+static int read_thread_stat(pid_t tid, uint64_t* minor_faults, uint64_t* major_faults, int32_t* cpu) {
+    char path[64];
+    char buffer[1024];
+    snprintf(path, sizeof(path), "/proc/self/task/%d/stat", (int)tid);
+    if (read_small_file(path, buffer, sizeof(buffer)) < 0) {
+        return -1;
+    }
+
+    char* p = strrchr(buffer, ')');
+    if (!p) {
+        return -1;
+    }
+    p++;
+
+    int parsed = 0;
+    for (int field = 3; field <= STAT_FIELD_PROCESSOR && *p; field++) {
+        while (*p == ' ') {
+            p++;
+        }
+        char* end;
+        unsigned long long value = strtoull(p, &end, 10);
+
+        if (field == STAT_FIELD_MINFLT) {
+            *minor_faults = value;
+            parsed++;
+        } else if (field == STAT_FIELD_MAJFLT) {
+            *major_faults = value;
+            parsed++;
+        } else if (field == STAT_FIELD_PROCESSOR) {
+            *cpu = (int32_t)value;
+            parsed++;
+        }
+
+        while (*p && *p != ' ') {
+            p++;
+        }
+    }
+
+    return parsed == 3 ? 0 : -1;
+}
+
+void task_accounting_attach_thread(TaskBase* task) {
+    if (!task) {
+        return;
+    }
+
+    __atomic_store_n(&task->tid, (int32_t)syscall(SYS_gettid), __ATOMIC_RELEASE);
+}
+
+int task_accounting_sample(TaskBase* task, uint32_t flags, uint64_t now_ns) {
+    if (!task) {
+        return -1;
+    }
+
+    TaskState state = __atomic_load_n(&task->state, __ATOMIC_ACQUIRE);
+    if (state != TASK_STATE_RUNNING && state != TASK_STATE_STOPPING) {
+        return 1;
+    }
+
+    bool pooled = __atomic_load_n(&task->executor, __ATOMIC_ACQUIRE) != NULL;
+    pid_t tid = pooled ? 0 : __atomic_load_n(&task->tid, __ATOMIC_ACQUIRE);
+    if (!pooled && tid == 0) {
+        return 1;
+    }
+
+    // 系统调用在锁外完成，持锁时间只覆盖写入
+    uint64_t cpu_ns = 0;
+    bool have_cpu = false;
+    if (!pooled && (flags & TASK_ACCOUNTING_CPU)) {
+        struct timespec ts;
+        if (clock_gettime(thread_cpu_clock(tid), &ts) != 0) {
+            // 线程已退出
+            int32_t expected = tid;
+            __atomic_compare_exchange_n(&task->tid, &expected, 0, false,
+                                        __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+            return 1;
+        }
+        cpu_ns = (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+        have_cpu = true;
+    }
+
+    uint64_t minor_faults = 0, major_faults = 0;
+    int32_t cpu = -1;
+    bool have_proc = !pooled && (flags & TASK_ACCOUNTING_PROC) &&
+                     read_thread_stat(tid, &minor_faults, &major_faults, &cpu) == 0;
+
+    task_stats_write_begin(task);
+
+    if (pooled && (flags & TASK_ACCOUNTING_CPU)) {
+        cpu_ns = task->stats.cpu_time_ns;
+        have_cpu = true;
+    }
+
+    if (have_cpu) {
+        task->stats.cpu_time_ns = cpu_ns;
+        if (task->acct_sample_ns != 0 && now_ns > task->acct_sample_ns && cpu_ns >= task->acct_cpu_ns) {
+            task->stats.cpu_usage = (uint32_t)((cpu_ns - task->acct_cpu_ns) * 100 /
+                                               (now_ns - task->acct_sample_ns));
+        }
+        task->acct_cpu_ns = cpu_ns;
+        task->acct_sample_ns = now_ns;
+    }
+
+    if (have_proc) {
+        task->stats.minor_faults = minor_faults;
+        task->stats.major_faults = major_faults;
+        task->stats.last_cpu = cpu;
+    }
+
+    task_stats_write_end(task);
+    return 0;
+}
+
+uint64_t task_accounting_process_rss(void) {
+    char buffer[128];
+    if (read_small_file("/proc/self/statm", buffer, sizeof(buffer)) < 0) {
+        return 0;
+    }
+
+    unsigned long long size_pages = 0, resident_pages = 0;
+    if (sscanf(buffer, "%llu %llu", &size_pages, &resident_pages) != 2) {
+        return 0;
+    }
+    return resident_pages * (uint64_t)sysconf(_SC_PAGESIZE);
+}
+
+static void sample_one(TaskBase* task, uint32_t flags, uint64_t now_ns, TaskAccountingSummary* summary) {
+    if (task_accounting_sample(task, flags, now_ns) == 0) {
+        summary->sampled++;
+    } else {
+        summary->skipped++;
+    }
+}
+
+int task_manager_sample_accounting(TaskManager* manager, uint32_t flags, TaskAccountingSummary* summary) {
+    if (!manager) {
+        return -1;
+    }
+
+    TaskAccountingSummary local;
+    if (!summary) {
+        summary = &local;
+    }
+    memset(summary, 0, sizeof(TaskAccountingSummary));
+
+    uint64_t start_ns = get_monotonic_ns();
+
+    // 已发布只读视图时无锁遍历，读/proc期间不阻塞注册和查询
+    if (__atomic_load_n(&manager->view, __ATOMIC_ACQUIRE)) {
+        TaskEpochGuard guard = task_epoch_enter(manager->view_epoch);
+        TaskRegistryView* view = __atomic_load_n(&manager->view, __ATOMIC_ACQUIRE);
+        for (uint32_t i = 0; i < view->count; i++) {
+            sample_one(view->nodes[i].task, flags, start_ns, summary);
+        }
+        task_epoch_exit(manager->view_epoch, guard);
+    } else {
+        pthread_mutex_lock(&manager->mutex);
+        TaskNode* node;
+        TAILQ_FOREACH(node, &manager->task_list, entries) {
+            sample_one(node->task, flags, start_ns, summary);
+        }
+        pthread_mutex_unlock(&manager->mutex);
+    }
+
+    if (flags & TASK_ACCOUNTING_PROC) {
+        summary->process_rss = task_accounting_process_rss();
+    }
+
+    summary->elapsed_ns = get_monotonic_ns() - start_ns;
+    return 0;
+}
@@ -0,0 +1,163 @@
+#include "task_arena.h"
+#include "task_manager.h"
+#include <stdlib.h>
+#include <string.h>
+
+static size_t cache_line_size(size_t size) {
+    return (size + SLAB_CACHE_LINE - 1) & ~(size_t)(SLAB_CACHE_LINE - 1);
+}
+
+TaskArena* task_arena_create(size_t node_size) {
+    TaskArena* arena = calloc(1, sizeof(TaskArena));
+    if (!arena) {
+        return NULL;
+    }
+
+    if (slab_init(&arena->nodes, node_size, 0, 0) != 0) {
+        free(arena);
+        return NULL;
+    }
+
+    pthread_mutex_init(&arena->mutex, NULL);
+    arena->refs = 1;
+    return arena;
+}
+
+void task_arena_release(TaskArena* arena) {
+    if (!arena || __atomic_sub_fetch(&arena->refs, 1, __ATOMIC_ACQ_REL) != 0) {
+        return;
+    }
+
+    slab_destroy(&arena->nodes);
+    for (uint32_t i = 0; i < arena->class_count; i++) {
+        slab_destroy(&arena->classes[i]);
+    }
+    pthread_mutex_destroy(&arena->mutex);
+    free(arena);
+}
+
+/**
+ * 查找或建立大小分类，分类用尽返回NULL
+ */
+static SlabAllocator* find_class(TaskArena* arena, size_t size, bool create) {
+    size_t object_size = cache_line_size(size);
+    SlabAllocator* slab = NULL;
+
+    pthread_mutex_lock(&arena->mutex);
+    for (uint32_t i = 0; i < arena->class_count; i++) {
+        if (arena->classes[i].object_size == object_size) {
+            slab = &arena->classes[i];
+            break;
+        }
+    }
+    if (!slab && create && arena->class_count < TASK_ARENA_CLASSES &&
+        slab_init(&arena->classes[arena->class_count], object_size, SLAB_CACHE_LINE, 0) == 0) {
+        slab = &arena->classes[arena->class_count++];
+    }
+    pthread_mutex_unlock(&arena->mutex);
+
+    return slab;
+}
+
+void* task_object_alloc(TaskArena* arena, size_t size) {
+    if (!arena) {
+        void* object = aligned_alloc(SLAB_CACHE_LINE, cache_line_size(size));
+        if (object) {
+            memset(object, 0, cache_line_size(size));
+        }
+        return object;
+    }
+
+    // 分类满后不再建立新分类，因此释放时按大小查找的结果与分配时一致
+    SlabAllocator* slab = find_class(arena, size, true);
+    void* object;
+    if (slab) {
+        object = slab_alloc(slab);
+    } else {
+        object = aligned_alloc(SLAB_CACHE_LINE, cache_line_size(size));
+        if (object) {
+            memset(object, 0, cache_line_size(size));
+            __atomic_add_fetch(&arena->fallback_count, 1, __ATOMIC_RELAXED);
+        }
+    }
+
+    if (object) {
+        __atomic_add_fetch(&arena->refs, 1, __ATOMIC_RELAXED);
+    }
+    return object;
+}
+
+void task_object_free(TaskArena* arena, void* object, size_t size) {
+    if (!object) {
+        return;
+    }
+    if (!arena) {
+        free(object);
+        return;
+    }
+
+    SlabAllocator* slab = find_class(arena, size, false);
+    if (slab) {
+        slab_free(slab, object);
+    } else {
+        free(object);
+    }
+    task_arena_release(arena);
+}
+
+void task_arena_get_stats(TaskArena* arena, TaskArenaStats* stats) {
+    if (!arena || !stats) {
+        return;
+    }
+
+    memset(stats, 0, sizeof(TaskArenaStats));
+    slab_get_stats(&arena->nodes, &stats->nodes);
+
+    pthread_mutex_lock(&arena->mutex);
+    stats->class_count = arena->class_count;
+    for (uint32_t i = 0; i < arena->class_count; i++) {
+        SlabStats class_stats;
+        slab_get_stats(&arena->classes[i], &class_stats);
+        stats->object_chunks += class_stats.chunk_count;
+        stats->objects_in_use += class_stats.in_use;
+    }
+    pthread_mutex_unlock(&arena->mutex);
+
+    stats->fallback_count = __atomic_load_n(&arena->fallback_count, __ATOMIC_RELAXED);
+}
+
+TaskArena* task_manager_get_arena(TaskManager* manager) {
+    if (!manager) {
+        return NULL;
+    }
+
+    TaskArena* arena = __atomic_load_n(&manager->arena, __ATOMIC_ACQUIRE);
+    if (arena) {
+        return arena;
+    }
+
+    TaskArena* created = task_arena_create(sizeof(TaskNode));
+    if (!created) {
+        return NULL;
+    }
+
+    if (!__atomic_compare_exchange_n(&manager->arena, &arena, created, false,
+                                     __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        task_arena_release(created);
+        return arena;
+    }
+    return created;
+}
+
+TaskNode* task_manager_alloc_node(TaskManager* manager) {
+    TaskArena* arena = task_manager_get_arena(manager);
+    return arena ? slab_alloc(&arena->nodes) : NULL;
+}
+
+void task_manager_free_node(TaskManager* manager, TaskNode* node) {
+    if (!manager || !node) {
+        return;
+    }
+
+    slab_free(&manager->arena->nodes, node);
+}
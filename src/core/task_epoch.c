@@ -0,0 +1,80 @@
+#include "task_epoch.h"
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+
+// 线程的分片下标(首次使用时分配，0表示未分配)
+static __thread uint32_t t_stripe_plus_one = 0;
+static uint32_t g_next_stripe = 0;
+
+/**
+ * 获取当前线程使用的分片下标
+ */
+static uint32_t current_stripe(void) {
+    if (t_stripe_plus_one == 0) {
+        uint32_t stripe = __atomic_fetch_add(&g_next_stripe, 1, __ATOMIC_RELAXED);
+        t_stripe_plus_one = (stripe % TASK_EPOCH_STRIPES) + 1;
+    }
+    return t_stripe_plus_one - 1;
+}
+
+TaskEpochDomain* task_epoch_create(void) {
+    TaskEpochDomain* domain = NULL;
+    if (posix_memalign((void**)&domain, 64, sizeof(TaskEpochDomain)) != 0) {
+        return NULL;
+    }
+
+    memset(domain, 0, sizeof(TaskEpochDomain));
+    if (pthread_mutex_init(&domain->writer_mutex, NULL) != 0) {
+        free(domain);
+        return NULL;
+    }
+
+    return domain;
+}
+
+void task_epoch_destroy(TaskEpochDomain* domain) {
+    if (!domain) {
+        return;
+    }
+
+    pthread_mutex_destroy(&domain->writer_mutex);
+    free(domain);
+}
+
+TaskEpochGuard task_epoch_enter(TaskEpochDomain* domain) {
+    TaskEpochGuard guard;
+    guard.stripe = current_stripe();
+
+    for (;;) {
+        uint64_t epoch = __atomic_load_n(&domain->global_epoch, __ATOMIC_SEQ_CST);
+        guard.parity = (uint32_t)(epoch & 1);
+        __atomic_fetch_add(&domain->stripes[guard.stripe].active[guard.parity], 1, __ATOMIC_SEQ_CST);
+
+        // 计数期间纪元未变，说明写者一定能看到本读者
+        if (__atomic_load_n(&domain->global_epoch, __ATOMIC_SEQ_CST) == epoch) {
+            return guard;
+        }
+
+        __atomic_fetch_sub(&domain->stripes[guard.stripe].active[guard.parity], 1, __ATOMIC_SEQ_CST);
+    }
+}
+
+void task_epoch_exit(TaskEpochDomain* domain, TaskEpochGuard guard) {
+    __atomic_fetch_sub(&domain->stripes[guard.stripe].active[guard.parity], 1, __ATOMIC_RELEASE);
+}
+
+void task_epoch_synchronize(TaskEpochDomain* domain) {
+    pthread_mutex_lock(&domain->writer_mutex);
+
+    uint64_t epoch = __atomic_fetch_add(&domain->global_epoch, 1, __ATOMIC_SEQ_CST);
+    uint32_t parity = (uint32_t)(epoch & 1);
+
+    for (uint32_t i = 0; i < TASK_EPOCH_STRIPES; i++) {
+        while (__atomic_load_n(&domain->stripes[i].active[parity], __ATOMIC_ACQUIRE) != 0) {
+            sched_yield();
+        }
+    }
+
+    pthread_mutex_unlock(&domain->writer_mutex);
+}
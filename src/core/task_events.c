@@ -0,0 +1,88 @@
+#include "task_manager.h"
+#include "task_epoch.h"
+
+/**
+ * 管理器的事件回调 - 在纪元读临界区内取当前分发器并投递，
+ * 替换或停止分发器时等宽限期结束再销毁旧分发器，已取到旧分发器的状态变化线程不会访问已释放的内存
+ */
+static void post_event(const char* task_name, TaskState old_state, TaskState new_state, void* user_data) {
+    TaskManager* manager = user_data;
+
+    TaskEpochGuard guard = task_epoch_enter(manager->event_epoch);
+    EventDispatcher* dispatcher = __atomic_load_n(&manager->event_dispatcher, __ATOMIC_ACQUIRE);
+    if (dispatcher) {
+        event_dispatcher_post(task_name, old_state, new_state, dispatcher);
+    }
+    task_epoch_exit(manager->event_epoch, guard);
+}
+
+int task_manager_set_async_event_callback(TaskManager* manager, const EventDispatcherConfig* config) {
+    if (!manager || !config) {
+        return -1;
+    }
+
+    EventDispatcher* dispatcher = event_dispatcher_create(config);
+    if (!dispatcher) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&manager->mutex);
+    if (!manager->event_epoch) {
+        manager->event_epoch = task_epoch_create();
+        if (!manager->event_epoch) {
+            pthread_mutex_unlock(&manager->mutex);
+            event_dispatcher_destroy(dispatcher);
+            return -1;
+        }
+    }
+    EventDispatcher* previous = manager->event_dispatcher;
+    __atomic_store_n(&manager->event_dispatcher, dispatcher, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&manager->mutex);
+
+    if (!previous) {
+        task_manager_set_event_callback(manager, post_event, manager);
+        return 0;
+    }
+
+    // 旧分发器已不再接收新事件，等正在投递的线程退出后交付剩余事件并销毁
+    task_epoch_synchronize(manager->event_epoch);
+    event_dispatcher_destroy(previous);
+    return 0;
+}
+
+int task_manager_get_event_stats(TaskManager* manager, EventDispatcherStats* stats) {
+    if (!manager || !stats || !__atomic_load_n(&manager->event_dispatcher, __ATOMIC_ACQUIRE)) {
+        return -1;
+    }
+
+    TaskEpochGuard guard = task_epoch_enter(manager->event_epoch);
+    EventDispatcher* dispatcher = __atomic_load_n(&manager->event_dispatcher, __ATOMIC_ACQUIRE);
+    if (dispatcher) {
+        event_dispatcher_get_stats(dispatcher, stats);
+    }
+    task_epoch_exit(manager->event_epoch, guard);
+    return dispatcher ? 0 : -1;
+}
+
+void task_manager_release_events(TaskManager* manager) {
+    if (!manager) {
+        return;
+    }
+
+    pthread_mutex_lock(&manager->mutex);
+    EventDispatcher* dispatcher = manager->event_dispatcher;
+    __atomic_store_n(&manager->event_dispatcher, NULL, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&manager->mutex);
+
+    if (!dispatcher) {
+        return;
+    }
+
+    task_manager_set_event_callback(manager, NULL, NULL);
+    task_epoch_synchronize(manager->event_epoch);
+    event_dispatcher_destroy(dispatcher);
+
+    // 调用前任务已全部停止，不会再有线程进入回收域
+    task_epoch_destroy(manager->event_epoch);
+    manager->event_epoch = NULL;
+}
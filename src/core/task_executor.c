@@ -0,0 +1,621 @@
+#define _GNU_SOURCE
+#include "task_executor.h"
+#include "task_stats.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <errno.h>
+#include <sched.h>
+
+// 工作线程本地队列容量(2的幂)，溢出的任务进入全局队列
+#define WORK_DEQUE_CAPACITY 1024
+
+// 空闲工作线程的最长休眠时间(毫秒)
+#define WORKER_PARK_TIMEOUT_MS 10
+
+// 每隔多少次取任务按从低到高的顺序扫描一次，防止低优先级任务饿死
+#define STARVATION_INTERVAL 16
+
+// 每隔多少次取任务先查注入队列，防止同优先级的本地任务持续让出时饿死新提交的任务
+#define INJECT_POLL_INTERVAL 8
+
+/**
+ * 池化任务调度状态(TaskBase.exec_state)
+ */
+enum {
+    EXEC_STATE_IDLE = 0,        // 未提交或已结束
+    EXEC_STATE_NEW,             // 已提交，尚未初始化
+    EXEC_STATE_QUEUED,          // 在队列中等待调度
+    EXEC_STATE_RUNNING,         // 正在某个工作线程上执行step
+    EXEC_STATE_WAITING          // 挂起，等待唤醒
+};
+
+/**
+ * 工作窃取双端队列(Chase-Lev)
+ * 所有者从bottom端压入；所有者和窃取者都从top端取出，保证本地任务按FIFO轮转
+ */
+typedef struct {
+    int64_t top __attribute__((aligned(64)));
+    int64_t bottom __attribute__((aligned(64)));
+    TaskBase* buffer[WORK_DEQUE_CAPACITY];
+} WorkDeque;
+
+/**
+ * 工作线程
+ */
+typedef struct {
+    TaskExecutor* executor;
+    pthread_t thread;
+    uint32_t index;
+    uint32_t rand_state;        // 选择窃取目标的随机数状态
+    uint32_t pick_count;        // 取任务次数(防饥饿计数)
+    WorkDeque deques[TASK_PRIORITY_LEVELS]; // 按优先级分开的本地队列
+} Worker;
+
+/**
+ * 全局注入队列 - 外部提交和本地队列溢出使用，每个优先级一个
+ */
+typedef struct {
+    TaskBase** items;
+    uint32_t capacity;
+    uint32_t head;
+    uint32_t count;
+} InjectQueue;
+
+struct TaskExecutor {
+    Worker* workers;
+    uint32_t worker_count;
+    bool running;
+
+    pthread_mutex_t mutex;      // 保护注入队列和空闲计数
+    pthread_cond_t work_cond;   // 有新任务时唤醒空闲线程
+    InjectQueue inject[TASK_PRIORITY_LEVELS];
+    uint32_t idle_workers;      // 锁内修改，入本地队列时无锁预读
+
+    pthread_mutex_t done_mutex; // 任务结束通知
+    pthread_cond_t done_cond;
+
+    uint32_t active_tasks;
+    uint64_t steps;
+    uint64_t steals;
+    uint64_t parks;
+    uint64_t priority_steps[TASK_PRIORITY_LEVELS];
+};
+
+// 当前线程所属的工作线程(非工作线程为NULL)
+static __thread Worker* t_current_worker = NULL;
+
+/**
+ * 获取任务的运行队列下标
+ */
+static uint32_t task_priority_level(TaskBase* task) {
+    uint32_t priority = (uint32_t)task->config.priority;
+    return priority < TASK_PRIORITY_LEVELS ? priority : TASK_PRIORITY_NORMAL;
+}
+
+/**
+ * 获取当前时间戳(秒)
+ */
+static uint64_t get_timestamp(void) {
+    return (uint64_t)time(NULL);
+}
+
+/**
+ * 获取调用线程已消耗的CPU时间(纳秒)
+ */
+static uint64_t get_thread_cpu_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// ============================================================================
+// 工作窃取队列
+// ============================================================================
+
+static bool deque_push(WorkDeque* deque, TaskBase* task) {
+    int64_t bottom = __atomic_load_n(&deque->bottom, __ATOMIC_RELAXED);
+    int64_t top = __atomic_load_n(&deque->top, __ATOMIC_ACQUIRE);
+    if (bottom - top >= WORK_DEQUE_CAPACITY) {
+        return false;
+    }
+
+    __atomic_store_n(&deque->buffer[bottom & (WORK_DEQUE_CAPACITY - 1)], task, __ATOMIC_RELAXED);
+    __atomic_store_n(&deque->bottom, bottom + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+static TaskBase* deque_take(WorkDeque* deque) {
+    for (;;) {
+        int64_t top = __atomic_load_n(&deque->top, __ATOMIC_ACQUIRE);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        int64_t bottom = __atomic_load_n(&deque->bottom, __ATOMIC_ACQUIRE);
+        if (top >= bottom) {
+            return NULL;
+        }
+
+        TaskBase* task = __atomic_load_n(&deque->buffer[top & (WORK_DEQUE_CAPACITY - 1)], __ATOMIC_RELAXED);
+        if (__atomic_compare_exchange_n(&deque->top, &top, top + 1, false,
+                                        __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+            return task;
+        }
+    }
+}
+
+// ============================================================================
+// 全局注入队列(调用者持有executor->mutex)
+// count以原子方式写入，工作线程可以不加锁地先判断队列是否为空
+// ============================================================================
+
+static int inject_push_locked(InjectQueue* queue, TaskBase* task) {
+    if (queue->count == queue->capacity) {
+        uint32_t new_capacity = queue->capacity ? queue->capacity * 2 : 256;
+        TaskBase** items = malloc(new_capacity * sizeof(TaskBase*));
+        if (!items) {
+            return -1;
+        }
+        for (uint32_t i = 0; i < queue->count; i++) {
+            items[i] = queue->items[(queue->head + i) % queue->capacity];
+        }
+        free(queue->items);
+        queue->items = items;
+        queue->capacity = new_capacity;
+        queue->head = 0;
+    }
+
+    queue->items[(queue->head + queue->count) % queue->capacity] = task;
+    __atomic_store_n(&queue->count, queue->count + 1, __ATOMIC_RELAXED);
+    return 0;
+}
+
+static TaskBase* inject_pop_locked(InjectQueue* queue) {
+    if (queue->count == 0) {
+        return NULL;
+    }
+
+    TaskBase* task = queue->items[queue->head];
+    queue->head = (queue->head + 1) % queue->capacity;
+    __atomic_store_n(&queue->count, queue->count - 1, __ATOMIC_RELAXED);
+    return task;
+}
+
+static bool inject_empty_locked(TaskExecutor* executor) {
+    for (uint32_t i = 0; i < TASK_PRIORITY_LEVELS; i++) {
+        if (executor->inject[i].count > 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static int inject_task(TaskExecutor* executor, TaskBase* task) {
+    pthread_mutex_lock(&executor->mutex);
+    int ret = inject_push_locked(&executor->inject[task_priority_level(task)], task);
+    if (ret == 0 && executor->idle_workers > 0) {
+        pthread_cond_signal(&executor->work_cond);
+    }
+    pthread_mutex_unlock(&executor->mutex);
+    return ret;
+}
+
+/**
+ * 将任务重新放入队列 - 工作线程优先放入本地队列
+ */
+static void enqueue_task(TaskExecutor* executor, TaskBase* task) {
+    Worker* worker = t_current_worker;
+    if (worker && worker->executor == executor &&
+        deque_push(&worker->deques[task_priority_level(task)], task)) {
+        // 本地队列的任务可被窃取，有空闲线程时唤醒一个，避免其睡满停靠超时
+        if (__atomic_load_n(&executor->idle_workers, __ATOMIC_RELAXED) > 0) {
+            pthread_mutex_lock(&executor->mutex);
+            if (executor->idle_workers > 0) {
+                pthread_cond_signal(&executor->work_cond);
+            }
+            pthread_mutex_unlock(&executor->mutex);
+        }
+        return;
+    }
+
+    inject_task(executor, task);
+}
+
+// ============================================================================
+// 任务执行
+// ============================================================================
+
+/**
+ * 结束任务 - 调用清理函数并更新状态
+ */
+static void finish_task(TaskExecutor* executor, TaskBase* task, TaskState final_state) {
+    TASK_CALL_VOID(task, cleanup);
+
+    task_stats_write_begin(task);
+    // task_stop_timed已放弃等待并标记ERROR，迟到的完成不覆盖
+    task->state = task->stop_abandoned ? TASK_STATE_ERROR : final_state;
+    task->stats.total_run_time = get_timestamp() - task->stats.start_time;
+    task_stats_write_end(task);
+
+    pthread_mutex_lock(&executor->done_mutex);
+    __atomic_store_n(&task->exec_state, EXEC_STATE_IDLE, __ATOMIC_RELEASE);
+    __atomic_sub_fetch(&executor->active_tasks, 1, __ATOMIC_RELAXED);
+    pthread_cond_broadcast(&executor->done_cond);
+    pthread_mutex_unlock(&executor->done_mutex);
+}
+
+static void run_task(TaskExecutor* executor, TaskBase* task) {
+    uint32_t previous = __atomic_exchange_n(&task->exec_state, EXEC_STATE_RUNNING, __ATOMIC_ACQ_REL);
+
+    if (previous == EXEC_STATE_NEW && TASK_CALL(task, initialize) != 0) {
+        task_stats_write_begin(task);
+        task->stats.error_count++;
+        task_stats_write_end(task);
+        finish_task(executor, task, TASK_STATE_ERROR);
+        return;
+    }
+
+    if (task_should_stop(task)) {
+        finish_task(executor, task, TASK_STATE_STOPPED);
+        return;
+    }
+
+    // 工作线程由多个任务共享，按step前后的线程CPU时钟差计入任务
+    bool account = task->config.enable_stats;
+    uint64_t cpu_start = account ? get_thread_cpu_ns() : 0;
+
+    int result = task->vtable->step(task);
+    __atomic_add_fetch(&executor->steps, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&executor->priority_steps[task_priority_level(task)], 1, __ATOMIC_RELAXED);
+
+    uint64_t cpu_used = account ? get_thread_cpu_ns() - cpu_start : 0;
+    int cpu = account ? sched_getcpu() : -1;
+
+    task_stats_write_begin(task);
+    task->stats.execution_count++;
+    if (result < 0) {
+        task->stats.error_count++;
+    }
+    if (account) {
+        task->stats.cpu_time_ns += cpu_used;
+        task->stats.last_cpu = cpu;
+    }
+    task_stats_write_end(task);
+
+    switch (result) {
+        case TASK_STEP_YIELD:
+            __atomic_store_n(&task->exec_state, EXEC_STATE_QUEUED, __ATOMIC_RELEASE);
+            enqueue_task(executor, task);
+            break;
+
+        case TASK_STEP_WAIT: {
+            __atomic_store_n(&task->exec_state, EXEC_STATE_WAITING, __ATOMIC_SEQ_CST);
+            // 执行step期间到达的唤醒不能丢失
+            uint32_t expected = EXEC_STATE_WAITING;
+            if (__atomic_exchange_n(&task->wake_pending, 0, __ATOMIC_SEQ_CST) &&
+                __atomic_compare_exchange_n(&task->exec_state, &expected, EXEC_STATE_QUEUED,
+                                            false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+                enqueue_task(executor, task);
+            }
+            break;
+        }
+
+        case TASK_STEP_DONE:
+            finish_task(executor, task, TASK_STATE_STOPPED);
+            break;
+
+        default:
+            finish_task(executor, task, TASK_STATE_ERROR);
+            break;
+    }
+}
+
+// ============================================================================
+// 工作线程
+// ============================================================================
+
+static TaskBase* steal_task(TaskExecutor* executor, Worker* self, uint32_t level) {
+    if (executor->worker_count < 2) {
+        return NULL;
+    }
+
+    self->rand_state = self->rand_state * 1103515245u + 12345u;
+    uint32_t start = (self->rand_state >> 16) % executor->worker_count;
+
+    for (uint32_t i = 0; i < executor->worker_count; i++) {
+        Worker* victim = &executor->workers[(start + i) % executor->worker_count];
+        if (victim == self) {
+            continue;
+        }
+        TaskBase* task = deque_take(&victim->deques[level]);
+        if (task) {
+            __atomic_add_fetch(&executor->steals, 1, __ATOMIC_RELAXED);
+            return task;
+        }
+    }
+    return NULL;
+}
+
+static TaskBase* take_inject(TaskExecutor* executor, uint32_t level) {
+    InjectQueue* queue = &executor->inject[level];
+    if (__atomic_load_n(&queue->count, __ATOMIC_RELAXED) == 0) {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&executor->mutex);
+    TaskBase* task = inject_pop_locked(queue);
+    pthread_mutex_unlock(&executor->mutex);
+    return task;
+}
+
+/**
+ * 从指定优先级取任务: 本地队列 -> 注入队列，定期反过来
+ */
+static TaskBase* take_level(TaskExecutor* executor, Worker* self, uint32_t level) {
+    TaskBase* task;
+    if (self->pick_count % INJECT_POLL_INTERVAL == 0 && (task = take_inject(executor, level))) {
+        return task;
+    }
+
+    task = deque_take(&self->deques[level]);
+    if (task) {
+        return task;
+    }
+
+    return take_inject(executor, level);
+}
+
+/**
+ * 按优先级从高到低取任务；每STARVATION_INTERVAL次改为从低到高，
+ * 保证低优先级任务在高优先级任务持续就绪时仍能获得一定比例的执行
+ */
+static TaskBase* find_task(TaskExecutor* executor, Worker* self) {
+    bool reverse = ++self->pick_count % STARVATION_INTERVAL == 0;
+
+    for (uint32_t i = 0; i < TASK_PRIORITY_LEVELS; i++) {
+        uint32_t level = reverse ? i : TASK_PRIORITY_LEVELS - 1 - i;
+        TaskBase* task = take_level(executor, self, level);
+        if (task) {
+            return task;
+        }
+    }
+
+    for (uint32_t i = 0; i < TASK_PRIORITY_LEVELS; i++) {
+        TaskBase* task = steal_task(executor, self, TASK_PRIORITY_LEVELS - 1 - i);
+        if (task) {
+            return task;
+        }
+    }
+    return NULL;
+}
+
+static void* worker_thread(void* arg) {
+    Worker* self = arg;
+    TaskExecutor* executor = self->executor;
+    t_current_worker = self;
+
+    while (__atomic_load_n(&executor->running, __ATOMIC_ACQUIRE)) {
+        TaskBase* task = find_task(executor, self);
+        if (task) {
+            run_task(executor, task);
+            continue;
+        }
+
+        // 没有可执行的任务，休眠直到有新任务注入(定时醒来以便窃取)
+        pthread_mutex_lock(&executor->mutex);
+        if (inject_empty_locked(executor) && executor->running) {
+            struct timespec deadline;
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_nsec += WORKER_PARK_TIMEOUT_MS * 1000000L;
+            if (deadline.tv_nsec >= 1000000000L) {
+                deadline.tv_sec++;
+                deadline.tv_nsec -= 1000000000L;
+            }
+
+            __atomic_add_fetch(&executor->idle_workers, 1, __ATOMIC_RELAXED);
+            executor->parks++;
+            pthread_cond_timedwait(&executor->work_cond, &executor->mutex, &deadline);
+            __atomic_sub_fetch(&executor->idle_workers, 1, __ATOMIC_RELAXED);
+        }
+        pthread_mutex_unlock(&executor->mutex);
+    }
+
+    t_current_worker = NULL;
+    return NULL;
+}
+
+// ============================================================================
+// 公共接口
+// ============================================================================
+
+TaskExecutor* task_executor_create(uint32_t worker_count) {
+    if (worker_count == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        worker_count = cpus > 0 ? (uint32_t)cpus : 1;
+    }
+
+    TaskExecutor* executor = calloc(1, sizeof(TaskExecutor));
+    if (!executor) {
+        return NULL;
+    }
+
+    if (posix_memalign((void**)&executor->workers, 64, worker_count * sizeof(Worker)) != 0) {
+        free(executor);
+        return NULL;
+    }
+    memset(executor->workers, 0, worker_count * sizeof(Worker));
+
+    pthread_mutex_init(&executor->mutex, NULL);
+    pthread_cond_init(&executor->work_cond, NULL);
+    pthread_mutex_init(&executor->done_mutex, NULL);
+    pthread_condattr_t cond_attr;
+    pthread_condattr_init(&cond_attr);
+    pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&executor->done_cond, &cond_attr);
+    pthread_condattr_destroy(&cond_attr);
+    executor->running = true;
+
+    for (uint32_t i = 0; i < worker_count; i++) {
+        Worker* worker = &executor->workers[i];
+        worker->executor = executor;
+        worker->index = i;
+        worker->rand_state = i * 2654435761u + 1;
+
+        if (pthread_create(&worker->thread, NULL, worker_thread, worker) != 0) {
+            executor->worker_count = i;
+            task_executor_destroy(executor);
+            return NULL;
+        }
+        executor->worker_count = i + 1;
+    }
+
+    return executor;
+}
+
+void task_executor_destroy(TaskExecutor* executor) {
+    if (!executor) {
+        return;
+    }
+
+    pthread_mutex_lock(&executor->mutex);
+    __atomic_store_n(&executor->running, false, __ATOMIC_RELEASE);
+    pthread_cond_broadcast(&executor->work_cond);
+    pthread_mutex_unlock(&executor->mutex);
+
+    for (uint32_t i = 0; i < executor->worker_count; i++) {
+        pthread_join(executor->workers[i].thread, NULL);
+    }
+
+    pthread_mutex_destroy(&executor->mutex);
+    pthread_cond_destroy(&executor->work_cond);
+    pthread_mutex_destroy(&executor->done_mutex);
+    pthread_cond_destroy(&executor->done_cond);
+    for (uint32_t i = 0; i < TASK_PRIORITY_LEVELS; i++) {
+        free(executor->inject[i].items);
+    }
+    free(executor->workers);
+    free(executor);
+}
+
+static TaskExecutor* g_default_executor = NULL;
+static pthread_once_t g_default_executor_once = PTHREAD_ONCE_INIT;
+
+static void create_default_executor(void) {
+    g_default_executor = task_executor_create(0);
+}
+
+TaskExecutor* task_executor_default(void) {
+    pthread_once(&g_default_executor_once, create_default_executor);
+    return g_default_executor;
+}
+
+int task_executor_submit(TaskExecutor* executor, TaskBase* task) {
+    if (!executor || !task || !task->vtable || !task->vtable->step) {
+        return -1;
+    }
+
+    uint32_t expected = EXEC_STATE_IDLE;
+    if (!__atomic_compare_exchange_n(&task->exec_state, &expected, EXEC_STATE_NEW,
+                                     false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+        return -1; // 已在运行
+    }
+
+    task_stats_write_begin(task);
+    task->executor = executor;
+    task->should_stop = false;
+    task->stop_abandoned = false;
+    task->state = TASK_STATE_RUNNING;
+    task->stats.start_time = get_timestamp();
+    task->stats.last_heartbeat = task->stats.start_time;
+    task_stats_write_end(task);
+
+    __atomic_store_n(&task->wake_pending, 0, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&executor->active_tasks, 1, __ATOMIC_RELAXED);
+
+    if (inject_task(executor, task) != 0) {
+        __atomic_sub_fetch(&executor->active_tasks, 1, __ATOMIC_RELAXED);
+        __atomic_store_n(&task->exec_state, EXEC_STATE_IDLE, __ATOMIC_RELEASE);
+        pthread_mutex_lock(&task->mutex);
+        task->state = TASK_STATE_ERROR;
+        pthread_mutex_unlock(&task->mutex);
+        return -1;
+    }
+
+    return 0;
+}
+
+void task_executor_wake(TaskBase* task) {
+    if (!task || !task->executor) {
+        return;
+    }
+
+    __atomic_store_n(&task->wake_pending, 1, __ATOMIC_SEQ_CST);
+
+    uint32_t expected = EXEC_STATE_WAITING;
+    if (__atomic_compare_exchange_n(&task->exec_state, &expected, EXEC_STATE_QUEUED,
+                                    false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+        __atomic_store_n(&task->wake_pending, 0, __ATOMIC_RELAXED);
+        enqueue_task(task->executor, task);
+    }
+}
+
+int task_executor_stop_task(TaskBase* task) {
+    return task_executor_stop_task_timed(task, 0);
+}
+
+int task_executor_stop_task_timed(TaskBase* task, uint32_t timeout_ms) {
+    if (!task || !task->executor) {
+        return -1;
+    }
+
+    TaskExecutor* executor = task->executor;
+
+    pthread_mutex_lock(&task->mutex);
+    task->should_stop = true;
+    if (task->state == TASK_STATE_RUNNING) {
+        task->state = TASK_STATE_STOPPING;
+    }
+    pthread_mutex_unlock(&task->mutex);
+
+    task_executor_wake(task);
+
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += timeout_ms / 1000;
+    deadline.tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    int ret = 0;
+    pthread_mutex_lock(&executor->done_mutex);
+    while (__atomic_load_n(&task->exec_state, __ATOMIC_ACQUIRE) != EXEC_STATE_IDLE) {
+        if (timeout_ms == 0) {
+            pthread_cond_wait(&executor->done_cond, &executor->done_mutex);
+        } else if (pthread_cond_timedwait(&executor->done_cond, &executor->done_mutex, &deadline) == ETIMEDOUT) {
+            ret = __atomic_load_n(&task->exec_state, __ATOMIC_ACQUIRE) == EXEC_STATE_IDLE ? 0 : 1;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&executor->done_mutex);
+
+    return ret;
+}
+
+void task_executor_get_stats(TaskExecutor* executor, TaskExecutorStats* stats) {
+    if (!executor || !stats) {
+        return;
+    }
+
+    stats->worker_count = executor->worker_count;
+    stats->active_tasks = __atomic_load_n(&executor->active_tasks, __ATOMIC_RELAXED);
+    stats->steps = __atomic_load_n(&executor->steps, __ATOMIC_RELAXED);
+    stats->steals = __atomic_load_n(&executor->steals, __ATOMIC_RELAXED);
+    for (uint32_t i = 0; i < TASK_PRIORITY_LEVELS; i++) {
+        stats->priority_steps[i] = __atomic_load_n(&executor->priority_steps[i], __ATOMIC_RELAXED);
+    }
+
+    pthread_mutex_lock(&executor->mutex);
+    stats->parks = executor->parks;
+    pthread_mutex_unlock(&executor->mutex);
+}
@@ -0,0 +1,185 @@
+#include "task_index.h"
+#include "task_manager.h"
+#include <stdlib.h>
+#include <string.h>
+
+// 已删除槽位标记
+#define TASK_INDEX_TOMBSTONE ((struct TaskNode*)(uintptr_t)1)
+
+// 最小容量
+#define TASK_INDEX_MIN_CAPACITY 16
+
+/**
+ * 向上取整为2的幂
+ */
+static uint32_t round_up_pow2(uint32_t value) {
+    uint32_t capacity = TASK_INDEX_MIN_CAPACITY;
+    while (capacity < value && capacity < (1u << 31)) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+uint32_t task_index_hash(const char* name) {
+    uint32_t hash = 2166136261u;
+    for (const unsigned char* p = (const unsigned char*)name; *p; p++) {
+        hash ^= *p;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * 查找名称所在槽位
+ * @return 槽位下标，未找到返回-1
+ */
+static int64_t find_slot(const TaskIndex* index, const char* name, uint32_t hash) {
+    if (!index->slots) {
+        return -1;
+    }
+
+    uint32_t mask = index->capacity - 1;
+    for (uint32_t i = hash & mask, probes = 0; probes < index->capacity; i = (i + 1) & mask, probes++) {
+        const TaskIndexSlot* slot = &index->slots[i];
+        if (slot->node == NULL) {
+            return -1;
+        }
+        if (slot->node != TASK_INDEX_TOMBSTONE && slot->hash == hash &&
+            strcmp(slot->node->name, name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * 在不检查重复的前提下放入节点(用于扩容重建)
+ */
+static void place_node(TaskIndexSlot* slots, uint32_t capacity, struct TaskNode* node, uint32_t hash) {
+    uint32_t mask = capacity - 1;
+    uint32_t i = hash & mask;
+    while (slots[i].node != NULL && slots[i].node != TASK_INDEX_TOMBSTONE) {
+        i = (i + 1) & mask;
+    }
+    slots[i].hash = hash;
+    slots[i].node = node;
+}
+
+/**
+ * 重建索引到新容量，同时清除墓碑
+ */
+static int rehash(TaskIndex* index, uint32_t new_capacity) {
+    TaskIndexSlot* new_slots = calloc(new_capacity, sizeof(TaskIndexSlot));
+    if (!new_slots) {
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < index->capacity; i++) {
+        TaskIndexSlot* slot = &index->slots[i];
+        if (slot->node != NULL && slot->node != TASK_INDEX_TOMBSTONE) {
+            place_node(new_slots, new_capacity, slot->node, slot->hash);
+        }
+    }
+
+    free(index->slots);
+    index->slots = new_slots;
+    index->capacity = new_capacity;
+    index->tombstones = 0;
+    return 0;
+}
+
+int task_index_init(TaskIndex* index, uint32_t initial_capacity) {
+    if (!index) {
+        return -1;
+    }
+
+    index->capacity = round_up_pow2(initial_capacity);
+    index->count = 0;
+    index->tombstones = 0;
+    index->slots = calloc(index->capacity, sizeof(TaskIndexSlot));
+    return index->slots ? 0 : -1;
+}
+
+void task_index_destroy(TaskIndex* index) {
+    if (!index) {
+        return;
+    }
+
+    free(index->slots);
+    index->slots = NULL;
+    index->capacity = 0;
+    index->count = 0;
+    index->tombstones = 0;
+}
+
+int task_index_insert(TaskIndex* index, struct TaskNode* node) {
+    if (!index || !node) {
+        return -1;
+    }
+
+    if (!index->slots && task_index_init(index, TASK_INDEX_MIN_CAPACITY) != 0) {
+        return -1;
+    }
+
+    uint32_t hash = task_index_hash(node->name);
+    if (find_slot(index, node->name, hash) >= 0) {
+        return -2;
+    }
+
+    // 负载因子(含墓碑)保持在0.7以下，保证探测链短
+    if ((uint64_t)(index->count + index->tombstones + 1) * 10 > (uint64_t)index->capacity * 7) {
+        uint32_t new_capacity = index->capacity;
+        if ((uint64_t)(index->count + 1) * 10 > (uint64_t)index->capacity * 5) {
+            new_capacity <<= 1;
+        }
+        if (rehash(index, new_capacity) != 0) {
+            return -1;
+        }
+    }
+
+    uint32_t mask = index->capacity - 1;
+    uint32_t i = hash & mask;
+    while (index->slots[i].node != NULL && index->slots[i].node != TASK_INDEX_TOMBSTONE) {
+        i = (i + 1) & mask;
+    }
+    if (index->slots[i].node == TASK_INDEX_TOMBSTONE) {
+        index->tombstones--;
+    }
+    index->slots[i].hash = hash;
+    index->slots[i].node = node;
+    index->count++;
+    return 0;
+}
+
+struct TaskNode* task_index_remove(TaskIndex* index, const char* name) {
+    if (!index || !name) {
+        return NULL;
+    }
+
+    int64_t i = find_slot(index, name, task_index_hash(name));
+    if (i < 0) {
+        return NULL;
+    }
+
+    struct TaskNode* node = index->slots[i].node;
+
+    // 后继为空槽时可直接清空，否则留下墓碑以保持探测链
+    uint32_t next = (uint32_t)(i + 1) & (index->capacity - 1);
+    if (index->slots[next].node == NULL) {
+        index->slots[i].node = NULL;
+    } else {
+        index->slots[i].node = TASK_INDEX_TOMBSTONE;
+        index->tombstones++;
+    }
+    index->count--;
+    return node;
+}
+
+struct TaskNode* task_index_find(const TaskIndex* index, const char* name) {
+    if (!index || !name) {
+        return NULL;
+    }
+
+    int64_t i = find_slot(index, name, task_index_hash(name));
+    return i >= 0 ? index->slots[i].node : NULL;
+}
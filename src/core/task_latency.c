@@ -0,0 +1,112 @@
+#include "task_latency.h"
+#include "task_manager.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+uint64_t task_latency_begin(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/**
+ * 获取任务的直方图，不存在时创建 - 只有记录线程会调用，
+ * 但读者可能同时读取指针，以CAS发布
+ */
+static LatencyHistogram* get_or_create_histogram(TaskBase* task) {
+    LatencyHistogram* histogram = __atomic_load_n(&task->latency, __ATOMIC_ACQUIRE);
+    if (histogram) {
+        return histogram;
+    }
+
+    LatencyHistogram* created = calloc(1, sizeof(LatencyHistogram));
+    if (!created) {
+        return NULL;
+    }
+
+    if (!__atomic_compare_exchange_n(&task->latency, &histogram, created, false,
+                                     __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        free(created);
+        return histogram;
+    }
+    return created;
+}
+
+void task_latency_record(TaskBase* task, uint64_t value_ns) {
+    if (!task) {
+        return;
+    }
+
+    LatencyHistogram* histogram = get_or_create_histogram(task);
+    if (histogram) {
+        latency_histogram_record(histogram, value_ns);
+    }
+}
+
+void task_latency_end(TaskBase* task, uint64_t begin) {
+    uint64_t end = task_latency_begin();
+    task_latency_record(task, end > begin ? end - begin : 0);
+}
+
+int task_latency_snapshot(TaskBase* task, LatencyHistogram* histogram) {
+    if (!task || !histogram) {
+        return -1;
+    }
+
+    LatencyHistogram* source = __atomic_load_n(&task->latency, __ATOMIC_ACQUIRE);
+    if (!source) {
+        return -1;
+    }
+
+    latency_histogram_snapshot(histogram, source);
+    return 0;
+}
+
+void task_latency_release(TaskBase* task) {
+    if (!task) {
+        return;
+    }
+
+    free(__atomic_exchange_n(&task->latency, NULL, __ATOMIC_ACQ_REL));
+}
+
+int task_manager_get_task_latency(TaskManager* manager, const char* name, LatencyHistogram* histogram) {
+    if (!manager || !name || !histogram) {
+        return -1;
+    }
+
+    TaskBase* task = task_manager_get_task(manager, name);
+    if (!task) {
+        return -1;
+    }
+
+    return task_latency_snapshot(task, histogram);
+}
+
+int task_manager_merge_latency(TaskManager* manager, LatencyHistogram* histogram) {
+    if (!manager || !histogram) {
+        return -1;
+    }
+
+    LatencyHistogram* snapshot = malloc(sizeof(LatencyHistogram));
+    if (!snapshot) {
+        return -1;
+    }
+
+    latency_histogram_reset(histogram);
+    int merged = 0;
+
+    pthread_mutex_lock(&manager->mutex);
+    TaskNode* node;
+    TAILQ_FOREACH(node, &manager->task_list, entries) {
+        if (task_latency_snapshot(node->task, snapshot) == 0) {
+            latency_histogram_merge(histogram, snapshot);
+            merged++;
+        }
+    }
+    pthread_mutex_unlock(&manager->mutex);
+
+    free(snapshot);
+    return merged;
+}
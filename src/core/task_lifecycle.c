@@ -0,0 +1,272 @@
+#include "task_manager.h"
+#include "core_internal.h"
+#include "task_executor.h"
+#include "task_stats.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * 复制当前所有任务名称
+ * @return 任务数量，失败返回-1
+ */
+static int collect_task_names(TaskManager* manager, char (**names)[64]) {
+    pthread_mutex_lock(&manager->mutex);
+
+    uint32_t count = 0;
+    TaskNode* node;
+    TAILQ_FOREACH(node, &manager->task_list, entries) {
+        count++;
+    }
+
+    *names = calloc(count ? count : 1, 64);
+    if (!*names) {
+        pthread_mutex_unlock(&manager->mutex);
+        return -1;
+    }
+
+    uint32_t i = 0;
+    TAILQ_FOREACH(node, &manager->task_list, entries) {
+        memcpy((*names)[i++], node->name, sizeof(node->name));
+    }
+
+    pthread_mutex_unlock(&manager->mutex);
+    return (int)count;
+}
+
+static int start_operation(void* target, const char* name) {
+    return task_manager_start_task(target, name);
+}
+
+static int stop_operation(void* target, const char* name) {
+    return task_manager_stop_task(target, name);
+}
+
+static void stop_escalation(void* target, const char* name) {
+    TaskBase* task = task_manager_get_task(target, name);
+    if (!task) {
+        return;
+    }
+
+    if (task->executor) {
+        task_executor_wake(task);
+        return;
+    }
+
+    // 再次唤醒停靠在task_park/task_sleep中的线程；不发信号，不影响宿主程序的信号处理
+    task_notify(task);
+}
+
+static int run_all(TaskManager* manager, LifecycleOperation operation, LifecycleEscalation escalate,
+                   const LifecycleOptions* options, LifecycleReport* report) {
+    // 失败时调用者仍可安全读取报告和调用lifecycle_report_free
+    if (report) {
+        memset(report, 0, sizeof(LifecycleReport));
+    }
+    if (!manager) {
+        return -1;
+    }
+
+    char (*names)[64];
+    int count = collect_task_names(manager, &names);
+    if (count < 0) {
+        return -1;
+    }
+
+    int ret = lifecycle_run(manager, names, (uint32_t)count, operation, escalate, options, report);
+    free(names);
+    return ret;
+}
+
+int task_manager_start_all_parallel(TaskManager* manager, const LifecycleOptions* options,
+                                    LifecycleReport* report) {
+    return run_all(manager, start_operation, NULL, options, report);
+}
+
+int task_manager_stop_all_parallel(TaskManager* manager, const LifecycleOptions* options,
+                                   LifecycleReport* report) {
+    return run_all(manager, stop_operation, stop_escalation, options, report);
+}
+
+int task_manager_stop_task_timed(TaskManager* manager, const char* name, const TaskStopOptions* options) {
+    if (!manager || !name) {
+        return -1;
+    }
+
+    TaskBase* task = task_manager_get_task(manager, name);
+    if (!task) {
+        return -1;
+    }
+    return task_stop_timed(task, options);
+}
+
+static bool task_ready_probe(void* target, const char* name) {
+    TaskBase* task = task_manager_get_task(target, name);
+    if (!task || task_get_state(task) != TASK_STATE_RUNNING) {
+        return false;
+    }
+
+    return !task->vtable || !task->vtable->health_check || task->vtable->health_check(task);
+}
+
+static int ordered_start_operation(void* target, const char* name) {
+    // 已经就绪的任务(如作为外部依赖先行启动)不再重复启动
+    if (task_ready_probe(target, name)) {
+        return 0;
+    }
+    return task_manager_start_task(target, name);
+}
+
+int task_manager_add_dependency(TaskManager* manager, const char* name, const char* dependency) {
+    if (!manager || !name || !dependency) {
+        return -1;
+    }
+
+    TaskBase* task = task_manager_get_task(manager, name);
+    if (!task) {
+        return -1;
+    }
+
+    int ret = -1;
+    pthread_mutex_lock(&task->mutex);
+    if (task->config.dependency_count < STARTUP_MAX_DEPENDENCIES) {
+        char* slot = task->config.depends_on[task->config.dependency_count++];
+        strncpy(slot, dependency, 63);
+        slot[63] = '\0';
+        ret = 0;
+    }
+    pthread_mutex_unlock(&task->mutex);
+    return ret;
+}
+
+int task_manager_start_all_ordered(TaskManager* manager, const StartupOptions* options,
+                                   StartupReport* report) {
+    if (!manager) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&manager->mutex);
+
+    uint32_t count = 0;
+    TaskNode* node;
+    TAILQ_FOREACH(node, &manager->task_list, entries) {
+        count++;
+    }
+
+    StartupNode* nodes = calloc(count ? count : 1, sizeof(StartupNode));
+    if (!nodes) {
+        pthread_mutex_unlock(&manager->mutex);
+        return -1;
+    }
+
+    uint32_t i = 0;
+    TAILQ_FOREACH(node, &manager->task_list, entries) {
+        TaskBase* task = node->task;
+        memcpy(nodes[i].name, node->name, sizeof(nodes[i].name));
+
+        pthread_mutex_lock(&task->mutex);
+        nodes[i].dependency_count = task->config.dependency_count;
+        memcpy(nodes[i].depends_on, task->config.depends_on, sizeof(nodes[i].depends_on));
+        pthread_mutex_unlock(&task->mutex);
+        i++;
+    }
+
+    pthread_mutex_unlock(&manager->mutex);
+
+    int ret = startup_graph_run(manager, nodes, count, ordered_start_operation, task_ready_probe,
+                                options, report);
+    free(nodes);
+    return ret;
+}
+
+int task_manager_set_restart_policy(TaskManager* manager, const char* name, const RestartPolicy* policy) {
+    if (!manager || !name) {
+        return -1;
+    }
+
+    TaskBase* task = task_manager_get_task(manager, name);
+    if (!task) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&task->mutex);
+    if (policy) {
+        task->restart_policy = *policy;
+    } else {
+        memset(&task->restart_policy, 0, sizeof(RestartPolicy));
+    }
+    pthread_mutex_unlock(&task->mutex);
+    return 0;
+}
+
+/**
+ * 在task->mutex下推进重启状态并导出统计
+ * @return true计划的重启已到期
+ */
+static bool update_restart_state(TaskBase* task, TaskState state, uint64_t now) {
+    RestartPolicy policy = task->restart_policy;
+    restart_policy_normalize(&policy, task->config.max_restart_count);
+
+    // 任务不经restart_state_init，按名称播种，否则同时失败的任务抖动序列相同，会同步重启
+    if (task->restart_state.seed == 0) {
+        task->restart_state.seed = task_index_hash(task->config.name);
+    }
+
+    // 限时停止放弃等待的任务也报告ERROR，但停止是操作者要求的，且被分离的线程可能仍在使用
+    // 同一个TaskBase，不得自动重启
+    bool due = false;
+    if (state == TASK_STATE_ERROR && !task->stop_abandoned) {
+        restart_state_schedule(&task->restart_state, &policy, now);
+        due = restart_state_due(&task->restart_state, now);
+    } else if (state == TASK_STATE_RUNNING) {
+        restart_state_mark_running(&task->restart_state, &policy, now);
+    }
+
+    task_stats_write_begin_locked(task);
+    restart_state_export(&task->restart_state, &policy, now, &task->stats.restart);
+    task_stats_write_end_locked(task);
+    return due;
+}
+
+int task_manager_check_restarts(TaskManager* manager) {
+    if (!manager) {
+        return -1;
+    }
+
+    char (*names)[64];
+    int count = collect_task_names(manager, &names);
+    if (count < 0) {
+        return -1;
+    }
+
+    int restarted = 0;
+    for (int i = 0; i < count; i++) {
+        TaskBase* task = task_manager_get_task(manager, names[i]);
+        if (!task || !task->config.auto_restart) {
+            continue;
+        }
+
+        TaskState state = task_get_state(task);
+        pthread_mutex_lock(&task->mutex);
+        bool due = update_restart_state(task, state, get_monotonic_ns());
+        pthread_mutex_unlock(&task->mutex);
+
+        if (!due) {
+            continue;
+        }
+
+        // 重启可能阻塞在join上，不持锁；失败的任务仍为ERROR，下一周期按更长的退避再试
+        int ret = task_manager_restart_task(manager, names[i]);
+        restarted += ret == 0;
+
+        state = task_get_state(task);
+        pthread_mutex_lock(&task->mutex);
+        uint64_t now = get_monotonic_ns();
+        restart_state_restarted(&task->restart_state, now);
+        update_restart_state(task, state, now);
+        pthread_mutex_unlock(&task->mutex);
+    }
+
+    free(names);
+    return restarted;
+}
@@ -0,0 +1,165 @@
+#include "task_park.h"
+#include "core_internal.h"
+#include "task_manager.h"
+#include <limits.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+
+/**
+ * park_seq仍等于expected时阻塞，timeout为NULL时不限时
+ */
+static void futex_wait(uint32_t* word, uint32_t expected, const struct timespec* timeout) {
+    syscall(SYS_futex, word, FUTEX_WAIT_PRIVATE, expected, timeout, NULL, 0);
+}
+
+static void futex_wake_all(uint32_t* word) {
+    syscall(SYS_futex, word, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+}
+
+/**
+ * 停靠到单调时刻*deadline(UINT64_MAX不限)
+ * @param extend_on_pause true时把暂停的时长加到*deadline上(task_sleep顺延)
+ */
+static TaskParkResult park_until(TaskBase* task, uint64_t* deadline, bool extend_on_pause) {
+    for (;;) {
+        // 先读序号再查标志: 设置标志的一方随后递增序号，futex比较序号时不会丢失唤醒
+        uint32_t sequence = __atomic_load_n(&task->park_seq, __ATOMIC_SEQ_CST);
+
+        if (__atomic_load_n(&task->should_stop, __ATOMIC_SEQ_CST)) {
+            task->park_seen = sequence;
+            return TASK_PARK_STOPPED;
+        }
+
+        if (__atomic_load_n(&task->paused, __ATOMIC_SEQ_CST)) {
+            // 暂停期间的通知一并吸收，恢复本身会再递增序号
+            task->park_seen = sequence;
+            uint64_t paused_at = get_monotonic_ns();
+            futex_wait(&task->park_seq, sequence, NULL);
+            if (extend_on_pause && *deadline != UINT64_MAX) {
+                *deadline += get_monotonic_ns() - paused_at;
+            }
+            continue;
+        }
+
+        if (sequence != task->park_seen) {
+            task->park_seen = sequence;
+            return TASK_PARK_NOTIFIED;
+        }
+
+        uint64_t now = get_monotonic_ns();
+        if (now >= *deadline) {
+            return TASK_PARK_TIMEOUT;
+        }
+
+        if (*deadline == UINT64_MAX) {
+            futex_wait(&task->park_seq, sequence, NULL);
+        } else {
+            uint64_t remaining = *deadline - now;
+            struct timespec timeout = {
+                .tv_sec = remaining / 1000000000ULL,
+                .tv_nsec = remaining % 1000000000ULL
+            };
+            futex_wait(&task->park_seq, sequence, &timeout);
+        }
+    }
+}
+
+TaskParkResult task_park(TaskBase* task, uint32_t timeout_ms) {
+    uint64_t deadline = timeout_ms == TASK_PARK_FOREVER
+        ? UINT64_MAX : get_monotonic_ns() + (uint64_t)timeout_ms * 1000000ULL;
+    return park_until(task, &deadline, false);
+}
+
+TaskParkResult task_sleep(TaskBase* task, uint32_t duration_ms) {
+    uint64_t deadline = get_monotonic_ns() + (uint64_t)duration_ms * 1000000ULL;
+
+    // 普通通知只打断本轮停靠，deadline保留跨轮累计的暂停顺延
+    for (;;) {
+        TaskParkResult result = park_until(task, &deadline, true);
+        if (result != TASK_PARK_NOTIFIED) {
+            return result;
+        }
+    }
+}
+
+void task_notify(TaskBase* task) {
+    if (!task) {
+        return;
+    }
+
+    __atomic_add_fetch(&task->park_seq, 1, __ATOMIC_SEQ_CST);
+    futex_wake_all(&task->park_seq);
+}
+
+void task_request_stop(TaskBase* task) {
+    if (!task) {
+        return;
+    }
+
+    pthread_mutex_lock(&task->mutex);
+    __atomic_store_n(&task->should_stop, true, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&task->mutex);
+
+    task_notify(task);
+}
+
+int task_pause(TaskBase* task) {
+    if (!task) {
+        return -1;
+    }
+
+    if (task->vtable && task->vtable->pause && task->vtable->pause(task) != 0) {
+        return -1;
+    }
+
+    __atomic_store_n(&task->paused, 1, __ATOMIC_SEQ_CST);
+    task_notify(task);
+    return 0;
+}
+
+int task_resume(TaskBase* task) {
+    if (!task) {
+        return -1;
+    }
+
+    __atomic_store_n(&task->paused, 0, __ATOMIC_SEQ_CST);
+    int result = task->vtable && task->vtable->resume ? task->vtable->resume(task) : 0;
+    task_notify(task);
+    return result;
+}
+
+bool task_is_paused(TaskBase* task) {
+    return task && __atomic_load_n(&task->paused, __ATOMIC_ACQUIRE);
+}
+
+int task_manager_pause_task(TaskManager* manager, const char* name) {
+    if (!manager || !name) {
+        return -1;
+    }
+
+    return task_pause(task_manager_get_task(manager, name));
+}
+
+int task_manager_resume_task(TaskManager* manager, const char* name) {
+    if (!manager || !name) {
+        return -1;
+    }
+
+    return task_resume(task_manager_get_task(manager, name));
+}
+
+int task_manager_notify_task(TaskManager* manager, const char* name) {
+    if (!manager || !name) {
+        return -1;
+    }
+
+    TaskBase* task = task_manager_get_task(manager, name);
+    if (!task) {
+        return -1;
+    }
+
+    task_notify(task);
+    return 0;
+}
@@ -0,0 +1,230 @@
+#include "task_manager.h"
+#include "task_executor.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * 定时维护任务 - 不注册到管理器的池化任务，由定时服务按周期唤醒
+ */
+typedef struct {
+    TaskBase base;
+    TaskManager* manager;
+    uint32_t accounting_flags;
+} MaintenanceTask;
+
+/**
+ * 定时器到期 - 唤醒挂起的任务(在定时线程上执行，不能阻塞)
+ */
+static void periodic_timer_fired(TimerWheelTimer* timer, void* user_data) {
+    (void)timer;
+    task_executor_wake((TaskBase*)user_data);
+}
+
+/**
+ * 释放任务的定时器 - 调用者须持有manager->mutex
+ */
+static void detach_periodic_locked(TaskManager* manager, TaskBase* task) {
+    if (!task->periodic_timer) {
+        return;
+    }
+
+    // 取消返回后回调不会再执行，可以安全释放定时器
+    if (manager->timer_service) {
+        timer_service_cancel(manager->timer_service, task->periodic_timer);
+    }
+    free(task->periodic_timer);
+    task->periodic_timer = NULL;
+}
+
+int task_manager_schedule_periodic(TaskManager* manager, const char* name, uint32_t interval_ms) {
+    if (!manager || !name || interval_ms == 0) {
+        return -1;
+    }
+
+    TaskBase* task = task_manager_get_task(manager, name);
+    if (!task || !task->vtable || !task->vtable->step) {
+        return -1;
+    }
+
+    // 已在独占线程中运行的任务无法由定时器驱动
+    bool running = task_get_state(task) == TASK_STATE_RUNNING;
+    if (running && !task->executor) {
+        return -1;
+    }
+
+    if (!running) {
+        TaskExecutor* executor = task->executor ? task->executor : task_executor_default();
+        if (task_executor_submit(executor, task) != 0) {
+            return -1;
+        }
+    }
+
+    // 定时服务和定时器的创建、启动与取消、释放定时服务都在管理器锁内进行；
+    // 回调只唤醒任务，不获取管理器锁
+    int ret = -1;
+    pthread_mutex_lock(&manager->mutex);
+    if (!manager->timer_service) {
+        manager->timer_service = timer_service_create();
+    }
+    if (manager->timer_service && !task->periodic_timer) {
+        task->periodic_timer = calloc(1, sizeof(TimerWheelTimer));
+    }
+    if (manager->timer_service && task->periodic_timer) {
+        timer_service_arm(manager->timer_service, task->periodic_timer, interval_ms, interval_ms,
+                          periodic_timer_fired, task);
+        ret = 0;
+    }
+    pthread_mutex_unlock(&manager->mutex);
+    return ret;
+}
+
+int task_manager_cancel_periodic(TaskManager* manager, const char* name) {
+    if (!manager || !name) {
+        return -1;
+    }
+
+    TaskBase* task = task_manager_get_task(manager, name);
+    if (!task) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&manager->mutex);
+    int ret = task->periodic_timer && manager->timer_service ? 0 : -1;
+    detach_periodic_locked(manager, task);
+    pthread_mutex_unlock(&manager->mutex);
+    return ret;
+}
+
+void task_manager_detach_periodic(TaskManager* manager, TaskBase* task) {
+    if (!manager || !task) {
+        return;
+    }
+
+    detach_periodic_locked(manager, task);
+}
+
+int task_manager_get_timer_stats(TaskManager* manager, TimerServiceStats* stats) {
+    if (!manager || !stats) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&manager->mutex);
+    int ret = manager->timer_service ? 0 : -1;
+    if (ret == 0) {
+        timer_service_get_stats(manager->timer_service, stats);
+    }
+    pthread_mutex_unlock(&manager->mutex);
+    return ret;
+}
+
+void task_manager_release_timers(TaskManager* manager) {
+    if (!manager) {
+        return;
+    }
+
+    // 先取消并释放所有任务的定时器，定时线程不会再持有任务指针
+    pthread_mutex_lock(&manager->mutex);
+    TaskNode* node;
+    TAILQ_FOREACH(node, &manager->task_list, entries) {
+        detach_periodic_locked(manager, node->task);
+    }
+    if (manager->maintenance) {
+        detach_periodic_locked(manager, manager->maintenance);
+    }
+    TimerService* service = manager->timer_service;
+    manager->timer_service = NULL;
+    pthread_mutex_unlock(&manager->mutex);
+
+    timer_service_destroy(service);
+}
+
+static int maintenance_initialize(TaskBase* task) {
+    (void)task;
+    return 0;
+}
+
+/**
+ * 一次维护 - 重启策略检查和CPU记账采样；重启会join已退出的任务线程，通常很快返回
+ */
+static int maintenance_step(TaskBase* task) {
+    MaintenanceTask* maintenance = (MaintenanceTask*)task;
+    task_manager_check_restarts(maintenance->manager);
+    if (maintenance->accounting_flags) {
+        task_manager_sample_accounting(maintenance->manager, maintenance->accounting_flags, NULL);
+    }
+    return TASK_STEP_WAIT;
+}
+
+static const TaskInterface g_maintenance_vtable = {
+    .initialize = maintenance_initialize,
+    .step = maintenance_step
+};
+
+int task_manager_start_maintenance(TaskManager* manager, uint32_t interval_ms, uint32_t accounting_flags) {
+    if (!manager || interval_ms == 0) {
+        return -1;
+    }
+
+    MaintenanceTask* maintenance = calloc(1, sizeof(MaintenanceTask));
+    if (!maintenance) {
+        return -1;
+    }
+
+    TaskConfig config;
+    memset(&config, 0, sizeof(config));
+    snprintf(config.name, sizeof(config.name), "maintenance");
+    config.priority = TASK_PRIORITY_HIGH;
+    config.exec_mode = TASK_EXEC_POOLED;
+    if (task_base_init(&maintenance->base, &g_maintenance_vtable, &config) != 0) {
+        free(maintenance);
+        return -1;
+    }
+    maintenance->manager = manager;
+    maintenance->accounting_flags = accounting_flags;
+    maintenance->base.periodic_timer = calloc(1, sizeof(TimerWheelTimer));
+
+    pthread_mutex_lock(&manager->mutex);
+    if (!manager->timer_service) {
+        manager->timer_service = timer_service_create();
+    }
+    bool ok = !manager->maintenance && manager->timer_service && maintenance->base.periodic_timer &&
+              task_executor_submit(task_executor_default(), &maintenance->base) == 0;
+    if (ok) {
+        manager->maintenance = &maintenance->base;
+        timer_service_arm(manager->timer_service, maintenance->base.periodic_timer, interval_ms,
+                          interval_ms, periodic_timer_fired, &maintenance->base);
+    }
+    pthread_mutex_unlock(&manager->mutex);
+
+    if (!ok) {
+        free(maintenance->base.periodic_timer);
+        task_base_destroy(&maintenance->base);
+        free(maintenance);
+        return -1;
+    }
+    return 0;
+}
+
+void task_manager_stop_maintenance(TaskManager* manager) {
+    if (!manager) {
+        return;
+    }
+
+    pthread_mutex_lock(&manager->mutex);
+    TaskBase* maintenance = manager->maintenance;
+    manager->maintenance = NULL;
+    if (maintenance) {
+        detach_periodic_locked(manager, maintenance);
+    }
+    pthread_mutex_unlock(&manager->mutex);
+
+    if (!maintenance) {
+        return;
+    }
+
+    // 维护步骤会获取管理器锁，须在锁外等待它结束
+    task_executor_stop_task(maintenance);
+    task_base_destroy(maintenance);
+    free(maintenance);
+}
@@ -0,0 +1,137 @@
+#include "task_manager.h"
+#include "task_epoch.h"
+#include "task_stats.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * 释放视图
+ */
+static void view_free(TaskRegistryView* view) {
+    if (!view) {
+        return;
+    }
+
+    task_index_destroy(&view->index);
+    free(view->nodes);
+    free(view);
+}
+
+/**
+ * 按当前链表构建新视图
+ * @return 新视图，内存不足时返回NULL
+ */
+static TaskRegistryView* view_build(TaskManager* manager, uint64_t generation) {
+    TaskRegistryView* view = calloc(1, sizeof(TaskRegistryView));
+    if (!view) {
+        return NULL;
+    }
+
+    uint32_t count = 0;
+    TaskNode* node;
+    TAILQ_FOREACH(node, &manager->task_list, entries) {
+        count++;
+    }
+
+    view->generation = generation;
+    view->nodes = calloc(count ? count : 1, sizeof(TaskNode));
+    if (!view->nodes || task_index_init(&view->index, count * 2) != 0) {
+        view_free(view);
+        return NULL;
+    }
+
+    TAILQ_FOREACH(node, &manager->task_list, entries) {
+        TaskNode* copy = &view->nodes[view->count++];
+        copy->task = node->task;
+        memcpy(copy->name, node->name, sizeof(copy->name));
+        // 缺项的视图会让读者查不到已注册的任务，插入失败时放弃本次构建，保留旧视图
+        if (task_index_insert(&view->index, copy) != 0) {
+            view_free(view);
+            return NULL;
+        }
+    }
+
+    return view;
+}
+
+int task_manager_publish_view(TaskManager* manager) {
+    if (!manager) {
+        return -1;
+    }
+
+    if (!manager->view_epoch) {
+        manager->view_epoch = task_epoch_create();
+        if (!manager->view_epoch) {
+            return -1;
+        }
+    }
+
+    TaskRegistryView* old_view = manager->view;
+    TaskRegistryView* new_view = view_build(manager, old_view ? old_view->generation + 1 : 1);
+    if (!new_view) {
+        return -1;
+    }
+
+    __atomic_store_n(&manager->view, new_view, __ATOMIC_RELEASE);
+
+    if (old_view) {
+        task_epoch_synchronize(manager->view_epoch);
+        view_free(old_view);
+    }
+
+    return 0;
+}
+
+void task_manager_release_view(TaskManager* manager) {
+    if (!manager) {
+        return;
+    }
+
+    view_free(manager->view);
+    manager->view = NULL;
+    task_epoch_destroy(manager->view_epoch);
+    manager->view_epoch = NULL;
+}
+
+TaskState task_manager_read_task_state(TaskManager* manager, const char* name) {
+    if (!manager || !name) {
+        return TASK_STATE_UNKNOWN;
+    }
+
+    if (!__atomic_load_n(&manager->view, __ATOMIC_ACQUIRE)) {
+        return task_manager_get_task_state(manager, name);
+    }
+
+    TaskEpochGuard guard = task_epoch_enter(manager->view_epoch);
+
+    TaskState state = TASK_STATE_UNKNOWN;
+    TaskRegistryView* view = __atomic_load_n(&manager->view, __ATOMIC_ACQUIRE);
+    TaskNode* node = task_index_find(&view->index, name);
+    if (node) {
+        state = __atomic_load_n(&node->task->state, __ATOMIC_ACQUIRE);
+    }
+
+    task_epoch_exit(manager->view_epoch, guard);
+    return state;
+}
+
+int task_manager_read_task_stats(TaskManager* manager, const char* name, TaskStats* stats) {
+    if (!manager || !name || !stats) {
+        return -1;
+    }
+
+    if (!__atomic_load_n(&manager->view, __ATOMIC_ACQUIRE)) {
+        return task_stats_snapshot(task_manager_get_task(manager, name), stats);
+    }
+
+    TaskEpochGuard guard = task_epoch_enter(manager->view_epoch);
+
+    TaskRegistryView* view = __atomic_load_n(&manager->view, __ATOMIC_ACQUIRE);
+    TaskNode* node = task_index_find(&view->index, name);
+    if (node) {
+        task_stats_snapshot(node->task, stats);
+    }
+
+    task_epoch_exit(manager->view_epoch, guard);
+    return node ? 0 : -1;
+}
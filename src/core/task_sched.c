@@ -0,0 +1,92 @@
+#define _GNU_SOURCE
+#include "task_sched.h"
+#include "task_accounting.h"
+#include "task_stats.h"
+#include <sched.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+
+/**
+ * 设置调用线程的普通调度策略和nice值
+ * Linux的nice值是线程级的，以tid作为PRIO_PROCESS的参数
+ */
+static int set_normal_policy(int nice_value) {
+    struct sched_param param = { .sched_priority = 0 };
+    if (sched_setscheduler(0, SCHED_OTHER, &param) != 0) {
+        return -1;
+    }
+    return setpriority(PRIO_PROCESS, (id_t)syscall(SYS_gettid), nice_value);
+}
+
+TaskSchedClass task_sched_apply_current(TaskPriority priority) {
+    switch (priority) {
+        case TASK_PRIORITY_LOW: {
+            struct sched_param param = { .sched_priority = 0 };
+            if (sched_setscheduler(0, SCHED_IDLE, &param) == 0) {
+                return TASK_SCHED_IDLE;
+            }
+            break;
+        }
+
+        case TASK_PRIORITY_CRITICAL: {
+            struct sched_param param = { .sched_priority = TASK_SCHED_FIFO_PRIORITY };
+            if (sched_setscheduler(0, SCHED_FIFO, &param) == 0) {
+                return TASK_SCHED_REALTIME;
+            }
+            // 没有CAP_SYS_NICE或RLIMIT_RTPRIO时降级
+            if (set_normal_policy(TASK_SCHED_CRITICAL_NICE) == 0) {
+                return TASK_SCHED_BOOSTED;
+            }
+            break;
+        }
+
+        case TASK_PRIORITY_HIGH:
+            if (set_normal_policy(TASK_SCHED_HIGH_NICE) == 0) {
+                return TASK_SCHED_BOOSTED;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    return set_normal_policy(0) == 0 ? TASK_SCHED_NORMAL : TASK_SCHED_DEFAULT;
+}
+
+TaskSchedClass task_sched_apply(TaskBase* task) {
+    if (!task) {
+        return TASK_SCHED_DEFAULT;
+    }
+
+    TaskSchedClass sched_class = task_sched_apply_current(task->config.priority);
+    __atomic_store_n(&task->sched_class, (uint32_t)sched_class, __ATOMIC_RELAXED);
+    task_accounting_attach_thread(task);
+
+    CpuMask mask;
+    if (cpu_affinity_get_thread(pthread_self(), &mask) == 0) {
+        task_stats_write_begin(task);
+        cpu_mask_format(&mask, task->stats.cpu_affinity, sizeof(task->stats.cpu_affinity));
+        task_stats_write_end(task);
+    }
+
+    return sched_class;
+}
+
+int task_sched_init_attr(TaskBase* task, pthread_attr_t* attr) {
+    if (!task || !attr) {
+        return -1;
+    }
+
+    return cpu_placement_init_attr(&task->config.placement, attr, NULL);
+}
+
+const char* task_sched_class_name(TaskSchedClass sched_class) {
+    switch (sched_class) {
+        case TASK_SCHED_IDLE:     return "SCHED_IDLE";
+        case TASK_SCHED_NORMAL:   return "SCHED_OTHER";
+        case TASK_SCHED_BOOSTED:  return "SCHED_OTHER(nice<0)";
+        case TASK_SCHED_REALTIME: return "SCHED_FIFO";
+        default:                  return "DEFAULT";
+    }
+}
@@ -0,0 +1,71 @@
+#include "task_manager.h"
+#include "task_epoch.h"
+#include "task_stats.h"
+#include <string.h>
+#include <time.h>
+
+static void fill_record(TaskSnapshotRecord* record, const char* name, TaskBase* task, uint64_t now) {
+    memcpy(record->name, name, sizeof(record->name));
+    record->state = __atomic_load_n(&task->state, __ATOMIC_ACQUIRE);
+    record->restart_count = __atomic_load_n(&task->restart_count, __ATOMIC_RELAXED);
+    task_stats_snapshot(task, &record->stats);
+
+    uint64_t last_heartbeat = record->stats.last_heartbeat;
+    record->heartbeat_age = last_heartbeat && now > last_heartbeat ? now - last_heartbeat : 0;
+}
+
+/**
+ * 记录本页的总数和代数，与首页不同时标记变化
+ */
+static void update_cursor(SnapshotCursor* cursor, uint32_t total, uint64_t generation, uint32_t filled) {
+    if (cursor->position == 0) {
+        cursor->generation = generation;
+        cursor->changed = false;
+    } else if (cursor->generation != generation || cursor->total != total) {
+        cursor->changed = true;
+    }
+
+    cursor->total = total;
+    cursor->position += filled;
+}
+
+int task_manager_snapshot(TaskManager* manager, TaskSnapshotRecord* records, uint32_t capacity,
+                          SnapshotCursor* cursor) {
+    if (!manager || !records || !cursor) {
+        return -1;
+    }
+
+    uint64_t now = (uint64_t)time(NULL);
+    uint32_t filled = 0;
+
+    if (__atomic_load_n(&manager->view, __ATOMIC_ACQUIRE)) {
+        TaskEpochGuard guard = task_epoch_enter(manager->view_epoch);
+        TaskRegistryView* view = __atomic_load_n(&manager->view, __ATOMIC_ACQUIRE);
+
+        for (uint32_t i = cursor->position; i < view->count && filled < capacity; i++) {
+            fill_record(&records[filled++], view->nodes[i].name, view->nodes[i].task, now);
+        }
+        update_cursor(cursor, view->count, view->generation, filled);
+
+        task_epoch_exit(manager->view_epoch, guard);
+        return (int)filled;
+    }
+
+    pthread_mutex_lock(&manager->mutex);
+
+    uint32_t index = 0;
+    TaskNode* node;
+    TAILQ_FOREACH(node, &manager->task_list, entries) {
+        if (index++ < cursor->position) {
+            continue;
+        }
+        if (filled == capacity) {
+            break;
+        }
+        fill_record(&records[filled++], node->name, node->task, now);
+    }
+    update_cursor(cursor, manager->task_count, 0, filled);
+
+    pthread_mutex_unlock(&manager->mutex);
+    return (int)filled;
+}
@@ -0,0 +1,28 @@
+#include "task_stats.h"
+
+void task_stats_write_begin(TaskBase* task) {
+    pthread_mutex_lock(&task->mutex);
+    seqlock_write_begin(&task->stats_seq);
+}
+
+void task_stats_write_end(TaskBase* task) {
+    seqlock_write_end(&task->stats_seq);
+    pthread_mutex_unlock(&task->mutex);
+}
+
+void task_stats_write_begin_locked(TaskBase* task) {
+    seqlock_write_begin(&task->stats_seq);
+}
+
+void task_stats_write_end_locked(TaskBase* task) {
+    seqlock_write_end(&task->stats_seq);
+}
+
+int task_stats_snapshot(const TaskBase* task, TaskStats* stats) {
+    if (!task || !stats) {
+        return -1;
+    }
+
+    seqlock_copy_out(&task->stats_seq, stats, &task->stats, sizeof(TaskStats));
+    return 0;
+}
@@ -0,0 +1,161 @@
+#define _GNU_SOURCE
+#include "task_stop.h"
+#include "core_internal.h"
+#include "task_park.h"
+#include "task_stats.h"
+#include "task_executor.h"
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+
+// 进程级停止耗时直方图(多个线程可能同时停止任务，记录时加锁)
+static LatencyHistogram g_stop_latency;
+static pthread_mutex_t g_stop_latency_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static void interrupt_task(void* context) {
+    task_notify(context);
+}
+
+static void normalize_options(const TaskStopOptions* options, TaskStopOptions* out) {
+    memset(out, 0, sizeof(TaskStopOptions));
+    if (options) {
+        *out = *options;
+    }
+    if (out->timeout_ms == 0) {
+        out->timeout_ms = TASK_STOP_DEFAULT_TIMEOUT_MS;
+    }
+    if (out->grace_ms == 0) {
+        out->grace_ms = TASK_STOP_DEFAULT_GRACE_MS;
+    }
+}
+
+/**
+ * 等待线程退出直到单调时刻deadline_ns
+ * pthread_timedjoin_np使用CLOCK_REALTIME，按剩余时间换算
+ * @return 0已join，ETIMEDOUT超时
+ */
+static int join_until(pthread_t thread, uint64_t deadline_ns) {
+    uint64_t now = get_monotonic_ns();
+    uint64_t remaining = deadline_ns > now ? deadline_ns - now : 0;
+
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    ts.tv_sec += (time_t)(remaining / 1000000000ULL);
+    ts.tv_nsec += (long)(remaining % 1000000000ULL);
+    if (ts.tv_nsec >= 1000000000L) {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000L;
+    }
+
+    return pthread_timedjoin_np(thread, NULL, &ts);
+}
+
+TaskStopOutcome task_stop_join_thread(pthread_t thread, const TaskStopOptions* options, uint64_t start_ns,
+                                      TaskStopInterrupt interrupt, void* context) {
+    TaskStopOptions opts;
+    normalize_options(options, &opts);
+    uint64_t grace_ns = (uint64_t)opts.grace_ms * 1000000ULL;
+
+    if (join_until(thread, start_ns + (uint64_t)opts.timeout_ms * 1000000ULL) == 0) {
+        return TASK_STOP_CLEAN;
+    }
+
+    // 再次唤醒: 期间才进入停靠或条件等待的线程随即看到停止请求
+    if (interrupt) {
+        interrupt(context);
+    }
+    if (join_until(thread, get_monotonic_ns() + grace_ns) == 0) {
+        return TASK_STOP_INTERRUPTED;
+    }
+
+    if (opts.escalation == TASK_STOP_ESCALATE_CANCEL) {
+        pthread_cancel(thread);
+        if (join_until(thread, get_monotonic_ns() + grace_ns) == 0) {
+            return TASK_STOP_CANCELLED;
+        }
+    }
+
+    pthread_detach(thread);
+    return TASK_STOP_DETACHED;
+}
+
+int task_stop_timed(TaskBase* task, const TaskStopOptions* options) {
+    if (!task) {
+        return -1;
+    }
+
+    TaskStopOptions opts;
+    normalize_options(options, &opts);
+    uint64_t start = get_monotonic_ns();
+    TaskStopOutcome outcome;
+
+    if (task->executor) {
+        int ret = task_executor_stop_task_timed(task, opts.timeout_ms);
+        if (ret < 0) {
+            return -1;
+        }
+        // 正在执行的step无法打断，只能放弃等待
+        outcome = ret == 0 ? TASK_STOP_CLEAN : TASK_STOP_DETACHED;
+    } else {
+        pthread_mutex_lock(&task->mutex);
+        TaskState state = task->state;
+        bool has_thread = (state == TASK_STATE_RUNNING || state == TASK_STATE_STOPPING) &&
+                          !task->stop_abandoned;
+        if (has_thread) {
+            task->state = TASK_STATE_STOPPING;
+        }
+        pthread_mutex_unlock(&task->mutex);
+
+        if (!has_thread) {
+            return TASK_STOP_CLEAN;
+        }
+
+        task_request_stop(task);
+        outcome = task_stop_join_thread(task->thread, &opts, start, interrupt_task, task);
+    }
+
+    uint64_t elapsed = get_monotonic_ns() - start;
+
+    task_stats_write_begin(task);
+    task->stats.stop_time_ns = elapsed;
+    task->stats.stop_count++;
+    if (outcome != TASK_STOP_CLEAN) {
+        task->stats.stop_escalations++;
+    }
+    if (outcome == TASK_STOP_CANCELLED || outcome == TASK_STOP_DETACHED) {
+        task->stop_abandoned = true;
+        task->state = TASK_STATE_ERROR;
+    } else if (task->state == TASK_STATE_RUNNING || task->state == TASK_STATE_STOPPING) {
+        task->state = TASK_STATE_STOPPED;
+    }
+    task_stats_write_end(task);
+
+    task_stop_record(elapsed);
+    return outcome;
+}
+
+void task_stop_record(uint64_t elapsed_ns) {
+    pthread_mutex_lock(&g_stop_latency_mutex);
+    latency_histogram_record(&g_stop_latency, elapsed_ns);
+    pthread_mutex_unlock(&g_stop_latency_mutex);
+}
+
+void task_stop_latency_snapshot(LatencyHistogram* histogram) {
+    if (!histogram) {
+        return;
+    }
+
+    pthread_mutex_lock(&g_stop_latency_mutex);
+    *histogram = g_stop_latency;
+    pthread_mutex_unlock(&g_stop_latency_mutex);
+}
+
+const char* task_stop_outcome_name(TaskStopOutcome outcome) {
+    switch (outcome) {
+        case TASK_STOP_CLEAN:       return "clean";
+        case TASK_STOP_INTERRUPTED: return "interrupted";
+        case TASK_STOP_CANCELLED:   return "cancelled";
+        case TASK_STOP_DETACHED:    return "detached";
+        default:                    return "unknown";
+    }
+}
@@ -0,0 +1,103 @@
+#include "task_manager.h"
+
+int task_manager_start_watchdog(TaskManager* manager, HeartbeatMissCallback callback, void* user_data) {
+    if (!manager) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&manager->mutex);
+
+    if (manager->watchdog) {
+        pthread_mutex_unlock(&manager->mutex);
+        return 0;
+    }
+
+    manager->watchdog = heartbeat_watchdog_create(callback, user_data);
+    if (!manager->watchdog) {
+        pthread_mutex_unlock(&manager->mutex);
+        return -1;
+    }
+
+    TaskNode* node;
+    TAILQ_FOREACH(node, &manager->task_list, entries) {
+        heartbeat_watchdog_watch(manager->watchdog, node->task);
+    }
+
+    pthread_mutex_unlock(&manager->mutex);
+    return 0;
+}
+
+void task_manager_stop_watchdog(TaskManager* manager) {
+    if (!manager) {
+        return;
+    }
+
+    pthread_mutex_lock(&manager->mutex);
+    HeartbeatWatchdog* watchdog = manager->watchdog;
+    manager->watchdog = NULL;
+    pthread_mutex_unlock(&manager->mutex);
+
+    // 在锁外等待看门狗线程退出，回调中可能查询管理器
+    heartbeat_watchdog_destroy(watchdog);
+}
+
+/**
+ * 在管理器锁内取得看门狗并增加引用 - 使用后调用heartbeat_watchdog_release
+ * 不在管理器锁内调用看门狗接口，unwatch会等待可能查询管理器的回调
+ */
+static HeartbeatWatchdog* acquire_watchdog(TaskManager* manager) {
+    pthread_mutex_lock(&manager->mutex);
+    HeartbeatWatchdog* watchdog = manager->watchdog;
+    if (watchdog) {
+        heartbeat_watchdog_retain(watchdog);
+    }
+    pthread_mutex_unlock(&manager->mutex);
+    return watchdog;
+}
+
+int task_manager_watch_task(TaskManager* manager, const char* name) {
+    if (!manager || !name) {
+        return -1;
+    }
+
+    TaskBase* task = task_manager_get_task(manager, name);
+    HeartbeatWatchdog* watchdog = task ? acquire_watchdog(manager) : NULL;
+    if (!watchdog) {
+        return -1;
+    }
+
+    int ret = heartbeat_watchdog_watch(watchdog, task);
+    heartbeat_watchdog_release(watchdog);
+    return ret;
+}
+
+int task_manager_unwatch_task(TaskManager* manager, const char* name) {
+    if (!manager || !name) {
+        return -1;
+    }
+
+    TaskBase* task = task_manager_get_task(manager, name);
+    HeartbeatWatchdog* watchdog = task ? acquire_watchdog(manager) : NULL;
+    if (!watchdog) {
+        return -1;
+    }
+
+    int ret = heartbeat_watchdog_unwatch(watchdog, task);
+    heartbeat_watchdog_release(watchdog);
+    return ret;
+}
+
+int task_manager_get_watchdog_stats(TaskManager* manager, HeartbeatWatchdogStats* stats) {
+    if (!manager || !stats) {
+        return -1;
+    }
+
+    HeartbeatWatchdog* watchdog = acquire_watchdog(manager);
+    if (!watchdog) {
+        return -1;
+    }
+
+    heartbeat_watchdog_get_stats(watchdog, stats);
+    heartbeat_watchdog_release(watchdog);
+    return 0;
+}
@@ -0,0 +1,307 @@
+#include "timer_wheel.h"
+#include "core_internal.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/prctl.h>
+
+// 第N层(N>=1)槽位对应的tick位移
+#define LEVEL_SHIFT(n) (TIMER_WHEEL_L0_BITS + ((n) - 1) * TIMER_WHEEL_LN_BITS)
+
+// 时间轮可表示的最大延迟
+#define MAX_DELTA ((1ULL << LEVEL_SHIFT(TIMER_WHEEL_LEVELS)) - 1)
+
+// ============================================================================
+// 分层时间轮
+// ============================================================================
+
+static void slot_insert(TimerWheelSlot* slot, TimerWheelTimer* timer) {
+    timer->slot = slot;
+    timer->prev = NULL;
+    timer->next = slot->head;
+    if (slot->head) {
+        slot->head->prev = timer;
+    }
+    slot->head = timer;
+}
+
+static void slot_remove(TimerWheelTimer* timer) {
+    if (timer->prev) {
+        timer->prev->next = timer->next;
+    } else {
+        timer->slot->head = timer->next;
+    }
+    if (timer->next) {
+        timer->next->prev = timer->prev;
+    }
+
+    timer->prev = NULL;
+    timer->next = NULL;
+    timer->slot = NULL;
+}
+
+/**
+ * 根据到期时间选择槽位
+ */
+static TimerWheelSlot* select_slot(TimerWheel* wheel, uint64_t expires) {
+    uint64_t delta = expires - wheel->current_tick;
+
+    if (delta < TIMER_WHEEL_L0_SIZE) {
+        return &wheel->level0[expires & (TIMER_WHEEL_L0_SIZE - 1)];
+    }
+
+    for (int level = 1; level < TIMER_WHEEL_LEVELS; level++) {
+        if (delta < (1ULL << LEVEL_SHIFT(level + 1)) || level == TIMER_WHEEL_LEVELS - 1) {
+            uint64_t index = (expires >> LEVEL_SHIFT(level)) & (TIMER_WHEEL_LN_SIZE - 1);
+            return &wheel->levels[level - 1][index];
+        }
+    }
+
+    return NULL; // 不可达
+}
+
+/**
+ * 将定时器放入槽位(不修改计数)
+ */
+static void place_timer(TimerWheel* wheel, TimerWheelTimer* timer) {
+    if (timer->expires <= wheel->current_tick) {
+        timer->expires = wheel->current_tick + 1;
+    }
+    if (timer->expires - wheel->current_tick > MAX_DELTA) {
+        timer->expires = wheel->current_tick + MAX_DELTA;
+    }
+
+    slot_insert(select_slot(wheel, timer->expires), timer);
+}
+
+/**
+ * 将高层槽位的定时器按剩余时间重新分配到低层
+ */
+static void cascade(TimerWheel* wheel, TimerWheelSlot* slot) {
+    TimerWheelTimer* timer = slot->head;
+    slot->head = NULL;
+
+    while (timer) {
+        TimerWheelTimer* next = timer->next;
+        if (timer->expires <= wheel->current_tick) {
+            // 恰好在本tick到期，放入即将处理的第0层槽位
+            slot_insert(&wheel->level0[wheel->current_tick & (TIMER_WHEEL_L0_SIZE - 1)], timer);
+        } else {
+            place_timer(wheel, timer);
+        }
+        timer = next;
+    }
+}
+
+void timer_wheel_init(TimerWheel* wheel, uint64_t start_tick) {
+    memset(wheel, 0, sizeof(TimerWheel));
+    wheel->current_tick = start_tick;
+}
+
+void timer_wheel_add(TimerWheel* wheel, TimerWheelTimer* timer, uint64_t expires) {
+    if (timer->armed) {
+        timer_wheel_cancel(wheel, timer);
+    }
+
+    timer->expires = expires;
+    place_timer(wheel, timer);
+    timer->armed = true;
+    wheel->count++;
+}
+
+void timer_wheel_cancel(TimerWheel* wheel, TimerWheelTimer* timer) {
+    if (!timer->armed) {
+        return;
+    }
+
+    slot_remove(timer);
+    timer->armed = false;
+    wheel->count--;
+}
+
+uint32_t timer_wheel_advance(TimerWheel* wheel, uint64_t now_tick) {
+    uint32_t fired = 0;
+
+    while (wheel->current_tick < now_tick) {
+        uint64_t tick = ++wheel->current_tick;
+
+        // 低层转满一圈时，从高层取下对应槽位
+        for (int level = 1; level < TIMER_WHEEL_LEVELS; level++) {
+            if (tick & ((1ULL << LEVEL_SHIFT(level)) - 1)) {
+                break;
+            }
+            uint64_t index = (tick >> LEVEL_SHIFT(level)) & (TIMER_WHEEL_LN_SIZE - 1);
+            cascade(wheel, &wheel->levels[level - 1][index]);
+        }
+
+        // 每次从槽头取一个，回调中取消同槽的其他定时器也是安全的
+        TimerWheelSlot* slot = &wheel->level0[tick & (TIMER_WHEEL_L0_SIZE - 1)];
+        while (slot->head) {
+            TimerWheelTimer* timer = slot->head;
+            slot_remove(timer);
+            timer->armed = false;
+            wheel->count--;
+
+            // 周期定时器按原节拍重新挂入，落后时跳过错过的周期
+            if (timer->interval > 0) {
+                uint64_t next = timer->expires + timer->interval;
+                if (next <= tick) {
+                    next += ((tick - next) / timer->interval + 1) * timer->interval;
+                }
+                timer_wheel_add(wheel, timer, next);
+            }
+
+            fired++;
+            if (timer->callback) {
+                timer->callback(timer, timer->user_data);
+            }
+        }
+    }
+
+    return fired;
+}
+
+uint64_t timer_wheel_next_tick(const TimerWheel* wheel) {
+    if (wheel->count == 0) {
+        return UINT64_MAX;
+    }
+
+    uint64_t tick = wheel->current_tick;
+    for (uint32_t offset = 1; offset <= TIMER_WHEEL_L0_SIZE; offset++) {
+        if (wheel->level0[(tick + offset) & (TIMER_WHEEL_L0_SIZE - 1)].head) {
+            return tick + offset;
+        }
+    }
+
+    // 第0层为空，下一次级联时再检查
+    return ((tick >> TIMER_WHEEL_L0_BITS) + 1) << TIMER_WHEEL_L0_BITS;
+}
+
+// ============================================================================
+// 定时服务
+// ============================================================================
+
+static uint64_t service_now_tick(TimerService* service) {
+    return (get_monotonic_ns() - service->base_ns) / 1000000ULL;
+}
+
+static void* timer_service_thread(void* arg) {
+    TimerService* service = arg;
+
+    // 默认50us的定时器松弛会放大抖动，定时线程使用最小值
+    prctl(PR_SET_TIMERSLACK, 1UL, 0, 0, 0);
+
+    pthread_mutex_lock(&service->mutex);
+    while (service->running) {
+        uint64_t now_tick = service_now_tick(service);
+
+        // 逐tick推进，以便按tick精确统计触发延迟
+        while (service->wheel.current_tick < now_tick) {
+            uint64_t tick = service->wheel.current_tick + 1;
+            uint32_t fired = timer_wheel_advance(&service->wheel, tick);
+            if (fired > 0) {
+                uint64_t due_ns = service->base_ns + tick * 1000000ULL;
+                uint64_t now_ns = get_monotonic_ns();
+                uint64_t lateness = now_ns > due_ns ? now_ns - due_ns : 0;
+                service->stats.fired += fired;
+                service->stats.total_lateness_ns += lateness * fired;
+                if (lateness > service->stats.max_lateness_ns) {
+                    service->stats.max_lateness_ns = lateness;
+                }
+            }
+        }
+
+        uint64_t next_tick = timer_wheel_next_tick(&service->wheel);
+        if (next_tick == UINT64_MAX) {
+            pthread_cond_wait(&service->cond, &service->mutex);
+        } else {
+            uint64_t deadline_ns = service->base_ns + next_tick * 1000000ULL;
+            struct timespec deadline = {
+                .tv_sec = deadline_ns / 1000000000ULL,
+                .tv_nsec = deadline_ns % 1000000000ULL
+            };
+            pthread_cond_timedwait(&service->cond, &service->mutex, &deadline);
+        }
+        service->stats.wakeups++;
+    }
+    pthread_mutex_unlock(&service->mutex);
+
+    return NULL;
+}
+
+TimerService* timer_service_create(void) {
+    TimerService* service = calloc(1, sizeof(TimerService));
+    if (!service) {
+        return NULL;
+    }
+
+    pthread_condattr_t cond_attr;
+    pthread_condattr_init(&cond_attr);
+    pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&service->cond, &cond_attr);
+    pthread_condattr_destroy(&cond_attr);
+    pthread_mutex_init(&service->mutex, NULL);
+
+    service->base_ns = get_monotonic_ns();
+    timer_wheel_init(&service->wheel, 0);
+    service->running = true;
+
+    if (pthread_create(&service->thread, NULL, timer_service_thread, service) != 0) {
+        pthread_mutex_destroy(&service->mutex);
+        pthread_cond_destroy(&service->cond);
+        free(service);
+        return NULL;
+    }
+
+    return service;
+}
+
+void timer_service_destroy(TimerService* service) {
+    if (!service) {
+        return;
+    }
+
+    pthread_mutex_lock(&service->mutex);
+    service->running = false;
+    pthread_cond_signal(&service->cond);
+    pthread_mutex_unlock(&service->mutex);
+
+    pthread_join(service->thread, NULL);
+    pthread_mutex_destroy(&service->mutex);
+    pthread_cond_destroy(&service->cond);
+    free(service);
+}
+
+void timer_service_arm(TimerService* service, TimerWheelTimer* timer,
+                       uint32_t delay_ms, uint32_t interval_ms,
+                       TimerWheelCallback callback, void* user_data) {
+    pthread_mutex_lock(&service->mutex);
+
+    uint64_t previous_next = timer_wheel_next_tick(&service->wheel);
+
+    timer->callback = callback;
+    timer->user_data = user_data;
+    timer->interval = interval_ms;
+    timer_wheel_add(&service->wheel, timer, service_now_tick(service) + delay_ms);
+
+    // 新定时器早于定时线程当前的睡眠期限时唤醒它
+    if (timer->expires < previous_next) {
+        pthread_cond_signal(&service->cond);
+    }
+
+    pthread_mutex_unlock(&service->mutex);
+}
+
+void timer_service_cancel(TimerService* service, TimerWheelTimer* timer) {
+    pthread_mutex_lock(&service->mutex);
+    timer->interval = 0;
+    timer_wheel_cancel(&service->wheel, timer);
+    pthread_mutex_unlock(&service->mutex);
+}
+
+void timer_service_get_stats(TimerService* service, TimerServiceStats* stats) {
+    pthread_mutex_lock(&service->mutex);
+    *stats = service->stats;
+    stats->armed_timers = service->wheel.count;
+    pthread_mutex_unlock(&service->mutex);
+}
@@ -0,0 +1,183 @@
+#include "cpp_coroutine_task.h"
+#include "task_manager.h"
+#include <iostream>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <signal.h>
+
+// 全局变量
+static volatile bool g_running = true;
+static std::atomic<uint64_t> g_ticks{0};
+static std::atomic<uint64_t> g_messages{0};
+static int g_pipe[2] = {-1, -1};
+
+// 信号处理函数
+void signal_handler(int signum) {
+    (void)signum;
+    g_running = false;
+}
+
+/**
+ * 定时协程 - 按各自的间隔计数，挂起期间不占用线程
+ */
+static CoroTask ticker(CoroContext& ctx, uint32_t interval_ms) {
+    for (;;) {
+        CoroWake wake = co_await ctx.sleep(interval_ms);
+        if (wake == CoroWake::Stopped) {
+            co_return;
+        }
+        g_ticks++;
+    }
+}
+
+/**
+ * 管道读取协程 - 等待fd可读，1秒内没有数据时打印一次提示
+ */
+static CoroTask pipe_reader(CoroContext& ctx) {
+    char buffer[64];
+
+    for (;;) {
+        CoroWake wake = co_await ctx.readable(g_pipe[0], 1000);
+        if (wake == CoroWake::Stopped || wake == CoroWake::Error) {
+            co_return;
+        }
+        if (wake == CoroWake::Timeout) {
+            std::cout << "[pipe_reader] 1秒内没有消息\n";
+            continue;
+        }
+
+        ssize_t n = read(g_pipe[0], buffer, sizeof(buffer));
+        if (n > 0) {
+            g_messages += static_cast<uint64_t>(n);
+        }
+    }
+}
+
+/**
+ * 管道写入协程 - 每200ms写入一条消息
+ */
+static CoroTask pipe_writer(CoroContext& ctx) {
+    for (;;) {
+        CoroWake wake = co_await ctx.sleep(200);
+        if (wake == CoroWake::Stopped) {
+            co_return;
+        }
+        if (write(g_pipe[1], "m", 1) != 1) {
+            co_return;
+        }
+    }
+}
+
+// 创建任务配置
+static TaskConfig create_task_config(const char* name) {
+    TaskConfig config;
+    memset(&config, 0, sizeof(config));
+
+    snprintf(config.name, sizeof(config.name), "%s", name);
+    snprintf(config.description, sizeof(config.description), "%s", "C++20 Coroutine Task Demo");
+    config.priority = TASK_PRIORITY_NORMAL;
+    config.heartbeat_interval = 30;
+    config.enable_stats = true;
+    config.exec_mode = TASK_EXEC_POOLED;
+
+    return config;
+}
+
+int main(int argc, char* argv[]) {
+    int ticker_count = argc > 1 ? atoi(argv[1]) : 2000;
+    int seconds = argc > 2 ? atoi(argv[2]) : 5;
+    if (ticker_count <= 0 || seconds <= 0) {
+        std::cerr << "用法: " << argv[0] << " [定时协程数] [运行秒数]\n";
+        return -1;
+    }
+
+    std::cout << "=== C++20 协程任务演示程序 ===\n\n";
+
+    signal(SIGINT, signal_handler);
+    signal(SIGTERM, signal_handler);
+
+    if (pipe(g_pipe) != 0) {
+        std::cerr << "❌ 创建管道失败\n";
+        return -1;
+    }
+
+    TaskManager* manager = task_manager_create();
+    if (!manager) {
+        std::cerr << "❌ 任务管理器创建失败\n";
+        return -1;
+    }
+    TaskArena* arena = task_manager_get_arena(manager);
+
+    // 创建协程任务
+    std::vector<CoroTaskWrapper*> tasks;
+    char name[64];
+
+    for (int i = 0; i < ticker_count; i++) {
+        snprintf(name, sizeof(name), "ticker_%d", i);
+        TaskConfig config = create_task_config(name);
+        uint32_t interval_ms = 50 + static_cast<uint32_t>(i % 10) * 50;
+
+        tasks.push_back(coro_task_create_in(&config, [interval_ms](CoroContext& ctx) {
+            return ticker(ctx, interval_ms);
+        }, arena));
+    }
+
+    TaskConfig reader_config = create_task_config("pipe_reader");
+    tasks.push_back(coro_task_create_in(&reader_config, pipe_reader, arena));
+    TaskConfig writer_config = create_task_config("pipe_writer");
+    tasks.push_back(coro_task_create_in(&writer_config, pipe_writer, arena));
+
+    for (CoroTaskWrapper* task : tasks) {
+        if (!task) {
+            std::cerr << "❌ 创建协程任务失败\n";
+            return -1;
+        }
+        TaskBase* base = coro_task_get_base(task);
+        if (task_manager_register(manager, base, base->config.name) != 0) {
+            std::cerr << "❌ 注册协程任务失败: " << base->config.name << "\n";
+            return -1;
+        }
+    }
+    std::cout << "✅ 已注册 " << tasks.size() << " 个协程任务\n";
+
+    if (task_manager_start_all(manager) != 0) {
+        std::cerr << "⚠️  部分任务启动失败\n";
+    }
+
+    // 主监控循环
+    for (int elapsed = 0; g_running && elapsed < seconds; elapsed++) {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+
+        TaskExecutorStats stats;
+        task_executor_get_stats(task_executor_default(), &stats);
+        std::cout << "⏰ " << elapsed + 1 << "s: 活动任务 " << stats.active_tasks
+                  << ", 工作线程 " << stats.worker_count
+                  << ", step " << stats.steps
+                  << ", 定时触发 " << g_ticks.load()
+                  << ", 管道消息 " << g_messages.load() << "\n";
+    }
+
+    // 停止: 挂起中的co_await返回Stopped，协程自行退出
+    auto stop_begin = std::chrono::steady_clock::now();
+    task_manager_stop_all(manager);
+    auto stop_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - stop_begin).count();
+    std::cout << "✅ " << tasks.size() << " 个协程任务已停止，用时 " << stop_ms << " ms\n";
+
+    // 任务对象持有分配区引用，可以在管理器之后销毁
+    task_manager_destroy(manager);
+    for (CoroTaskWrapper* task : tasks) {
+        coro_task_destroy(task);
+    }
+
+    close(g_pipe[0]);
+    close(g_pipe[1]);
+
+    std::cout << "\n=== 协程任务演示程序正常退出 ===\n";
+    return 0;
+}
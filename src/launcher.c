@@ -52,12 +52,133 @@ static void print_usage(const char* program_name) {
     printf("      \"library_path\": \"./plugins/example.so\",\n");
     printf("      \"config_data\": \"{}\",\n");
     printf("      \"priority\": 1,\n");
-    printf("      \"auto_start\": true\n");
+    printf("      \"auto_start\": true,\n");
+    printf("      \"isolated\": false,\n");
+    printf("      \"placement\": {\"policy\": \"spread\", \"cpu_count\": 1},\n");
+    printf("      \"depends_on\": [\"network_service\"]\n");
     printf("    }\n");
     printf("  ]\n");
     printf("}\n");
 }
 
+/**
+ * 按依赖顺序启动进程，并记录结果和决定启动耗时的关键路径
+ */
+static void start_processes_ordered(ProcessManager* manager, char (*names)[64], uint32_t count) {
+    StartupOptions options = {
+        .max_parallel = 0,
+        .ready_timeout_ms = 10000,
+        .poll_ms = 0
+    };
+    StartupReport report;
+    char msg[512];
+    
+    if (process_manager_start_ordered(manager, names, count, &options, &report) < 0) {
+        logger_log(g_logger, LOG_LEVEL_ERROR, "Failed to start processes");
+        return;
+    }
+    
+    snprintf(msg, sizeof(msg), "Started %u/%u processes in %u waves, %.1f ms (failed %u, timeout %u, blocked %u)",
+             report.ready, report.count, report.wave_count, report.total_us / 1000.0,
+             report.failed, report.timed_out, report.blocked);
+    logger_log(g_logger, report.ready == report.count ? LOG_LEVEL_INFO : LOG_LEVEL_WARN, msg);
+    
+    for (uint32_t i = 0; i < report.count; i++) {
+        const StartupEntry* entry = &report.entries[i];
+        if (entry->outcome != STARTUP_READY) {
+            snprintf(msg, sizeof(msg), "  %s: %s", entry->name, startup_outcome_name(entry->outcome));
+            logger_log(g_logger, LOG_LEVEL_WARN, msg);
+        }
+    }
+    
+    for (uint32_t i = 0; i < report.critical_path_length; i++) {
+        const StartupEntry* entry = &report.entries[report.critical_path[i]];
+        snprintf(msg, sizeof(msg), "  critical path %u: %s (wave %u, %.1f ms -> %.1f ms)", i, entry->name,
+                 entry->wave, entry->start_us / 1000.0, entry->ready_us / 1000.0);
+        logger_log(g_logger, LOG_LEVEL_INFO, msg);
+    }
+    
+    startup_report_free(&report);
+}
+
+/**
+ * 记录插件加载时间线 - 每个插件一行，条形按整批耗时缩放:
+ * 'o' dlopen(隔离加载时为创建宿主)，'r' 解析导出函数，'=' initialize，'-' 延迟加载(只登记)
+ */
+static void log_load_timeline(const ProcessLoadReport* report) {
+    enum { BAR_WIDTH = 40 };
+    char msg[512];
+    
+    snprintf(msg, sizeof(msg), "Loaded %u/%u plugins (%u deferred) in %.1f ms (%.1f ms if loaded one at a time)",
+             report->loaded, report->count, report->deferred, report->total_us / 1000.0,
+             report->serial_us / 1000.0);
+    logger_log(g_logger, report->failed ? LOG_LEVEL_WARN : LOG_LEVEL_INFO, msg);
+    
+    uint64_t scale = report->total_us > 0 ? report->total_us : 1;
+    for (uint32_t i = 0; i < report->count; i++) {
+        const ProcessLoadEntry* entry = &report->entries[i];
+        char bar[BAR_WIDTH + 1];
+        memset(bar, ' ', BAR_WIDTH);
+        bar[BAR_WIDTH] = '\0';
+        
+        const uint64_t marks[] = {entry->start_us, entry->open_us, entry->resolve_us, entry->ready_us};
+        const char fills[] = {'o', 'r', '='};
+        for (int phase = 0; phase < 3; phase++) {
+            uint64_t from = marks[phase] * BAR_WIDTH / scale;
+            uint64_t to = marks[phase + 1] * BAR_WIDTH / scale;
+            for (uint64_t c = from; c < to && c < BAR_WIDTH; c++) {
+                bar[c] = fills[phase];
+            }
+        }
+        // 很短的加载也至少占一格，延迟加载的只标记登记时刻
+        uint64_t first = entry->start_us * BAR_WIDTH / scale;
+        if (first < BAR_WIDTH && bar[first] == ' ') {
+            bar[first] = entry->deferred ? '-' : '=';
+        }
+        
+        snprintf(msg, sizeof(msg), "  %-24s p%-3d |%s| %8.1f -> %8.1f ms%s%s", entry->name, entry->priority, bar,
+                 entry->start_us / 1000.0, entry->ready_us / 1000.0,
+                 entry->result != 0 ? "  FAILED: " : entry->deferred ? "  lazy" : "",
+                 entry->result == 0 ? "" : entry->error);
+        logger_log(g_logger, entry->result == 0 ? LOG_LEVEL_INFO : LOG_LEVEL_ERROR, msg);
+    }
+}
+
+/**
+ * 查询加载报告中的插件是否加载成功
+ */
+static bool load_succeeded(const ProcessLoadReport* report, const char* name) {
+    for (uint32_t i = 0; i < report->count; i++) {
+        if (strcmp(report->entries[i].name, name) == 0 && report->entries[i].result == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * 打印插件的接口版本和声明的能力
+ */
+static void print_interface_info(ProcessManager* manager, const char* name) {
+    ProcessSnapshotRecord records[16];
+    SnapshotCursor cursor = SNAPSHOT_CURSOR_INIT;
+    int count;
+    while ((count = process_manager_snapshot(manager, records, 16, &cursor)) > 0) {
+        for (int i = 0; i < count; i++) {
+            const ProcessSnapshotRecord* record = &records[i];
+            if (strcmp(record->name, name) != 0 || record->interface_version == 0) {
+                continue;
+            }
+            printf("Process %s interface: v%u%s%s%s%s\n", name, PROCESS_INTERFACE_MAJOR(record->interface_version),
+                   record->capabilities ? ", capabilities:" : "",
+                   record->capabilities & PROCESS_CAP_BATCH_STATS ? " batch-stats" : "",
+                   record->capabilities & PROCESS_CAP_PAUSE ? " pause" : "",
+                   record->capabilities & PROCESS_CAP_RELOAD ? " reload" : "");
+            return;
+        }
+    }
+}
+
 /**
  * 交互式命令处理
  */
@@ -70,6 +191,9 @@ static void handle_interactive_commands(ProcessManager* manager) {
     printf("  start <process_name>   - Start a process\n");
     printf("  stop <process_name>    - Stop a process\n");
     printf("  restart <process_name> - Restart a process\n");
+    printf("  reload <process_name> [library_path] - Hot reload a plugin\n");
+    printf("  pause <process_name>   - Pause a process (v2 plugins with pause capability)\n");
+    printf("  resume <process_name>  - Resume a paused process\n");
     printf("  status <process_name>  - Get process status\n");
     printf("  list                   - List all processes\n");
     printf("  quit                   - Exit launcher\n");
@@ -105,13 +229,105 @@ static void handle_interactive_commands(ProcessManager* manager) {
             } else {
                 printf("Failed to restart process %s (error: %d)\n", process_name, ret);
             }
+        } else if (strncmp(command, "reload ", 7) == 0) {
+            char library_path[256] = "";
+            sscanf(command + 7, "%63s %255s", process_name, library_path);
+            ProcessReloadOptions options = {
+                .library_path = library_path[0] ? library_path : NULL,
+            };
+            ProcessReloadReport report;
+            int ret = process_manager_reload_plugin(manager, process_name, &options, &report);
+            if (ret == 0) {
+                printf("Process %s reloaded %s -> %s (prepare %.1f ms, service gap %.1f ms, state %u bytes)\n",
+                       process_name, report.old_version, report.new_version, report.prepare_us / 1000.0,
+                       report.gap_us / 1000.0, report.state_bytes);
+            } else {
+                printf("Failed to reload process %s%s: %s\n", process_name,
+                       report.rolled_back ? " (rolled back)" : "", report.error);
+            }
+        } else if (strncmp(command, "pause ", 6) == 0) {
+            sscanf(command + 6, "%63s", process_name);
+            if (process_manager_pause_process(manager, process_name) == 0) {
+                printf("Process %s paused\n", process_name);
+            } else {
+                printf("Failed to pause process %s (not running or no pause capability)\n", process_name);
+            }
+        } else if (strncmp(command, "resume ", 7) == 0) {
+            sscanf(command + 7, "%63s", process_name);
+            if (process_manager_resume_process(manager, process_name) == 0) {
+                printf("Process %s resumed\n", process_name);
+            } else {
+                printf("Failed to resume process %s\n", process_name);
+            }
         } else if (strncmp(command, "status ", 7) == 0) {
             sscanf(command + 7, "%s", process_name);
             ProcessState state = process_manager_get_process_state(manager, process_name);
-            const char* state_names[] = {"UNKNOWN", "INITIALIZING", "RUNNING", "STOPPING", "STOPPED", "ERROR"};
+            const char* state_names[] = {"UNKNOWN", "INITIALIZING", "RUNNING", "STOPPING", "STOPPED", "ERROR", "PAUSED"};
             printf("Process %s state: %s\n", process_name, state_names[state]);
+            char placement[128];
+            if (process_manager_get_placement(manager, process_name, placement, sizeof(placement)) > 0) {
+                printf("Process %s placement: %s\n", process_name, placement);
+            }
+            print_interface_info(manager, process_name);
+            PluginHostInfo host;
+            if (process_manager_get_host_info(manager, process_name, &host) == 0) {
+                printf("Process %s host: pid %d%s, spawned %u, crashes %u, rss %.1f MB, calls %llu\n",
+                       process_name, (int)host.pid, host.alive ? "" : " (exited)", host.spawn_count,
+                       host.crash_count, host.rss_bytes / (1024.0 * 1024.0), (unsigned long long)host.calls);
+            }
+            ProcessStatsPage page;
+            if (process_manager_read_stats_page(manager, process_name, &page) == 0) {
+                if (page.latency.count > 0) {
+                    printf("Process %s latency: p50 %.1fus, p99 %.1fus, p999 %.1fus, max %.1fus (%llu samples)\n",
+                           process_name,
+                           page.latency.p50_ns / 1e3,
+                           page.latency.p99_ns / 1e3,
+                           page.latency.p999_ns / 1e3,
+                           page.latency.max_ns / 1e3,
+                           (unsigned long long)page.latency.count);
+                }
+                printf("Process %s stats page: /dev/shm%s, %llu updates\n", process_name, page.shm_name,
+                       (unsigned long long)page.update_count);
+                for (uint32_t i = 0; i < page.counter_count && i < PROCESS_STATS_PAGE_MAX_COUNTERS; i++) {
+                    printf("  %s = %llu\n", page.counters[i].name, (unsigned long long)page.counters[i].value);
+                }
+            }
         } else if (strcmp(command, "list") == 0) {
-            printf("Process list functionality not implemented yet\n");
+            const char* state_names[] = {"UNKNOWN", "INITIALIZING", "RUNNING", "STOPPING", "STOPPED", "ERROR", "PAUSED"};
+            ProcessSnapshotRecord records[16];
+            SnapshotCursor cursor = SNAPSHOT_CURSOR_INIT;
+            int count;
+            printf("%-24s %-12s %-8s %8s %10s %12s %-10s %s\n",
+                   "NAME", "STATE", "THREAD", "RESTARTS", "UPTIME(s)", "P99(us)", "PLACEMENT", "RESTART");
+            while ((count = process_manager_snapshot(manager, records, 16, &cursor)) > 0) {
+                for (int i = 0; i < count; i++) {
+                    const ProcessSnapshotRecord* record = &records[i];
+                    char restart[64] = "-";
+                    if (record->restart.pending) {
+                        snprintf(restart, sizeof(restart), "%s %ums",
+                                 record->restart.crash_loop ? "crash-loop" : "backoff",
+                                 record->restart.backoff_ms);
+                    }
+                    // 隔离加载的进程显示宿主pid
+                    char thread[16];
+                    if (record->isolated && record->host_pid > 0) {
+                        snprintf(thread, sizeof(thread), "pid %d", (int)record->host_pid);
+                    } else {
+                        snprintf(thread, sizeof(thread), "%s", record->is_running ? "running" : "-");
+                    }
+                    printf("%-24s %-12s %-8s %8u %10llu %12.1f %-10s %s\n",
+                           record->name,
+                           record->dormant ? "DORMANT" : state_names[record->state],
+                           thread,
+                           record->restart_count,
+                           (unsigned long long)record->stats.run_time,
+                           record->latency.p99_ns / 1e3,
+                           cpu_placement_policy_name(record->placement),
+                           restart);
+                }
+            }
+            printf("Total: %u process(es)%s\n", cursor.total,
+                   cursor.changed ? " (process list changed while listing)" : "");
         } else if (strlen(command) > 0) {
             printf("Unknown command: %s\n", command);
         }
@@ -156,31 +372,61 @@ int main(int argc, char* argv[]) {
         return 1;
     }
     
-    // 加载所有插件
-    int loaded_count = 0;
-    for (int i = 0; i < config->process_count; i++) {
+    // 并发加载所有插件，优先级高的先派发
+    int process_count = config->process_count > 0 ? config->process_count : 0;
+    ProcessLoadRequest* requests = calloc(process_count > 0 ? process_count : 1, sizeof(ProcessLoadRequest));
+    ProcessLoadReport load_report;
+    memset(&load_report, 0, sizeof(load_report));
+    if (requests) {
+        for (int i = 0; i < process_count; i++) {
+            ProcessConfig* proc_config = &config->processes[i];
+            requests[i].name = proc_config->name;
+            requests[i].library_path = proc_config->library_path;
+            requests[i].config_data = proc_config->config_data;
+            requests[i].priority = proc_config->priority;
+            requests[i].isolated = proc_config->isolated;
+            // 自动启动的进程马上要用，延迟加载没有意义
+            requests[i].lazy = proc_config->lazy && !proc_config->auto_start;
+            requests[i].idle_unload_ms = proc_config->idle_unload_seconds > 0
+                                             ? (uint32_t)proc_config->idle_unload_seconds * 1000
+                                             : 0;
+        }
+        process_manager_load_plugins(g_manager, requests, (uint32_t)process_count, NULL, &load_report);
+        free(requests);
+    }
+    log_load_timeline(&load_report);
+    
+    uint32_t auto_start_count = 0;
+    char (*auto_start_names)[64] = calloc(process_count > 0 ? process_count : 1, 64);
+    for (int i = 0; i < process_count; i++) {
         ProcessConfig* proc_config = &config->processes[i];
-        int ret = process_manager_load_plugin(g_manager, 
-                                             proc_config->name,
-                                             proc_config->library_path,
-                                             proc_config->config_data);
-        if (ret == 0) {
-            loaded_count++;
-            
-            // 如果配置为自动启动，则启动进程
-            if (proc_config->auto_start) {
-                process_manager_start_process(g_manager, proc_config->name);
-            }
-        } else {
-            char msg[512];
-            snprintf(msg, sizeof(msg), "Failed to load plugin %s: %d", proc_config->name, ret);
-            logger_log(g_logger, LOG_LEVEL_ERROR, msg);
+        if (!load_succeeded(&load_report, proc_config->name)) {
+            continue;
+        }
+        
+        // 放置需在创建线程前设置
+        if (proc_config->placement.policy != CPU_PLACEMENT_NONE) {
+            process_manager_set_placement(g_manager, proc_config->name, &proc_config->placement);
+        }
+        
+        if (proc_config->dependency_count > 0) {
+            process_manager_set_dependencies(g_manager, proc_config->name,
+                                             (const char (*)[64])proc_config->depends_on,
+                                             (uint32_t)proc_config->dependency_count);
+        }
+        
+        // 如果配置为自动启动，加载完成后按依赖顺序启动
+        if (proc_config->auto_start && auto_start_names) {
+            memcpy(auto_start_names[auto_start_count++], proc_config->name, sizeof(proc_config->name));
         }
     }
+    process_load_report_free(&load_report);
     
     char msg[256];
-    snprintf(msg, sizeof(msg), "Loaded %d/%d plugins", loaded_count, config->process_count);
-    logger_log(g_logger, LOG_LEVEL_INFO, msg);
+    if (auto_start_count > 0) {
+        start_processes_ordered(g_manager, auto_start_names, auto_start_count);
+    }
+    free(auto_start_names);
     
     // 启动监控线程
     if (config->enable_monitor) {
@@ -198,8 +444,40 @@ int main(int argc, char* argv[]) {
     logger_log(g_logger, LOG_LEVEL_INFO, "Launcher shutting down...");
     
     if (g_manager) {
-        process_manager_stop_all(g_manager);
-        process_manager_destroy(g_manager);
+        // 并发停止，单个进程5秒后升级，整批最多等待30秒
+        LifecycleOptions stop_options = {
+            .task_timeout_ms = 5000,
+            .global_timeout_ms = 30000,
+            .max_parallel = 0
+        };
+        LifecycleReport report;
+        if (process_manager_stop_all_parallel(g_manager, &stop_options, &report) < 0) {
+            // 未能并发停止(内存不足)，退回逐个停止
+            logger_log(g_logger, LOG_LEVEL_ERROR, "Parallel stop failed, stopping processes one by one");
+            process_manager_stop_all(g_manager);
+            process_manager_destroy(g_manager);
+        } else {
+            snprintf(msg, sizeof(msg),
+                     "Stopped %u/%u processes in %.1f ms (escalated %u, abandoned %u, skipped %u)",
+                     report.succeeded, report.count, report.total_us / 1000.0,
+                     report.escalated, report.abandoned, report.skipped);
+            logger_log(g_logger, report.abandoned || report.skipped ? LOG_LEVEL_WARN : LOG_LEVEL_INFO, msg);
+            
+            // 报告按耗时排序，记录最慢的几个
+            for (uint32_t i = 0; i < report.count && i < 5; i++) {
+                snprintf(msg, sizeof(msg), "  %s: %.1f ms%s", report.entries[i].name,
+                         report.entries[i].elapsed_us / 1000.0,
+                         !report.entries[i].started ? " (not stopped)" :
+                         report.entries[i].completed ? "" : " (still stopping)");
+                logger_log(g_logger, LOG_LEVEL_INFO, msg);
+            }
+            
+            // 只有仍在后台停止的进程会继续访问管理器，未开始的不会再执行
+            if (report.abandoned == 0) {
+                process_manager_destroy(g_manager);
+            }
+            lifecycle_report_free(&report);
+        }
     }
     
     if (g_logger) {
@@ -0,0 +1,305 @@
+#define _GNU_SOURCE
+#include "plugin_host.h"
+#include "process_stats_page.h"
+#include <dlfcn.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+
+/*
+ * 插件宿主程序 - 由启动器通过posix_spawn创建，在独立进程中加载一个插件，
+ * 从共享内存通道(PLUGIN_HOST_CHANNEL_FD)读取命令并调用插件接口
+ * v2插件的start不阻塞，宿主把它的STOPPED/ERROR通知当作start返回转告启动器，代理接口对两种插件一致
+ * 用法: plugin_host <library_path> <name>
+ */
+
+// 等待命令时检查启动器是否仍在的间隔
+#define HOST_PARENT_CHECK_MS 1000
+
+static PluginHostChannel* g_channel = NULL;
+static ProcessInterface* g_interface = NULL;
+static ProcessInterfaceV2* g_interface_v2 = NULL;  // v2插件时与g_interface指向同一结构
+static pthread_mutex_t g_log_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_t g_start_thread;
+static bool g_start_joinable = false;
+static bool g_start_running = false;
+
+/**
+ * 插件日志回调 - 写入通道的日志缓冲，由启动器转发给它的日志回调
+ */
+static void host_log_callback(LogLevel level, const char* message) {
+    if (!message) {
+        return;
+    }
+
+    pthread_mutex_lock(&g_log_mutex);
+    uint32_t head = g_channel->log_head;
+    uint32_t tail = __atomic_load_n(&g_channel->log_tail, __ATOMIC_ACQUIRE);
+    if (head - tail >= PLUGIN_HOST_LOG_SLOTS) {
+        __atomic_add_fetch(&g_channel->log_dropped, 1, __ATOMIC_RELAXED);
+    } else {
+        uint32_t index = head % PLUGIN_HOST_LOG_SLOTS;
+        g_channel->logs[index].level = (int32_t)level;
+        strncpy(g_channel->logs[index].message, message, sizeof(g_channel->logs[index].message) - 1);
+        g_channel->logs[index].message[sizeof(g_channel->logs[index].message) - 1] = '\0';
+        __atomic_store_n(&g_channel->log_head, head + 1, __ATOMIC_RELEASE);
+        sem_post(&g_channel->events);
+    }
+    pthread_mutex_unlock(&g_log_mutex);
+}
+
+/**
+ * 通知启动器start已返回 - v1插件在start线程结束时，v2插件在通知运行结束时
+ */
+static void finish_start(int result) {
+    if (!__atomic_exchange_n(&g_start_running, false, __ATOMIC_ACQ_REL)) {
+        return;
+    }
+    g_channel->start_result = result;
+    __atomic_add_fetch(&g_channel->start_count, 1, __ATOMIC_RELEASE);
+    sem_post(&g_channel->events);
+}
+
+/**
+ * 插件主循环线程 - start返回后通知启动器
+ */
+static void* start_thread(void* arg) {
+    (void)arg;
+
+    finish_start(g_interface->start ? g_interface->start() : -1);
+    return NULL;
+}
+
+/**
+ * v2插件的状态通知
+ */
+static void host_notify(void* context, ProcessState state, int result) {
+    (void)context;
+    if (state == PROCESS_STATE_STOPPED || state == PROCESS_STATE_ERROR) {
+        finish_start(state == PROCESS_STATE_ERROR && result == 0 ? -1 : result);
+    }
+}
+
+static const ProcessNotifier g_notifier = {
+    .context = NULL,
+    .notify = host_notify,
+};
+
+/**
+ * 启动v2插件 - 不占用线程，运行结束由host_notify转告
+ */
+static int32_t start_async(void) {
+    __atomic_store_n(&g_start_running, true, __ATOMIC_RELEASE);
+    int ret = g_interface->start ? g_interface->start() : -1;
+    if (ret != 0) {
+        // 失败的start不计入start_count，代理直接返回错误
+        __atomic_store_n(&g_start_running, false, __ATOMIC_RELEASE);
+    }
+    return ret;
+}
+
+static int32_t handle_command(PluginHostCommand command, int32_t argument) {
+    switch (command) {
+        case PLUGIN_HOST_CMD_INITIALIZE:
+            g_channel->config_data[sizeof(g_channel->config_data) - 1] = '\0';
+            return g_interface->initialize ? g_interface->initialize(g_channel->config_data, host_log_callback) : 0;
+
+        case PLUGIN_HOST_CMD_START:
+            if (__atomic_load_n(&g_start_running, __ATOMIC_ACQUIRE)) {
+                return -1;
+            }
+            if (g_interface_v2) {
+                return start_async();
+            }
+            if (g_start_joinable) {
+                pthread_join(g_start_thread, NULL);
+                g_start_joinable = false;
+            }
+            __atomic_store_n(&g_start_running, true, __ATOMIC_RELEASE);
+            if (pthread_create(&g_start_thread, NULL, start_thread, NULL) != 0) {
+                __atomic_store_n(&g_start_running, false, __ATOMIC_RELEASE);
+                return -1;
+            }
+            g_start_joinable = true;
+            return 0;
+
+        case PLUGIN_HOST_CMD_STOP:
+            return g_interface->stop ? g_interface->stop() : 0;
+
+        case PLUGIN_HOST_CMD_CLEANUP:
+            if (g_interface->cleanup) {
+                g_interface->cleanup();
+            }
+            return 0;
+
+        case PLUGIN_HOST_CMD_GET_STATE:
+            return g_interface->get_state ? (int32_t)g_interface->get_state() : (int32_t)PROCESS_STATE_UNKNOWN;
+
+        case PLUGIN_HOST_CMD_GET_STATS: {
+            const ProcessStats* stats = g_interface->get_stats ? g_interface->get_stats() : NULL;
+            if (!stats) {
+                return -1;
+            }
+            g_channel->stats = *stats;
+            return 0;
+        }
+
+        case PLUGIN_HOST_CMD_HANDLE_SIGNAL:
+            if (g_interface->handle_signal) {
+                g_interface->handle_signal(argument);
+            }
+            return 0;
+
+        case PLUGIN_HOST_CMD_HEALTH_CHECK:
+            return g_interface->health_check ? g_interface->health_check() : 1;
+
+        default:
+            return -1;
+    }
+}
+
+/**
+ * 加载插件并检查接口版本
+ * @return 0成功，非0失败
+ */
+static int load_plugin(const char* library_path) {
+    void* handle = dlopen(library_path, RTLD_NOW | RTLD_LOCAL);
+    if (!handle) {
+        fprintf(stderr, "plugin_host: %s\n", dlerror());
+        return -1;
+    }
+
+    ProcessInterface* (*get_interface)(void) = (ProcessInterface* (*)(void))dlsym(handle, "get_process_interface");
+    uint32_t (*get_version)(void) = (uint32_t (*)(void))dlsym(handle, "get_interface_version");
+    if (!get_interface || !get_version) {
+        fprintf(stderr, "plugin_host: %s 缺少插件导出函数\n", library_path);
+        return -1;
+    }
+
+    // 主版本号决定接口布局
+    uint32_t version = get_version();
+    uint32_t major = PROCESS_INTERFACE_MAJOR(version);
+    g_channel->interface_version = version;
+    if (major != PROCESS_INTERFACE_MAJOR(PROCESS_INTERFACE_VERSION) &&
+        major != PROCESS_INTERFACE_MAJOR(PROCESS_INTERFACE_VERSION_2)) {
+        fprintf(stderr, "plugin_host: %s 接口版本 0x%08x 不兼容\n", library_path, version);
+        return -1;
+    }
+
+    g_interface = get_interface();
+    if (!g_interface) {
+        return -1;
+    }
+
+    // 通知须在initialize之前绑定
+    ProcessStatsPageSetter set_page = (ProcessStatsPageSetter)dlsym(handle, PROCESS_STATS_PAGE_SETTER);
+    if (major == PROCESS_INTERFACE_MAJOR(PROCESS_INTERFACE_VERSION_2)) {
+        g_interface_v2 = (ProcessInterfaceV2*)g_interface;
+        if (g_interface_v2->size < sizeof(ProcessInterfaceV2) || !g_interface_v2->bind_notifier) {
+            fprintf(stderr, "plugin_host: %s ProcessInterfaceV2不完整\n", library_path);
+            return -1;
+        }
+        g_interface_v2->bind_notifier(&g_notifier);
+        if ((g_interface_v2->capabilities & PROCESS_CAP_BATCH_STATS) && g_interface_v2->set_stats_page) {
+            set_page = g_interface_v2->set_stats_page;
+        }
+        // 暂停和状态交接没有代理命令
+        g_channel->capabilities = g_interface_v2->capabilities & PROCESS_CAP_BATCH_STATS;
+    }
+
+    const ProcessInfo* info = g_interface->get_process_info ? g_interface->get_process_info() : NULL;
+    if (info) {
+        g_channel->info = *info;
+    }
+
+    // 统计页须在initialize之前交给插件；映射失败时插件照常运行，启动器回退到GET_STATS
+    g_channel->stats_page_name[sizeof(g_channel->stats_page_name) - 1] = '\0';
+    if (set_page && g_channel->stats_page_name[0]) {
+        ProcessStatsPage* page = process_stats_page_open(g_channel->stats_page_name, true);
+        if (page) {
+            set_page(page);
+            g_channel->stats_page_attached = 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * 等待下一个命令
+ * @return 0有命令，-1启动器已退出
+ */
+static int wait_request(pid_t parent) {
+    for (;;) {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        ts.tv_sec += HOST_PARENT_CHECK_MS / 1000;
+        if (sem_clockwait(&g_channel->request, CLOCK_MONOTONIC, &ts) == 0) {
+            return 0;
+        }
+        if (errno != ETIMEDOUT && errno != EINTR) {
+            return -1;
+        }
+        if (getppid() != parent) {
+            return -1;
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        fprintf(stderr, "Usage: %s <library_path> <name>\n", argv[0]);
+        fprintf(stderr, "  由启动器创建，不应直接运行\n");
+        return 2;
+    }
+
+    // PR_SET_PDEATHSIG跟随创建宿主的线程而不是启动器进程，宿主可能由代理的start线程重建，
+    // 改为等待命令时检查父进程是否变化
+    pid_t parent = getppid();
+    prctl(PR_SET_NAME, argv[2]);
+
+    g_channel = mmap(NULL, sizeof(PluginHostChannel), PROT_READ | PROT_WRITE, MAP_SHARED,
+                     PLUGIN_HOST_CHANNEL_FD, 0);
+    if (g_channel == MAP_FAILED || g_channel->magic != PLUGIN_HOST_CHANNEL_MAGIC) {
+        fprintf(stderr, "plugin_host: 无效的通道\n");
+        return 2;
+    }
+    close(PLUGIN_HOST_CHANNEL_FD);
+
+    // 握手: 加载结果随序号0的应答返回
+    int load_result = load_plugin(argv[1]);
+    g_channel->load_result = load_result;
+    __atomic_store_n(&g_channel->reply_sequence, 0, __ATOMIC_RELEASE);
+    sem_post(&g_channel->reply);
+    if (load_result != 0) {
+        return 1;
+    }
+
+    for (;;) {
+        if (wait_request(parent) != 0) {
+            // 启动器已退出，插件没有人管理
+            _exit(1);
+        }
+
+        uint32_t sequence = __atomic_load_n(&g_channel->sequence, __ATOMIC_ACQUIRE);
+        PluginHostCommand command = (PluginHostCommand)g_channel->command;
+        int32_t result = command == PLUGIN_HOST_CMD_EXIT ? 0 : handle_command(command, g_channel->argument);
+
+        g_channel->result = result;
+        __atomic_store_n(&g_channel->reply_sequence, sequence, __ATOMIC_RELEASE);
+        sem_post(&g_channel->reply);
+
+        if (command == PLUGIN_HOST_CMD_EXIT) {
+            break;
+        }
+    }
+
+    // 插件线程可能仍在运行，不执行atexit和析构
+    fflush(NULL);
+    _exit(0);
+}
@@ -0,0 +1,158 @@
+#include "process_interface.h"
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+
+/*
+ * 基准用v2进程插件 - 不创建线程: start/stop/pause/resume在调用中直接切换状态并通知管理器，
+ * 测得的是v2通知路径本身的开销；热重载时交接已启动的次数
+ */
+
+static ProcessState g_state = PROCESS_STATE_STOPPED;
+static const ProcessNotifier* g_notifier = NULL;
+static uint64_t g_starts = 0;
+static pthread_mutex_t g_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static ProcessInfo g_process_info = {
+    .name = "bench_async_process",
+    .version = "2.0.0",
+    .description = "No-op v2 process plugin for lifecycle notification benchmarks",
+    .priority = 1,
+    .restart_count = 0,
+    .auto_restart = false
+};
+
+static ProcessStats g_stats = {0};
+
+/**
+ * 在g_mutex下切换状态，解锁后通知 - 管理器可能在通知里回调get_state
+ */
+static int transition(ProcessState from, ProcessState to) {
+    pthread_mutex_lock(&g_mutex);
+    if (g_state != from && !(from == PROCESS_STATE_RUNNING && g_state == PROCESS_STATE_PAUSED &&
+                             to == PROCESS_STATE_STOPPED)) {
+        pthread_mutex_unlock(&g_mutex);
+        return -1;
+    }
+    g_state = to;
+    g_starts += to == PROCESS_STATE_RUNNING && from == PROCESS_STATE_STOPPED;
+    const ProcessNotifier* notifier = g_notifier;
+    pthread_mutex_unlock(&g_mutex);
+
+    if (notifier) {
+        notifier->notify(notifier->context, to, 0);
+    }
+    return 0;
+}
+
+static const ProcessInfo* get_process_info(void) {
+    return &g_process_info;
+}
+
+static int initialize(const char* config_data, LogCallback log_callback) {
+    (void)config_data;
+    (void)log_callback;
+
+    pthread_mutex_lock(&g_mutex);
+    memset(&g_stats, 0, sizeof(g_stats));
+    g_stats.start_time = time(NULL);
+    g_state = PROCESS_STATE_STOPPED;
+    pthread_mutex_unlock(&g_mutex);
+    return 0;
+}
+
+static int start(void) {
+    return transition(PROCESS_STATE_STOPPED, PROCESS_STATE_RUNNING);
+}
+
+static int stop(void) {
+    return transition(PROCESS_STATE_RUNNING, PROCESS_STATE_STOPPED);
+}
+
+static void cleanup(void) {
+    pthread_mutex_lock(&g_mutex);
+    g_notifier = NULL;
+    pthread_mutex_unlock(&g_mutex);
+}
+
+static ProcessState get_state(void) {
+    pthread_mutex_lock(&g_mutex);
+    ProcessState state = g_state;
+    pthread_mutex_unlock(&g_mutex);
+    return state;
+}
+
+static const ProcessStats* get_stats(void) {
+    return &g_stats;
+}
+
+static void handle_signal(int signal) {
+    (void)signal;
+}
+
+static bool health_check(void) {
+    return true;
+}
+
+static void bind_notifier(const ProcessNotifier* notifier) {
+    pthread_mutex_lock(&g_mutex);
+    g_notifier = notifier;
+    pthread_mutex_unlock(&g_mutex);
+}
+
+static int pause_process(void) {
+    return transition(PROCESS_STATE_RUNNING, PROCESS_STATE_PAUSED);
+}
+
+static int resume_process(void) {
+    return transition(PROCESS_STATE_PAUSED, PROCESS_STATE_RUNNING);
+}
+
+static size_t export_state(void* buffer, size_t size) {
+    if (size < sizeof(g_starts)) {
+        return 0;
+    }
+    pthread_mutex_lock(&g_mutex);
+    memcpy(buffer, &g_starts, sizeof(g_starts));
+    pthread_mutex_unlock(&g_mutex);
+    return sizeof(g_starts);
+}
+
+static int import_state(const void* buffer, size_t size) {
+    if (size != sizeof(g_starts)) {
+        return -1;
+    }
+    pthread_mutex_lock(&g_mutex);
+    memcpy(&g_starts, buffer, sizeof(g_starts));
+    pthread_mutex_unlock(&g_mutex);
+    return 0;
+}
+
+static ProcessInterfaceV2 g_interface = {
+    .base = {
+        .get_process_info = get_process_info,
+        .initialize = initialize,
+        .start = start,
+        .stop = stop,
+        .cleanup = cleanup,
+        .get_state = get_state,
+        .get_stats = get_stats,
+        .handle_signal = handle_signal,
+        .health_check = health_check
+    },
+    .size = sizeof(ProcessInterfaceV2),
+    .capabilities = PROCESS_CAP_PAUSE | PROCESS_CAP_RELOAD,
+    .bind_notifier = bind_notifier,
+    .pause = pause_process,
+    .resume = resume_process,
+    .export_state = export_state,
+    .import_state = import_state
+};
+
+ProcessInterface* get_process_interface(void) {
+    return &g_interface.base;
+}
+
+uint32_t get_interface_version(void) {
+    return PROCESS_INTERFACE_VERSION_2;
+}
@@ -0,0 +1,171 @@
+#include "process_interface.h"
+#include "process_stats_page.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/*
+ * 基准用进程插件 - 各接口不做实际工作，start阻塞到stop为止，
+ * 测得的是调用路径本身(进程内直接调用 vs 经插件宿主代理)的开销
+ * 配置"init_ms=N"时initialize睡眠N毫秒，模拟较慢的初始化
+ * 配置"update_us=N"时start每N微秒更新一次统计信息(0为不停更新)，直到stop；
+ * 每次更新把run_time/cpu_usage/memory_usage都写成同一个序号，读者据此发现撕裂的副本
+ */
+
+static ProcessState g_state = PROCESS_STATE_STOPPED;
+static bool g_should_stop = false;
+static pthread_mutex_t g_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t g_cond = PTHREAD_COND_INITIALIZER;
+
+static ProcessInfo g_process_info = {
+    .name = "bench_process",
+    .version = "1.0.0",
+    .description = "No-op process plugin for call latency benchmarks",
+    .priority = 1,
+    .restart_count = 0,
+    .auto_restart = false
+};
+
+static ProcessStats g_stats = {0};
+static ProcessStatsPage* g_stats_page = NULL;
+static int g_updates_counter = -1;
+static long g_update_us = -1;  // <0时start不更新统计
+
+static const ProcessInfo* get_process_info(void) {
+    return &g_process_info;
+}
+
+static int initialize(const char* config_data, LogCallback log_callback) {
+    (void)log_callback;
+
+    const char* init_ms = config_data ? strstr(config_data, "init_ms=") : NULL;
+    if (init_ms) {
+        usleep((useconds_t)atoi(init_ms + strlen("init_ms=")) * 1000);
+    }
+    const char* update_us = config_data ? strstr(config_data, "update_us=") : NULL;
+    g_update_us = update_us ? atol(update_us + strlen("update_us=")) : -1;
+
+    pthread_mutex_lock(&g_mutex);
+    memset(&g_stats, 0, sizeof(g_stats));
+    g_stats.start_time = time(NULL);
+    g_state = PROCESS_STATE_STOPPED;
+    pthread_mutex_unlock(&g_mutex);
+    return 0;
+}
+
+/**
+ * start线程在等待中被取消(限时停止的TASK_STOP_ESCALATE_CANCEL)时释放重新取得的g_mutex
+ */
+static void start_cancelled(void* arg) {
+    (void)arg;
+    g_state = PROCESS_STATE_STOPPED;
+    pthread_mutex_unlock(&g_mutex);
+}
+
+static int start(void) {
+    pthread_mutex_lock(&g_mutex);
+    if (g_state != PROCESS_STATE_STOPPED) {
+        pthread_mutex_unlock(&g_mutex);
+        return -1;
+    }
+
+    g_state = PROCESS_STATE_RUNNING;
+    g_should_stop = false;
+    if (g_update_us < 0) {
+        pthread_cleanup_push(start_cancelled, NULL);
+        while (!g_should_stop) {
+            pthread_cond_wait(&g_cond, &g_mutex);
+        }
+        pthread_cleanup_pop(0);
+    } else {
+        // 本线程是统计信息唯一的写者，循环期间不持锁，stop无需等它让出g_mutex
+        pthread_mutex_unlock(&g_mutex);
+        uint64_t sequence = 0;
+        while (!__atomic_load_n(&g_should_stop, __ATOMIC_ACQUIRE)) {
+            // 逐字段写入，不经统计页读取get_stats的调用方可能看到写了一半的结构
+            sequence++;
+            g_stats.run_time = sequence;
+            g_stats.cpu_usage = (uint32_t)sequence;
+            g_stats.memory_usage = sequence;
+            process_stats_page_write_begin(g_stats_page);
+            if (g_stats_page) {
+                g_stats_page->stats = g_stats;
+                if (g_updates_counter >= 0) {
+                    g_stats_page->counters[g_updates_counter].value = sequence;
+                }
+            }
+            process_stats_page_write_end(g_stats_page);
+            if (g_update_us > 0) {
+                usleep((useconds_t)g_update_us);
+            }
+        }
+        pthread_mutex_lock(&g_mutex);
+    }
+    g_state = PROCESS_STATE_STOPPED;
+    pthread_mutex_unlock(&g_mutex);
+    return 0;
+}
+
+static int stop(void) {
+    pthread_mutex_lock(&g_mutex);
+    if (g_state != PROCESS_STATE_RUNNING) {
+        pthread_mutex_unlock(&g_mutex);
+        return -1;
+    }
+
+    __atomic_store_n(&g_should_stop, true, __ATOMIC_RELEASE);
+    pthread_cond_broadcast(&g_cond);
+    pthread_mutex_unlock(&g_mutex);
+    return 0;
+}
+
+static void cleanup(void) {
+}
+
+static ProcessState get_state(void) {
+    pthread_mutex_lock(&g_mutex);
+    ProcessState state = g_state;
+    pthread_mutex_unlock(&g_mutex);
+    return state;
+}
+
+static const ProcessStats* get_stats(void) {
+    return &g_stats;
+}
+
+static void handle_signal(int signal) {
+    (void)signal;
+}
+
+static bool health_check(void) {
+    return true;
+}
+
+static ProcessInterface g_interface = {
+    .get_process_info = get_process_info,
+    .initialize = initialize,
+    .start = start,
+    .stop = stop,
+    .cleanup = cleanup,
+    .get_state = get_state,
+    .get_stats = get_stats,
+    .handle_signal = handle_signal,
+    .health_check = health_check
+};
+
+ProcessInterface* get_process_interface(void) {
+    return &g_interface;
+}
+
+void set_process_stats_page(ProcessStatsPage* page) {
+    pthread_mutex_lock(&g_mutex);
+    g_stats_page = page;
+    g_updates_counter = process_stats_page_add_counter(page, "updates");
+    pthread_mutex_unlock(&g_mutex);
+}
+
+uint32_t get_interface_version(void) {
+    return PROCESS_INTERFACE_VERSION;
+}
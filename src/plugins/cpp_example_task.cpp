@@ -237,7 +237,8 @@ static const TaskInterface cpp_task_vtable = {
     .resume = nullptr,      // 使用默认实现
     .handle_signal = cpp_task_handle_signal,
     .health_check = cpp_task_health_check,
-    .get_status = cpp_task_get_status
+    .get_status = cpp_task_get_status,
+    .step = nullptr
 };
 
 // ==============================================================================
@@ -246,22 +247,23 @@ static const TaskInterface cpp_task_vtable = {
 
 extern "C" {
 
-CppTaskWrapper* cpp_example_task_create(const TaskConfig* config) {
+CppTaskWrapper* cpp_example_task_create_in(const TaskConfig* config, TaskArena* arena) {
     if (!config) {
         return nullptr;
     }
     
     // 分配包装器
-    CppTaskWrapper* wrapper = static_cast<CppTaskWrapper*>(malloc(sizeof(CppTaskWrapper)));
+    CppTaskWrapper* wrapper = static_cast<CppTaskWrapper*>(task_object_alloc(arena, sizeof(CppTaskWrapper)));
     if (!wrapper) {
         return nullptr;
     }
     
     // 初始化C基类
     if (task_base_init(&wrapper->base, &cpp_task_vtable, config) != 0) {
-        free(wrapper);
+        task_object_free(arena, wrapper, sizeof(CppTaskWrapper));
         return nullptr;
     }
+    wrapper->base.arena = arena;
     
     // 初始化C++部分
     new(&wrapper->cpp_task) std::unique_ptr<CppTaskBase>();
@@ -269,18 +271,24 @@ CppTaskWrapper* cpp_example_task_create(const TaskConfig* config) {
     return wrapper;
 }
 
+CppTaskWrapper* cpp_example_task_create(const TaskConfig* config) {
+    return cpp_example_task_create_in(config, nullptr);
+}
+
 void cpp_example_task_destroy(CppTaskWrapper* wrapper) {
     if (!wrapper) {
         return;
     }
     
+    TaskArena* arena = wrapper->base.arena;
+    
     // 销毁C++对象
     wrapper->cpp_task.~unique_ptr<CppTaskBase>();
     
     // 销毁C基类
     task_base_destroy(&wrapper->base);
     
-    free(wrapper);
+    task_object_free(arena, wrapper, sizeof(CppTaskWrapper));
 }
 
 TaskBase* cpp_example_task_get_base(CppTaskWrapper* wrapper) {
@@ -1,4 +1,6 @@
 #include "task_interface.h"
+#include "task_arena.h"
+#include "task_park.h"
 #include <iostream>
 #include <string>
 #include <memory>
@@ -20,6 +22,7 @@
 #include <iomanip>
 #include <random>
 #include <mutex>
+#include <condition_variable>
 #include <shared_mutex>
 
 /**
@@ -80,7 +83,8 @@ public:
         return true;
     }
     
-    void start() {
+    void start(TaskBase* task) {
+        task_ = task;
         running_ = true;
         log("数据处理任务开始运行");
         
@@ -101,7 +105,11 @@ public:
         if (!running_) return;
         
         log("停止数据处理任务...");
-        running_ = false;
+        {
+            std::lock_guard<std::mutex> lock(stop_mutex_);
+            running_ = false;
+        }
+        stop_cv_.notify_all();
         
         // 等待所有线程结束
         if (data_generator_thread_.joinable()) {
@@ -398,7 +406,10 @@ private:
         
         while (running_) {
             calculate_statistics();
-            std::this_thread::sleep_for(std::chrono::seconds(30));
+            
+            // 停止时立即醒来，stop()不必等满一个统计周期
+            std::unique_lock<std::mutex> lock(stop_mutex_);
+            stop_cv_.wait_for(lock, std::chrono::seconds(30), [this] { return !running_; });
         }
         
         log("统计分析线程退出");
@@ -443,7 +454,8 @@ private:
         
         auto last_report = std::chrono::steady_clock::now();
         
-        while (running_) {
+        // 停止请求由task_stop发出，running_只在cleanup中清除
+        while (running_ && !task_should_stop(task_)) {
             auto now = std::chrono::steady_clock::now();
             
             // 每分钟输出一次状态报告
@@ -453,7 +465,8 @@ private:
                 last_report = now;
             }
             
-            std::this_thread::sleep_for(std::chrono::seconds(10));
+            // 可中断的休眠: 任务被停止时立即返回
+            task_sleep(task_, 10000);
         }
         
         log("主监控循环结束");
@@ -469,7 +482,10 @@ private:
     }
 
 private:
+    TaskBase* task_ = nullptr;
     std::atomic<bool> running_;
+    std::mutex stop_mutex_;
+    std::condition_variable stop_cv_;
     std::atomic<size_t> process_counter_;
     
     mutable std::shared_mutex data_mutex_;
@@ -523,7 +539,7 @@ static int data_processor_execute(TaskBase* base_task) {
     }
     
     try {
-        wrapper->processor->start();
+        wrapper->processor->start(base_task);
         return 0;
     } catch (const std::exception& e) {
         std::cerr << "数据处理任务执行异常: " << e.what() << std::endl;
@@ -567,7 +583,8 @@ static const TaskInterface data_processor_vtable = {
     .resume = nullptr,
     .handle_signal = nullptr,
     .health_check = data_processor_health_check,
-    .get_status = data_processor_get_status
+    .get_status = data_processor_get_status,
+    .step = nullptr
 };
 
 // ==============================================================================
@@ -576,34 +593,41 @@ static const TaskInterface data_processor_vtable = {
 
 extern "C" {
 
-DataProcessorWrapper* data_processor_task_create(const TaskConfig* config) {
+DataProcessorWrapper* data_processor_task_create_in(const TaskConfig* config, TaskArena* arena) {
     if (!config) {
         return nullptr;
     }
     
-    auto* wrapper = static_cast<DataProcessorWrapper*>(malloc(sizeof(DataProcessorWrapper)));
+    auto* wrapper = static_cast<DataProcessorWrapper*>(task_object_alloc(arena, sizeof(DataProcessorWrapper)));
     if (!wrapper) {
         return nullptr;
     }
     
     if (task_base_init(&wrapper->base, &data_processor_vtable, config) != 0) {
-        free(wrapper);
+        task_object_free(arena, wrapper, sizeof(DataProcessorWrapper));
         return nullptr;
     }
+    wrapper->base.arena = arena;
     
     new(&wrapper->processor) std::unique_ptr<DataProcessorTask>();
     
     return wrapper;
 }
 
+DataProcessorWrapper* data_processor_task_create(const TaskConfig* config) {
+    return data_processor_task_create_in(config, nullptr);
+}
+
 void data_processor_task_destroy(DataProcessorWrapper* wrapper) {
     if (!wrapper) {
         return;
     }
     
+    TaskArena* arena = wrapper->base.arena;
+    
     wrapper->processor.~unique_ptr<DataProcessorTask>();
     task_base_destroy(&wrapper->base);
-    free(wrapper);
+    task_object_free(arena, wrapper, sizeof(DataProcessorWrapper));
 }
 
 TaskBase* data_processor_task_get_base(DataProcessorWrapper* wrapper) {
@@ -1,4 +1,5 @@
 #include "process_interface.h"
+#include "process_stats_page.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -13,11 +14,17 @@ static ProcessState g_state = PROCESS_STATE_STOPPED;
 static bool g_should_stop = false;
 static LogCallback g_log_callback = NULL;
 static pthread_mutex_t g_state_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t g_wake;               // 停止/暂停/恢复时唤醒主循环(CLOCK_MONOTONIC)
+static pthread_once_t g_wake_once = PTHREAD_ONCE_INIT;
+static const ProcessNotifier* g_notifier = NULL;
+static pthread_t g_worker;
+static bool g_worker_joinable = false;
+static uint64_t g_cycle_count = 0;          // 热重载时交接
 
 // 进程信息
 static ProcessInfo g_process_info = {
     .name = "example_process",
-    .version = "1.0.0",
+    .version = "2.0.0",
     .description = "Example process plugin for demonstration",
     .priority = 1,
     .restart_count = 3,
@@ -26,6 +33,9 @@ static ProcessInfo g_process_info = {
 
 // 统计信息
 static ProcessStats g_stats = {0};
+static LatencyHistogram g_latency;  // 每个工作周期的耗时(仅主循环线程记录)
+static ProcessStatsPage* g_stats_page = NULL;  // 管理器分配的统计页，未分配时为NULL
+static int g_cycles_counter = -1;
 
 /**
  * 日志函数
@@ -44,6 +54,27 @@ static void log_message(LogLevel level, const char* format, ...) {
     g_log_callback(level, message);
 }
 
+/**
+ * 向管理器推送状态 - 调用时不持g_state_mutex
+ */
+static void notify_state(ProcessState state, int result) {
+    pthread_mutex_lock(&g_state_mutex);
+    const ProcessNotifier* notifier = g_notifier;
+    pthread_mutex_unlock(&g_state_mutex);
+
+    if (notifier) {
+        notifier->notify(notifier->context, state, result);
+    }
+}
+
+static void init_wake(void) {
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&g_wake, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
 /**
  * 获取进程信息
  */
@@ -62,6 +93,7 @@ static int initialize(const char* config_data, LogCallback log_callback) {
         return -1;
     }
     
+    pthread_once(&g_wake_once, init_wake);
     g_state = PROCESS_STATE_INITIALIZING;
     g_log_callback = log_callback;
     g_should_stop = false;
@@ -69,6 +101,7 @@ static int initialize(const char* config_data, LogCallback log_callback) {
     // 初始化统计信息
     memset(&g_stats, 0, sizeof(g_stats));
     g_stats.start_time = time(NULL);
+    latency_histogram_reset(&g_latency);
     
     log_message(LOG_LEVEL_INFO, "Example process initializing...");
     
@@ -88,85 +121,168 @@ static int initialize(const char* config_data, LogCallback log_callback) {
 }
 
 /**
- * 启动进程主循环
+ * 主循环线程 - 每2秒一个工作周期，暂停期间不计周期；结束时通知STOPPED
  */
-static int start(void) {
+static void* worker_main(void* arg) {
+    (void)arg;
+
     pthread_mutex_lock(&g_state_mutex);
-    
-    if (g_state != PROCESS_STATE_STOPPED) {
-        pthread_mutex_unlock(&g_state_mutex);
-        return -1;
-    }
-    
-    g_state = PROCESS_STATE_RUNNING;
-    g_should_stop = false;
-    pthread_mutex_unlock(&g_state_mutex);
-    
-    log_message(LOG_LEVEL_INFO, "Example process started");
-    
-    // 主循环
-    int cycle_count = 0;
     while (!g_should_stop) {
-        // 模拟工作
-        sleep(2);
-        cycle_count++;
+        struct timespec begin, end, deadline;
+        clock_gettime(CLOCK_MONOTONIC, &begin);
+        
+        // 模拟工作: 等待2秒，停止时立即醒来
+        deadline = begin;
+        deadline.tv_sec += 2;
+        while (!g_should_stop && pthread_cond_timedwait(&g_wake, &g_state_mutex, &deadline) == 0) {
+        }
+        while (!g_should_stop && g_state == PROCESS_STATE_PAUSED) {
+            pthread_cond_wait(&g_wake, &g_state_mutex);
+        }
+        if (g_should_stop) {
+            break;
+        }
+        uint64_t cycle_count = ++g_cycle_count;
+        
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        latency_histogram_record(&g_latency, (uint64_t)(end.tv_sec - begin.tv_sec) * 1000000000ULL +
+                                             (uint64_t)end.tv_nsec - (uint64_t)begin.tv_nsec);
         
         // 更新统计信息
-        pthread_mutex_lock(&g_state_mutex);
         g_stats.run_time = time(NULL) - g_stats.start_time;
         g_stats.cpu_usage = 10 + (cycle_count % 20); // 模拟CPU使用率
         g_stats.memory_usage = 1024 * 1024 * (5 + (cycle_count % 10)); // 模拟内存使用
+        // 同时发布到统计页，读者无需调用get_stats
+        process_stats_page_write_begin(g_stats_page);
+        if (g_stats_page) {
+            g_stats_page->stats = g_stats;
+            latency_histogram_summarize(&g_latency, &g_stats_page->latency);
+            if (g_cycles_counter >= 0) {
+                g_stats_page->counters[g_cycles_counter].value = cycle_count;
+            }
+        }
+        process_stats_page_write_end(g_stats_page);
         pthread_mutex_unlock(&g_state_mutex);
         
         if (cycle_count % 10 == 0) {
-            log_message(LOG_LEVEL_INFO, "Example process is running, cycle: %d", cycle_count);
+            log_message(LOG_LEVEL_INFO, "Example process is running, cycle: %llu", (unsigned long long)cycle_count);
         }
+        pthread_mutex_lock(&g_state_mutex);
     }
-    
-    pthread_mutex_lock(&g_state_mutex);
     g_state = PROCESS_STATE_STOPPED;
     pthread_mutex_unlock(&g_state_mutex);
     
     log_message(LOG_LEVEL_INFO, "Example process stopped");
+    notify_state(PROCESS_STATE_STOPPED, 0);
+    return NULL;
+}
+
+/**
+ * 启动进程 - 创建主循环线程后立即返回
+ */
+static int start(void) {
+    pthread_mutex_lock(&g_state_mutex);
+    
+    if (g_state != PROCESS_STATE_STOPPED) {
+        pthread_mutex_unlock(&g_state_mutex);
+        return -1;
+    }
+    
+    // 上一次运行的线程已通知STOPPED，此处很快返回
+    if (g_worker_joinable) {
+        pthread_mutex_unlock(&g_state_mutex);
+        pthread_join(g_worker, NULL);
+        pthread_mutex_lock(&g_state_mutex);
+        g_worker_joinable = false;
+    }
+    
+    g_state = PROCESS_STATE_RUNNING;
+    g_should_stop = false;
+    if (pthread_create(&g_worker, NULL, worker_main, NULL) != 0) {
+        g_state = PROCESS_STATE_STOPPED;
+        pthread_mutex_unlock(&g_state_mutex);
+        return -1;
+    }
+    g_worker_joinable = true;
+    pthread_mutex_unlock(&g_state_mutex);
+    
+    log_message(LOG_LEVEL_INFO, "Example process started");
+    notify_state(PROCESS_STATE_RUNNING, 0);
     return 0;
 }
 
 /**
- * 停止进程
+ * 停止进程 - 唤醒主循环后立即返回，主循环结束时通知STOPPED
  */
 static int stop(void) {
     pthread_mutex_lock(&g_state_mutex);
     
-    if (g_state != PROCESS_STATE_RUNNING) {
+    if (g_state != PROCESS_STATE_RUNNING && g_state != PROCESS_STATE_PAUSED) {
         pthread_mutex_unlock(&g_state_mutex);
         return -1;
     }
     
     g_state = PROCESS_STATE_STOPPING;
     g_should_stop = true;
+    pthread_cond_broadcast(&g_wake);
     pthread_mutex_unlock(&g_state_mutex);
     
     log_message(LOG_LEVEL_INFO, "Example process stopping...");
-    
-    // 等待主循环结束
-    while (g_state == PROCESS_STATE_STOPPING) {
-        usleep(100000); // 100ms
+    return 0;
+}
+
+/**
+ * 暂停/恢复 - 主循环在当前周期结束后等待恢复
+ */
+static int set_paused(bool pause) {
+    ProcessState from = pause ? PROCESS_STATE_RUNNING : PROCESS_STATE_PAUSED;
+    ProcessState to = pause ? PROCESS_STATE_PAUSED : PROCESS_STATE_RUNNING;
+
+    pthread_mutex_lock(&g_state_mutex);
+    if (g_state != from) {
+        pthread_mutex_unlock(&g_state_mutex);
+        return -1;
     }
-    
+    g_state = to;
+    pthread_cond_broadcast(&g_wake);
+    pthread_mutex_unlock(&g_state_mutex);
+
+    log_message(LOG_LEVEL_INFO, pause ? "Example process paused" : "Example process resumed");
+    notify_state(to, 0);
     return 0;
 }
 
+static int pause_process(void) {
+    return set_paused(true);
+}
+
+static int resume_process(void) {
+    return set_paused(false);
+}
+
 /**
  * 清理资源
  */
 static void cleanup(void) {
     pthread_mutex_lock(&g_state_mutex);
-    g_state = PROCESS_STATE_STOPPED;
     g_should_stop = true;
-    g_log_callback = NULL;
+    if (g_worker_joinable) {
+        pthread_cond_broadcast(&g_wake);
+    }
+    bool joinable = g_worker_joinable;
+    g_worker_joinable = false;
     pthread_mutex_unlock(&g_state_mutex);
     
-    // 清理资源（如果有的话）
+    // 通知器在cleanup返回前仍然有效，主循环线程可以照常通知STOPPED
+    if (joinable) {
+        pthread_join(g_worker, NULL);
+    }
+    
+    pthread_mutex_lock(&g_state_mutex);
+    g_state = PROCESS_STATE_STOPPED;
+    g_log_callback = NULL;
+    g_notifier = NULL;
+    pthread_mutex_unlock(&g_state_mutex);
 }
 
 /**
@@ -193,7 +309,12 @@ static void handle_signal(int signal) {
     log_message(LOG_LEVEL_INFO, "Example process received signal: %d", signal);
     
     if (signal == SIGTERM || signal == SIGINT) {
+        pthread_mutex_lock(&g_state_mutex);
         g_should_stop = true;
+        if (g_worker_joinable) {
+            pthread_cond_broadcast(&g_wake);
+        }
+        pthread_mutex_unlock(&g_state_mutex);
     }
 }
 
@@ -203,36 +324,92 @@ static void handle_signal(int signal) {
 static bool health_check(void) {
     // 简单的健康检查：如果进程应该在运行但状态不是运行，则认为不健康
     pthread_mutex_lock(&g_state_mutex);
-    bool healthy = (g_state == PROCESS_STATE_RUNNING && !g_should_stop) ||
+    bool healthy = ((g_state == PROCESS_STATE_RUNNING || g_state == PROCESS_STATE_PAUSED) && !g_should_stop) ||
                    (g_state == PROCESS_STATE_STOPPED);
     pthread_mutex_unlock(&g_state_mutex);
     
     return healthy;
 }
 
-// 进程接口实例
-static ProcessInterface g_interface = {
-    .get_process_info = get_process_info,
-    .initialize = initialize,
-    .start = start,
-    .stop = stop,
-    .cleanup = cleanup,
-    .get_state = get_state,
-    .get_stats = get_stats,
-    .handle_signal = handle_signal,
-    .health_check = health_check
+/**
+ * 绑定状态通知
+ */
+static void bind_notifier(const ProcessNotifier* notifier) {
+    pthread_mutex_lock(&g_state_mutex);
+    g_notifier = notifier;
+    pthread_mutex_unlock(&g_state_mutex);
+}
+
+/**
+ * 接收统计页
+ */
+static void set_stats_page(ProcessStatsPage* page) {
+    pthread_mutex_lock(&g_state_mutex);
+    g_stats_page = page;
+    g_cycles_counter = process_stats_page_add_counter(page, "cycles");
+    pthread_mutex_unlock(&g_state_mutex);
+}
+
+/**
+ * 导出运行状态(周期计数)
+ */
+static size_t export_state(void* buffer, size_t size) {
+    if (size < sizeof(g_cycle_count)) {
+        return 0;
+    }
+    pthread_mutex_lock(&g_state_mutex);
+    memcpy(buffer, &g_cycle_count, sizeof(g_cycle_count));
+    pthread_mutex_unlock(&g_state_mutex);
+    return sizeof(g_cycle_count);
+}
+
+/**
+ * 导入旧实例的运行状态
+ */
+static int import_state(const void* buffer, size_t size) {
+    if (size != sizeof(g_cycle_count)) {
+        return -1;
+    }
+    pthread_mutex_lock(&g_state_mutex);
+    memcpy(&g_cycle_count, buffer, sizeof(g_cycle_count));
+    pthread_mutex_unlock(&g_state_mutex);
+    log_message(LOG_LEVEL_INFO, "Example process resumed from cycle %llu", (unsigned long long)g_cycle_count);
+    return 0;
+}
+
+// 进程接口实例(v2: start/stop不阻塞，状态经通知推送)
+static ProcessInterfaceV2 g_interface = {
+    .base = {
+        .get_process_info = get_process_info,
+        .initialize = initialize,
+        .start = start,
+        .stop = stop,
+        .cleanup = cleanup,
+        .get_state = get_state,
+        .get_stats = get_stats,
+        .handle_signal = handle_signal,
+        .health_check = health_check
+    },
+    .size = sizeof(ProcessInterfaceV2),
+    .capabilities = PROCESS_CAP_BATCH_STATS | PROCESS_CAP_PAUSE | PROCESS_CAP_RELOAD,
+    .bind_notifier = bind_notifier,
+    .pause = pause_process,
+    .resume = resume_process,
+    .set_stats_page = set_stats_page,
+    .export_state = export_state,
+    .import_state = import_state
 };
 
 /**
  * 导出函数：获取进程接口
  */
 ProcessInterface* get_process_interface(void) {
-    return &g_interface;
+    return &g_interface.base;
 }
 
 /**
  * 导出函数：获取接口版本
  */
 uint32_t get_interface_version(void) {
-    return PROCESS_INTERFACE_VERSION;
+    return PROCESS_INTERFACE_VERSION_2;
 }
@@ -1,4 +1,8 @@
 #include "task_interface.h"
+#include "task_latency.h"
+#include "task_stats.h"
+#include "task_park.h"
+#include "task_arena.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -62,6 +66,29 @@ static int example_task_initialize(TaskBase* base_task) {
     return 0;
 }
 
+/**
+ * 执行一次工作 - execute主循环和step共用
+ */
+static void example_task_do_work(ExampleTask* task) {
+    uint64_t begin = task_latency_begin();
+    
+    // 模拟工作
+    task->counter++;
+    
+    // 更新心跳
+    task_update_heartbeat(&task->base);
+    
+    // CPU时间和使用率由管理器采样(task_manager_sample_accounting)，内存只上报任务自身占用
+    task_stats_write_begin(&task->base);
+    task->base.stats.memory_usage = sizeof(ExampleTask);
+    task_stats_write_end(&task->base);
+    
+    printf("[%s] 执行第 %d 次: %s\n", 
+           task->base.config.name, task->counter, task->message);
+    
+    task_latency_end(&task->base, begin);
+}
+
 /**
  * 执行函数 - 重写基类虚函数(任务主循环)
  */
@@ -71,20 +98,7 @@ static int example_task_execute(TaskBase* base_task) {
     printf("示例任务开始执行: %s\n", task->base.config.name);
     
     while (!task_should_stop(base_task)) {
-        // 模拟工作
-        task->counter++;
-        
-        // 更新心跳
-        task_update_heartbeat(base_task);
-        
-        // 更新统计信息
-        pthread_mutex_lock(&task->base.mutex);
-        task->base.stats.cpu_usage = 10 + (task->counter % 20); // 模拟CPU使用率
-        task->base.stats.memory_usage = 1024 * 1024 * (2 + (task->counter % 5)); // 模拟内存使用
-        pthread_mutex_unlock(&task->base.mutex);
-        
-        printf("[%s] 执行第 %d 次: %s\n", 
-               task->base.config.name, task->counter, task->message);
+        example_task_do_work(task);
         
         // 模拟工作延迟
         int delay = task->work_interval;
@@ -92,10 +106,8 @@ static int example_task_execute(TaskBase* base_task) {
             delay += (rand() % 3); // 随机增加0-2秒
         }
         
-        // 分段休眠，以便及时响应停止信号
-        for (int i = 0; i < delay && !task_should_stop(base_task); i++) {
-            sleep(1);
-        }
+        // 停靠等待，停止时立即返回，暂停期间阻塞
+        task_sleep(base_task, (uint32_t)delay * 1000);
     }
     
     printf("示例任务执行完成: %s，总执行次数: %d\n", 
@@ -104,6 +116,14 @@ static int example_task_execute(TaskBase* base_task) {
     return 0;
 }
 
+/**
+ * 单步函数 - 重写基类虚函数(周期调度时由定时服务唤醒)
+ */
+static int example_task_step(TaskBase* base_task) {
+    example_task_do_work(TASK_CAST(ExampleTask, base_task));
+    return TASK_STEP_WAIT;
+}
+
 /**
  * 清理函数 - 重写基类虚函数
  */
@@ -178,7 +198,7 @@ static bool example_task_health_check(TaskBase* base_task) {
     
     // 检查任务是否卡死(例如：长时间没有更新计数器)
     uint64_t current_time = time(NULL);
-    if (task->base.state == TASK_STATE_RUNNING) {
+    if (task->base.state == TASK_STATE_RUNNING && !task_is_paused(&task->base)) {
         // 如果超过工作间隔的3倍时间没有心跳，认为不健康
         if (current_time - task->base.stats.last_heartbeat > (task->work_interval * 3)) {
             healthy = false;
@@ -201,6 +221,14 @@ static int example_task_get_status(TaskBase* base_task, char* buffer, size_t siz
         return -1;
     }
     
+    // 单次工作耗时分布
+    LatencySummary latency = {0};
+    LatencyHistogram* histogram = malloc(sizeof(LatencyHistogram));
+    if (histogram && task_latency_snapshot(&task->base, histogram) == 0) {
+        latency_histogram_summarize(histogram, &latency);
+    }
+    free(histogram);
+    
     pthread_mutex_lock(&task->base.mutex);
     
     int written = snprintf(buffer, size,
@@ -213,8 +241,13 @@ static int example_task_get_status(TaskBase* base_task, char* buffer, size_t siz
         "消息: %s\n"
         "运行时间: %lu秒\n"
         "CPU使用率: %u%%\n"
+        "CPU时间: %.3f秒\n"
+        "缺页: 次 %lu / 主 %lu\n"
+        "最近运行CPU: %d\n"
         "内存使用: %lu bytes\n"
-        "最后心跳: %lu\n",
+        "最后心跳: %lu\n"
+        "CPU放置: %s (%s)\n"
+        "单次耗时: p50 %.1fus / p99 %.1fus / p999 %.1fus (%lu 次)\n",
         task->base.config.name,
         task->base.state == TASK_STATE_RUNNING ? "运行中" : "已停止",
         task->counter,
@@ -223,8 +256,15 @@ static int example_task_get_status(TaskBase* base_task, char* buffer, size_t siz
         task->message,
         task->base.stats.total_run_time,
         task->base.stats.cpu_usage,
+        task->base.stats.cpu_time_ns / 1e9,
+        task->base.stats.minor_faults,
+        task->base.stats.major_faults,
+        task->base.stats.last_cpu,
         task->base.stats.memory_usage,
-        task->base.stats.last_heartbeat
+        task->base.stats.last_heartbeat,
+        cpu_placement_policy_name(task->base.config.placement.policy),
+        task->base.stats.cpu_affinity[0] ? task->base.stats.cpu_affinity : "未记录",
+        latency.p50_ns / 1e3, latency.p99_ns / 1e3, latency.p999_ns / 1e3, latency.count
     );
     
     pthread_mutex_unlock(&task->base.mutex);
@@ -243,7 +283,8 @@ static const TaskInterface example_task_vtable = {
     .resume = example_task_resume,
     .handle_signal = example_task_handle_signal,
     .health_check = example_task_health_check,
-    .get_status = example_task_get_status
+    .get_status = example_task_get_status,
+    .step = example_task_step
 };
 
 // ============================================================================
@@ -251,27 +292,30 @@ static const TaskInterface example_task_vtable = {
 // ============================================================================
 
 /**
- * 创建示例任务 - "构造函数"
+ * 在分配区中创建示例任务
  * @param config 任务配置
  * @param custom_config 自定义配置
+ * @param arena 分配区，NULL时使用malloc
  * @return 任务指针，失败返回NULL
  */
-ExampleTask* example_task_create(const TaskConfig* config, const ExampleTaskConfig* custom_config) {
+ExampleTask* example_task_create_in(const TaskConfig* config, const ExampleTaskConfig* custom_config,
+                                    TaskArena* arena) {
     if (!config) {
         return NULL;
     }
     
     // 分配内存
-    ExampleTask* task = malloc(sizeof(ExampleTask));
+    ExampleTask* task = task_object_alloc(arena, sizeof(ExampleTask));
     if (!task) {
         return NULL;
     }
     
     // 初始化基类
     if (task_base_init(&task->base, &example_task_vtable, config) != 0) {
-        free(task);
+        task_object_free(arena, task, sizeof(ExampleTask));
         return NULL;
     }
+    task->base.arena = arena;
     
     // 设置自定义配置
     if (custom_config) {
@@ -285,6 +329,16 @@ ExampleTask* example_task_create(const TaskConfig* config, const ExampleTaskConf
     return task;
 }
 
+/**
+ * 创建示例任务 - "构造函数"
+ * @param config 任务配置
+ * @param custom_config 自定义配置
+ * @return 任务指针，失败返回NULL
+ */
+ExampleTask* example_task_create(const TaskConfig* config, const ExampleTaskConfig* custom_config) {
+    return example_task_create_in(config, custom_config, NULL);
+}
+
 /**
  * 销毁示例任务 - "析构函数"
  * @param task 任务指针
@@ -300,11 +354,15 @@ void example_task_destroy(ExampleTask* task) {
         free(custom_config);
     }
     
+    // 释放耗时直方图
+    task_latency_release(&task->base);
+    
     // 销毁基类
+    TaskArena* arena = task->base.arena;
     task_base_destroy(&task->base);
     
     // 释放任务内存
-    free(task);
+    task_object_free(arena, task, sizeof(ExampleTask));
 }
 
 /**
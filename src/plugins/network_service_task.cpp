@@ -1,4 +1,5 @@
 #include "task_interface.h"
+#include "task_arena.h"
 #include <iostream>
 #include <string>
 #include <memory>
@@ -345,7 +346,8 @@ static const TaskInterface network_service_vtable = {
     .resume = nullptr,
     .handle_signal = nullptr,
     .health_check = network_service_health_check,
-    .get_status = network_service_get_status
+    .get_status = network_service_get_status,
+    .step = nullptr
 };
 
 // ==============================================================================
@@ -354,34 +356,41 @@ static const TaskInterface network_service_vtable = {
 
 extern "C" {
 
-NetworkServiceWrapper* network_service_task_create(const TaskConfig* config) {
+NetworkServiceWrapper* network_service_task_create_in(const TaskConfig* config, TaskArena* arena) {
     if (!config) {
         return nullptr;
     }
     
-    auto* wrapper = static_cast<NetworkServiceWrapper*>(malloc(sizeof(NetworkServiceWrapper)));
+    auto* wrapper = static_cast<NetworkServiceWrapper*>(task_object_alloc(arena, sizeof(NetworkServiceWrapper)));
     if (!wrapper) {
         return nullptr;
     }
     
     if (task_base_init(&wrapper->base, &network_service_vtable, config) != 0) {
-        free(wrapper);
+        task_object_free(arena, wrapper, sizeof(NetworkServiceWrapper));
         return nullptr;
     }
+    wrapper->base.arena = arena;
     
     new(&wrapper->service) std::unique_ptr<NetworkServiceTask>();
     
     return wrapper;
 }
 
+NetworkServiceWrapper* network_service_task_create(const TaskConfig* config) {
+    return network_service_task_create_in(config, nullptr);
+}
+
 void network_service_task_destroy(NetworkServiceWrapper* wrapper) {
     if (!wrapper) {
         return;
     }
     
+    TaskArena* arena = wrapper->base.arena;
+    
     wrapper->service.~unique_ptr<NetworkServiceTask>();
     task_base_destroy(&wrapper->base);
-    free(wrapper);
+    task_object_free(arena, wrapper, sizeof(NetworkServiceWrapper));
 }
 
 TaskBase* network_service_task_get_base(NetworkServiceWrapper* wrapper) {
@@ -1,4 +1,5 @@
 #include "task_interface.h"
+#include "task_arena.h"
 #include "process_interface.h" // LogLevel和LogCallback定义
 #include <iostream>
 #include <string>
@@ -138,7 +139,8 @@ static const TaskInterface simple_cpp_task_vtable = {
     .resume = nullptr,
     .handle_signal = nullptr,
     .health_check = simple_cpp_task_health_check,
-    .get_status = simple_cpp_task_get_status
+    .get_status = simple_cpp_task_get_status,
+    .step = nullptr
 };
 
 // ==============================================================================
@@ -150,34 +152,41 @@ extern "C" {
 // 使用CppTaskWrapper作为类型别名
 typedef SimpleCppTaskWrapper CppTaskWrapper;
 
-CppTaskWrapper* cpp_task_create(const TaskConfig* config) {
+CppTaskWrapper* cpp_task_create_in(const TaskConfig* config, TaskArena* arena) {
     if (!config) {
         return nullptr;
     }
     
-    auto* wrapper = static_cast<CppTaskWrapper*>(malloc(sizeof(CppTaskWrapper)));
+    auto* wrapper = static_cast<CppTaskWrapper*>(task_object_alloc(arena, sizeof(CppTaskWrapper)));
     if (!wrapper) {
         return nullptr;
     }
     
     if (task_base_init(&wrapper->base, &simple_cpp_task_vtable, config) != 0) {
-        free(wrapper);
+        task_object_free(arena, wrapper, sizeof(CppTaskWrapper));
         return nullptr;
     }
+    wrapper->base.arena = arena;
     
     new(&wrapper->task) std::unique_ptr<SimpleCppTask>();
     
     return wrapper;
 }
 
+CppTaskWrapper* cpp_task_create(const TaskConfig* config) {
+    return cpp_task_create_in(config, nullptr);
+}
+
 void cpp_task_destroy(CppTaskWrapper* wrapper) {
     if (!wrapper) {
         return;
     }
     
+    TaskArena* arena = wrapper->base.arena;
+    
     wrapper->task.~unique_ptr<SimpleCppTask>();
     task_base_destroy(&wrapper->base);
-    free(wrapper);
+    task_object_free(arena, wrapper, sizeof(CppTaskWrapper));
 }
 
 TaskBase* cpp_task_get_base(CppTaskWrapper* wrapper) {
@@ -0,0 +1,113 @@
+#include "process_stats_page.h"
+#include <dirent.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/*
+ * 统计页查看工具 - 只读映射/dev/shm下启动器为各插件创建的统计页并打印，
+ * 不连接启动器，也不调用插件
+ * 用法: stats_dump [进程名] [-i 间隔毫秒]
+ */
+
+#define SHM_DIRECTORY "/dev/shm"
+
+static volatile sig_atomic_t g_running = 1;
+
+static void signal_handler(int signal) {
+    (void)signal;
+    g_running = 0;
+}
+
+static void print_page(const ProcessStatsPage* page) {
+    const ProcessStats* stats = &page->stats;
+    bool owner_alive = kill(page->owner_pid, 0) == 0;
+    printf("%s (launcher %d%s) %s\n", page->process_name, (int)page->owner_pid, owner_alive ? "" : ", exited",
+           page->shm_name);
+    printf("  updates %llu, run_time %llus, cpu %u%%, memory %.1f MB\n", (unsigned long long)page->update_count,
+           (unsigned long long)stats->run_time, stats->cpu_usage, stats->memory_usage / (1024.0 * 1024.0));
+    if (page->latency.count > 0) {
+        printf("  latency p50 %.1fus, p99 %.1fus, max %.1fus (%llu samples)\n", page->latency.p50_ns / 1e3,
+               page->latency.p99_ns / 1e3, page->latency.max_ns / 1e3, (unsigned long long)page->latency.count);
+    }
+    for (uint32_t i = 0; i < page->counter_count && i < PROCESS_STATS_PAGE_MAX_COUNTERS; i++) {
+        printf("  %s = %llu\n", page->counters[i].name, (unsigned long long)page->counters[i].value);
+    }
+}
+
+/**
+ * 打印所有匹配的统计页
+ * @param process_name 进程名称，NULL为全部
+ * @return 打印的页面数量
+ */
+static int dump_pages(const char* process_name) {
+    DIR* directory = opendir(SHM_DIRECTORY);
+    if (!directory) {
+        perror(SHM_DIRECTORY);
+        return -1;
+    }
+
+    int count = 0;
+    struct dirent* entry;
+    while ((entry = readdir(directory)) != NULL) {
+        if (strncmp(entry->d_name, PROCESS_STATS_PAGE_PREFIX, strlen(PROCESS_STATS_PAGE_PREFIX)) != 0) {
+            continue;
+        }
+
+        char shm_name[sizeof(((ProcessStatsPage*)0)->shm_name)];
+        int written = snprintf(shm_name, sizeof(shm_name), "/%s", entry->d_name);
+        ProcessStatsPage* page = written > 0 && (size_t)written < sizeof(shm_name) ?
+                                 process_stats_page_open(shm_name, false) : NULL;
+        if (!page) {
+            continue;
+        }
+        ProcessStatsPage copy;
+        if (process_stats_page_read(page, &copy) >= 0 &&
+            (!process_name || strcmp(copy.process_name, process_name) == 0)) {
+            print_page(&copy);
+            count++;
+        }
+        process_stats_page_close(page);
+    }
+    closedir(directory);
+    return count;
+}
+
+int main(int argc, char* argv[]) {
+    const char* process_name = NULL;
+    long interval_ms = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-i") == 0 && i + 1 < argc) {
+            interval_ms = atol(argv[++i]);
+        } else if (argv[i][0] != '-' && !process_name) {
+            process_name = argv[i];
+        } else {
+            fprintf(stderr, "Usage: %s [process_name] [-i interval_ms]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    signal(SIGINT, signal_handler);
+    signal(SIGTERM, signal_handler);
+
+    do {
+        int count = dump_pages(process_name);
+        if (count < 0) {
+            return 1;
+        }
+        if (count == 0) {
+            printf("No stats pages found%s%s\n", process_name ? " for " : "", process_name ? process_name : "");
+        }
+        if (interval_ms > 0) {
+            printf("\n");
+            fflush(stdout);
+            usleep((useconds_t)interval_ms * 1000);
+        }
+    } while (interval_ms > 0 && g_running);
+
+    return 0;
+}
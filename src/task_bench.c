@@ -0,0 +1,2298 @@
+#include "task_manager.h"
+#include "task_executor.h"
+#include "task_sched.h"
+#include "task_stats.h"
+#include "plugin_host.h"
+#include "process_manager.h"
+#include <dlfcn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sched.h>
+#include <sys/resource.h>
+
+/**
+ * 获取单调时钟(纳秒)
+ */
+static uint64_t get_monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/**
+ * 读取/proc/self/status中的内存字段(KB)
+ */
+static uint64_t read_status_kb(const char* field) {
+    FILE* file = fopen("/proc/self/status", "r");
+    if (!file) {
+        return 0;
+    }
+
+    char line[256];
+    uint64_t value = 0;
+    size_t field_len = strlen(field);
+    while (fgets(line, sizeof(line), file)) {
+        if (strncmp(line, field, field_len) == 0 && line[field_len] == ':') {
+            value = strtoull(line + field_len + 1, NULL, 10);
+            break;
+        }
+    }
+
+    fclose(file);
+    return value;
+}
+
+/**
+ * 获取本进程累计上下文切换次数
+ */
+static uint64_t get_context_switches(void) {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return (uint64_t)usage.ru_nvcsw + (uint64_t)usage.ru_nivcsw;
+}
+
+// ============================================================================
+// 名称查找: 链表线性扫描 vs 哈希索引
+// ============================================================================
+
+static int bench_index(void) {
+    const uint32_t sizes[] = {10, 100, 1000, 10000, 100000};
+    const uint32_t lookups = 200000;
+
+    printf("%-10s %18s %18s\n", "tasks", "list scan(ns/op)", "hash index(ns/op)");
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        uint32_t count = sizes[s];
+        TaskNode* nodes = calloc(count, sizeof(TaskNode));
+        if (!nodes) {
+            return 1;
+        }
+
+        struct TaskList list;
+        TAILQ_INIT(&list);
+        TaskIndex index;
+        task_index_init(&index, 0);
+
+        for (uint32_t i = 0; i < count; i++) {
+            snprintf(nodes[i].name, sizeof(nodes[i].name), "bench_task_%u", i);
+            TAILQ_INSERT_TAIL(&list, &nodes[i], entries);
+            task_index_insert(&index, &nodes[i]);
+        }
+
+        // 线性扫描开销随规模增长，限制次数以免大规模时耗时过长
+        uint32_t scan_lookups = count > 1000 ? lookups / (count / 1000) : lookups;
+        volatile uintptr_t sink = 0;
+
+        uint64_t start = get_monotonic_ns();
+        for (uint32_t i = 0; i < scan_lookups; i++) {
+            const char* name = nodes[(i * 2654435761u) % count].name;
+            TaskNode* node;
+            TAILQ_FOREACH(node, &list, entries) {
+                if (strcmp(node->name, name) == 0) {
+                    sink += (uintptr_t)node;
+                    break;
+                }
+            }
+        }
+        double scan_ns = (double)(get_monotonic_ns() - start) / scan_lookups;
+
+        start = get_monotonic_ns();
+        for (uint32_t i = 0; i < lookups; i++) {
+            const char* name = nodes[(i * 2654435761u) % count].name;
+            sink += (uintptr_t)task_index_find(&index, name);
+        }
+        double index_ns = (double)(get_monotonic_ns() - start) / lookups;
+
+        printf("%-10u %18.1f %18.1f\n", count, scan_ns, index_ns);
+
+        task_index_destroy(&index);
+        free(nodes);
+    }
+
+    return 0;
+}
+
+// ============================================================================
+// 基准用的空任务
+// ============================================================================
+
+static int bench_task_initialize(TaskBase* task) {
+    (void)task;
+    return 0;
+}
+
+static int bench_task_execute(TaskBase* task) {
+    while (!task_should_stop(task)) {
+        usleep(1000);
+    }
+    return 0;
+}
+
+static const TaskInterface bench_task_vtable = {
+    .initialize = bench_task_initialize,
+    .execute = bench_task_execute,
+};
+
+static TaskBase* bench_task_create(const char* name) {
+    TaskConfig config;
+    memset(&config, 0, sizeof(config));
+    snprintf(config.name, sizeof(config.name), "%s", name);
+    config.priority = TASK_PRIORITY_NORMAL;
+
+    TaskBase* task = malloc(sizeof(TaskBase));
+    if (!task) {
+        return NULL;
+    }
+    if (task_base_init(task, &bench_task_vtable, &config) != 0) {
+        free(task);
+        return NULL;
+    }
+    return task;
+}
+
+static void bench_task_destroy(TaskBase* task) {
+    if (task) {
+        task_base_destroy(task);
+        free(task);
+    }
+}
+
+// ============================================================================
+// 状态查询: 加锁路径 vs 纪元保护的只读视图
+// ============================================================================
+
+#define RCU_BENCH_TASKS 1000
+#define RCU_BENCH_SECONDS 1
+
+typedef struct {
+    TaskManager* manager;
+    bool use_view;
+    volatile bool* running;
+    uint64_t ops;
+    uint32_t seed;
+} RcuReaderArgs;
+
+static void* rcu_reader_thread(void* arg) {
+    RcuReaderArgs* args = arg;
+    char name[64];
+    TaskStats stats;
+    uint64_t ops = 0;
+
+    while (*args->running) {
+        args->seed = args->seed * 1103515245u + 12345u;
+        snprintf(name, sizeof(name), "rcu_task_%u", (args->seed >> 8) % RCU_BENCH_TASKS);
+
+        if (args->use_view) {
+            task_manager_read_task_state(args->manager, name);
+            task_manager_read_task_stats(args->manager, name, &stats);
+        } else {
+            task_manager_get_task_state(args->manager, name);
+            task_manager_get_task_stats(args->manager, name);
+        }
+        ops++;
+    }
+
+    args->ops = ops;
+    return NULL;
+}
+
+typedef struct {
+    TaskManager* manager;
+    volatile bool* running;
+    uint64_t ops;
+} RcuChurnArgs;
+
+static void* rcu_churn_thread(void* arg) {
+    RcuChurnArgs* args = arg;
+    uint64_t ops = 0;
+
+    while (*args->running) {
+        char name[64];
+        snprintf(name, sizeof(name), "churn_%lu", (unsigned long)(ops % 16));
+
+        TaskBase* task = bench_task_create(name);
+        task_manager_register(args->manager, task, name);
+        pthread_mutex_lock(&args->manager->mutex);
+        task_manager_publish_view(args->manager);
+        pthread_mutex_unlock(&args->manager->mutex);
+
+        task_manager_unregister(args->manager, name);
+        pthread_mutex_lock(&args->manager->mutex);
+        task_manager_publish_view(args->manager);
+        pthread_mutex_unlock(&args->manager->mutex);
+
+        bench_task_destroy(task);
+        ops++;
+    }
+
+    args->ops = ops;
+    return NULL;
+}
+
+static int bench_rcu(void) {
+    const int reader_counts[] = {1, 2, 4, 8};
+
+    TaskManager* manager = task_manager_create();
+    if (!manager) {
+        return 1;
+    }
+
+    TaskBase* tasks[RCU_BENCH_TASKS];
+    for (int i = 0; i < RCU_BENCH_TASKS; i++) {
+        char name[64];
+        snprintf(name, sizeof(name), "rcu_task_%d", i);
+        tasks[i] = bench_task_create(name);
+        task_manager_register(manager, tasks[i], name);
+    }
+
+    pthread_mutex_lock(&manager->mutex);
+    task_manager_publish_view(manager);
+    pthread_mutex_unlock(&manager->mutex);
+
+    printf("%-8s %-8s %16s %14s\n", "readers", "path", "queries(Mops/s)", "churn(ops/s)");
+
+    for (size_t r = 0; r < sizeof(reader_counts) / sizeof(reader_counts[0]); r++) {
+        for (int use_view = 0; use_view <= 1; use_view++) {
+            int reader_count = reader_counts[r];
+            volatile bool running = true;
+            pthread_t readers[8];
+            RcuReaderArgs reader_args[8];
+            pthread_t churn;
+            RcuChurnArgs churn_args = {manager, &running, 0};
+
+            for (int i = 0; i < reader_count; i++) {
+                reader_args[i] = (RcuReaderArgs){manager, use_view, &running, 0, (uint32_t)i + 1};
+                pthread_create(&readers[i], NULL, rcu_reader_thread, &reader_args[i]);
+            }
+            pthread_create(&churn, NULL, rcu_churn_thread, &churn_args);
+
+            sleep(RCU_BENCH_SECONDS);
+            running = false;
+
+            uint64_t total_ops = 0;
+            for (int i = 0; i < reader_count; i++) {
+                pthread_join(readers[i], NULL);
+                total_ops += reader_args[i].ops;
+            }
+            pthread_join(churn, NULL);
+
+            printf("%-8d %-8s %16.2f %14.0f\n", reader_count, use_view ? "view" : "locked",
+                   total_ops / 1e6 / RCU_BENCH_SECONDS,
+                   (double)churn_args.ops / RCU_BENCH_SECONDS);
+        }
+    }
+
+    task_manager_release_view(manager);
+    task_manager_destroy(manager);
+    for (int i = 0; i < RCU_BENCH_TASKS; i++) {
+        bench_task_destroy(tasks[i]);
+    }
+    return 0;
+}
+
+// ============================================================================
+// 执行模式: 每任务一线程 vs 工作窃取线程池
+// ============================================================================
+
+#define POOL_BENCH_TASKS 10000
+#define POOL_BENCH_ITERATIONS 100
+
+typedef struct {
+    TaskBase base;
+    uint32_t iterations;
+    uint64_t accumulator;
+} PoolBenchTask;
+
+static void pool_bench_work(PoolBenchTask* task) {
+    for (uint32_t i = 0; i < 1000; i++) {
+        task->accumulator += i * 2654435761u;
+    }
+}
+
+static int pool_bench_initialize(TaskBase* base) {
+    PoolBenchTask* task = TASK_CAST(PoolBenchTask, base);
+    task->iterations = 0;
+    task->accumulator = 0;
+    return 0;
+}
+
+static int pool_bench_execute(TaskBase* base) {
+    PoolBenchTask* task = TASK_CAST(PoolBenchTask, base);
+    while (!task_should_stop(base) && task->iterations < POOL_BENCH_ITERATIONS) {
+        pool_bench_work(task);
+        task->iterations++;
+        sched_yield();
+    }
+    return 0;
+}
+
+static int pool_bench_step(TaskBase* base) {
+    PoolBenchTask* task = TASK_CAST(PoolBenchTask, base);
+    pool_bench_work(task);
+    return ++task->iterations >= POOL_BENCH_ITERATIONS ? TASK_STEP_DONE : TASK_STEP_YIELD;
+}
+
+static const TaskInterface pool_bench_vtable = {
+    .initialize = pool_bench_initialize,
+    .execute = pool_bench_execute,
+    .step = pool_bench_step,
+};
+
+static int run_pool_bench(bool pooled) {
+    PoolBenchTask* tasks = calloc(POOL_BENCH_TASKS, sizeof(PoolBenchTask));
+    if (!tasks) {
+        return 1;
+    }
+
+    TaskConfig config;
+    memset(&config, 0, sizeof(config));
+    config.exec_mode = pooled ? TASK_EXEC_POOLED : TASK_EXEC_THREAD;
+
+    for (int i = 0; i < POOL_BENCH_TASKS; i++) {
+        snprintf(config.name, sizeof(config.name), "pool_task_%d", i);
+        task_base_init(&tasks[i].base, &pool_bench_vtable, &config);
+    }
+
+    TaskExecutor* executor = pooled ? task_executor_create(0) : NULL;
+    uint64_t rss_before = read_status_kb("VmRSS");
+    uint64_t switches_before = get_context_switches();
+    uint64_t start = get_monotonic_ns();
+
+    int started = 0;
+    for (int i = 0; i < POOL_BENCH_TASKS; i++) {
+        int ret = pooled ? task_executor_submit(executor, &tasks[i].base) : task_start(&tasks[i].base);
+        started += ret == 0;
+    }
+
+    // 等待全部完成，期间采样内存峰值
+    uint64_t rss_peak = read_status_kb("VmRSS");
+    for (;;) {
+        int finished = 0;
+        for (int i = 0; i < POOL_BENCH_TASKS; i++) {
+            TaskState state = task_get_state(&tasks[i].base);
+            finished += state == TASK_STATE_STOPPED || state == TASK_STATE_ERROR;
+        }
+        uint64_t rss = read_status_kb("VmRSS");
+        if (rss > rss_peak) {
+            rss_peak = rss;
+        }
+        if (finished >= started) {
+            break;
+        }
+        usleep(10000);
+    }
+
+    double elapsed_ms = (get_monotonic_ns() - start) / 1e6;
+    uint64_t switches = get_context_switches() - switches_before;
+
+    for (int i = 0; i < POOL_BENCH_TASKS; i++) {
+        if (!pooled) {
+            task_stop(&tasks[i].base);
+        }
+        task_base_destroy(&tasks[i].base);
+    }
+    task_executor_destroy(executor);
+    free(tasks);
+
+    printf("%-8s %8d %12.1f %14lu %16lu\n", pooled ? "pooled" : "thread", started, elapsed_ms,
+           (unsigned long)(rss_peak > rss_before ? rss_peak - rss_before : 0),
+           (unsigned long)switches);
+    return started == POOL_BENCH_TASKS ? 0 : 1;
+}
+
+static int bench_pool(void) {
+    printf("%d 个任务，每个执行 %d 步\n", POOL_BENCH_TASKS, POOL_BENCH_ITERATIONS);
+    printf("%-8s %8s %12s %14s %16s\n", "mode", "tasks", "elapsed(ms)", "rss_peak(KB)", "ctx_switches");
+    int failed = run_pool_bench(false);
+    failed += run_pool_bench(true);
+    return failed;
+}
+
+// ============================================================================
+// 分层时间轮: 插入/到期开销与定时服务抖动
+// ============================================================================
+
+#define TIMER_BENCH_TIMERS 100000
+#define TIMER_BENCH_SECONDS 3
+
+static void timer_bench_count(TimerWheelTimer* timer, void* user_data) {
+    (void)timer;
+    (*(uint64_t*)user_data)++;
+}
+
+static int bench_timer(void) {
+    TimerWheelTimer* timers = calloc(TIMER_BENCH_TIMERS, sizeof(TimerWheelTimer));
+    TimerWheel* wheel = malloc(sizeof(TimerWheel));
+    if (!timers || !wheel) {
+        free(timers);
+        free(wheel);
+        return 1;
+    }
+
+    // 纯数据结构开销: 随机到期时间(1ms~60s)
+    uint64_t fired_count = 0;
+    uint32_t seed = 1;
+    timer_wheel_init(wheel, 0);
+
+    uint64_t start = get_monotonic_ns();
+    for (int i = 0; i < TIMER_BENCH_TIMERS; i++) {
+        seed = seed * 1103515245u + 12345u;
+        timers[i].callback = timer_bench_count;
+        timers[i].user_data = &fired_count;
+        timer_wheel_add(wheel, &timers[i], 1 + (seed >> 8) % 60000);
+    }
+    double add_ns = (double)(get_monotonic_ns() - start) / TIMER_BENCH_TIMERS;
+
+    start = get_monotonic_ns();
+    uint32_t fired = timer_wheel_advance(wheel, 60000);
+    double expire_ns = (double)(get_monotonic_ns() - start) / (fired ? fired : 1);
+
+    printf("时间轮: %d 个定时器, 插入 %.1f ns/个, 推进60000 tick触发 %u 个, %.1f ns/个\n",
+           TIMER_BENCH_TIMERS, add_ns, fired, expire_ns);
+
+    // 定时服务抖动: 10万个周期定时器(50ms~1s)
+    memset(timers, 0, TIMER_BENCH_TIMERS * sizeof(TimerWheelTimer));
+    fired_count = 0;
+    TimerService* service = timer_service_create();
+    if (!service) {
+        free(timers);
+        free(wheel);
+        return 1;
+    }
+
+    for (int i = 0; i < TIMER_BENCH_TIMERS; i++) {
+        seed = seed * 1103515245u + 12345u;
+        uint32_t interval = 50 + (seed >> 8) % 951;
+        timer_service_arm(service, &timers[i], interval, interval, timer_bench_count, &fired_count);
+    }
+
+    sleep(TIMER_BENCH_SECONDS);
+
+    TimerServiceStats stats;
+    timer_service_get_stats(service, &stats);
+    for (int i = 0; i < TIMER_BENCH_TIMERS; i++) {
+        timer_service_cancel(service, &timers[i]);
+    }
+    timer_service_destroy(service);
+
+    printf("定时服务: 已挂入 %u, %d 秒内触发 %lu 次, 唤醒 %lu 次, 平均延迟 %.1f us, 最大延迟 %.1f us\n",
+           stats.armed_timers, TIMER_BENCH_SECONDS, (unsigned long)stats.fired,
+           (unsigned long)stats.wakeups,
+           stats.fired ? stats.total_lateness_ns / 1e3 / stats.fired : 0.0,
+           stats.max_lateness_ns / 1e3);
+
+    free(timers);
+    free(wheel);
+    return 0;
+}
+
+// ============================================================================
+// 优先级: 低优先级任务占满CPU时关键任务的唤醒延迟
+// ============================================================================
+
+#define PRIORITY_BENCH_SAMPLES 500
+#define PRIORITY_BENCH_PERIOD_US 2000
+#define PRIORITY_BENCH_SPIN_NS 200000
+
+typedef struct {
+    TaskBase base;
+    uint64_t wake_ns;                  // 唤醒时刻(探针任务)
+    uint64_t* samples;
+    uint32_t sample_count;
+} PriorityBenchTask;
+
+static int compare_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return x < y ? -1 : x > y;
+}
+
+static void spin_for_ns(uint64_t duration_ns) {
+    uint64_t end = get_monotonic_ns() + duration_ns;
+    while (get_monotonic_ns() < end) {
+    }
+}
+
+static int priority_background_step(TaskBase* base) {
+    (void)base;
+    spin_for_ns(PRIORITY_BENCH_SPIN_NS);
+    return TASK_STEP_YIELD;
+}
+
+static int priority_probe_step(TaskBase* base) {
+    PriorityBenchTask* task = TASK_CAST(PriorityBenchTask, base);
+    uint64_t wake_ns = __atomic_exchange_n(&task->wake_ns, 0, __ATOMIC_ACQ_REL);
+    if (wake_ns && task->sample_count < PRIORITY_BENCH_SAMPLES) {
+        task->samples[task->sample_count] = get_monotonic_ns() - wake_ns;
+        __atomic_store_n(&task->sample_count, task->sample_count + 1, __ATOMIC_RELEASE);
+    }
+    return TASK_STEP_WAIT;
+}
+
+static int priority_bench_initialize(TaskBase* base) {
+    (void)base;
+    return 0;
+}
+
+static const TaskInterface priority_background_vtable = {
+    .initialize = priority_bench_initialize,
+    .step = priority_background_step,
+};
+
+static const TaskInterface priority_probe_vtable = {
+    .initialize = priority_bench_initialize,
+    .step = priority_probe_step,
+};
+
+static void print_latency_row(const char* mode, const char* probe, uint64_t* samples, uint32_t count) {
+    if (count == 0) {
+        printf("%-8s %-20s %8s\n", mode, probe, "-");
+        return;
+    }
+
+    qsort(samples, count, sizeof(uint64_t), compare_u64);
+    printf("%-8s %-20s %8u %10.1f %10.1f %10.1f\n", mode, probe, count,
+           samples[count / 2] / 1e3, samples[count * 99 / 100] / 1e3, samples[count - 1] / 1e3);
+}
+
+static int run_priority_pooled(TaskPriority probe_priority) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int background_count = (cpus > 0 ? (int)cpus : 1) * 4;
+
+    PriorityBenchTask* tasks = calloc(background_count + 1, sizeof(PriorityBenchTask));
+    uint64_t* samples = calloc(PRIORITY_BENCH_SAMPLES, sizeof(uint64_t));
+    if (!tasks || !samples) {
+        free(tasks);
+        free(samples);
+        return 1;
+    }
+
+    TaskConfig config;
+    memset(&config, 0, sizeof(config));
+    config.exec_mode = TASK_EXEC_POOLED;
+    config.priority = TASK_PRIORITY_LOW;
+    for (int i = 0; i < background_count; i++) {
+        snprintf(config.name, sizeof(config.name), "background_%d", i);
+        task_base_init(&tasks[i].base, &priority_background_vtable, &config);
+    }
+
+    PriorityBenchTask* probe = &tasks[background_count];
+    snprintf(config.name, sizeof(config.name), "probe");
+    config.priority = probe_priority;
+    task_base_init(&probe->base, &priority_probe_vtable, &config);
+    probe->samples = samples;
+
+    TaskExecutor* executor = task_executor_create(0);
+    for (int i = 0; i <= background_count; i++) {
+        task_executor_submit(executor, &tasks[i].base);
+    }
+
+    for (int i = 0; i < PRIORITY_BENCH_SAMPLES; i++) {
+        usleep(PRIORITY_BENCH_PERIOD_US);
+        uint32_t expected = __atomic_load_n(&probe->sample_count, __ATOMIC_ACQUIRE) + 1;
+        __atomic_store_n(&probe->wake_ns, get_monotonic_ns(), __ATOMIC_RELEASE);
+        task_executor_wake(&probe->base);
+
+        uint64_t deadline = get_monotonic_ns() + 1000000000ULL;
+        while (__atomic_load_n(&probe->sample_count, __ATOMIC_ACQUIRE) < expected &&
+               get_monotonic_ns() < deadline) {
+            usleep(50);
+        }
+    }
+
+    TaskExecutorStats stats;
+    task_executor_get_stats(executor, &stats);
+
+    for (int i = 0; i <= background_count; i++) {
+        task_executor_stop_task(&tasks[i].base);
+        task_base_destroy(&tasks[i].base);
+    }
+    task_executor_destroy(executor);
+
+    char label[64];
+    snprintf(label, sizeof(label), "%s (bg %d)", probe_priority == TASK_PRIORITY_CRITICAL ? "CRITICAL" : "LOW",
+             background_count);
+    print_latency_row("pooled", label, samples, probe->sample_count);
+    printf("%-8s   LOW steps %lu, CRITICAL steps %lu\n", "",
+           (unsigned long)stats.priority_steps[TASK_PRIORITY_LOW],
+           (unsigned long)stats.priority_steps[TASK_PRIORITY_CRITICAL]);
+
+    free(samples);
+    free(tasks);
+    return 0;
+}
+
+typedef struct {
+    TaskPriority priority;
+    bool stop;
+} PrioritySpinner;
+
+static void* priority_spinner_thread(void* arg) {
+    PrioritySpinner* spinner = arg;
+    task_sched_apply_current(spinner->priority);
+    while (!__atomic_load_n(&spinner->stop, __ATOMIC_RELAXED)) {
+        spin_for_ns(PRIORITY_BENCH_SPIN_NS);
+    }
+    return NULL;
+}
+
+typedef struct {
+    TaskPriority priority;
+    TaskSchedClass applied;
+    uint64_t* samples;
+} PrioritySleeper;
+
+static void* priority_sleeper_thread(void* arg) {
+    PrioritySleeper* sleeper = arg;
+    sleeper->applied = task_sched_apply_current(sleeper->priority);
+
+    struct timespec next;
+    clock_gettime(CLOCK_MONOTONIC, &next);
+    for (int i = 0; i < PRIORITY_BENCH_SAMPLES; i++) {
+        next.tv_nsec += PRIORITY_BENCH_PERIOD_US * 1000L;
+        if (next.tv_nsec >= 1000000000L) {
+            next.tv_sec++;
+            next.tv_nsec -= 1000000000L;
+        }
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+        uint64_t due = (uint64_t)next.tv_sec * 1000000000ULL + next.tv_nsec;
+        uint64_t now = get_monotonic_ns();
+        sleeper->samples[i] = now > due ? now - due : 0;
+    }
+    return NULL;
+}
+
+static int run_priority_threads(TaskPriority background_priority, TaskPriority probe_priority) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int spinner_count = cpus > 0 ? (int)cpus : 1;
+
+    pthread_t* threads = calloc(spinner_count, sizeof(pthread_t));
+    uint64_t* samples = calloc(PRIORITY_BENCH_SAMPLES, sizeof(uint64_t));
+    if (!threads || !samples) {
+        free(threads);
+        free(samples);
+        return 1;
+    }
+
+    PrioritySpinner spinner = { .priority = background_priority, .stop = false };
+    for (int i = 0; i < spinner_count; i++) {
+        pthread_create(&threads[i], NULL, priority_spinner_thread, &spinner);
+    }
+
+    PrioritySleeper sleeper = { .priority = probe_priority, .samples = samples };
+    pthread_t sleeper_thread;
+    pthread_create(&sleeper_thread, NULL, priority_sleeper_thread, &sleeper);
+    pthread_join(sleeper_thread, NULL);
+
+    __atomic_store_n(&spinner.stop, true, __ATOMIC_RELAXED);
+    for (int i = 0; i < spinner_count; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    char label[64];
+    snprintf(label, sizeof(label), "%s", task_sched_class_name(sleeper.applied));
+    print_latency_row("thread", label, samples, PRIORITY_BENCH_SAMPLES);
+
+    free(samples);
+    free(threads);
+    return 0;
+}
+
+static int bench_priority(void) {
+    printf("池化: 探针任务每 %d us 被唤醒一次，后台LOW任务每步忙等 %d us\n",
+           PRIORITY_BENCH_PERIOD_US, PRIORITY_BENCH_SPIN_NS / 1000);
+    printf("%-8s %-20s %8s %10s %10s %10s\n", "mode", "probe", "samples", "p50(us)", "p99(us)", "max(us)");
+    int failed = run_priority_pooled(TASK_PRIORITY_LOW);
+    failed += run_priority_pooled(TASK_PRIORITY_CRITICAL);
+
+    printf("线程: 每核一个忙等线程，探针线程每 %d us 定时醒来(统计超时量)\n", PRIORITY_BENCH_PERIOD_US);
+    printf("%-8s %-20s %8s %10s %10s %10s\n", "mode", "probe", "samples", "p50(us)", "p99(us)", "max(us)");
+    failed += run_priority_threads(TASK_PRIORITY_NORMAL, TASK_PRIORITY_NORMAL);
+    failed += run_priority_threads(TASK_PRIORITY_LOW, TASK_PRIORITY_CRITICAL);
+    return failed;
+}
+
+// ============================================================================
+// 资源采样: 每任务一个线程时批量采样的开销
+// ============================================================================
+
+#define ACCOUNTING_BENCH_STACK_SIZE (64 * 1024)
+#define ACCOUNTING_BENCH_SPIN_NS 100000
+
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    uint32_t attached;
+    bool stop;
+} AccountingBenchGate;
+
+typedef struct {
+    TaskBase base;
+    AccountingBenchGate* gate;
+} AccountingBenchTask;
+
+/**
+ * 模拟独占线程任务: 记录tid、消耗少量CPU后阻塞到测量结束
+ */
+static void* accounting_bench_thread(void* arg) {
+    AccountingBenchTask* task = arg;
+    AccountingBenchGate* gate = task->gate;
+
+    task_accounting_attach_thread(&task->base);
+    spin_for_ns(ACCOUNTING_BENCH_SPIN_NS);
+
+    pthread_mutex_lock(&gate->mutex);
+    gate->attached++;
+    pthread_cond_broadcast(&gate->cond);
+    while (!gate->stop) {
+        pthread_cond_wait(&gate->cond, &gate->mutex);
+    }
+    pthread_mutex_unlock(&gate->mutex);
+    return NULL;
+}
+
+/**
+ * 多次批量采样，返回每批的平均耗时(纳秒)
+ */
+static uint64_t time_accounting_batches(TaskManager* manager, uint32_t flags, int rounds,
+                                        TaskAccountingSummary* summary) {
+    uint64_t total = 0;
+    for (int i = 0; i < rounds; i++) {
+        task_manager_sample_accounting(manager, flags, summary);
+        total += summary->elapsed_ns;
+    }
+    return total / rounds;
+}
+
+static int run_accounting_bench(uint32_t task_count) {
+    AccountingBenchGate gate = {0};
+    pthread_mutex_init(&gate.mutex, NULL);
+    pthread_cond_init(&gate.cond, NULL);
+
+    TaskManager* manager = task_manager_create();
+    AccountingBenchTask* tasks = calloc(task_count, sizeof(AccountingBenchTask));
+    pthread_t* threads = calloc(task_count, sizeof(pthread_t));
+    if (!manager || !tasks || !threads) {
+        task_manager_destroy(manager);
+        free(tasks);
+        free(threads);
+        return 1;
+    }
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, ACCOUNTING_BENCH_STACK_SIZE);
+
+    TaskConfig config;
+    memset(&config, 0, sizeof(config));
+    config.enable_stats = true;
+
+    uint32_t started = 0;
+    for (uint32_t i = 0; i < task_count; i++) {
+        snprintf(config.name, sizeof(config.name), "acct_task_%u", i);
+        task_base_init(&tasks[i].base, &bench_task_vtable, &config);
+        tasks[i].base.state = TASK_STATE_RUNNING;
+        tasks[i].gate = &gate;
+        task_manager_register(manager, &tasks[i].base, config.name);
+
+        if (pthread_create(&threads[i], &attr, accounting_bench_thread, &tasks[i]) != 0) {
+            break;
+        }
+        started++;
+    }
+    pthread_attr_destroy(&attr);
+
+    pthread_mutex_lock(&gate.mutex);
+    while (gate.attached < started) {
+        pthread_cond_wait(&gate.cond, &gate.mutex);
+    }
+    pthread_mutex_unlock(&gate.mutex);
+
+    pthread_mutex_lock(&manager->mutex);
+    task_manager_publish_view(manager);
+    pthread_mutex_unlock(&manager->mutex);
+
+    int rounds = task_count >= 10000 ? 5 : 20;
+    TaskAccountingSummary summary;
+    struct {
+        const char* name;
+        uint32_t flags;
+    } modes[] = {
+        {"cpu", TASK_ACCOUNTING_CPU},
+        {"cpu+proc", TASK_ACCOUNTING_ALL},
+    };
+
+    for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++) {
+        uint64_t batch_ns = time_accounting_batches(manager, modes[m].flags, rounds, &summary);
+        printf("%-8u %-10s %8u %12.2f %12.2f\n", task_count, modes[m].name, summary.sampled,
+               batch_ns / 1e6, summary.sampled ? (double)batch_ns / summary.sampled / 1e3 : 0.0);
+    }
+
+    uint64_t cpu_total = 0;
+    for (uint32_t i = 0; i < started; i++) {
+        cpu_total += tasks[i].base.stats.cpu_time_ns;
+    }
+    printf("%-8s 线程 %u 个, 采得CPU时间合计 %.1f ms, 进程常驻内存 %llu KB\n", "", started,
+           cpu_total / 1e6, (unsigned long long)(summary.process_rss / 1024));
+
+    pthread_mutex_lock(&gate.mutex);
+    gate.stop = true;
+    pthread_cond_broadcast(&gate.cond);
+    pthread_mutex_unlock(&gate.mutex);
+    for (uint32_t i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    task_manager_release_view(manager);
+    for (uint32_t i = 0; i < task_count; i++) {
+        task_manager_unregister(manager, tasks[i].base.config.name);
+        task_base_destroy(&tasks[i].base);
+    }
+    task_manager_destroy(manager);
+    pthread_mutex_destroy(&gate.mutex);
+    pthread_cond_destroy(&gate.cond);
+    free(threads);
+    free(tasks);
+    return started == task_count ? 0 : 1;
+}
+
+static int bench_accounting(void) {
+    printf("%-8s %-10s %8s %12s %12s\n", "tasks", "sample", "sampled", "batch(ms)", "per-task(us)");
+    int failed = run_accounting_bench(1000);
+    failed += run_accounting_bench(10000);
+    return failed;
+}
+
+// ============================================================================
+// 耗时直方图: 记录开销与合并开销
+// ============================================================================
+
+#define LATENCY_BENCH_RECORDS 10000000
+#define LATENCY_BENCH_TASKS 1000
+
+static int bench_latency(void) {
+    TaskConfig config;
+    memset(&config, 0, sizeof(config));
+    snprintf(config.name, sizeof(config.name), "latency_task");
+
+    TaskBase task;
+    task_base_init(&task, &bench_task_vtable, &config);
+
+    // 预生成跨多个数量级的样本，避免随机数生成计入开销
+    uint64_t* values = malloc(4096 * sizeof(uint64_t));
+    if (!values) {
+        task_base_destroy(&task);
+        return 1;
+    }
+    uint32_t seed = 1;
+    for (int i = 0; i < 4096; i++) {
+        seed = seed * 1103515245u + 12345u;
+        values[i] = (uint64_t)((seed >> 8) & 0xffff) << ((seed >> 4) % 20);
+    }
+
+    printf("%-24s %12s\n", "operation", "ns/op");
+
+    uint64_t start = get_monotonic_ns();
+    for (int i = 0; i < LATENCY_BENCH_RECORDS; i++) {
+        task_latency_record(&task, values[i & 4095]);
+    }
+    printf("%-24s %12.1f\n", "record", (double)(get_monotonic_ns() - start) / LATENCY_BENCH_RECORDS);
+
+    start = get_monotonic_ns();
+    for (int i = 0; i < LATENCY_BENCH_RECORDS; i++) {
+        uint64_t begin = task_latency_begin();
+        task_latency_end(&task, begin);
+    }
+    printf("%-24s %12.1f\n", "begin+end", (double)(get_monotonic_ns() - start) / LATENCY_BENCH_RECORDS);
+
+    LatencyHistogram* snapshot = malloc(sizeof(LatencyHistogram));
+    LatencyHistogram* merged = malloc(sizeof(LatencyHistogram));
+    if (!snapshot || !merged) {
+        free(snapshot);
+        free(merged);
+        free(values);
+        task_latency_release(&task);
+        task_base_destroy(&task);
+        return 1;
+    }
+
+    start = get_monotonic_ns();
+    latency_histogram_reset(merged);
+    for (int i = 0; i < LATENCY_BENCH_TASKS; i++) {
+        task_latency_snapshot(&task, snapshot);
+        latency_histogram_merge(merged, snapshot);
+    }
+    printf("%-24s %12.1f\n", "snapshot+merge", (double)(get_monotonic_ns() - start) / LATENCY_BENCH_TASKS);
+
+    LatencySummary summary;
+    start = get_monotonic_ns();
+    latency_histogram_summarize(merged, &summary);
+    printf("%-24s %12.1f\n", "summarize", (double)(get_monotonic_ns() - start));
+    printf("合并 %d 个任务: %llu 个样本, p50 %.1fus, p99 %.1fus, p999 %.1fus, max %.1fus\n",
+           LATENCY_BENCH_TASKS, (unsigned long long)summary.count, summary.p50_ns / 1e3,
+           summary.p99_ns / 1e3, summary.p999_ns / 1e3, summary.max_ns / 1e3);
+
+    free(snapshot);
+    free(merged);
+    free(values);
+    task_latency_release(&task);
+    task_base_destroy(&task);
+    return 0;
+}
+
+// ============================================================================
+// 统计快照: 读者加锁 vs 顺序锁
+// ============================================================================
+
+#define STATS_BENCH_SECONDS 1
+
+typedef struct {
+    TaskBase* task;
+    volatile bool* running;
+    uint64_t updates;
+} StatsWriterArgs;
+
+typedef struct {
+    TaskBase* task;
+    bool use_seqlock;
+    volatile bool* running;
+    uint64_t reads;
+    uint64_t torn;
+} StatsReaderArgs;
+
+/**
+ * 模拟任务线程: 每次更新同时改多个字段，读者据此检查一致性
+ */
+static void* stats_writer_thread(void* arg) {
+    StatsWriterArgs* args = arg;
+    TaskBase* task = args->task;
+    uint64_t updates = 0;
+
+    while (*args->running) {
+        task_stats_write_begin(task);
+        task->stats.execution_count++;
+        task->stats.total_run_time = task->stats.execution_count;
+        task->stats.last_heartbeat = task->stats.execution_count * 3;
+        task->stats.cpu_time_ns = task->stats.execution_count * 7;
+        task_stats_write_end(task);
+        updates++;
+    }
+
+    args->updates = updates;
+    return NULL;
+}
+
+static void* stats_reader_thread(void* arg) {
+    StatsReaderArgs* args = arg;
+    TaskStats stats;
+    uint64_t reads = 0;
+    uint64_t torn = 0;
+
+    while (*args->running) {
+        if (args->use_seqlock) {
+            task_stats_snapshot(args->task, &stats);
+        } else {
+            pthread_mutex_lock(&args->task->mutex);
+            stats = args->task->stats;
+            pthread_mutex_unlock(&args->task->mutex);
+        }
+
+        uint64_t count = stats.execution_count;
+        if (stats.total_run_time != count || stats.last_heartbeat != count * 3 ||
+            stats.cpu_time_ns != count * 7) {
+            torn++;
+        }
+        reads++;
+    }
+
+    args->reads = reads;
+    args->torn = torn;
+    return NULL;
+}
+
+static int bench_stats(void) {
+    const int reader_counts[] = {0, 1, 2, 4};
+
+    TaskConfig config;
+    memset(&config, 0, sizeof(config));
+    snprintf(config.name, sizeof(config.name), "stats_task");
+
+    TaskBase task;
+    if (task_base_init(&task, &bench_task_vtable, &config) != 0) {
+        return 1;
+    }
+
+    printf("%-8s %-8s %16s %16s %8s\n", "readers", "read", "updates(M/s)", "reads(M/s)", "torn");
+
+    for (size_t r = 0; r < sizeof(reader_counts) / sizeof(reader_counts[0]); r++) {
+        for (int use_seqlock = 0; use_seqlock <= 1; use_seqlock++) {
+            int reader_count = reader_counts[r];
+            if (reader_count == 0 && use_seqlock) {
+                continue;
+            }
+
+            volatile bool running = true;
+            pthread_t writer;
+            StatsWriterArgs writer_args = {&task, &running, 0};
+            pthread_t readers[4];
+            StatsReaderArgs reader_args[4];
+
+            pthread_create(&writer, NULL, stats_writer_thread, &writer_args);
+            for (int i = 0; i < reader_count; i++) {
+                reader_args[i] = (StatsReaderArgs){&task, use_seqlock, &running, 0, 0};
+                pthread_create(&readers[i], NULL, stats_reader_thread, &reader_args[i]);
+            }
+
+            sleep(STATS_BENCH_SECONDS);
+            running = false;
+
+            uint64_t reads = 0, torn = 0;
+            pthread_join(writer, NULL);
+            for (int i = 0; i < reader_count; i++) {
+                pthread_join(readers[i], NULL);
+                reads += reader_args[i].reads;
+                torn += reader_args[i].torn;
+            }
+
+            printf("%-8d %-8s %16.2f %16.2f %8llu\n", reader_count,
+                   reader_count == 0 ? "-" : use_seqlock ? "seqlock" : "mutex",
+                   writer_args.updates / 1e6 / STATS_BENCH_SECONDS,
+                   reads / 1e6 / STATS_BENCH_SECONDS, (unsigned long long)torn);
+        }
+    }
+
+    task_base_destroy(&task);
+    return 0;
+}
+
+// ============================================================================
+// 停靠: sleep轮询 vs futex停靠的停止延迟与空闲唤醒
+// ============================================================================
+
+#define PARK_BENCH_TASKS 100
+#define PARK_BENCH_POLL_MS 100
+#define PARK_BENCH_IDLE_SECONDS 1
+
+typedef struct {
+    TaskBase base;
+    bool use_park;
+    uint64_t stopped_ns;               // 任务线程发现停止请求的时刻
+} ParkBenchTask;
+
+static void* park_bench_thread(void* arg) {
+    ParkBenchTask* task = arg;
+
+    if (task->use_park) {
+        while (task_park(&task->base, TASK_PARK_FOREVER) != TASK_PARK_STOPPED) {
+        }
+    } else {
+        while (!task_should_stop(&task->base)) {
+            usleep(PARK_BENCH_POLL_MS * 1000);
+        }
+    }
+
+    task->stopped_ns = get_monotonic_ns();
+    return NULL;
+}
+
+static int run_park_bench(bool use_park) {
+    ParkBenchTask* tasks = calloc(PARK_BENCH_TASKS, sizeof(ParkBenchTask));
+    pthread_t* threads = calloc(PARK_BENCH_TASKS, sizeof(pthread_t));
+    if (!tasks || !threads) {
+        free(tasks);
+        free(threads);
+        return 1;
+    }
+
+    TaskConfig config;
+    memset(&config, 0, sizeof(config));
+    for (int i = 0; i < PARK_BENCH_TASKS; i++) {
+        snprintf(config.name, sizeof(config.name), "park_task_%d", i);
+        task_base_init(&tasks[i].base, &bench_task_vtable, &config);
+        tasks[i].use_park = use_park;
+        pthread_create(&threads[i], NULL, park_bench_thread, &tasks[i]);
+    }
+
+    // 等线程进入空闲状态后统计空闲期间的上下文切换
+    usleep(100 * 1000);
+    uint64_t switches_before = get_context_switches();
+    sleep(PARK_BENCH_IDLE_SECONDS);
+    uint64_t idle_switches = get_context_switches() - switches_before;
+
+    uint64_t request_ns = get_monotonic_ns();
+    for (int i = 0; i < PARK_BENCH_TASKS; i++) {
+        if (use_park) {
+            task_request_stop(&tasks[i].base);
+        } else {
+            pthread_mutex_lock(&tasks[i].base.mutex);
+            tasks[i].base.should_stop = true;
+            pthread_mutex_unlock(&tasks[i].base.mutex);
+        }
+    }
+
+    uint64_t total_latency = 0;
+    uint64_t max_latency = 0;
+    for (int i = 0; i < PARK_BENCH_TASKS; i++) {
+        pthread_join(threads[i], NULL);
+        uint64_t latency = tasks[i].stopped_ns > request_ns ? tasks[i].stopped_ns - request_ns : 0;
+        total_latency += latency;
+        if (latency > max_latency) {
+            max_latency = latency;
+        }
+        task_base_destroy(&tasks[i].base);
+    }
+
+    printf("%-10s %8d %16.1f %16.1f %16.1f\n", use_park ? "park" : "poll", PARK_BENCH_TASKS,
+           (double)idle_switches / PARK_BENCH_IDLE_SECONDS,
+           total_latency / 1e3 / PARK_BENCH_TASKS, max_latency / 1e3);
+
+    free(threads);
+    free(tasks);
+    return 0;
+}
+
+static int bench_park(void) {
+    printf("poll: 每 %d ms 检查一次停止标志; park: task_park无限期停靠\n", PARK_BENCH_POLL_MS);
+    printf("%-10s %8s %16s %16s %16s\n", "mode", "tasks", "idle-wakeups/s", "stop-mean(us)", "stop-max(us)");
+    int failed = run_park_bench(false);
+    failed += run_park_bench(true);
+    return failed;
+}
+
+// ============================================================================
+// 启动图: 按注册顺序串行启动 vs 按依赖拓扑并发启动
+// ============================================================================
+
+#define STARTUP_BENCH_LAYERS 4
+#define STARTUP_BENCH_WIDTH 8
+#define STARTUP_BENCH_NODES (STARTUP_BENCH_LAYERS * STARTUP_BENCH_WIDTH)
+#define STARTUP_BENCH_START_MS 5
+#define STARTUP_BENCH_SLOW_NODE (STARTUP_BENCH_WIDTH + 2)  // 第1层的一个节点启动慢4倍
+
+static uint32_t g_startup_ready[STARTUP_BENCH_NODES];
+
+static int startup_bench_start(void* target, const char* name) {
+    (void)target;
+    uint32_t index = (uint32_t)atoi(name + 4);
+    uint32_t cost_ms = index == STARTUP_BENCH_SLOW_NODE ? STARTUP_BENCH_START_MS * 4 : STARTUP_BENCH_START_MS;
+    usleep(cost_ms * 1000);
+    __atomic_store_n(&g_startup_ready[index], 1, __ATOMIC_RELEASE);
+    return 0;
+}
+
+static bool startup_bench_probe(void* target, const char* name) {
+    (void)target;
+    return __atomic_load_n(&g_startup_ready[atoi(name + 4)], __ATOMIC_ACQUIRE) != 0;
+}
+
+static int run_startup_bench(const char* mode, uint32_t max_parallel, const StartupNode* nodes) {
+    memset(g_startup_ready, 0, sizeof(g_startup_ready));
+
+    StartupOptions options = { .max_parallel = max_parallel, .ready_timeout_ms = 1000, .poll_ms = 0 };
+    StartupReport report;
+    int failed = startup_graph_run(NULL, nodes, STARTUP_BENCH_NODES, startup_bench_start,
+                                   startup_bench_probe, &options, &report);
+    if (failed != 0) {
+        startup_report_free(&report);
+        return 1;
+    }
+
+    printf("%-10s %8u %8u %12.1f   ", mode, report.count, report.wave_count, report.total_us / 1000.0);
+    for (uint32_t i = 0; i < report.critical_path_length; i++) {
+        const StartupEntry* entry = &report.entries[report.critical_path[i]];
+        printf("%s%s", i ? " -> " : "", entry->name);
+    }
+    printf("\n");
+
+    startup_report_free(&report);
+    return 0;
+}
+
+static int bench_startup(void) {
+    // 分层依赖: 每个节点依赖上一层的两个节点
+    StartupNode* nodes = calloc(STARTUP_BENCH_NODES, sizeof(StartupNode));
+    if (!nodes) {
+        return 1;
+    }
+    for (uint32_t layer = 0; layer < STARTUP_BENCH_LAYERS; layer++) {
+        for (uint32_t w = 0; w < STARTUP_BENCH_WIDTH; w++) {
+            StartupNode* node = &nodes[layer * STARTUP_BENCH_WIDTH + w];
+            snprintf(node->name, sizeof(node->name), "svc_%02u", layer * STARTUP_BENCH_WIDTH + w);
+            if (layer > 0) {
+                uint32_t base = (layer - 1) * STARTUP_BENCH_WIDTH;
+                snprintf(node->depends_on[0], 64, "svc_%02u", base + w);
+                snprintf(node->depends_on[1], 64, "svc_%02u", base + (w + 3) % STARTUP_BENCH_WIDTH);
+                node->dependency_count = 2;
+            }
+        }
+    }
+
+    printf("%d 层 x %d 个服务，每个启动 %d ms(svc_%02d 为 %d ms)\n", STARTUP_BENCH_LAYERS, STARTUP_BENCH_WIDTH,
+           STARTUP_BENCH_START_MS, STARTUP_BENCH_SLOW_NODE, STARTUP_BENCH_START_MS * 4);
+    printf("%-10s %8s %8s %12s   %s\n", "mode", "nodes", "waves", "total(ms)", "critical path");
+    int failed = run_startup_bench("serial", 1, nodes);
+    failed += run_startup_bench("ordered", 0, nodes);
+
+    free(nodes);
+    return failed;
+}
+
+// ============================================================================
+// 重启策略: 立即重启+固定次数 vs 退避+滑动窗口预算(模拟时钟)
+// ============================================================================
+
+#define RESTART_BENCH_TICK_MS 100           // 监控周期
+#define RESTART_BENCH_CRASH_AFTER_MS 50     // 故障期间每次启动后多久崩溃
+#define RESTART_BENCH_FAULT_SECONDS 120     // 故障持续时间
+#define RESTART_BENCH_SECONDS 300           // 模拟总时长
+#define RESTART_BENCH_MAX_RESTARTS 5
+
+static void run_restart_bench(const char* mode, const RestartPolicy* policy) {
+    const uint64_t ms = 1000000ULL;
+    RestartPolicy effective;
+    RestartState state;
+    if (policy) {
+        effective = *policy;
+        restart_policy_normalize(&effective, RESTART_BENCH_MAX_RESTARTS);
+    }
+    restart_state_init(&state, 12345);
+
+    bool running = true;
+    uint64_t started = 0;
+    uint32_t restarts = 0, early_restarts = 0;
+    uint64_t recovered_ms = 0;
+    uint64_t fault_end = (uint64_t)RESTART_BENCH_FAULT_SECONDS * 1000 * ms;
+
+    // 从1开始计时，0在重启状态中表示"未知"
+    for (uint64_t now = ms; now <= (uint64_t)RESTART_BENCH_SECONDS * 1000 * ms; now += RESTART_BENCH_TICK_MS * ms) {
+        if (running && now < fault_end && now - started >= RESTART_BENCH_CRASH_AFTER_MS * ms) {
+            running = false;
+        }
+
+        bool restart = false;
+        if (!running) {
+            if (!policy) {
+                restart = restarts < RESTART_BENCH_MAX_RESTARTS;
+            } else {
+                restart_state_schedule(&state, &effective, now);
+                restart = restart_state_due(&state, now);
+            }
+        } else if (policy) {
+            restart_state_mark_running(&state, &effective, now);
+        }
+
+        if (restart) {
+            if (policy) {
+                restart_state_restarted(&state, now);
+            }
+            running = true;
+            started = now;
+            restarts++;
+            early_restarts += now <= 1000 * ms;
+            if (now >= fault_end && recovered_ms == 0) {
+                recovered_ms = now / ms;
+            }
+        }
+    }
+
+    char recovered[32] = "never";
+    if (recovered_ms) {
+        snprintf(recovered, sizeof(recovered), "%.1f s", recovered_ms / 1000.0);
+    }
+    printf("%-10s %16u %16u %18s %12s\n", mode, early_restarts, restarts, recovered,
+           policy && state.crash_loop ? "crash-loop" : "-");
+}
+
+static int bench_restart(void) {
+    printf("故障持续 %d 秒(每次启动 %d ms后崩溃)，监控周期 %d ms，模拟 %d 秒，预算 %d 次\n",
+           RESTART_BENCH_FAULT_SECONDS, RESTART_BENCH_CRASH_AFTER_MS, RESTART_BENCH_TICK_MS,
+           RESTART_BENCH_SECONDS, RESTART_BENCH_MAX_RESTARTS);
+    printf("%-10s %16s %16s %18s %12s\n", "mode", "restarts(0-1s)", "restarts(total)", "back after fault", "final");
+
+    run_restart_bench("immediate", NULL);
+
+    RestartPolicy policy = { .jitter_percent = 20 };
+    run_restart_bench("policy", &policy);
+    return 0;
+}
+
+// ============================================================================
+// 分配: 逐个malloc vs 块分配器与任务分配区(监控扫描耗时)
+// ============================================================================
+
+#define SLAB_BENCH_TASKS 50000
+#define SLAB_BENCH_SCANS 5
+#define SLAB_BENCH_EVICT_BYTES (64 * 1024 * 1024)
+
+typedef struct {
+    TaskBase base;
+    char payload[256];                 // 包装器中的插件私有数据
+} SlabBenchTask;
+
+TAILQ_HEAD(SlabBenchList, TaskNode);
+
+static volatile uint64_t g_slab_bench_sink;
+
+/**
+ * 模拟监控扫描: 沿链表读取每个任务的状态、心跳和重启配置
+ */
+static uint64_t slab_bench_scan(struct SlabBenchList* list) {
+    uint64_t sum = 0;
+    TaskNode* node;
+    TAILQ_FOREACH(node, list, entries) {
+        TaskBase* task = node->task;
+        sum += (uint64_t)task->state + task->stats.last_heartbeat + task->config.auto_restart +
+               (uint64_t)node->name[0];
+    }
+    return sum;
+}
+
+/**
+ * 写一遍大缓冲区，把链表和任务挤出缓存
+ */
+static void slab_bench_evict(char* buffer) {
+    for (size_t i = 0; i < SLAB_BENCH_EVICT_BYTES; i += 64) {
+        buffer[i]++;
+    }
+}
+
+static int run_slab_bench(bool use_arena, char* evict_buffer) {
+    // 注册期间穿插其他分配(自定义配置副本、直方图等)，与实际进程的堆布局相近
+    void** noise = calloc(SLAB_BENCH_TASKS, sizeof(void*));
+    if (!noise) {
+        return 1;
+    }
+
+    TaskArena* arena = use_arena ? task_arena_create(sizeof(TaskNode)) : NULL;
+    if (use_arena && !arena) {
+        free(noise);
+        return 1;
+    }
+
+    struct SlabBenchList list = TAILQ_HEAD_INITIALIZER(list);
+    uint64_t allocations = 0;
+    uint64_t start = get_monotonic_ns();
+    srand(7);
+
+    for (uint32_t i = 0; i < SLAB_BENCH_TASKS; i++) {
+        TaskNode* node;
+        SlabBenchTask* task;
+        if (use_arena) {
+            node = slab_alloc(&arena->nodes);
+            task = task_object_alloc(arena, sizeof(SlabBenchTask));
+        } else {
+            node = calloc(1, sizeof(TaskNode));
+            task = calloc(1, sizeof(SlabBenchTask));
+            allocations += 2;
+        }
+        noise[i] = malloc(32 + rand() % 480);
+        if (!node || !task) {
+            return 1;
+        }
+
+        task->base.state = TASK_STATE_RUNNING;
+        task->base.arena = arena;
+        node->task = &task->base;
+        snprintf(node->name, sizeof(node->name), "slab_task_%u", i);
+        TAILQ_INSERT_TAIL(&list, node, entries);
+    }
+    uint64_t register_ns = get_monotonic_ns() - start;
+
+    if (use_arena) {
+        TaskArenaStats stats;
+        task_arena_get_stats(arena, &stats);
+        allocations = stats.nodes.chunk_count + stats.object_chunks + stats.fallback_count;
+    }
+
+    uint64_t warm_ns = 0, cold_ns = 0, checksum = 0;
+    for (int round = 0; round < SLAB_BENCH_SCANS; round++) {
+        slab_bench_evict(evict_buffer);
+        start = get_monotonic_ns();
+        checksum += slab_bench_scan(&list);
+        cold_ns += get_monotonic_ns() - start;
+
+        start = get_monotonic_ns();
+        checksum += slab_bench_scan(&list);
+        warm_ns += get_monotonic_ns() - start;
+    }
+
+    g_slab_bench_sink = checksum;
+    printf("%-8s %8d %12llu %14.1f %14.1f %14.1f\n", use_arena ? "arena" : "malloc", SLAB_BENCH_TASKS,
+           (unsigned long long)allocations, register_ns / 1e6,
+           cold_ns / 1e6 / SLAB_BENCH_SCANS, warm_ns / 1e6 / SLAB_BENCH_SCANS);
+
+    TaskNode* node;
+    while ((node = TAILQ_FIRST(&list)) != NULL) {
+        TAILQ_REMOVE(&list, node, entries);
+        if (use_arena) {
+            task_object_free(arena, node->task, sizeof(SlabBenchTask));
+            slab_free(&arena->nodes, node);
+        } else {
+            free(node->task);
+            free(node);
+        }
+    }
+    for (uint32_t i = 0; i < SLAB_BENCH_TASKS; i++) {
+        free(noise[i]);
+    }
+    free(noise);
+    task_arena_release(arena);
+    return 0;
+}
+
+static int bench_slab(void) {
+    char* evict_buffer = calloc(1, SLAB_BENCH_EVICT_BYTES);
+    if (!evict_buffer) {
+        return 1;
+    }
+
+    printf("%-8s %8s %12s %14s %14s %14s\n", "mode", "tasks", "allocations", "register(ms)",
+           "scan-cold(ms)", "scan-warm(ms)");
+    int failed = run_slab_bench(false, evict_buffer);
+    failed += run_slab_bench(true, evict_buffer);
+
+    free(evict_buffer);
+    return failed;
+}
+
+// ============================================================================
+// 限时停止: 不同停止行为的任务的停止耗时与升级结果
+// ============================================================================
+
+#define STOP_BENCH_TASKS 8
+#define STOP_BENCH_TIMEOUT_MS 100
+#define STOP_BENCH_GRACE_MS 50
+
+typedef enum {
+    STOP_BENCH_PARK = 0,                // task_sleep停靠，停止时立即返回
+    STOP_BENCH_BLOCKING,                // sleep(10)后检查停止标志(原DataProcessor监控循环)
+    STOP_BENCH_IGNORING,                // 忽略停止标志，但会进入取消点
+    STOP_BENCH_SPINNING,                // 忽略停止标志且没有取消点
+    STOP_BENCH_KINDS
+} StopBenchKind;
+
+static const char* const g_stop_bench_names[STOP_BENCH_KINDS] = {"park", "blocking", "ignoring", "spinning"};
+static volatile bool g_stop_bench_release;
+
+static int stop_bench_execute(TaskBase* task) {
+    switch ((StopBenchKind)(uintptr_t)task->config.custom_config) {
+        case STOP_BENCH_PARK:
+            while (task_sleep(task, 10000) != TASK_PARK_STOPPED) {
+            }
+            break;
+        case STOP_BENCH_BLOCKING:
+            while (!task_should_stop(task)) {
+                sleep(10);
+            }
+            break;
+        case STOP_BENCH_IGNORING:
+            while (!g_stop_bench_release) {
+                usleep(100 * 1000);
+            }
+            break;
+        default:
+            while (!g_stop_bench_release) {
+            }
+            break;
+    }
+    return 0;
+}
+
+static const TaskInterface stop_bench_vtable = {
+    .initialize = bench_task_initialize,
+    .execute = stop_bench_execute,
+};
+
+static int bench_stop(void) {
+    TaskBase* tasks = calloc(STOP_BENCH_KINDS * STOP_BENCH_TASKS, sizeof(TaskBase));
+    if (!tasks) {
+        return 1;
+    }
+
+    TaskStopOptions options = {
+        .timeout_ms = STOP_BENCH_TIMEOUT_MS,
+        .grace_ms = STOP_BENCH_GRACE_MS,
+        .escalation = TASK_STOP_ESCALATE_CANCEL,
+    };
+    printf("期限 %d ms，每级宽限 %d ms，超时后再次唤醒 -> 取消 -> 分离；每类 %d 个任务逐个停止\n",
+           STOP_BENCH_TIMEOUT_MS, STOP_BENCH_GRACE_MS, STOP_BENCH_TASKS);
+    printf("%-10s %-12s %14s %14s %10s\n", "behavior", "outcome", "stop-mean(ms)", "stop-max(ms)", "state");
+
+    TaskConfig config;
+    memset(&config, 0, sizeof(config));
+
+    // 每类任务单独启动和停止，空转的任务不影响其他类的测量
+    for (int kind = 0; kind < STOP_BENCH_KINDS; kind++) {
+        uint32_t outcomes[TASK_STOP_DETACHED + 1] = {0};
+        uint64_t total = 0, max = 0;
+        TaskState state = TASK_STATE_UNKNOWN;
+
+        for (int i = 0; i < STOP_BENCH_TASKS; i++) {
+            TaskBase* task = &tasks[kind * STOP_BENCH_TASKS + i];
+            snprintf(config.name, sizeof(config.name), "%s_%d", g_stop_bench_names[kind], i);
+            config.custom_config = (void*)(uintptr_t)kind;
+            task_base_init(task, &stop_bench_vtable, &config);
+            task_start(task);
+        }
+        usleep(50 * 1000);
+
+        for (int i = 0; i < STOP_BENCH_TASKS; i++) {
+            TaskBase* task = &tasks[kind * STOP_BENCH_TASKS + i];
+            int outcome = task_stop_timed(task, &options);
+            if (outcome >= 0) {
+                outcomes[outcome]++;
+            }
+            uint64_t elapsed = task->stats.stop_time_ns;
+            total += elapsed;
+            max = elapsed > max ? elapsed : max;
+            state = task_get_state(task);
+        }
+
+        // 报告最常见的结果
+        int common = 0;
+        for (int o = 1; o <= TASK_STOP_DETACHED; o++) {
+            if (outcomes[o] > outcomes[common]) {
+                common = o;
+            }
+        }
+        printf("%-10s %-12s %14.1f %14.1f %10s\n", g_stop_bench_names[kind],
+               task_stop_outcome_name((TaskStopOutcome)common), total / 1e6 / STOP_BENCH_TASKS, max / 1e6,
+               state == TASK_STATE_STOPPED ? "STOPPED" : state == TASK_STATE_ERROR ? "ERROR" : "other");
+    }
+
+    LatencyHistogram histogram;
+    LatencySummary summary;
+    task_stop_latency_snapshot(&histogram);
+    latency_histogram_summarize(&histogram, &summary);
+    printf("进程级停止耗时: n=%llu p50=%.1f ms p99=%.1f ms max=%.1f ms\n",
+           (unsigned long long)summary.count, summary.p50_ns / 1e6, summary.p99_ns / 1e6, summary.max_ns / 1e6);
+
+    // 让被分离的线程结束后再释放任务
+    g_stop_bench_release = true;
+    usleep(200 * 1000);
+    for (int i = 0; i < STOP_BENCH_KINDS * STOP_BENCH_TASKS; i++) {
+        task_base_destroy(&tasks[i]);
+    }
+    free(tasks);
+    return 0;
+}
+
+// ============================================================================
+// 插件隔离: 进程内直接调用 vs 经插件宿主进程代理的调用延迟
+// ============================================================================
+
+#define HOST_BENCH_CALLS 20000
+#define HOST_BENCH_CYCLES 200
+
+static void* host_bench_start_thread(void* arg) {
+    ProcessInterface* interface = arg;
+    interface->start();
+    return NULL;
+}
+
+static void print_host_row(const char* mode, const char* call, const LatencyHistogram* histogram) {
+    LatencySummary summary;
+    latency_histogram_summarize(histogram, &summary);
+    printf("%-10s %-14s %10.1f %10.1f %10.1f\n", mode, call,
+           summary.p50_ns / 1e3, summary.p99_ns / 1e3, summary.max_ns / 1e3);
+}
+
+static int run_host_bench(const char* mode, ProcessInterface* interface) {
+    if (interface->initialize("", NULL) != 0) {
+        return 1;
+    }
+
+    LatencyHistogram stats_latency, health_latency, start_latency, stop_latency;
+    latency_histogram_reset(&stats_latency);
+    latency_histogram_reset(&health_latency);
+    latency_histogram_reset(&start_latency);
+    latency_histogram_reset(&stop_latency);
+
+    for (int i = 0; i < HOST_BENCH_CALLS; i++) {
+        uint64_t begin = get_monotonic_ns();
+        interface->get_stats();
+        uint64_t middle = get_monotonic_ns();
+        interface->health_check();
+        uint64_t end = get_monotonic_ns();
+        latency_histogram_record(&stats_latency, middle - begin);
+        latency_histogram_record(&health_latency, end - middle);
+    }
+
+    // start阻塞到插件停止: 测量从调用到插件报告RUNNING，stop测量到start返回为止
+    for (int i = 0; i < HOST_BENCH_CYCLES; i++) {
+        pthread_t thread;
+        uint64_t begin = get_monotonic_ns();
+        if (pthread_create(&thread, NULL, host_bench_start_thread, interface) != 0) {
+            return 1;
+        }
+        // 让出CPU，避免轮询抢占插件的状态锁
+        while (interface->get_state() != PROCESS_STATE_RUNNING) {
+            sched_yield();
+        }
+        uint64_t running = get_monotonic_ns();
+        interface->stop();
+        pthread_join(thread, NULL);
+        uint64_t stopped = get_monotonic_ns();
+        latency_histogram_record(&start_latency, running - begin);
+        latency_histogram_record(&stop_latency, stopped - running);
+    }
+
+    print_host_row(mode, "get_stats", &stats_latency);
+    print_host_row(mode, "health_check", &health_latency);
+    print_host_row(mode, "start", &start_latency);
+    print_host_row(mode, "stop", &stop_latency);
+    return 0;
+}
+
+/**
+ * 基准插件路径: 环境变量STARTTOOL_BENCH_PLUGIN，默认为构建目录的lib/libbench_process.so
+ */
+static void resolve_bench_plugin(char* path, size_t size) {
+    const char* configured = getenv("STARTTOOL_BENCH_PLUGIN");
+    if (configured && configured[0]) {
+        snprintf(path, size, "%s", configured);
+        return;
+    }
+
+    char exe[512];
+    ssize_t len = readlink("/proc/self/exe", exe, sizeof(exe) - 1);
+    exe[len > 0 ? len : 0] = '\0';
+    char* slash = strrchr(exe, '/');
+    if (slash) {
+        *slash = '\0';
+    }
+    snprintf(path, size, "%s/../lib/libbench_process.so", slash ? exe : ".");
+}
+
+static int bench_host(void) {
+    char path[600];
+    resolve_bench_plugin(path, sizeof(path));
+
+    void* handle = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+    ProcessInterface* (*get_interface)(void) = handle ? (ProcessInterface* (*)(void))dlsym(handle, "get_process_interface") : NULL;
+    if (!get_interface) {
+        printf("无法加载基准插件 %s (可用STARTTOOL_BENCH_PLUGIN指定)\n", path);
+        return 1;
+    }
+
+    printf("插件 %s，%d 次get_stats/health_check，%d 次start/stop\n", path, HOST_BENCH_CALLS, HOST_BENCH_CYCLES);
+    printf("%-10s %-14s %10s %10s %10s\n", "mode", "call", "p50(us)", "p99(us)", "max(us)");
+
+    int failed = run_host_bench("in-process", get_interface());
+    dlclose(handle);
+
+    uint64_t spawn_begin = get_monotonic_ns();
+    PluginHost* host = plugin_host_create("bench_process", path, NULL);
+    uint64_t spawn_ns = get_monotonic_ns() - spawn_begin;
+    if (!host) {
+        printf("无法创建插件宿主 (可用%s指定plugin_host路径)\n", PLUGIN_HOST_PATH_ENV);
+        return 1;
+    }
+    failed += run_host_bench("isolated", plugin_host_get_interface(host));
+
+    PluginHostInfo info;
+    plugin_host_get_info(host, &info);
+    printf("宿主进程: 创建+加载 %.2f ms，常驻内存 %.1f MB，代理调用 %llu 次\n",
+           spawn_ns / 1e6, info.rss_bytes / (1024.0 * 1024.0), (unsigned long long)info.calls);
+    plugin_host_destroy(host);
+    return failed;
+}
+
+#define LOAD_BENCH_PLUGINS 64
+#define LOAD_BENCH_INIT_MS 20
+#define LOAD_BENCH_PRIORITIES 4
+
+static int run_load_bench(const char* mode, const char* path, const ProcessLoadOptions* options) {
+    ProcessManager* manager = process_manager_create(NULL);
+    if (!manager) {
+        return 1;
+    }
+
+    static char names[LOAD_BENCH_PLUGINS][64];
+    ProcessLoadRequest requests[LOAD_BENCH_PLUGINS];
+    char config_data[32];
+    snprintf(config_data, sizeof(config_data), "init_ms=%d", LOAD_BENCH_INIT_MS);
+    for (int i = 0; i < LOAD_BENCH_PLUGINS; i++) {
+        snprintf(names[i], sizeof(names[i]), "bench_%02d", i);
+        requests[i] = (ProcessLoadRequest){
+            .name = names[i],
+            .library_path = path,
+            .config_data = config_data,
+            .priority = i % LOAD_BENCH_PRIORITIES,
+            .isolated = false,
+        };
+    }
+
+    ProcessLoadReport report;
+    int ret = process_manager_load_plugins(manager, requests, LOAD_BENCH_PLUGINS, options, &report);
+
+    // 最高优先级一组全部就绪的时刻
+    uint64_t first_group_us = 0;
+    for (uint32_t i = 0; i < report.count; i++) {
+        if (report.entries[i].priority == LOAD_BENCH_PRIORITIES - 1 && report.entries[i].ready_us > first_group_us) {
+            first_group_us = report.entries[i].ready_us;
+        }
+    }
+    printf("%-10s %8u %8u %12.1f %12.1f %16.1f\n", mode, report.count, report.loaded,
+           report.total_us / 1000.0, report.serial_us / 1000.0, first_group_us / 1000.0);
+
+    process_load_report_free(&report);
+    process_manager_destroy(manager);
+    return ret == 0 ? 0 : 1;
+}
+
+static int bench_load(void) {
+    char path[600];
+    resolve_bench_plugin(path, sizeof(path));
+
+    printf("%d 个插件，每个initialize耗时 %d ms，%d 个优先级\n", LOAD_BENCH_PLUGINS, LOAD_BENCH_INIT_MS,
+           LOAD_BENCH_PRIORITIES);
+    printf("%-10s %8s %8s %12s %12s %16s\n", "mode", "plugins", "loaded", "total(ms)", "serial(ms)",
+           "top-prio-ready(ms)");
+
+    ProcessLoadOptions serial = {.max_parallel = 1};
+    ProcessLoadOptions parallel = {0};
+    ProcessLoadOptions barrier = {.priority_barrier = true};
+    int failed = run_load_bench("serial", path, &serial);
+    failed += run_load_bench("parallel", path, &parallel);
+    failed += run_load_bench("barrier", path, &barrier);
+    if (failed) {
+        printf("加载失败 (可用STARTTOOL_BENCH_PLUGIN指定插件路径)\n");
+    }
+    return failed;
+}
+
+#define LAZY_BENCH_PLUGINS 64
+#define LAZY_BENCH_HOSTS 8
+#define LAZY_BENCH_STARTS 8
+
+/**
+ * 把基准插件复制成count个不同的文件 - 同一路径只会被dlopen映射一次
+ * @return 0成功
+ */
+static int copy_bench_plugins(const char* source, const char* dir, uint32_t count) {
+    FILE* in = fopen(source, "rb");
+    if (!in) {
+        return -1;
+    }
+    fseek(in, 0, SEEK_END);
+    long size = ftell(in);
+    fseek(in, 0, SEEK_SET);
+    char* data = size > 0 ? malloc((size_t)size) : NULL;
+    bool ok = data && fread(data, 1, (size_t)size, in) == (size_t)size;
+    fclose(in);
+
+    for (uint32_t i = 0; ok && i < count; i++) {
+        char path[600];
+        snprintf(path, sizeof(path), "%s/plugin_%02u.so", dir, i);
+        FILE* out = fopen(path, "wb");
+        ok = out && fwrite(data, 1, (size_t)size, out) == (size_t)size;
+        if (out) {
+            fclose(out);
+        }
+    }
+    free(data);
+    return ok ? 0 : -1;
+}
+
+static uint64_t sum_host_rss(ProcessManager* manager) {
+    ProcessSnapshotRecord records[16];
+    SnapshotCursor cursor = SNAPSHOT_CURSOR_INIT;
+    uint64_t total = 0;
+    int count;
+    while ((count = process_manager_snapshot(manager, records, 16, &cursor)) > 0) {
+        for (int i = 0; i < count; i++) {
+            total += records[i].host_rss_bytes;
+        }
+    }
+    return total;
+}
+
+/**
+ * 登记或加载一批休眠插件(都不自动启动)，再启动其中几个并空闲卸载
+ */
+static int run_lazy_bench(const char* mode, const char* dir, uint32_t count, bool isolated, bool lazy) {
+    ProcessManager* manager = process_manager_create(NULL);
+    if (!manager) {
+        return 1;
+    }
+
+    static char names[LAZY_BENCH_PLUGINS][64];
+    static char paths[LAZY_BENCH_PLUGINS][600];
+    ProcessLoadRequest requests[LAZY_BENCH_PLUGINS];
+    for (uint32_t i = 0; i < count; i++) {
+        snprintf(names[i], sizeof(names[i]), "dormant_%02u", i);
+        snprintf(paths[i], sizeof(paths[i]), "%s/plugin_%02u.so", dir, i);
+        requests[i] = (ProcessLoadRequest){
+            .name = names[i],
+            .library_path = paths[i],
+            .isolated = isolated,
+            .lazy = lazy,
+            .idle_unload_ms = 1,
+        };
+    }
+
+    uint64_t rss_before = read_status_kb("VmRSS");
+    ProcessLoadReport report;
+    int failed = process_manager_load_plugins(manager, requests, count, NULL, &report);
+    int64_t rss_loaded = (int64_t)read_status_kb("VmRSS") - (int64_t)rss_before + (int64_t)(sum_host_rss(manager) / 1024);
+
+    // 首次启动的额外开销: 延迟加载的在这里才dlopen和initialize
+    uint64_t first_start_ns = 0;
+    for (uint32_t i = 0; i < LAZY_BENCH_STARTS && i < count; i++) {
+        uint64_t begin = get_monotonic_ns();
+        failed += process_manager_ensure_loaded(manager, names[i]) != 0;
+        first_start_ns += get_monotonic_ns() - begin;
+    }
+    uint32_t starts = count < LAZY_BENCH_STARTS ? count : LAZY_BENCH_STARTS;
+
+    // 第一次检查开始计时，超过idle_unload_ms后的第二次检查卸载
+    process_manager_unload_idle(manager);
+    usleep(2000);
+    int unloaded = process_manager_unload_idle(manager);
+
+    printf("%-16s %8u %10.1f %12lld %16.1f %10d\n", mode, report.loaded, report.total_us / 1000.0,
+           (long long)rss_loaded, first_start_ns / 1000.0 / starts, unloaded);
+
+    process_load_report_free(&report);
+    process_manager_destroy(manager);
+    return failed;
+}
+
+static int bench_lazy(void) {
+    char source[600];
+    resolve_bench_plugin(source, sizeof(source));
+
+    char dir[] = "/tmp/starttool_lazy_XXXXXX";
+    if (!mkdtemp(dir) || copy_bench_plugins(source, dir, LAZY_BENCH_PLUGINS) != 0) {
+        printf("无法准备基准插件 %s (可用STARTTOOL_BENCH_PLUGIN指定)\n", source);
+        return 1;
+    }
+
+    printf("%d 个不自动启动的插件(各为独立的动态库文件)，之后启动其中 %d 个\n", LAZY_BENCH_PLUGINS, LAZY_BENCH_STARTS);
+    printf("%-16s %8s %10s %12s %16s %10s\n", "mode", "plugins", "load(ms)", "rss(KB)", "first-start(us)",
+           "unloaded");
+
+    int failed = run_lazy_bench("eager", dir, LAZY_BENCH_PLUGINS, false, false);
+    failed += run_lazy_bench("lazy", dir, LAZY_BENCH_PLUGINS, false, true);
+    failed += run_lazy_bench("eager-isolated", dir, LAZY_BENCH_HOSTS, true, false);
+    failed += run_lazy_bench("lazy-isolated", dir, LAZY_BENCH_HOSTS, true, true);
+
+    for (uint32_t i = 0; i < LAZY_BENCH_PLUGINS; i++) {
+        char path[600];
+        snprintf(path, sizeof(path), "%s/plugin_%02u.so", dir, i);
+        unlink(path);
+    }
+    rmdir(dir);
+    return failed;
+}
+
+#define RELOAD_BENCH_ROUNDS 20
+#define RELOAD_BENCH_INIT_MS 20
+
+typedef struct {
+    ProcessManager* manager;
+    bool stop;
+    uint64_t probes;
+    uint64_t failed_probes;
+    uint64_t max_outage_ns;           // 连续观察到非RUNNING的最长时间
+} ReloadProbe;
+
+/**
+ * 模拟客户端: 持续查询进程状态，记录不可用的时长
+ */
+static void* reload_probe_thread(void* arg) {
+    ReloadProbe* probe = arg;
+    uint64_t outage_begin = 0;
+    while (!__atomic_load_n(&probe->stop, __ATOMIC_ACQUIRE)) {
+        uint64_t now = get_monotonic_ns();
+        bool up = process_manager_get_process_state(probe->manager, "reload_target") == PROCESS_STATE_RUNNING;
+        probe->probes++;
+        if (up) {
+            if (outage_begin && now - outage_begin > probe->max_outage_ns) {
+                probe->max_outage_ns = now - outage_begin;
+            }
+            outage_begin = 0;
+        } else {
+            probe->failed_probes++;
+            outage_begin = outage_begin ? outage_begin : now;
+        }
+        sched_yield();
+    }
+    return NULL;
+}
+
+static int run_reload_bench(const char* mode, const char* path, bool isolated, uint32_t rounds) {
+    ProcessManager* manager = process_manager_create(NULL);
+    if (!manager) {
+        return 1;
+    }
+
+    char config_data[32];
+    snprintf(config_data, sizeof(config_data), "init_ms=%d", RELOAD_BENCH_INIT_MS);
+    ProcessLoadRequest request = {
+        .name = "reload_target",
+        .library_path = path,
+        .config_data = config_data,
+        .isolated = isolated,
+    };
+    if (process_manager_load_plugins(manager, &request, 1, NULL, NULL) != 0 ||
+        process_manager_start_process(manager, "reload_target") != 0) {
+        process_manager_destroy(manager);
+        return 1;
+    }
+    while (process_manager_get_process_state(manager, "reload_target") != PROCESS_STATE_RUNNING) {
+        sched_yield();
+    }
+
+    ReloadProbe probe = {.manager = manager};
+    pthread_t thread;
+    pthread_create(&thread, NULL, reload_probe_thread, &probe);
+
+    // 每轮都重载同一路径，进程内加载时经私有副本与旧实例同时存在
+    ProcessReloadOptions options = {.drain_ms = 10};
+    uint64_t prepare[RELOAD_BENCH_ROUNDS];
+    uint64_t gap[RELOAD_BENCH_ROUNDS];
+    int failed = 0;
+    for (uint32_t i = 0; i < rounds; i++) {
+        ProcessReloadReport report;
+        failed += process_manager_reload_plugin(manager, "reload_target", &options, &report) != 0;
+        prepare[i] = report.prepare_us;
+        gap[i] = report.gap_us;
+    }
+
+    __atomic_store_n(&probe.stop, true, __ATOMIC_RELEASE);
+    pthread_join(thread, NULL);
+
+    qsort(prepare, rounds, sizeof(uint64_t), compare_u64);
+    qsort(gap, rounds, sizeof(uint64_t), compare_u64);
+    printf("%-10s %8u %14.1f %12llu %12llu %18.1f %14.1f\n", mode, rounds, prepare[rounds / 2] / 1000.0,
+           (unsigned long long)gap[rounds / 2], (unsigned long long)gap[rounds - 1], probe.max_outage_ns / 1e3,
+           (prepare[rounds / 2] + gap[rounds / 2]) / 1000.0);
+
+    process_manager_stop_process(manager, "reload_target");
+    process_manager_destroy(manager);
+    return failed;
+}
+
+static int bench_reload(void) {
+    char path[600];
+    resolve_bench_plugin(path, sizeof(path));
+
+    printf("运行中的插件(initialize耗时 %d ms)连续热重载，客户端持续查询状态\n", RELOAD_BENCH_INIT_MS);
+    printf("%-10s %8s %14s %12s %12s %18s %14s\n", "mode", "reloads", "prepare(ms)", "gap-p50(us)",
+           "gap-max(us)", "client-outage(us)", "cold-gap(ms)");
+
+    int failed = run_reload_bench("in-process", path, false, RELOAD_BENCH_ROUNDS);
+    failed += run_reload_bench("isolated", path, true, RELOAD_BENCH_ROUNDS / 4);
+    printf("cold-gap: 停止后再加载和初始化(原先的升级方式)的估计中断，即prepare+gap\n");
+    if (failed) {
+        printf("热重载失败 (可用STARTTOOL_BENCH_PLUGIN指定插件路径)\n");
+    }
+    return failed;
+}
+
+#define STATSPAGE_BENCH_PLUGINS 4
+#define STATSPAGE_BENCH_ROUNDS 20000
+
+/**
+ * 判断统计副本是否撕裂 - 基准插件每次更新把三个字段写成同一个序号
+ */
+static bool stats_torn(const ProcessStats* stats) {
+    return stats->run_time != stats->memory_usage || (uint32_t)stats->memory_usage != stats->cpu_usage;
+}
+
+/**
+ * 一批不停更新统计的插件，监控端反复抓取每个插件的统计
+ * @param use_page true经统计页读取副本，false调用get_stats再复制(原先的方式)
+ */
+static int run_statspage_bench(const char* mode, const char* dir, const char* config_data, bool isolated, bool use_page,
+                               uint32_t rounds) {
+    ProcessManager* manager = process_manager_create(NULL);
+    if (!manager) {
+        return 1;
+    }
+
+    static char names[STATSPAGE_BENCH_PLUGINS][64];
+    static char paths[STATSPAGE_BENCH_PLUGINS][600];
+    ProcessLoadRequest requests[STATSPAGE_BENCH_PLUGINS];
+    for (uint32_t i = 0; i < STATSPAGE_BENCH_PLUGINS; i++) {
+        snprintf(names[i], sizeof(names[i]), "stats_%02u", i);
+        snprintf(paths[i], sizeof(paths[i]), "%s/plugin_%02u.so", dir, i);
+        requests[i] = (ProcessLoadRequest){
+            .name = names[i],
+            .library_path = paths[i],
+            .config_data = config_data,
+            .isolated = isolated,
+        };
+    }
+    int failed = process_manager_load_plugins(manager, requests, STATSPAGE_BENCH_PLUGINS, NULL, NULL);
+    for (uint32_t i = 0; i < STATSPAGE_BENCH_PLUGINS && !failed; i++) {
+        failed += process_manager_start_process(manager, names[i]) != 0;
+    }
+    ProcessStatsPage page;
+    uint32_t pages = 0;
+    for (uint32_t i = 0; i < STATSPAGE_BENCH_PLUGINS && !failed; i++) {
+        while (process_manager_get_process_state(manager, names[i]) != PROCESS_STATE_RUNNING) {
+            sched_yield();
+        }
+        pages += process_manager_read_stats_page(manager, names[i], &page) == 0;
+    }
+    if (failed || (use_page && pages != STATSPAGE_BENCH_PLUGINS)) {
+        process_manager_destroy(manager);
+        return 1;
+    }
+
+    LatencyHistogram histogram;
+    latency_histogram_reset(&histogram);
+    uint64_t torn = 0;
+    uint64_t reads = 0;
+    for (uint32_t round = 0; round < rounds; round++) {
+        for (uint32_t i = 0; i < STATSPAGE_BENCH_PLUGINS; i++) {
+            ProcessStats copy;
+            uint64_t begin = get_monotonic_ns();
+            if (use_page) {
+                failed += process_manager_read_stats(manager, names[i], &copy) != 0;
+            } else {
+                const ProcessStats* stats = process_manager_get_process_stats(manager, names[i]);
+                if (stats) {
+                    copy = *stats;
+                } else {
+                    failed++;
+                    continue;
+                }
+            }
+            latency_histogram_record(&histogram, get_monotonic_ns() - begin);
+            torn += stats_torn(&copy);
+            reads++;
+        }
+    }
+
+    LatencySummary summary;
+    latency_histogram_summarize(&histogram, &summary);
+    printf("%-16s %6u %10llu %10.2f %10.2f %10llu\n", mode, pages, (unsigned long long)reads,
+           summary.p50_ns / 1e3, summary.p99_ns / 1e3, (unsigned long long)torn);
+
+    for (uint32_t i = 0; i < STATSPAGE_BENCH_PLUGINS; i++) {
+        process_manager_stop_process(manager, names[i]);
+    }
+    process_manager_destroy(manager);
+    return failed != 0;
+}
+
+static int bench_statspage(void) {
+    char source[600];
+    resolve_bench_plugin(source, sizeof(source));
+
+    char dir[] = "/tmp/starttool_statspage_XXXXXX";
+    if (!mkdtemp(dir) || copy_bench_plugins(source, dir, STATSPAGE_BENCH_PLUGINS) != 0) {
+        printf("无法准备基准插件 %s (可用STARTTOOL_BENCH_PLUGIN指定)\n", source);
+        return 1;
+    }
+
+    // 写者在写入中途被抢占时读者只能等它再被调度，CPU不够每个写者一个时改为间歇更新
+    bool spinning = sysconf(_SC_NPROCESSORS_ONLN) > STATSPAGE_BENCH_PLUGINS;
+    const char* config_data = spinning ? "update_us=0" : "update_us=20";
+    printf("%d 个%s更新统计的插件，每个抓取 %d 次(torn: 各字段不属于同一次更新的副本)\n",
+           STATSPAGE_BENCH_PLUGINS, spinning ? "不停" : "每20us", STATSPAGE_BENCH_ROUNDS);
+    printf("%-16s %6s %10s %10s %10s %10s\n", "mode", "pages", "reads", "p50(us)", "p99(us)", "torn");
+
+    int failed = run_statspage_bench("get_stats", dir, config_data, false, false, STATSPAGE_BENCH_ROUNDS);
+    failed += run_statspage_bench("page", dir, config_data, false, true, STATSPAGE_BENCH_ROUNDS);
+    failed += run_statspage_bench("get_stats-host", dir, config_data, true, false, STATSPAGE_BENCH_ROUNDS / 10);
+    failed += run_statspage_bench("page-host", dir, config_data, true, true, STATSPAGE_BENCH_ROUNDS / 10);
+
+    for (uint32_t i = 0; i < STATSPAGE_BENCH_PLUGINS; i++) {
+        char path[600];
+        snprintf(path, sizeof(path), "%s/plugin_%02u.so", dir, i);
+        unlink(path);
+    }
+    rmdir(dir);
+    return failed;
+}
+
+#define ASYNC_BENCH_ROUNDS 200
+#define ASYNC_BENCH_WAIT_MS 1000
+
+/**
+ * v2基准插件路径: 环境变量STARTTOOL_BENCH_ASYNC_PLUGIN，默认与v1基准插件同目录
+ */
+static void resolve_async_bench_plugin(char* path, size_t size) {
+    const char* configured = getenv("STARTTOOL_BENCH_ASYNC_PLUGIN");
+    if (configured && configured[0]) {
+        snprintf(path, size, "%s", configured);
+        return;
+    }
+
+    char v1[600];
+    resolve_bench_plugin(v1, sizeof(v1));
+    char* slash = strrchr(v1, '/');
+    if (slash) {
+        *slash = '\0';
+    }
+    if (snprintf(path, size, "%s/libbench_async_process.so", slash ? v1 : ".") >= (int)size) {
+        path[0] = '\0';
+    }
+}
+
+static double rusage_cpu_ms(void) {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1e3 +
+           (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e3;
+}
+
+/**
+ * 反复启动到RUNNING、(可选)暂停恢复、停止，测量管理器观察到的各阶段耗时
+ */
+static int run_async_bench(const char* mode, const char* path, uint32_t rounds) {
+    ProcessManager* manager = process_manager_create(NULL);
+    if (!manager) {
+        return 1;
+    }
+    ProcessLoadRequest request = {.name = "async_target", .library_path = path, .config_data = ""};
+    if (process_manager_load_plugins(manager, &request, 1, NULL, NULL) != 0) {
+        process_manager_destroy(manager);
+        return 1;
+    }
+
+    LatencyHistogram start_latency, stop_latency, pause_latency;
+    latency_histogram_reset(&start_latency);
+    latency_histogram_reset(&stop_latency);
+    latency_histogram_reset(&pause_latency);
+
+    int failed = 0;
+    bool pausable = true;
+    double cpu_begin = rusage_cpu_ms();
+    for (uint32_t i = 0; i < rounds && !failed; i++) {
+        uint64_t begin = get_monotonic_ns();
+        if (process_manager_start_process(manager, "async_target") != 0 ||
+            process_manager_wait_state(manager, "async_target", PROCESS_STATE_RUNNING, ASYNC_BENCH_WAIT_MS) != 0) {
+            failed++;
+            break;
+        }
+        uint64_t running = get_monotonic_ns();
+        latency_histogram_record(&start_latency, running - begin);
+
+        if (pausable) {
+            if (process_manager_pause_process(manager, "async_target") == 0) {
+                failed += process_manager_resume_process(manager, "async_target") != 0;
+                latency_histogram_record(&pause_latency, get_monotonic_ns() - running);
+            } else {
+                pausable = false;
+            }
+        }
+
+        uint64_t stopping = get_monotonic_ns();
+        failed += process_manager_stop_process_timed(manager, "async_target", NULL) != TASK_STOP_CLEAN;
+        latency_histogram_record(&stop_latency, get_monotonic_ns() - stopping);
+    }
+    double cpu_ms = rusage_cpu_ms() - cpu_begin;
+
+    LatencySummary start_summary, stop_summary, pause_summary;
+    latency_histogram_summarize(&start_latency, &start_summary);
+    latency_histogram_summarize(&stop_latency, &stop_summary);
+    latency_histogram_summarize(&pause_latency, &pause_summary);
+    char pause_column[32];
+    if (pause_summary.count) {
+        snprintf(pause_column, sizeof(pause_column), "%.1f", pause_summary.p50_ns / 1e3);
+    } else {
+        snprintf(pause_column, sizeof(pause_column), "-");
+    }
+    printf("%-10s %8llu %14.1f %14.1f %14.1f %14.1f %14s %10.1f\n", mode,
+           (unsigned long long)start_summary.count, start_summary.p50_ns / 1e3, start_summary.p99_ns / 1e3,
+           stop_summary.p50_ns / 1e3, stop_summary.p99_ns / 1e3, pause_column,
+           start_summary.count ? cpu_ms * 1e3 / start_summary.count : 0.0);
+
+    process_manager_destroy(manager);
+    return failed != 0;
+}
+
+static int bench_async(void) {
+    char v1_path[600], v2_path[600];
+    resolve_bench_plugin(v1_path, sizeof(v1_path));
+    resolve_async_bench_plugin(v2_path, sizeof(v2_path));
+
+    printf("同一插件反复启动、暂停恢复、停止 %d 轮: v1阻塞start+状态轮询 vs v2非阻塞start+状态通知\n",
+           ASYNC_BENCH_ROUNDS);
+    printf("%-10s %8s %14s %14s %14s %14s %14s %10s\n", "mode", "rounds", "ready-p50(us)", "ready-p99(us)",
+           "stop-p50(us)", "stop-p99(us)", "pause-rt(us)", "cpu/rd(us)");
+
+    int failed = run_async_bench("v1", v1_path, ASYNC_BENCH_ROUNDS);
+    failed += run_async_bench("v2", v2_path, ASYNC_BENCH_ROUNDS);
+    printf("ready: 调用start_process到wait_state(RUNNING)返回；v1每 %d ms查询一次状态，v2由插件通知唤醒\n",
+           PROCESS_WAIT_POLL_MS);
+    if (failed) {
+        printf("基准失败 (可用STARTTOOL_BENCH_PLUGIN/STARTTOOL_BENCH_ASYNC_PLUGIN指定插件路径)\n");
+    }
+    return failed;
+}
+
+// ============================================================================
+// 入口
+// ============================================================================
+
+typedef struct {
+    const char* name;
+    const char* description;
+    int (*run)(void);
+} BenchCase;
+
+static const BenchCase g_bench_cases[] = {
+    {"index", "任务名称查找(链表扫描 vs 哈希索引)", bench_index},
+    {"rcu", "读者并发查询+注册表抖动(加锁 vs 只读视图)", bench_rcu},
+    {"pool", "一万任务: 每任务一线程 vs 工作窃取线程池", bench_pool},
+    {"timer", "十万定时器: 时间轮插入/到期开销与触发抖动", bench_timer},
+    {"priority", "低优先级任务占满CPU时关键任务的唤醒延迟", bench_priority},
+    {"accounting", "一千/一万个任务线程的CPU时间与/proc批量采样开销", bench_accounting},
+    {"latency", "单次工作耗时直方图的记录、快照与合并开销", bench_latency},
+    {"stats", "任务更新统计时并发读取(读者加锁 vs 顺序锁快照)", bench_stats},
+    {"park", "空闲任务: sleep轮询 vs futex停靠的停止延迟与空闲唤醒", bench_park},
+    {"startup", "分层依赖服务: 串行启动 vs 按依赖拓扑并发启动", bench_startup},
+    {"restart", "启动即崩溃的任务: 立即重启 vs 退避与窗口预算(模拟时钟)", bench_restart},
+    {"slab", "五万任务: 逐个malloc vs 块分配器与任务分配区的分配次数和扫描耗时", bench_slab},
+    {"stop", "不响应停止的任务: 限时停止的耗时、升级结果与停止耗时分位", bench_stop},
+    {"host", "插件接口调用: 进程内直接调用 vs 插件宿主进程代理的延迟", bench_host},
+    {"load", "六十四个初始化较慢的插件: 逐个加载 vs 并发加载(可按优先级分批)", bench_load},
+    {"lazy", "六十四个休眠插件: 启动时全部加载 vs 首次启动时加载的内存、首启开销与空闲卸载", bench_lazy},
+    {"reload", "运行中的插件热重载: 准备耗时、服务中断与客户端观察到的不可用时长", bench_reload},
+    {"statspage", "插件统计: 调用get_stats复制 vs 共享内存统计页的抓取开销与撕裂副本", bench_statspage},
+    {"async", "插件生命周期: v1阻塞start与轮询 vs v2非阻塞start与状态通知的就绪、停止和暂停耗时", bench_async},
+};
+
+static void print_usage(const char* program_name) {
+    printf("Usage: %s <bench>|all\n", program_name);
+    for (size_t i = 0; i < sizeof(g_bench_cases) / sizeof(g_bench_cases[0]); i++) {
+        printf("  %-12s - %s\n", g_bench_cases[i].name, g_bench_cases[i].description);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 2) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    bool run_all = strcmp(argv[1], "all") == 0;
+    bool matched = false;
+    int failed = 0;
+
+    for (size_t i = 0; i < sizeof(g_bench_cases) / sizeof(g_bench_cases[0]); i++) {
+        if (run_all || strcmp(argv[1], g_bench_cases[i].name) == 0) {
+            printf("=== %s: %s ===\n", g_bench_cases[i].name, g_bench_cases[i].description);
+            failed += g_bench_cases[i].run() != 0;
+            matched = true;
+        }
+    }
+
+    if (!matched) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    return failed;
+}
@@ -5,9 +5,24 @@
 #include <string.h>
 #include <signal.h>
 #include <unistd.h>
+#include <time.h>
 
 static TaskManager* g_manager = NULL;
 
+// 批量启停: 单个任务2秒后升级，整批最多等待10秒
+static const LifecycleOptions g_lifecycle_options = {
+    .task_timeout_ms = 2000,
+    .global_timeout_ms = 10000,
+    .max_parallel = 0
+};
+
+// 按依赖顺序启动: 每个任务最多等待2秒就绪
+static const StartupOptions g_startup_options = {
+    .max_parallel = 0,
+    .ready_timeout_ms = 2000,
+    .poll_ms = 0
+};
+
 /**
  * 信号处理函数
  */
@@ -15,7 +30,11 @@ static void signal_handler(int sig) {
     printf("收到信号 %d，正在关闭任务管理器...\n", sig);
     
     if (g_manager) {
+        task_manager_stop_watchdog(g_manager);
+        task_manager_stop_maintenance(g_manager);
+        task_manager_release_timers(g_manager);
         task_manager_stop_all(g_manager);
+        task_manager_release_events(g_manager);
         task_manager_destroy(g_manager);
         g_manager = NULL;
     }
@@ -36,6 +55,56 @@ static void task_event_callback(const char* task_name, TaskState old_state, Task
            task_name, state_names[old_state], state_names[new_state]);
 }
 
+/**
+ * 心跳超时回调函数
+ */
+static void heartbeat_miss_callback(TaskBase* task, uint64_t last_heartbeat, void* user_data) {
+    (void)user_data;
+    printf("心跳超时: %s 最后心跳 %llu 秒前\n", task->config.name,
+           (unsigned long long)(time(NULL) - (time_t)last_heartbeat));
+}
+
+/**
+ * 打印批量启停报告中最慢的几个任务
+ */
+static void print_lifecycle_report(const char* action, const LifecycleReport* report) {
+    printf("%s完成: 成功 %u, 失败 %u, 升级 %u, 未完成 %u, 未开始 %u, 总耗时 %.1f ms\n", action,
+           report->succeeded, report->failed, report->escalated, report->abandoned,
+           report->skipped, report->total_us / 1000.0);
+
+    for (uint32_t i = 0; i < report->count && i < 5; i++) {
+        const LifecycleEntry* entry = &report->entries[i];
+        printf("  %-20s %10.1f ms  %s%s\n", entry->name, entry->elapsed_us / 1000.0,
+               !entry->started ? "未开始" : !entry->completed ? "未完成" :
+               entry->result == 0 ? "成功" : "失败",
+               entry->escalated ? " (已升级)" : "");
+    }
+}
+
+/**
+ * 打印按依赖顺序启动的结果和关键路径
+ */
+static void print_startup_report(const StartupReport* report) {
+    printf("启动所有任务完成: 就绪 %u, 失败 %u, 超时 %u, 阻塞 %u, 共 %u 层, 总耗时 %.1f ms\n",
+           report->ready, report->failed, report->timed_out, report->blocked,
+           report->wave_count, report->total_us / 1000.0);
+
+    for (uint32_t i = 0; i < report->count; i++) {
+        const StartupEntry* entry = &report->entries[i];
+        if (entry->outcome != STARTUP_READY) {
+            printf("  %-20s %s\n", entry->name, startup_outcome_name(entry->outcome));
+        }
+    }
+
+    printf("关键路径:");
+    for (uint32_t i = 0; i < report->critical_path_length; i++) {
+        const StartupEntry* entry = &report->entries[report->critical_path[i]];
+        printf("%s %s(%.1f ms)", i ? " ->" : "", entry->name,
+               (entry->ready_us - entry->start_us) / 1000.0);
+    }
+    printf("\n");
+}
+
 /**
  * 交互式命令处理
  */
@@ -48,11 +117,14 @@ static void handle_interactive_commands(TaskManager* manager) {
     printf("  start <task_name>     - 启动任务\n");
     printf("  stop <task_name>      - 停止任务\n");
     printf("  restart <task_name>   - 重启任务\n");
+    printf("  pause <task_name>     - 暂停任务\n");
+    printf("  resume <task_name>    - 恢复任务\n");
     printf("  status <task_name>    - 查看任务状态\n");
+    printf("  periodic <task> <ms>  - 按固定间隔调度任务(不占用独立线程)\n");
     printf("  list                  - 列出所有任务\n");
     printf("  stats                 - 查看管理器统计\n");
     printf("  health                - 执行健康检查\n");
-    printf("  start_all             - 启动所有任务\n");
+    printf("  start_all             - 按依赖顺序启动所有任务\n");
     printf("  stop_all              - 停止所有任务\n");
     printf("  quit                  - 退出\n");
     printf("\n> ");
@@ -87,10 +159,25 @@ static void handle_interactive_commands(TaskManager* manager) {
             } else {
                 printf("任务 %s 重启失败 (错误: %d)\n", task_name, ret);
             }
+        } else if (strncmp(command, "pause ", 6) == 0) {
+            sscanf(command + 6, "%63s", task_name);
+            if (task_manager_pause_task(manager, task_name) == 0) {
+                printf("任务 %s 已暂停\n", task_name);
+            } else {
+                printf("任务 %s 暂停失败\n", task_name);
+            }
+        } else if (strncmp(command, "resume ", 7) == 0) {
+            sscanf(command + 7, "%63s", task_name);
+            if (task_manager_resume_task(manager, task_name) == 0) {
+                printf("任务 %s 已恢复\n", task_name);
+            } else {
+                printf("任务 %s 恢复失败\n", task_name);
+            }
         } else if (strncmp(command, "status ", 7) == 0) {
             sscanf(command + 7, "%s", task_name);
             TaskBase* task = task_manager_get_task(manager, task_name);
             if (task) {
+                task_manager_sample_accounting(manager, TASK_ACCOUNTING_ALL, NULL);
                 char status_buffer[1024];
                 int written = TASK_CALL(task, get_status, status_buffer, sizeof(status_buffer));
                 if (written > 0) {
@@ -101,17 +188,41 @@ static void handle_interactive_commands(TaskManager* manager) {
             } else {
                 printf("未找到任务: %s\n", task_name);
             }
+        } else if (strncmp(command, "periodic ", 9) == 0) {
+            unsigned int interval_ms = 0;
+            if (sscanf(command + 9, "%63s %u", task_name, &interval_ms) == 2 &&
+                task_manager_schedule_periodic(manager, task_name, interval_ms) == 0) {
+                printf("任务 %s 已按 %u 毫秒周期调度\n", task_name, interval_ms);
+            } else {
+                printf("周期调度任务失败\n");
+            }
         } else if (strcmp(command, "list") == 0) {
-            char names[32][64];
-            int count = task_manager_list_tasks(manager, names, 32);
-            printf("任务列表 (共 %d 个):\n", count);
-            for (int i = 0; i < count; i++) {
-                TaskState state = task_manager_get_task_state(manager, names[i]);
-                const char* state_names[] = {
-                    "UNKNOWN", "INITIALIZED", "RUNNING", 
-                    "STOPPING", "STOPPED", "ERROR"
-                };
-                printf("  %s - %s\n", names[i], state_names[state]);
+            const char* state_names[] = {
+                "UNKNOWN", "INITIALIZED", "RUNNING", 
+                "STOPPING", "STOPPED", "ERROR"
+            };
+            TaskSnapshotRecord records[16];
+            SnapshotCursor cursor = SNAPSHOT_CURSOR_INIT;
+            int count;
+            while ((count = task_manager_snapshot(manager, records, 16, &cursor)) > 0) {
+                if (cursor.position == (uint32_t)count) {
+                    printf("任务列表 (共 %u 个):\n", cursor.total);
+                }
+                for (int i = 0; i < count; i++) {
+                    const TaskSnapshotRecord* record = &records[i];
+                    printf("  %s - %s, 执行 %u 次, 错误 %u, 重启 %u, 心跳 %llu 秒前\n",
+                           record->name, state_names[record->state],
+                           record->stats.execution_count, record->stats.error_count,
+                           record->restart_count, (unsigned long long)record->heartbeat_age);
+                    if (record->stats.restart.pending) {
+                        printf("    %s: 退避 %u ms, 窗口内已重启 %u 次\n",
+                               record->stats.restart.crash_loop ? "崩溃循环" : "退避中",
+                               record->stats.restart.backoff_ms, record->stats.restart.in_window);
+                    }
+                }
+            }
+            if (cursor.total == 0) {
+                printf("任务列表为空\n");
             }
         } else if (strcmp(command, "stats") == 0) {
             uint32_t total, running, error;
@@ -120,15 +231,53 @@ static void handle_interactive_commands(TaskManager* manager) {
             printf("  总任务数: %u\n", total);
             printf("  运行中: %u\n", running);
             printf("  错误任务: %u\n", error);
+            TaskAccountingSummary accounting;
+            if (task_manager_sample_accounting(manager, TASK_ACCOUNTING_ALL, &accounting) == 0) {
+                printf("  资源采样: %u 个任务, 耗时 %llu us, 进程常驻内存 %llu KB\n",
+                       accounting.sampled,
+                       (unsigned long long)(accounting.elapsed_ns / 1000),
+                       (unsigned long long)(accounting.process_rss / 1024));
+            }
+            HeartbeatWatchdogStats watchdog_stats;
+            if (task_manager_get_watchdog_stats(manager, &watchdog_stats) == 0) {
+                printf("  看门狗: 监视 %u, 唤醒 %llu, 顺延 %llu, 超时 %llu\n",
+                       watchdog_stats.watched_tasks,
+                       (unsigned long long)watchdog_stats.wakeups,
+                       (unsigned long long)watchdog_stats.rearms,
+                       (unsigned long long)watchdog_stats.misses);
+            }
+            LatencyHistogram* merged = malloc(sizeof(LatencyHistogram));
+            if (merged && task_manager_merge_latency(manager, merged) > 0) {
+                LatencySummary latency;
+                latency_histogram_summarize(merged, &latency);
+                printf("  单次耗时(全部任务): p50 %.1fus, p99 %.1fus, p999 %.1fus, %llu 次\n",
+                       latency.p50_ns / 1e3, latency.p99_ns / 1e3, latency.p999_ns / 1e3,
+                       (unsigned long long)latency.count);
+            }
+            free(merged);
+            EventDispatcherStats event_stats;
+            if (task_manager_get_event_stats(manager, &event_stats) == 0) {
+                printf("  事件分发: 投递 %llu, 交付 %llu, 合并 %llu, 丢弃 %llu, 批次 %llu\n",
+                       (unsigned long long)event_stats.posted,
+                       (unsigned long long)event_stats.delivered,
+                       (unsigned long long)event_stats.coalesced,
+                       (unsigned long long)event_stats.dropped,
+                       (unsigned long long)event_stats.batches);
+            }
         } else if (strcmp(command, "health") == 0) {
             int unhealthy = task_manager_health_check(manager);
             printf("健康检查完成，不健康任务数: %d\n", unhealthy);
         } else if (strcmp(command, "start_all") == 0) {
-            int failed = task_manager_start_all(manager);
-            printf("启动所有任务完成，失败任务数: %d\n", failed);
+            StartupReport report;
+            if (task_manager_start_all_ordered(manager, &g_startup_options, &report) >= 0) {
+                print_startup_report(&report);
+                startup_report_free(&report);
+            }
         } else if (strcmp(command, "stop_all") == 0) {
-            int failed = task_manager_stop_all(manager);
-            printf("停止所有任务完成，失败任务数: %d\n", failed);
+            LifecycleReport report;
+            task_manager_stop_all_parallel(manager, &g_lifecycle_options, &report);
+            print_lifecycle_report("停止所有任务", &report);
+            lifecycle_report_free(&report);
         } else if (strlen(command) > 0) {
             printf("未知命令: %s\n", command);
         }
@@ -152,7 +301,16 @@ int main() {
     }
     
     // 设置事件回调
-    task_manager_set_event_callback(g_manager, task_event_callback, NULL);
+    EventDispatcherConfig event_config = {
+        .capacity = 1024,
+        .max_batch = 64,
+        .coalesce = false,
+        .callback = task_event_callback,
+        .user_data = NULL
+    };
+    if (task_manager_set_async_event_callback(g_manager, &event_config) != 0) {
+        task_manager_set_event_callback(g_manager, task_event_callback, NULL);
+    }
     
     // 创建示例任务1
     TaskConfig config1 = {
@@ -163,7 +321,8 @@ int main() {
         .heartbeat_interval = 10,
         .auto_restart = true,
         .enable_stats = true,
-        .custom_config = NULL
+        .custom_config = NULL,
+        .placement = { .policy = CPU_PLACEMENT_SPREAD, .cpu_count = 1 }
     };
     
     ExampleTaskConfig custom_config1 = {
@@ -172,7 +331,7 @@ int main() {
         .message = "我是任务1，每3秒工作一次"
     };
     
-    ExampleTask* example1 = example_task_create(&config1, &custom_config1);
+    ExampleTask* example1 = example_task_create_in(&config1, &custom_config1, task_manager_get_arena(g_manager));
     if (example1) {
         task_manager_register(g_manager, example_task_get_base(example1), "task1");
         printf("注册任务1成功\n");
@@ -187,7 +346,9 @@ int main() {
         .heartbeat_interval = 15,
         .auto_restart = true,
         .enable_stats = true,
-        .custom_config = NULL
+        .custom_config = NULL,
+        .depends_on = { "task1" },
+        .dependency_count = 1
     };
     
     ExampleTaskConfig custom_config2 = {
@@ -196,15 +357,20 @@ int main() {
         .message = "我是任务2，每5秒工作一次(有随机延迟)"
     };
     
-    ExampleTask* example2 = example_task_create(&config2, &custom_config2);
+    ExampleTask* example2 = example_task_create_in(&config2, &custom_config2, task_manager_get_arena(g_manager));
     if (example2) {
         task_manager_register(g_manager, example_task_get_base(example2), "task2");
         printf("注册任务2成功\n");
     }
     
-    // 启动监控
-    if (task_manager_start_monitor(g_manager) == 0) {
-        printf("任务监控启动成功\n");
+    // 启动定时维护 - 负责auto_restart重启、重启策略和CPU记账采样，不占用监控线程
+    if (task_manager_start_maintenance(g_manager, 1000, TASK_ACCOUNTING_CPU) == 0) {
+        printf("定时维护启动成功\n");
+    }
+    
+    // 启动心跳看门狗 - 心跳超时改由看门狗按截止时间检测
+    if (task_manager_start_watchdog(g_manager, heartbeat_miss_callback, NULL) == 0) {
+        printf("心跳看门狗启动成功\n");
     }
     
     // 进入交互模式
@@ -214,7 +380,11 @@ int main() {
     printf("正在清理资源...\n");
     
     if (g_manager) {
+        task_manager_stop_watchdog(g_manager);
+        task_manager_stop_maintenance(g_manager);
+        task_manager_release_timers(g_manager);
         task_manager_stop_all(g_manager);
+        task_manager_release_events(g_manager);
         task_manager_destroy(g_manager);
     }
     
@@ -0,0 +1,23 @@
+#ifndef TEST_COMMON_H
+#define TEST_COMMON_H
+
+#include <stdio.h>
+
+/*
+ * 单元测试公用断言 - 失败时打印位置并计数，main以失败数作为退出码
+ */
+
+static int g_test_failures = 0;
+
+#define CHECK(condition)                                                        \
+    do {                                                                        \
+        if (!(condition)) {                                                     \
+            fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__,    \
+                    #condition);                                                \
+            g_test_failures++;                                                  \
+        }                                                                       \
+    } while (0)
+
+#define TEST_RESULT() (g_test_failures == 0 ? 0 : 1)
+
+#endif // TEST_COMMON_H
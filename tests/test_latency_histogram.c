@@ -0,0 +1,104 @@
+#include "latency_histogram.h"
+#include "test_common.h"
+#include <string.h>
+
+/*
+ * 延迟直方图测试 - 分桶精度、分位数、合并和摘要
+ */
+
+static LatencyHistogram g_histogram;
+static LatencyHistogram g_other;
+
+/**
+ * 分位数的相对误差不超过1/16，且不超过最大值
+ */
+static void test_percentiles(void) {
+    latency_histogram_reset(&g_histogram);
+    CHECK(latency_histogram_percentile(&g_histogram, 0.5) == 0);
+
+    // 1us..1000us各一个样本
+    for (uint64_t us = 1; us <= 1000; us++) {
+        latency_histogram_record(&g_histogram, us * 1000);
+    }
+    CHECK(g_histogram.count == 1000);
+    CHECK(g_histogram.min_ns == 1000);
+    CHECK(g_histogram.max_ns == 1000000);
+
+    const double quantiles[] = { 0.5, 0.9, 0.99, 0.999 };
+    for (int i = 0; i < 4; i++) {
+        uint64_t exact = (uint64_t)(quantiles[i] * 1000 + 0.5) * 1000;
+        uint64_t value = latency_histogram_percentile(&g_histogram, quantiles[i]);
+        CHECK(value >= exact);
+        CHECK(value <= exact + exact / 16);
+    }
+    CHECK(latency_histogram_percentile(&g_histogram, 1.0) == 1000000);
+    CHECK(latency_histogram_percentile(&g_histogram, 2.0) == 1000000);
+    CHECK(latency_histogram_percentile(&g_histogram, 0.0) <= 1000 + 1000 / 16);
+}
+
+/**
+ * 小于子桶数的值精确记录；超出范围的值计入最后一个桶，分位数以该桶上界封顶
+ */
+static void test_edges(void) {
+    latency_histogram_reset(&g_histogram);
+    for (uint64_t v = 0; v < LATENCY_SUB_BUCKETS; v++) {
+        latency_histogram_record(&g_histogram, v);
+    }
+    for (uint64_t v = 0; v < LATENCY_SUB_BUCKETS; v++) {
+        CHECK(g_histogram.buckets[v] == 1);
+    }
+    CHECK(latency_histogram_percentile(&g_histogram, 0.5) == LATENCY_SUB_BUCKETS / 2 - 1);
+
+    uint64_t huge = 1ULL << (LATENCY_MAX_BITS + 3);
+    latency_histogram_record(&g_histogram, huge);
+    CHECK(g_histogram.buckets[LATENCY_BUCKET_COUNT - 1] == 1);
+    CHECK(g_histogram.max_ns == huge);
+    uint64_t top = latency_histogram_percentile(&g_histogram, 1.0);
+    CHECK(top == (1ULL << LATENCY_MAX_BITS) - 1);
+}
+
+/**
+ * 合并与快照保留计数、极值和总和；摘要与分位数一致
+ */
+static void test_merge_and_summary(void) {
+    latency_histogram_reset(&g_histogram);
+    latency_histogram_reset(&g_other);
+    for (int i = 0; i < 99; i++) {
+        latency_histogram_record(&g_histogram, 2000);
+    }
+    latency_histogram_record(&g_other, 500);
+    latency_histogram_record(&g_other, 64000);
+
+    latency_histogram_merge(&g_histogram, &g_other);
+    CHECK(g_histogram.count == 101);
+    CHECK(g_histogram.min_ns == 500);
+    CHECK(g_histogram.max_ns == 64000);
+    CHECK(g_histogram.sum_ns == 99 * 2000 + 500 + 64000);
+
+    // 合并空直方图不改变极值
+    latency_histogram_reset(&g_other);
+    latency_histogram_merge(&g_histogram, &g_other);
+    CHECK(g_histogram.min_ns == 500);
+
+    latency_histogram_snapshot(&g_other, &g_histogram);
+    CHECK(memcmp(&g_other, &g_histogram, sizeof(LatencyHistogram)) == 0);
+
+    LatencySummary summary;
+    latency_histogram_summarize(&g_histogram, &summary);
+    CHECK(summary.count == 101);
+    CHECK(summary.mean_ns == g_histogram.sum_ns / 101);
+    CHECK(summary.p50_ns == latency_histogram_percentile(&g_histogram, 0.50));
+    CHECK(summary.p50_ns >= 2000 && summary.p50_ns <= 2000 + 2000 / 16);
+    CHECK(summary.p999_ns == 64000);
+
+    latency_histogram_reset(&g_histogram);
+    latency_histogram_summarize(&g_histogram, &summary);
+    CHECK(summary.count == 0 && summary.p99_ns == 0);
+}
+
+int main(void) {
+    test_percentiles();
+    test_edges();
+    test_merge_and_summary();
+    return TEST_RESULT();
+}
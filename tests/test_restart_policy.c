@@ -0,0 +1,139 @@
+#include "restart_policy.h"
+#include "test_common.h"
+#include <string.h>
+
+/*
+ * 重启策略测试 - 指数退避、抖动范围和崩溃循环截断
+ */
+
+#define MS 1000000ULL
+
+// 单调时钟起点，避免与"0表示未知"混淆
+#define BASE_NS (1000ULL * 1000 * MS)
+
+/**
+ * 连续失败时延迟按倍数增长并在上限处封顶；稳定运行后退避清零
+ */
+static void test_backoff(void) {
+    RestartPolicy policy = {
+        .initial_delay_ms = 100, .max_delay_ms = 1000, .backoff_factor = 2,
+        .window_ms = 60000, .max_restarts = RESTART_HISTORY_SIZE, .stable_ms = 5000
+    };
+    restart_policy_normalize(&policy, 0);
+
+    RestartState state;
+    restart_state_init(&state, 1);
+
+    const uint32_t expected[] = { 100, 200, 400, 800, 1000, 1000 };
+    uint64_t now = BASE_NS;
+    for (uint32_t i = 0; i < sizeof(expected) / sizeof(expected[0]); i++) {
+        uint64_t due = restart_state_schedule(&state, &policy, now);
+        CHECK(state.delay_ms == expected[i]);
+        CHECK(due == now + expected[i] * MS);
+
+        // 已有计划时不重复计算
+        CHECK(restart_state_schedule(&state, &policy, now + 1) == due);
+        CHECK(!restart_state_due(&state, due - 1));
+        CHECK(restart_state_due(&state, due));
+
+        restart_state_restarted(&state, due);
+        now = due + MS;
+    }
+    CHECK(state.total == 6);
+    CHECK(!state.crash_loop);
+
+    // 运行未满stable_ms不清零，满后清零
+    CHECK(!restart_state_mark_running(&state, &policy, state.started_ns + 4999 * MS));
+    CHECK(restart_state_mark_running(&state, &policy, state.started_ns + 5000 * MS));
+    CHECK(state.attempt == 0);
+    restart_state_schedule(&state, &policy, now + 10000 * MS);
+    CHECK(state.delay_ms == 100);
+}
+
+/**
+ * 抖动落在±jitter_percent内，且不同种子得到不同延迟
+ */
+static void test_jitter_bounds(void) {
+    RestartPolicy policy = { .initial_delay_ms = 1000, .max_delay_ms = 1000, .jitter_percent = 20 };
+    restart_policy_normalize(&policy, 0);
+
+    uint32_t min_delay = UINT32_MAX;
+    uint32_t max_delay = 0;
+    for (uint32_t seed = 1; seed <= 1000; seed++) {
+        RestartState state;
+        restart_state_init(&state, seed);
+        restart_state_schedule(&state, &policy, BASE_NS);
+        CHECK(state.delay_ms >= 800 && state.delay_ms <= 1200);
+        if (state.delay_ms < min_delay) {
+            min_delay = state.delay_ms;
+        }
+        if (state.delay_ms > max_delay) {
+            max_delay = state.delay_ms;
+        }
+    }
+    // 1000个种子应覆盖范围的大部分
+    CHECK(min_delay < 850);
+    CHECK(max_delay > 1150);
+
+    // 超过100%的抖动被截断，延迟不会下溢
+    RestartPolicy wide = { .initial_delay_ms = 100, .max_delay_ms = 100, .jitter_percent = 500 };
+    restart_policy_normalize(&wide, 0);
+    CHECK(wide.jitter_percent == 100);
+    for (uint32_t seed = 1; seed <= 100; seed++) {
+        RestartState state;
+        restart_state_init(&state, seed);
+        restart_state_schedule(&state, &wide, BASE_NS);
+        CHECK(state.delay_ms <= 200);
+    }
+}
+
+/**
+ * 窗口内重启max_restarts次后进入崩溃循环，下一次重启推迟到最早的一次滑出窗口
+ */
+static void test_crash_loop_cutoff(void) {
+    RestartPolicy policy = { .initial_delay_ms = 10, .max_delay_ms = 10, .window_ms = 10000, .max_restarts = 3 };
+    restart_policy_normalize(&policy, 0);
+    CHECK(policy.stable_ms == policy.window_ms);
+
+    RestartState state;
+    restart_state_init(&state, 7);
+
+    uint64_t now = BASE_NS;
+    uint64_t first_restart = 0;
+    for (int i = 0; i < 3; i++) {
+        uint64_t due = restart_state_schedule(&state, &policy, now);
+        CHECK(!state.crash_loop);
+        restart_state_restarted(&state, due);
+        if (i == 0) {
+            first_restart = due;
+        }
+        now = due + MS;
+    }
+
+    uint64_t due = restart_state_schedule(&state, &policy, now);
+    CHECK(state.crash_loop);
+    CHECK(due == first_restart + policy.window_ms * MS);
+
+    RestartStats stats;
+    restart_state_export(&state, &policy, now, &stats);
+    CHECK(stats.crash_loop && stats.pending);
+    CHECK(stats.in_window == 3);
+    CHECK(stats.total == 3);
+
+    // 窗口有余量后重启，稳定运行后崩溃循环状态清零
+    restart_state_restarted(&state, due);
+    CHECK(restart_state_mark_running(&state, &policy, due + policy.stable_ms * MS));
+    CHECK(!state.crash_loop);
+
+    // fallback只在max_restarts为0时生效，且不超过历史容量
+    RestartPolicy fallback = {0};
+    restart_policy_normalize(&fallback, 100);
+    CHECK(fallback.max_restarts == RESTART_HISTORY_SIZE);
+}
+
+int main(void) {
+    test_backoff();
+    test_jitter_bounds();
+    test_crash_loop_cutoff();
+    return TEST_RESULT();
+}
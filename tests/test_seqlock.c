@@ -0,0 +1,61 @@
+#include "seqlock.h"
+#include "test_common.h"
+#include <string.h>
+
+/*
+ * 顺序锁测试 - 写入期间读者重试，写者死在写入中途时有界读取放弃
+ */
+
+typedef struct {
+    uint64_t first;
+    uint64_t second;
+} Pair;
+
+/**
+ * 读取期间发生写入时需要重读；写入结束后读到新值
+ */
+static void test_retry(void) {
+    SeqLock lock = SEQLOCK_INITIALIZER;
+    Pair data = { 1, 1 };
+    Pair copy;
+
+    uint32_t start = seqlock_read_begin(&lock);
+    seqlock_read_copy(&copy, &data, sizeof(Pair));
+    CHECK(!seqlock_read_retry(&lock, start));
+
+    start = seqlock_read_begin(&lock);
+    seqlock_write_begin(&lock);
+    data.first = 2;
+    data.second = 2;
+    seqlock_write_end(&lock);
+    CHECK(seqlock_read_retry(&lock, start));
+
+    CHECK(seqlock_copy_out(&lock, &copy, &data, sizeof(Pair)) == 0);
+    CHECK(copy.first == 2 && copy.second == 2);
+}
+
+/**
+ * 序号停在奇数时有界读取在限定次数后返回-1，写入结束后恢复
+ */
+static void test_abandoned_writer(void) {
+    SeqLock lock;
+    seqlock_init(&lock);
+
+    uint32_t start = UINT32_MAX;
+    CHECK(seqlock_read_try_begin(&lock, 1, &start) == 0);
+    CHECK(start == 0);
+
+    seqlock_write_begin(&lock);
+    CHECK(seqlock_read_try_begin(&lock, 1000, &start) == -1);
+    CHECK(start == 0);
+
+    seqlock_write_end(&lock);
+    CHECK(seqlock_read_try_begin(&lock, 1, &start) == 0);
+    CHECK(start == 2);
+}
+
+int main(void) {
+    test_retry();
+    test_abandoned_writer();
+    return TEST_RESULT();
+}
@@ -0,0 +1,179 @@
+#include "startup_graph.h"
+#include "test_common.h"
+#include <pthread.h>
+#include <string.h>
+
+/*
+ * 启动图测试 - 依赖顺序、成环、依赖缺失和失败的向下游传播
+ */
+
+#define MAX_STARTED 32
+
+typedef struct {
+    pthread_mutex_t mutex;
+    char started[MAX_STARTED][64];     // 按启动顺序记录的名称
+    uint32_t started_count;
+} FakeTarget;
+
+static bool is_started(FakeTarget* target, const char* name) {
+    for (uint32_t i = 0; i < target->started_count; i++) {
+        if (strcmp(target->started[i], name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static int start_order(FakeTarget* target, const char* name) {
+    for (uint32_t i = 0; i < target->started_count; i++) {
+        if (strcmp(target->started[i], name) == 0) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+// 名称以"fail"开头的节点启动失败
+static int fake_start(void* arg, const char* name) {
+    FakeTarget* target = arg;
+    pthread_mutex_lock(&target->mutex);
+    if (target->started_count < MAX_STARTED) {
+        strncpy(target->started[target->started_count++], name, 63);
+    }
+    pthread_mutex_unlock(&target->mutex);
+    return strncmp(name, "fail", 4) == 0 ? -1 : 0;
+}
+
+// 已启动的节点和外部依赖"ext_ready"视为就绪
+static bool fake_probe(void* arg, const char* name) {
+    FakeTarget* target = arg;
+    if (strcmp(name, "ext_ready") == 0) {
+        return true;
+    }
+    pthread_mutex_lock(&target->mutex);
+    bool ready = is_started(target, name) && strncmp(name, "fail", 4) != 0;
+    pthread_mutex_unlock(&target->mutex);
+    return ready;
+}
+
+static void set_node(StartupNode* node, const char* name, const char* dep0, const char* dep1) {
+    memset(node, 0, sizeof(StartupNode));
+    strncpy(node->name, name, sizeof(node->name) - 1);
+    if (dep0) {
+        strncpy(node->depends_on[node->dependency_count++], dep0, 63);
+    }
+    if (dep1) {
+        strncpy(node->depends_on[node->dependency_count++], dep1, 63);
+    }
+}
+
+static const StartupEntry* find_entry(const StartupReport* report, const char* name) {
+    for (uint32_t i = 0; i < report->count; i++) {
+        if (strcmp(report->entries[i].name, name) == 0) {
+            return &report->entries[i];
+        }
+    }
+    return NULL;
+}
+
+static StartupOutcome outcome_of(const StartupReport* report, const char* name) {
+    const StartupEntry* entry = find_entry(report, name);
+    return entry ? entry->outcome : STARTUP_PENDING;
+}
+
+static int run_graph(FakeTarget* target, const StartupNode* nodes, uint32_t count, StartupReport* report) {
+    StartupOptions options = { .max_parallel = 4, .ready_timeout_ms = 500, .poll_ms = 2 };
+    memset(target->started, 0, sizeof(target->started));
+    target->started_count = 0;
+    return startup_graph_run(target, nodes, count, fake_start, fake_probe, &options, report);
+}
+
+/**
+ * 链式依赖按层次启动，环及其下游被阻塞且从未启动
+ */
+static void test_order_and_cycle(FakeTarget* target) {
+    StartupNode nodes[6];
+    set_node(&nodes[0], "c", "b", NULL);
+    set_node(&nodes[1], "b", "a", NULL);
+    set_node(&nodes[2], "a", NULL, NULL);
+    set_node(&nodes[3], "x", "y", NULL);
+    set_node(&nodes[4], "y", "x", NULL);
+    set_node(&nodes[5], "z", "y", NULL);
+
+    StartupReport report;
+    int ret = run_graph(target, nodes, 6, &report);
+    CHECK(ret == 3);
+    CHECK(report.ready == 3);
+    CHECK(report.blocked == 3);
+    CHECK(report.wave_count == 3);
+
+    CHECK(outcome_of(&report, "a") == STARTUP_READY);
+    CHECK(outcome_of(&report, "c") == STARTUP_READY);
+    CHECK(find_entry(&report, "c")->wave == 2);
+    CHECK(start_order(target, "a") < start_order(target, "b"));
+    CHECK(start_order(target, "b") < start_order(target, "c"));
+
+    CHECK(outcome_of(&report, "x") == STARTUP_BLOCKED);
+    CHECK(outcome_of(&report, "y") == STARTUP_BLOCKED);
+    CHECK(outcome_of(&report, "z") == STARTUP_BLOCKED);
+    CHECK(!is_started(target, "x") && !is_started(target, "z"));
+
+    // 关键路径从a到c
+    CHECK(report.critical_path_length == 3);
+    startup_report_free(&report);
+}
+
+/**
+ * 不在本批中的依赖按外部依赖探测一次，未就绪则阻塞
+ */
+static void test_missing_dependency(FakeTarget* target) {
+    StartupNode nodes[3];
+    set_node(&nodes[0], "m", "ext_missing", NULL);
+    set_node(&nodes[1], "n", "ext_ready", NULL);
+    set_node(&nodes[2], "o", "m", "n");
+
+    StartupReport report;
+    int ret = run_graph(target, nodes, 3, &report);
+    CHECK(ret == 2);
+    CHECK(outcome_of(&report, "m") == STARTUP_BLOCKED);
+    CHECK(outcome_of(&report, "n") == STARTUP_READY);
+    CHECK(outcome_of(&report, "o") == STARTUP_BLOCKED);
+    CHECK(!is_started(target, "m") && !is_started(target, "o"));
+    startup_report_free(&report);
+}
+
+/**
+ * 启动失败阻塞全部下游，不影响无关分支
+ */
+static void test_blocked_propagation(FakeTarget* target) {
+    StartupNode nodes[4];
+    set_node(&nodes[0], "fail_root", NULL, NULL);
+    set_node(&nodes[1], "g", "fail_root", NULL);
+    set_node(&nodes[2], "h", "g", NULL);
+    set_node(&nodes[3], "i", NULL, NULL);
+
+    StartupReport report;
+    int ret = run_graph(target, nodes, 4, &report);
+    CHECK(ret == 3);
+    CHECK(report.failed == 1);
+    CHECK(report.blocked == 2);
+    CHECK(outcome_of(&report, "fail_root") == STARTUP_FAILED);
+    CHECK(outcome_of(&report, "g") == STARTUP_BLOCKED);
+    CHECK(outcome_of(&report, "h") == STARTUP_BLOCKED);
+    CHECK(outcome_of(&report, "i") == STARTUP_READY);
+    CHECK(!is_started(target, "g") && !is_started(target, "h"));
+    startup_report_free(&report);
+}
+
+int main(void) {
+    FakeTarget target;
+    memset(&target, 0, sizeof(target));
+    pthread_mutex_init(&target.mutex, NULL);
+
+    test_order_and_cycle(&target);
+    test_missing_dependency(&target);
+    test_blocked_propagation(&target);
+
+    pthread_mutex_destroy(&target.mutex);
+    return TEST_RESULT();
+}
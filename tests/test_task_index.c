@@ -0,0 +1,112 @@
+#include "task_index.h"
+#include "task_manager.h"
+#include "test_common.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * 任务名称索引测试 - 插入查找、重复、删除后的探测链和扩容
+ */
+
+#define NODE_COUNT 1000
+
+static TaskNode g_nodes[NODE_COUNT];
+
+static void name_nodes(void) {
+    for (int i = 0; i < NODE_COUNT; i++) {
+        memset(&g_nodes[i], 0, sizeof(TaskNode));
+        snprintf(g_nodes[i].name, sizeof(g_nodes[i].name), "task_%d", i);
+    }
+}
+
+/**
+ * 插入大量节点触发多次扩容，全部可查到；重复名称被拒绝
+ */
+static void test_insert_find(void) {
+    TaskIndex index;
+    CHECK(task_index_init(&index, 4) == 0);
+    CHECK(index.capacity == 16);
+
+    for (int i = 0; i < NODE_COUNT; i++) {
+        CHECK(task_index_insert(&index, &g_nodes[i]) == 0);
+    }
+    CHECK(index.count == NODE_COUNT);
+    CHECK((index.capacity & (index.capacity - 1)) == 0);
+    CHECK((uint64_t)index.count * 10 <= (uint64_t)index.capacity * 7);
+
+    for (int i = 0; i < NODE_COUNT; i++) {
+        CHECK(task_index_find(&index, g_nodes[i].name) == &g_nodes[i]);
+    }
+    CHECK(task_index_find(&index, "missing") == NULL);
+
+    TaskNode duplicate;
+    memset(&duplicate, 0, sizeof(duplicate));
+    strcpy(duplicate.name, "task_7");
+    CHECK(task_index_insert(&index, &duplicate) == -2);
+    CHECK(task_index_find(&index, "task_7") == &g_nodes[7]);
+
+    task_index_destroy(&index);
+    CHECK(index.slots == NULL && index.count == 0);
+}
+
+/**
+ * 删除留下的墓碑不截断其他节点的探测链，反复增删不会无限积累墓碑
+ */
+static void test_remove(void) {
+    TaskIndex index;
+    CHECK(task_index_init(&index, 0) == 0);
+    for (int i = 0; i < NODE_COUNT; i++) {
+        task_index_insert(&index, &g_nodes[i]);
+    }
+
+    for (int i = 0; i < NODE_COUNT; i += 2) {
+        CHECK(task_index_remove(&index, g_nodes[i].name) == &g_nodes[i]);
+    }
+    CHECK(task_index_remove(&index, g_nodes[0].name) == NULL);
+    CHECK(index.count == NODE_COUNT / 2);
+    for (int i = 0; i < NODE_COUNT; i++) {
+        CHECK(task_index_find(&index, g_nodes[i].name) == (i % 2 ? &g_nodes[i] : NULL));
+    }
+
+    uint32_t capacity = index.capacity;
+    for (int round = 0; round < 20; round++) {
+        for (int i = 0; i < NODE_COUNT; i += 2) {
+            CHECK(task_index_insert(&index, &g_nodes[i]) == 0);
+        }
+        for (int i = 0; i < NODE_COUNT; i += 2) {
+            CHECK(task_index_remove(&index, g_nodes[i].name) == &g_nodes[i]);
+        }
+    }
+    CHECK(index.capacity == capacity);
+    CHECK((uint64_t)(index.count + index.tombstones) * 10 <= (uint64_t)index.capacity * 7);
+    for (int i = 1; i < NODE_COUNT; i += 2) {
+        CHECK(task_index_find(&index, g_nodes[i].name) == &g_nodes[i]);
+    }
+
+    task_index_destroy(&index);
+}
+
+/**
+ * 未初始化的索引在首次插入时分配；哈希值稳定
+ */
+static void test_lazy_init_and_hash(void) {
+    TaskIndex index;
+    memset(&index, 0, sizeof(index));
+    CHECK(task_index_find(&index, "task_0") == NULL);
+    CHECK(task_index_insert(&index, &g_nodes[0]) == 0);
+    CHECK(task_index_find(&index, "task_0") == &g_nodes[0]);
+    task_index_destroy(&index);
+
+    // FNV-1a
+    CHECK(task_index_hash("") == 2166136261u);
+    CHECK(task_index_hash("a") == 0xe40c292cu);
+    CHECK(task_index_hash("task_1") != task_index_hash("task_2"));
+}
+
+int main(void) {
+    name_nodes();
+    test_insert_find();
+    test_remove();
+    test_lazy_init_and_hash();
+    return TEST_RESULT();
+}
@@ -0,0 +1,129 @@
+#include "timer_wheel.h"
+#include "test_common.h"
+#include <string.h>
+
+/*
+ * 时间轮测试 - 跨层级联、周期重挂、回调内重挂和取消
+ */
+
+typedef struct {
+    TimerWheel* wheel;
+    uint64_t fired_at[16];             // 每次触发时的tick
+    uint32_t fired;
+    uint32_t rearm_remaining;          // 回调内还需重挂的次数
+    uint64_t rearm_delay;
+} Probe;
+
+static void record_fire(TimerWheelTimer* timer, void* user_data) {
+    (void)timer;
+    Probe* probe = user_data;
+    if (probe->fired < sizeof(probe->fired_at) / sizeof(probe->fired_at[0])) {
+        probe->fired_at[probe->fired] = probe->wheel->current_tick;
+    }
+    probe->fired++;
+}
+
+static void rearm_fire(TimerWheelTimer* timer, void* user_data) {
+    Probe* probe = user_data;
+    record_fire(timer, user_data);
+    if (probe->rearm_remaining > 0) {
+        probe->rearm_remaining--;
+        timer_wheel_add(probe->wheel, timer, probe->wheel->current_tick + probe->rearm_delay);
+    }
+}
+
+static void init_timer(TimerWheelTimer* timer, uint64_t interval, TimerWheelCallback callback, Probe* probe) {
+    memset(timer, 0, sizeof(TimerWheelTimer));
+    timer->interval = interval;
+    timer->callback = callback;
+    timer->user_data = probe;
+}
+
+/**
+ * 挂在第1、2、3层的定时器经级联后恰好在到期tick触发，起点不在层边界上
+ */
+static void test_cascade(void) {
+    static TimerWheel wheel;
+    const uint64_t start = 1000;
+    timer_wheel_init(&wheel, start);
+
+    const uint64_t delays[] = { 300, 70000, 5000000 };
+    Probe probes[3];
+    TimerWheelTimer timers[3];
+    for (int i = 0; i < 3; i++) {
+        memset(&probes[i], 0, sizeof(Probe));
+        probes[i].wheel = &wheel;
+        init_timer(&timers[i], 0, record_fire, &probes[i]);
+        timer_wheel_add(&wheel, &timers[i], start + delays[i]);
+    }
+    CHECK(wheel.count == 3);
+
+    // 分段推进，每段都跨过若干级联点
+    uint64_t now = start;
+    while (now < start + delays[2] + 10) {
+        uint64_t next = timer_wheel_next_tick(&wheel);
+        CHECK(next > now);
+        now += 4099;
+        timer_wheel_advance(&wheel, now);
+    }
+
+    for (int i = 0; i < 3; i++) {
+        CHECK(probes[i].fired == 1);
+        CHECK(probes[i].fired_at[0] == start + delays[i]);
+        CHECK(!timers[i].armed);
+    }
+    CHECK(wheel.count == 0);
+    CHECK(timer_wheel_next_tick(&wheel) == UINT64_MAX);
+}
+
+/**
+ * 周期定时器按原节拍重挂；回调内重挂的一次性定时器从当前tick起算
+ */
+static void test_rearm(void) {
+    static TimerWheel wheel;
+    timer_wheel_init(&wheel, 0);
+
+    Probe periodic = { .wheel = &wheel };
+    TimerWheelTimer periodic_timer;
+    init_timer(&periodic_timer, 100, record_fire, &periodic);
+    timer_wheel_add(&wheel, &periodic_timer, 50);
+
+    Probe oneshot = { .wheel = &wheel, .rearm_remaining = 3, .rearm_delay = 300 };
+    TimerWheelTimer oneshot_timer;
+    init_timer(&oneshot_timer, 0, rearm_fire, &oneshot);
+    timer_wheel_add(&wheel, &oneshot_timer, 10);
+
+    uint32_t fired = timer_wheel_advance(&wheel, 1000);
+    CHECK(periodic.fired == 10);
+    for (uint32_t i = 0; i < periodic.fired && i < 10; i++) {
+        CHECK(periodic.fired_at[i] == 50 + i * 100);
+    }
+    CHECK(periodic_timer.armed);
+    CHECK(periodic_timer.expires == 1050);
+
+    CHECK(oneshot.fired == 4);
+    CHECK(oneshot.fired_at[3] == 910);
+    CHECK(!oneshot_timer.armed);
+    CHECK(fired == periodic.fired + oneshot.fired);
+
+    // 取消后不再触发
+    timer_wheel_cancel(&wheel, &periodic_timer);
+    CHECK(!periodic_timer.armed);
+    CHECK(wheel.count == 0);
+    timer_wheel_advance(&wheel, 2000);
+    CHECK(periodic.fired == 10);
+
+    // 已过期的到期时间按下一tick处理
+    Probe late = { .wheel = &wheel };
+    TimerWheelTimer late_timer;
+    init_timer(&late_timer, 0, record_fire, &late);
+    timer_wheel_add(&wheel, &late_timer, 1500);
+    timer_wheel_advance(&wheel, 2001);
+    CHECK(late.fired == 1 && late.fired_at[0] == 2001);
+}
+
+int main(void) {
+    test_cascade();
+    test_rearm();
+    return TEST_RESULT();
+}